@@ -1,4 +1,5 @@
 #include <Python.h>
+#include <errno.h>
 #include <numpy/arrayobject.h>
 #include "fht.h"
 
@@ -19,100 +20,956 @@ static char fht_docstring[] =
     "[AVX](https://en.wikipedia.org/wiki/Advanced_Vector_Extensions) "
     "to speed up the computation. If AVX is not supported on your machine, "
     "a simpler implementation without (explicit) vectorization is used.\n\n"
-    "The function takes two parameters:\n\n"
+    "The function takes three parameters:\n\n"
     "* `buffer` is a NumPy array which is being transformed. It must be a "
-    "one-dimensional array with `dtype` equal to `float32` or `float64` (the "
-    "former is recommended unless you need high accuracy) and of size being a "
-    "power "
-    "of two. If your CPU supports AVX, then `buffer` must be aligned to 32 "
-    "bytes. "
-    "To allocate such an aligned buffer, use the function `created_aligned` "
-    "from this "
-    "module.\n"
-    "* `chunk` is a positive integer that controls when the implementation "
-    "switches "
-    "from recursive to iterative algorithm. The overall algorithm is "
-    "recursive, but as "
-    "soon as the vector becomes no longer than `chunk`, the iterative "
-    "algorithm is "
-    "invoked. For technical reasons, `chunk` must be at least 8. A good choice "
-    "is to "
-    "set `chunk` to 1024. But to fine-tune the performance one should use a "
-    "program "
-    "`best_chunk` supplied with the library.\n";
-
-static PyObject *ffht_fht(PyObject *self, PyObject *args) {
+    "one-dimensional, C-contiguous and aligned array with `dtype` equal to "
+    "`float32` or `float64` (the former is recommended unless you need high "
+    "accuracy) and of size being a power of two. `int16`, `int32` and `int64` "
+    "arrays get an exact integer transform (`int16` raises OverflowError if a "
+    "value saturates), and `float16` is transformed with float32 arithmetic. "
+    "The array is used where it is, never copied, so anything else (a list, a "
+    "strided view, another dtype) raises TypeError or ValueError instead of "
+    "transforming a temporary. Arrays from `created_aligned` keep the SIMD "
+    "loads on cache-line boundaries.\n"
+    "* `out` (optional) receives the transform and `buffer` is left unchanged. "
+    "It must have the same dtype and length as `buffer`, and it may be "
+    "`buffer` itself but not overlap it otherwise. For `float32` and "
+    "`float64` the copy is fused into the first pass. `out` is returned.\n"
+    "* `order` (optional, `float32`/`float64`): \"natural\" (the default), "
+    "\"sequency\" (Walsh order, coefficient k has k sign changes) or \"paley\" "
+    "(dyadic order, the natural one at bit-reversed indices). The permutation "
+    "is applied while the input is gathered into `out`, not as a pass over "
+    "the result.\n\n"
+    "The GIL is released while the transform runs, so threads can transform "
+    "different arrays in parallel.\n";
+
+static char fht_batch_docstring[] =
+    "fht_batch(buffer, axis=-1, threads=1): in-place FHT of every 1-D slice "
+    "of `buffer` along `axis`, in a single call. `buffer` is an N-D "
+    "float32/float64 array with the memory requirements of `fht`; its length "
+    "along `axis` must be a power of two. The last axis runs as a batch of "
+    "contiguous rows, other axes as column transforms without a transpose. "
+    "The slices are spread over `threads` threads (0 or less: the library "
+    "default, all CPUs) once the array has 2^16 elements or more.\n";
+
+static char fht_hd_docstring[] =
+    "fht_hd(buffer, sign_bits, scale=1.0): in-place randomized Hadamard "
+    "transform (H D_k) ... (H D_1) of every row of a 1-D or 2-D "
+    "float32/float64 `buffer` (memory requirements of `fht`), as used by "
+    "cross-polytope LSH and SRHT. `sign_bits` is a C-contiguous uint64 array "
+    "of k * max(1, n / 64) words, round by round: bit i % 64 of word i / 64 "
+    "set negates element i before that round's transform. The flips ride in "
+    "the transform passes and the result is multiplied by `scale`, so the k "
+    "rounds cost k plain transforms. The GIL is released while it runs.\n";
+
+static char fht_argmax_docstring[] =
+    "fht_argmax(buffer): in-place FHT of every row of a 1-D or 2-D "
+    "float32/float64 `buffer` (memory requirements of `fht`) that also "
+    "returns the index of each row's largest |coefficient|, picked out while "
+    "the last butterfly stage writes it: an int for a 1-D array, an intp "
+    "array for a 2-D one. Ties go to the lower index, NaNs are never picked "
+    "and the spectrum stays in `buffer`, so buffer[index] gives the sign of a "
+    "cross-polytope LSH hash. The GIL is released while it runs.\n";
+
+static char fht_topk_docstring[] =
+    "fht_topk(buffer, k): like `fht_argmax`, with the indices of the `k` "
+    "largest |coefficients| of each row, largest first: an intp array of "
+    "shape (k,) or (rows, k), -1 where NaNs leave fewer than k.\n";
+
+static char fht_threshold_docstring[] =
+    "fht_threshold(buffer, threshold): in-place FHT of a 1-D float32/float64 "
+    "`buffer` that also returns the indices of the coefficients with "
+    "magnitude at least `threshold`, in increasing order, as an intp array "
+    "collected during the last butterfly stage.\n";
+
+static char created_aligned_docstring[] =
+    "created_aligned(n, dtype=numpy.float32, alignment=64): return a "
+    "zero-filled one-dimensional array of `n` elements whose data starts on "
+    "an `alignment`-byte boundary (a power of two). The memory is released "
+    "with the array.\n";
+
+static char fht_scaled_docstring[] =
+    "fht_scaled(buffer, scale): compute the FHT of `buffer` in place and "
+    "multiply the result by `scale`. The scale is applied inside the last "
+    "butterfly stage, so it is as fast as `fht`. `buffer` has the same "
+    "requirements as for `fht`.\n";
+
+static char fht_orthonormal_docstring[] =
+    "fht_orthonormal(buffer): in-place FHT scaled by 1/sqrt(n). The "
+    "orthonormal transform is its own inverse.\n";
+
+static char fht_inverse_docstring[] =
+    "fht_inverse(buffer): in-place FHT scaled by 1/n, which undoes `fht`.\n";
+
+static char tune_docstring[] =
+    "tune(max_log_n=20, max_threads=0): time every kernel this CPU supports "
+    "for each size up to 2^max_log_n, float32 and float64, and from 2^16 the "
+    "thread split of the C library's multithreaded transform (up to "
+    "`max_threads`, 0: all CPUs). Later calls use the fastest kernel for each "
+    "size. Takes a few seconds; the GIL is released while it runs.\n";
+
+static char fht_file_docstring[] =
+    "fht_file(file, n, offset=0, dtype=float32, mem_bytes=1<<28, threads=0): "
+    "transform in place the `n` native-endian float32 or float64 values at "
+    "byte `offset` of `file`, an open file descriptor or an object with "
+    "fileno() opened for reading and writing (flush buffered writes first). "
+    "`n` is a power of two up to 2^48, so vectors larger than RAM work: the "
+    "file is read and written once per pass through two tiles that fit in "
+    "`mem_bytes`, with the I/O overlapping the transform on `threads` threads "
+    "(0: the default). Raises OSError on I/O errors, after which the file is "
+    "partly transformed. The GIL is released while it runs.\n";
+
+static char wisdom_save_docstring[] =
+    "wisdom_save(path): write the `tune` results to a text file.\n";
+
+static char wisdom_load_docstring[] =
+    "wisdom_load(path): read a file written by `wisdom_save`. Entries for "
+    "kernels this CPU does not support are skipped. Setting FFHT_WISDOM=path "
+    "does the same when the module is imported.\n";
+
+static char wisdom_forget_docstring[] =
+    "wisdom_forget(): drop all tuning results.\n";
+
+static char stats_docstring[] =
+    "stats(all_threads=True): the C library's call counters as a list of "
+    "dicts, one per (dtype, entry point, log_n) that was called, with keys "
+    "`dtype` ('float32', 'float64', 'float16', 'bfloat16', 'int16', 'int32', "
+    "'int64'), `entry` ('inplace', 'oop', 'batch', 'scaled', 'stream', 'mt', "
+    "'hd', 'xor', 'reduce', 'sparse', 'ordered', 'strided', 'file'), `log_n`, "
+    "`calls`, `bytes`, `ns`, `histogram` (calls per [2^b, 2^(b+1)) ns bin) and "
+    "`kernel`. Only the outermost C call is counted, so an xor_convolve is "
+    "one 'xor' call. With all_threads=False only the calling thread's calls "
+    "are included. Counting is off until `stats_enable()` or FFHT_STATS=1; "
+    "RuntimeError if the library was built without it.\n";
+
+static char stats_enable_docstring[] =
+    "stats_enable(on=True): turn the call counters on or off and return the "
+    "previous state.\n";
+
+static char stats_reset_docstring[] =
+    "stats_reset(all_threads=True): zero the call counters of every thread, "
+    "or of the calling thread only.\n";
+
+static char kernel_name_docstring[] =
+    "Return the name of the SIMD kernel (\"avx\", \"sse\", \"neon\", ...) that "
+    "was selected for this CPU when the module was loaded.\n";
+
+/* Check that `buffer_obj` is a NumPy array of a supported dtype that can be
+ * transformed where it is: C-contiguous, aligned and, if `writeable`,
+ * writeable. Nothing is ever converted or copied, since the transform of a
+ * temporary would be silently lost. Returns a borrowed reference, or sets an
+ * exception and returns NULL. */
+static PyArrayObject *check_array(PyObject *buffer_obj, int writeable) {
+  if (!PyArray_Check(buffer_obj)) {
+    PyErr_SetString(PyExc_TypeError, "not a numpy array");
+    return NULL;
+  }
+  PyArrayObject *arr = (PyArrayObject *)buffer_obj;
+
+  switch (PyArray_TYPE(arr)) {
+    case NPY_FLOAT: case NPY_DOUBLE: case NPY_HALF:
+    case NPY_INT16: case NPY_INT32: case NPY_INT64:
+      break;
+    default:
+      PyErr_SetString(PyExc_TypeError,
+                      "array must consist of float16/32/64 or int16/int32/int64");
+      return NULL;
+  }
+
+  if (!PyArray_IS_C_CONTIGUOUS(arr) || !PyArray_ISALIGNED(arr)) {
+    PyErr_SetString(PyExc_ValueError,
+                    "array must be contiguous and aligned (use numpy.ascontiguousarray)");
+    return NULL;
+  }
+
+  if (writeable && !PyArray_ISWRITEABLE(arr)) {
+    PyErr_SetString(PyExc_ValueError, "array is read-only");
+    return NULL;
+  }
+  return arr;
+}
+
+/* log2 of a transform length, or -1 with an exception set */
+static int get_log_n(npy_intp n) {
+  if (n == 0 || (n & (n - 1))) {
+    PyErr_SetString(PyExc_ValueError, "array's length must be a power of two");
+    return -1;
+  }
+
+  int log_n = 0;
+  while (((npy_intp)1 << log_n) < n) {
+    ++log_n;
+  }
+  if (log_n > 30) {
+    PyErr_SetString(PyExc_ValueError, "array's length must be at most 2^30");
+    return -1;
+  }
+  return log_n;
+}
+
+/* A 1-D checked array of power-of-two length: returns a new reference and
+ * stores log2(length) */
+static PyArrayObject *get_buffer(PyObject *buffer_obj, int writeable, int *log_n_out) {
+  PyArrayObject *arr = check_array(buffer_obj, writeable);
+  if (arr == NULL) {
+    return NULL;
+  }
+
+  if (PyArray_NDIM(arr) != 1) {
+    PyErr_SetString(PyExc_TypeError, "array must be one-dimensional");
+    return NULL;
+  }
+
+  *log_n_out = get_log_n(PyArray_DIM(arr, 0));
+  if (*log_n_out < 0) {
+    return NULL;
+  }
+  Py_INCREF(arr);
+  return arr;
+}
+
+enum fht_variant { FHT_PLAIN, FHT_SCALED, FHT_ORTHONORMAL, FHT_INVERSE };
+
+/* Transform `raw_buffer` in place; called without the GIL, so it must not
+ * touch Python objects */
+static int transform(void *raw_buffer, int type_num, int log_n, enum fht_variant variant, double scale) {
+  switch (type_num) {
+    case NPY_INT16: return fht_int16((int16_t *)raw_buffer, log_n);
+    case NPY_INT32: return fht_int32((int32_t *)raw_buffer, log_n);
+    case NPY_INT64: return fht_int64((int64_t *)raw_buffer, log_n);
+    case NPY_HALF: return fht_half((uint16_t *)raw_buffer, log_n);
+    case NPY_FLOAT:
+      switch (variant) {
+        case FHT_SCALED: return fht_float_scaled((float *)raw_buffer, log_n, (float)scale);
+        case FHT_ORTHONORMAL: return fht_float_orthonormal((float *)raw_buffer, log_n);
+        case FHT_INVERSE: return fht_float_inverse((float *)raw_buffer, log_n);
+        default: return fht_float((float *)raw_buffer, log_n);
+      }
+    default:
+      switch (variant) {
+        case FHT_SCALED: return fht_double_scaled((double *)raw_buffer, log_n, scale);
+        case FHT_ORTHONORMAL: return fht_double_orthonormal((double *)raw_buffer, log_n);
+        case FHT_INVERSE: return fht_double_inverse((double *)raw_buffer, log_n);
+        default: return fht_double((double *)raw_buffer, log_n);
+      }
+  }
+}
+
+/* `out_obj` (NULL or None: in place) receives the transform of `buffer_obj`,
+ * which is then only read. float32/float64 use the fused out-of-place
+ * kernel, or fht_*_ordered for another `order`; the other dtypes copy first. */
+static PyObject *run_fht(PyObject *buffer_obj, PyObject *out_obj, enum fht_variant variant, double scale,
+                         int order) {
+  int log_n, out_log_n;
+  int has_out = out_obj != NULL && out_obj != Py_None;
+  PyArrayObject *arr = get_buffer(buffer_obj, !has_out, &log_n);
+  if (arr == NULL) {
+    return NULL;
+  }
+  PyArrayObject *out = arr;
+  int type_num = PyArray_TYPE(arr);
+
+  if (has_out) {
+    out = get_buffer(out_obj, 1, &out_log_n);
+    if (out == NULL) {
+      Py_DECREF(arr);
+      return NULL;
+    }
+    if (PyArray_TYPE(out) != type_num || out_log_n != log_n) {
+      PyErr_SetString(PyExc_ValueError, "out must have the dtype and length of the input");
+      goto fail;
+    }
+    /* The fused kernel reads `in` while writing `out`: same buffer or none */
+    char *a = (char *)PyArray_DATA(arr), *b = (char *)PyArray_DATA(out);
+    npy_intp bytes = PyArray_NBYTES(arr);
+    if (a != b && a < b + bytes && b < a + bytes) {
+      PyErr_SetString(PyExc_ValueError, "out must not partly overlap the input");
+      goto fail;
+    }
+  }
+
+  if (variant != FHT_PLAIN && type_num != NPY_FLOAT && type_num != NPY_DOUBLE) {
+    /* Exact integer and fp16 transforms; the scaled variants need float32/64 */
+    PyErr_SetString(PyExc_TypeError, "integer and float16 arrays only support fht");
+    goto fail;
+  }
+  if (order != FHT_ORDER_NATURAL && type_num != NPY_FLOAT && type_num != NPY_DOUBLE) {
+    PyErr_SetString(PyExc_TypeError, "integer and float16 arrays only support the natural order");
+    goto fail;
+  }
+
+  void *in_data = PyArray_DATA(arr), *out_data = PyArray_DATA(out);
+  size_t bytes = (size_t)PyArray_NBYTES(arr);
+  int res;
+  Py_BEGIN_ALLOW_THREADS
+  if (order != FHT_ORDER_NATURAL) {
+    res = type_num == NPY_FLOAT ? fht_float_ordered((float *)in_data, (float *)out_data, log_n, order)
+                                : fht_double_ordered((double *)in_data, (double *)out_data, log_n, order);
+  } else if (type_num == NPY_FLOAT && out_data != in_data) {
+    res = fht_float_oop((float *)in_data, (float *)out_data, log_n);
+  } else if (type_num == NPY_DOUBLE && out_data != in_data) {
+    res = fht_double_oop((double *)in_data, (double *)out_data, log_n);
+  } else {
+    if (out_data != in_data) {
+      memcpy(out_data, in_data, bytes);
+    }
+    res = transform(out_data, type_num, log_n, variant, scale);
+  }
+  Py_END_ALLOW_THREADS
+
+  if (res == 1 && type_num == NPY_INT16) {
+    PyErr_SetString(PyExc_OverflowError, "int16 transform saturated");
+    goto fail;
+  }
+  if (res) {
+    PyErr_SetString(PyExc_RuntimeError, "FHT did not work properly");
+    goto fail;
+  }
+
+  Py_DECREF(arr);
+  if (has_out) {
+    return (PyObject *)out;  /* our reference passes to the caller */
+  }
+  return Py_BuildValue("");
+
+fail:
+  if (has_out) {
+    Py_DECREF(out);
+  }
+  Py_DECREF(arr);
+  return NULL;
+}
+
+static PyObject *ffht_fht(PyObject *self, PyObject *args, PyObject *kwds) {
+  UNUSED(self);
+
+  static char *kwlist[] = {"buffer", "out", "order", NULL};
+  PyObject *buffer_obj;
+  PyObject *out_obj = NULL;
+  const char *order_name = "natural";
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|Os", kwlist, &buffer_obj, &out_obj, &order_name)) {
+    return NULL;
+  }
+  int order;
+  if (strcmp(order_name, "natural") == 0) {
+    order = FHT_ORDER_NATURAL;
+  } else if (strcmp(order_name, "sequency") == 0) {
+    order = FHT_ORDER_SEQUENCY;
+  } else if (strcmp(order_name, "paley") == 0) {
+    order = FHT_ORDER_PALEY;
+  } else {
+    PyErr_SetString(PyExc_ValueError, "order must be \"natural\", \"sequency\" or \"paley\"");
+    return NULL;
+  }
+
+  return run_fht(buffer_obj, out_obj, FHT_PLAIN, 1.0, order);
+}
+
+static PyObject *ffht_fht_batch(PyObject *self, PyObject *args, PyObject *kwds) {
   UNUSED(self);
 
+  static char *kwlist[] = {"buffer", "axis", "threads", NULL};
   PyObject *buffer_obj;
+  int axis = -1;
+  int threads = 1;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|ii", kwlist, &buffer_obj, &axis, &threads)) {
+    return NULL;
+  }
+
+  PyArrayObject *arr = check_array(buffer_obj, 1);
+  if (arr == NULL) {
+    return NULL;
+  }
+  int type_num = PyArray_TYPE(arr);
+  if (type_num != NPY_FLOAT && type_num != NPY_DOUBLE) {
+    PyErr_SetString(PyExc_TypeError, "fht_batch supports float32 and float64 arrays");
+    return NULL;
+  }
+  int ndim = PyArray_NDIM(arr);
+  if (axis < 0) {
+    axis += ndim;
+  }
+  if (axis < 0 || axis >= ndim) {
+    PyErr_SetString(PyExc_ValueError, "axis out of range");
+    return NULL;
+  }
+  int log_n = get_log_n(PyArray_DIM(arr, axis));
+  if (log_n < 0) {
+    return NULL;
+  }
+
+  /* A C-contiguous array is (outer, 2^log_n, inner) around `axis`: rows of
+   * a batch when inner is 1, otherwise `inner` interleaved columns per
+   * outer block */
+  size_t outer = 1, inner = 1;
+  for (int d = 0; d < axis; d++) {
+    outer *= (size_t)PyArray_DIM(arr, d);
+  }
+  for (int d = axis + 1; d < ndim; d++) {
+    inner *= (size_t)PyArray_DIM(arr, d);
+  }
+  size_t block = inner << log_n;
+  void *data = PyArray_DATA(arr);
+
+  int res = 0;
+  Py_BEGIN_ALLOW_THREADS
+  if (inner == 1) {
+    res = type_num == NPY_FLOAT ? fht_float_batch_mt((float *)data, log_n, outer, block, threads)
+                                : fht_double_batch_mt((double *)data, log_n, outer, block, threads);
+  } else {
+    for (size_t o = 0; res == 0 && o < outer; o++) {
+      res = type_num == NPY_FLOAT
+          ? fht_float_strided_mt((float *)data + o * block, log_n, inner, inner, 1, threads)
+          : fht_double_strided_mt((double *)data + o * block, log_n, inner, inner, 1, threads);
+    }
+  }
+  Py_END_ALLOW_THREADS
+
+  if (res) {
+    PyErr_SetString(PyExc_RuntimeError, "FHT did not work properly");
+    return NULL;
+  }
+  return Py_BuildValue("");
+}
+
+static PyObject *ffht_fht_hd(PyObject *self, PyObject *args, PyObject *kwds) {
+  UNUSED(self);
+
+  static char *kwlist[] = {"buffer", "sign_bits", "scale", NULL};
+  PyObject *buffer_obj, *signs_obj;
+  double scale = 1.0;
 
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|d", kwlist, &buffer_obj, &signs_obj, &scale)) {
+    return NULL;
+  }
+  PyArrayObject *arr = check_array(buffer_obj, 1);
+  if (arr == NULL) {
+    return NULL;
+  }
+  int type_num = PyArray_TYPE(arr);
+  int ndim = PyArray_NDIM(arr);
+  if (type_num != NPY_FLOAT && type_num != NPY_DOUBLE) {
+    PyErr_SetString(PyExc_TypeError, "fht_hd supports float32 and float64 arrays");
+    return NULL;
+  }
+  if (ndim != 1 && ndim != 2) {
+    PyErr_SetString(PyExc_TypeError, "array must be one- or two-dimensional");
+    return NULL;
+  }
+  int log_n = get_log_n(PyArray_DIM(arr, ndim - 1));
+  if (log_n < 0) {
+    return NULL;
+  }
+  if (!PyArray_Check(signs_obj) || PyArray_TYPE((PyArrayObject *)signs_obj) != NPY_UINT64 ||
+      !PyArray_IS_C_CONTIGUOUS((PyArrayObject *)signs_obj) || !PyArray_ISALIGNED((PyArrayObject *)signs_obj)) {
+    PyErr_SetString(PyExc_TypeError, "sign_bits must be a contiguous uint64 array");
+    return NULL;
+  }
+  size_t words = log_n > 6 ? (size_t)1 << (log_n - 6) : 1;
+  size_t size = (size_t)PyArray_SIZE((PyArrayObject *)signs_obj);
+  if (size == 0 || size % words != 0 || size / words > INT_MAX) {
+    PyErr_SetString(PyExc_ValueError, "sign_bits must hold whole rounds of max(1, n / 64) words");
+    return NULL;
+  }
+
+  int rounds = (int)(size / words);
+  size_t count = ndim == 2 ? (size_t)PyArray_DIM(arr, 0) : 1;
+  void *data = PyArray_DATA(arr);
+  const uint64_t *signs = (const uint64_t *)PyArray_DATA((PyArrayObject *)signs_obj);
+  size_t n = (size_t)1 << log_n;
+  int res;
+  Py_BEGIN_ALLOW_THREADS
+  res = type_num == NPY_FLOAT
+      ? fht_float_hd_batch((float *)data, log_n, count, n, signs, rounds, (float)scale)
+      : fht_double_hd_batch((double *)data, log_n, count, n, signs, rounds, scale);
+  Py_END_ALLOW_THREADS
+
+  if (res) {
+    PyErr_SetString(PyExc_RuntimeError, "FHT did not work properly");
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+/* A checked float32/float64 array of 1 (or up to max_ndim) dimensions whose
+ * rows have power-of-two length; borrowed reference, NULL with an exception */
+static PyArrayObject *get_float_rows(PyObject *buffer_obj, int max_ndim, const char *name, int *log_n,
+                                     size_t *count) {
+  PyArrayObject *arr = check_array(buffer_obj, 1);
+  if (arr == NULL) {
+    return NULL;
+  }
+  int ndim = PyArray_NDIM(arr);
+  if (PyArray_TYPE(arr) != NPY_FLOAT && PyArray_TYPE(arr) != NPY_DOUBLE) {
+    PyErr_Format(PyExc_TypeError, "%s supports float32 and float64 arrays", name);
+    return NULL;
+  }
+  if (ndim < 1 || ndim > max_ndim) {
+    PyErr_SetString(PyExc_TypeError, max_ndim == 1 ? "array must be one-dimensional"
+                                                   : "array must be one- or two-dimensional");
+    return NULL;
+  }
+  *log_n = get_log_n(PyArray_DIM(arr, ndim - 1));
+  if (*log_n < 0) {
+    return NULL;
+  }
+  *count = ndim == 2 ? (size_t)PyArray_DIM(arr, 0) : 1;
+  return arr;
+}
+
+/* fht_argmax (k == 0) and fht_topk */
+static PyObject *run_topk(PyObject *buffer_obj, size_t k, const char *name) {
+  int log_n;
+  size_t count;
+  PyArrayObject *arr = get_float_rows(buffer_obj, 2, name, &log_n, &count);
+  if (arr == NULL) {
+    return NULL;
+  }
+  size_t n = (size_t)1 << log_n;
+  if (k > n) {
+    PyErr_SetString(PyExc_ValueError, "k must be between 1 and the row length");
+    return NULL;
+  }
+
+  int ndim = PyArray_NDIM(arr);
+  npy_intp dims[2] = {(npy_intp)count, (npy_intp)(k ? k : 1)};
+  PyObject *out;
+  if (k == 0) {
+    out = ndim == 2 ? PyArray_SimpleNew(1, dims, NPY_INTP) : NULL;
+  } else {
+    out = ndim == 2 ? PyArray_SimpleNew(2, dims, NPY_INTP) : PyArray_SimpleNew(1, dims + 1, NPY_INTP);
+  }
+  if (out == NULL && (k > 0 || ndim == 2)) {
+    return NULL;
+  }
+
+  size_t single = 0;
+  size_t *indices = out != NULL ? (size_t *)PyArray_DATA((PyArrayObject *)out) : &single;
+  void *data = PyArray_DATA(arr);
+  int is_float = PyArray_TYPE(arr) == NPY_FLOAT;
+  int res;
+  Py_BEGIN_ALLOW_THREADS
+  res = is_float ? fht_float_topk_batch((float *)data, log_n, count, n, k ? k : 1, indices)
+                 : fht_double_topk_batch((double *)data, log_n, count, n, k ? k : 1, indices);
+  Py_END_ALLOW_THREADS
+
+  if (res) {
+    Py_XDECREF(out);
+    PyErr_SetString(PyExc_RuntimeError, "FHT did not work properly");
+    return NULL;
+  }
+  return out != NULL ? out : PyLong_FromSsize_t(single == SIZE_MAX ? -1 : (Py_ssize_t)single);
+}
+
+static PyObject *ffht_fht_argmax(PyObject *self, PyObject *args) {
+  UNUSED(self);
+
+  PyObject *buffer_obj;
   if (!PyArg_ParseTuple(args, "O", &buffer_obj)) {
     return NULL;
   }
+  return run_topk(buffer_obj, 0, "fht_argmax");
+}
+
+static PyObject *ffht_fht_topk(PyObject *self, PyObject *args) {
+  UNUSED(self);
 
-  PyArray_Descr *dtype;
-  int ndim;
-  npy_intp dims[NPY_MAXDIMS];
-  PyArrayObject *arr = NULL;
+  PyObject *buffer_obj;
+  Py_ssize_t k;
+  if (!PyArg_ParseTuple(args, "On", &buffer_obj, &k)) {
+    return NULL;
+  }
+  if (k < 1) {
+    PyErr_SetString(PyExc_ValueError, "k must be between 1 and the row length");
+    return NULL;
+  }
+  return run_topk(buffer_obj, (size_t)k, "fht_topk");
+}
 
-  arr = (PyArrayObject*)PyArray_FromAny(buffer_obj, NULL, 1, 1,
-                                        NPY_ARRAY_IN_ARRAY, NULL);
+static PyObject *ffht_fht_threshold(PyObject *self, PyObject *args) {
+  UNUSED(self);
 
+  PyObject *buffer_obj;
+  double threshold;
+  if (!PyArg_ParseTuple(args, "Od", &buffer_obj, &threshold)) {
+    return NULL;
+  }
+  int log_n;
+  size_t count;
+  PyArrayObject *arr = get_float_rows(buffer_obj, 1, "fht_threshold", &log_n, &count);
   if (arr == NULL) {
-    PyErr_SetString(PyExc_TypeError, "not a numpy array");
     return NULL;
   }
 
-  dtype = PyArray_DESCR(arr);
+  /* Room for every index; the result is copied out at its size */
+  size_t n = (size_t)1 << log_n;
+  size_t *indices = (size_t *)malloc(n * sizeof(size_t));
+  if (indices == NULL) {
+    return PyErr_NoMemory();
+  }
+  void *data = PyArray_DATA(arr);
+  int is_float = PyArray_TYPE(arr) == NPY_FLOAT;
+  int res;
+  Py_BEGIN_ALLOW_THREADS
+  res = is_float ? fht_float_threshold((float *)data, log_n, (float)threshold, indices, n, &count)
+                 : fht_double_threshold((double *)data, log_n, threshold, indices, n, &count);
+  Py_END_ALLOW_THREADS
 
-  if (dtype->type_num != NPY_FLOAT && dtype->type_num != NPY_DOUBLE) {
-    PyErr_SetString(PyExc_TypeError, "array must consist of floats or doubles");
-    Py_DECREF(arr);
+  if (res) {
+    free(indices);
+    PyErr_SetString(PyExc_RuntimeError, "FHT did not work properly");
     return NULL;
   }
+  npy_intp dims[1] = {(npy_intp)count};
+  PyObject *out = PyArray_SimpleNew(1, dims, NPY_INTP);
+  if (out != NULL) {
+    memcpy(PyArray_DATA((PyArrayObject *)out), indices, count * sizeof(size_t));
+  }
+  free(indices);
+  return out;
+}
 
-  if (PyArray_NDIM(arr) != 1) {
-    PyErr_SetString(PyExc_TypeError, "array must be one-dimensional");
-    Py_DECREF(arr);
+static void free_aligned(PyObject *capsule) {
+  free(PyCapsule_GetPointer(capsule, "ffht.aligned"));
+}
+
+static PyObject *ffht_created_aligned(PyObject *self, PyObject *args, PyObject *kwds) {
+  UNUSED(self);
+
+  static char *kwlist[] = {"n", "dtype", "alignment", NULL};
+  Py_ssize_t n;
+  PyArray_Descr *descr = NULL;
+  Py_ssize_t alignment = 64;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|O&n", kwlist, &n,
+                                   PyArray_DescrConverter2, &descr, &alignment)) {
     return NULL;
   }
+  int type_num = descr == NULL ? NPY_FLOAT : descr->type_num;
+  Py_XDECREF(descr);
 
-  int n = PyArray_DIM(arr, 0);
+  size_t itemsize;
+  switch (type_num) {
+    case NPY_HALF: case NPY_INT16: itemsize = 2; break;
+    case NPY_FLOAT: case NPY_INT32: itemsize = 4; break;
+    case NPY_DOUBLE: case NPY_INT64: itemsize = 8; break;
+    default:
+      PyErr_SetString(PyExc_TypeError,
+                      "dtype must be float16/32/64 or int16/int32/int64");
+      return NULL;
+  }
+  if (n < 0 || alignment <= 0 || (alignment & (alignment - 1))) {
+    PyErr_SetString(PyExc_ValueError,
+                    "n must be non-negative and alignment a power of two");
+    return NULL;
+  }
 
-  if (n == 0 || (n & (n - 1))) {
-    PyErr_SetString(PyExc_ValueError, "array's length must be a power of two");
+  /* Over-allocate and round up; the capsule keeps the malloc'd pointer */
+  char *raw = (char *)malloc((size_t)n * itemsize + (size_t)alignment);
+  if (raw == NULL) {
+    return PyErr_NoMemory();
+  }
+  char *data = raw + ((size_t)alignment - ((uintptr_t)raw & (size_t)(alignment - 1))) % (size_t)alignment;
+  memset(data, 0, (size_t)n * itemsize);
+
+  npy_intp dims[1] = {(npy_intp)n};
+  PyObject *arr = PyArray_SimpleNewFromData(1, dims, type_num, data);
+  if (arr == NULL) {
+    free(raw);
+    return NULL;
+  }
+  PyObject *capsule = PyCapsule_New(raw, "ffht.aligned", free_aligned);
+  if (capsule == NULL) {
+    free(raw);
+    Py_DECREF(arr);
+    return NULL;
+  }
+  /* Steals the capsule reference, also on failure */
+  if (PyArray_SetBaseObject((PyArrayObject *)arr, capsule) < 0) {
     Py_DECREF(arr);
     return NULL;
   }
+  return arr;
+}
+
+static PyObject *ffht_fht_scaled(PyObject *self, PyObject *args) {
+  UNUSED(self);
+
+  PyObject *buffer_obj;
+  double scale;
+
+  if (!PyArg_ParseTuple(args, "Od", &buffer_obj, &scale)) {
+    return NULL;
+  }
+
+  return run_fht(buffer_obj, NULL, FHT_SCALED, scale, FHT_ORDER_NATURAL);
+}
+
+static PyObject *ffht_fht_orthonormal(PyObject *self, PyObject *args) {
+  UNUSED(self);
+
+  PyObject *buffer_obj;
+
+  if (!PyArg_ParseTuple(args, "O", &buffer_obj)) {
+    return NULL;
+  }
+
+  return run_fht(buffer_obj, NULL, FHT_ORTHONORMAL, 1.0, FHT_ORDER_NATURAL);
+}
+
+static PyObject *ffht_fht_inverse(PyObject *self, PyObject *args) {
+  UNUSED(self);
+
+  PyObject *buffer_obj;
+
+  if (!PyArg_ParseTuple(args, "O", &buffer_obj)) {
+    return NULL;
+  }
+
+  return run_fht(buffer_obj, NULL, FHT_INVERSE, 1.0, FHT_ORDER_NATURAL);
+}
+
+static PyObject *ffht_kernel_name(PyObject *self, PyObject *args) {
+  UNUSED(self);
+  UNUSED(args);
+
+  return PyUnicode_FromString(fht_kernel_name());
+}
+
+static PyObject *ffht_tune(PyObject *self, PyObject *args, PyObject *kwds) {
+  UNUSED(self);
+
+  static char *kwlist[] = {"max_log_n", "max_threads", NULL};
+  int max_log_n = 20;
+  int max_threads = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|ii", kwlist, &max_log_n, &max_threads)) {
+    return NULL;
+  }
+  if (max_log_n < 1 || max_log_n > 30) {
+    PyErr_SetString(PyExc_ValueError, "max_log_n must be between 1 and 30");
+    return NULL;
+  }
 
+  int res;
+  Py_BEGIN_ALLOW_THREADS
+  res = fht_tune(max_log_n, max_threads);
+  Py_END_ALLOW_THREADS
+  if (res) {
+    PyErr_NoMemory();
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject *ffht_fht_file(PyObject *self, PyObject *args, PyObject *kwds) {
+  UNUSED(self);
+
+  static char *kwlist[] = {"file", "n", "offset", "dtype", "mem_bytes", "threads", NULL};
+  PyObject *file_obj;
+  unsigned long long n;
+  unsigned long long offset = 0;
+  PyArray_Descr *descr = NULL;
+  Py_ssize_t mem_bytes = (Py_ssize_t)1 << 28;
+  int nthreads = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OK|KO&ni", kwlist, &file_obj, &n, &offset,
+                                   PyArray_DescrConverter2, &descr, &mem_bytes, &nthreads)) {
+    return NULL;
+  }
+  int type_num = descr == NULL ? NPY_FLOAT : descr->type_num;
+  Py_XDECREF(descr);
+  if (type_num != NPY_FLOAT && type_num != NPY_DOUBLE) {
+    PyErr_SetString(PyExc_TypeError, "dtype must be float32 or float64");
+    return NULL;
+  }
   int log_n = 0;
-  while ((1 << log_n) < n) {
-    ++log_n;
+  while (log_n < 63 && ((unsigned long long)1 << log_n) < n) {
+    log_n++;
+  }
+  if (n == 0 || ((unsigned long long)1 << log_n) != n || log_n > FHT_LARGE_MAX_LOG_N) {
+    PyErr_SetString(PyExc_ValueError, "n must be a power of two up to 2^48");
+    return NULL;
+  }
+  if (mem_bytes <= 0) {
+    PyErr_SetString(PyExc_ValueError, "mem_bytes must be positive");
+    return NULL;
+  }
+  int fd = PyObject_AsFileDescriptor(file_obj);
+  if (fd < 0) {
+    return NULL;
   }
 
-  void *raw_buffer = PyArray_DATA(arr);
   int res;
-  if (dtype->type_num == NPY_FLOAT) {
-    float *buffer = (float *)raw_buffer;
-    res = fht_float(buffer, log_n);
-  } else {
-    double *buffer = (double *)raw_buffer;
-    res = fht_double(buffer, log_n);
+  Py_BEGIN_ALLOW_THREADS
+  res = type_num == NPY_FLOAT ? fht_float_file(fd, offset, log_n, (size_t)mem_bytes, nthreads)
+                              : fht_double_file(fd, offset, log_n, (size_t)mem_bytes, nthreads);
+  Py_END_ALLOW_THREADS
+  if (res) {
+    return PyErr_SetFromErrno(PyExc_OSError);
   }
+  Py_RETURN_NONE;
+}
+
+static PyObject *ffht_wisdom_save(PyObject *self, PyObject *args) {
+  UNUSED(self);
 
+  PyObject *path_obj;
+
+  if (!PyArg_ParseTuple(args, "O&", PyUnicode_FSConverter, &path_obj)) {
+    return NULL;
+  }
+  int res = fht_wisdom_save(PyBytes_AS_STRING(path_obj));
+  if (res) {
+    PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path_obj);
+  }
+  Py_DECREF(path_obj);
   if (res) {
-    PyErr_SetString(PyExc_RuntimeError, "FHT did not work properly");
-    Py_DECREF(arr);
     return NULL;
   }
+  Py_RETURN_NONE;
+}
 
-  Py_DECREF(arr);
+static PyObject *ffht_wisdom_load(PyObject *self, PyObject *args) {
+  UNUSED(self);
 
-  return Py_BuildValue("");
+  PyObject *path_obj;
+
+  if (!PyArg_ParseTuple(args, "O&", PyUnicode_FSConverter, &path_obj)) {
+    return NULL;
+  }
+  errno = 0;
+  int res = fht_wisdom_load(PyBytes_AS_STRING(path_obj));
+  if (res && errno != 0) {
+    PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path_obj);
+  } else if (res) {
+    PyErr_Format(PyExc_ValueError, "%s is not an ffht wisdom file", PyBytes_AS_STRING(path_obj));
+  }
+  Py_DECREF(path_obj);
+  if (res) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject *ffht_wisdom_forget(PyObject *self, PyObject *args) {
+  UNUSED(self);
+  UNUSED(args);
+
+  fht_wisdom_forget();
+  Py_RETURN_NONE;
+}
+
+static PyObject *ffht_stats(PyObject *self, PyObject *args, PyObject *kwds) {
+  UNUSED(self);
+
+  static char *kwlist[] = {"all_threads", NULL};
+  int all_threads = 1;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|p", kwlist, &all_threads)) {
+    return NULL;
+  }
+  /* About 600 KiB, too much for the stack of most threads */
+  fht_stats *st = (fht_stats *)malloc(sizeof(fht_stats));
+  if (st == NULL) {
+    return PyErr_NoMemory();
+  }
+  if (fht_stats_snapshot(st, all_threads)) {
+    free(st);
+    PyErr_SetString(PyExc_RuntimeError, "ffht was built without stats (FFHT_NO_STATS)");
+    return NULL;
+  }
+
+  static const char *const dtypes[FHT_STATS_NUM_DTYPES] = {
+      "float32", "float64", "float16", "bfloat16", "int16", "int32", "int64"};
+  PyObject *list = PyList_New(0);
+  for (int d = 0; list != NULL && d < FHT_STATS_NUM_DTYPES; d++) {
+    for (int entry = 0; list != NULL && entry < FHT_STATS_NUM_ENTRIES; entry++) {
+      for (int log_n = 0; list != NULL && log_n <= 30; log_n++) {
+        const fht_stats_counter *c = &st->counters[d][entry][log_n];
+        if (c->calls == 0) {
+          continue;
+        }
+        PyObject *hist = PyList_New(FHT_STATS_HIST_BINS);
+        for (int b = 0; hist != NULL && b < FHT_STATS_HIST_BINS; b++) {
+          PyList_SET_ITEM(hist, b, PyLong_FromUnsignedLongLong(c->hist[b]));
+        }
+        PyObject *item = hist == NULL ? NULL
+            : Py_BuildValue("{s:s,s:s,s:i,s:K,s:K,s:K,s:N,s:s}",
+                            "dtype", dtypes[d],
+                            "entry", fht_stats_entry_name(entry), "log_n", log_n,
+                            "calls", (unsigned long long)c->calls,
+                            "bytes", (unsigned long long)c->bytes,
+                            "ns", (unsigned long long)c->ns, "histogram", hist,
+                            "kernel", st->kernel[d][log_n]);
+        if (item == NULL || PyList_Append(list, item) < 0) {
+          Py_XDECREF(item);
+          Py_CLEAR(list);
+          break;
+        }
+        Py_DECREF(item);
+      }
+    }
+  }
+  free(st);
+  return list;
+}
+
+static PyObject *ffht_stats_enable(PyObject *self, PyObject *args, PyObject *kwds) {
+  UNUSED(self);
+
+  static char *kwlist[] = {"on", NULL};
+  int on = 1;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|p", kwlist, &on)) {
+    return NULL;
+  }
+  int was = fht_stats_enable(on);
+  if (was < 0) {
+    PyErr_SetString(PyExc_RuntimeError, "ffht was built without stats (FFHT_NO_STATS)");
+    return NULL;
+  }
+  return PyBool_FromLong(was);
+}
+
+static PyObject *ffht_stats_reset(PyObject *self, PyObject *args, PyObject *kwds) {
+  UNUSED(self);
+
+  static char *kwlist[] = {"all_threads", NULL};
+  int all_threads = 1;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|p", kwlist, &all_threads)) {
+    return NULL;
+  }
+  fht_stats_reset(all_threads);
+  Py_RETURN_NONE;
 }
 
 static PyMethodDef module_methods[] = {
-    {"fht", ffht_fht, METH_VARARGS, fht_docstring},
+    {"fht", (PyCFunction)(void (*)(void))ffht_fht, METH_VARARGS | METH_KEYWORDS, fht_docstring},
+    {"fht_scaled", ffht_fht_scaled, METH_VARARGS, fht_scaled_docstring},
+    {"fht_orthonormal", ffht_fht_orthonormal, METH_VARARGS, fht_orthonormal_docstring},
+    {"fht_inverse", ffht_fht_inverse, METH_VARARGS, fht_inverse_docstring},
+    {"fht_batch", (PyCFunction)(void (*)(void))ffht_fht_batch, METH_VARARGS | METH_KEYWORDS, fht_batch_docstring},
+    {"fht_hd", (PyCFunction)(void (*)(void))ffht_fht_hd, METH_VARARGS | METH_KEYWORDS, fht_hd_docstring},
+    {"fht_argmax", ffht_fht_argmax, METH_VARARGS, fht_argmax_docstring},
+    {"fht_topk", ffht_fht_topk, METH_VARARGS, fht_topk_docstring},
+    {"fht_threshold", ffht_fht_threshold, METH_VARARGS, fht_threshold_docstring},
+    {"created_aligned", (PyCFunction)(void (*)(void))ffht_created_aligned, METH_VARARGS | METH_KEYWORDS,
+     created_aligned_docstring},
+    {"kernel_name", ffht_kernel_name, METH_NOARGS, kernel_name_docstring},
+    {"tune", (PyCFunction)(void (*)(void))ffht_tune, METH_VARARGS | METH_KEYWORDS, tune_docstring},
+    {"fht_file", (PyCFunction)(void (*)(void))ffht_fht_file, METH_VARARGS | METH_KEYWORDS, fht_file_docstring},
+    {"wisdom_save", ffht_wisdom_save, METH_VARARGS, wisdom_save_docstring},
+    {"wisdom_load", ffht_wisdom_load, METH_VARARGS, wisdom_load_docstring},
+    {"wisdom_forget", ffht_wisdom_forget, METH_NOARGS, wisdom_forget_docstring},
+    {"stats", (PyCFunction)(void (*)(void))ffht_stats, METH_VARARGS | METH_KEYWORDS, stats_docstring},
+    {"stats_enable", (PyCFunction)(void (*)(void))ffht_stats_enable, METH_VARARGS | METH_KEYWORDS,
+     stats_enable_docstring},
+    {"stats_reset", (PyCFunction)(void (*)(void))ffht_stats_reset, METH_VARARGS | METH_KEYWORDS,
+     stats_reset_docstring},
     {NULL, NULL, 0, NULL}
 };
 
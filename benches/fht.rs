@@ -0,0 +1,82 @@
+//! Criterion benchmarks for the Rust API
+//!
+//! `cargo bench` sweeps 2^4..2^20 for f32 and f64 through the slice API
+//! (in place, out of place, batched, multithreaded) and `FhtPlan`.
+//! Throughput is reported in elements per second; criterion keeps the raw
+//! estimates as JSON under `target/criterion/` for tracking across machines.
+
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use ffht::{Fht, FhtPlan};
+
+const LOG_SIZES: [usize; 9] = [4, 6, 8, 10, 12, 14, 16, 18, 20];
+/// Batched benches transform 2^BATCH_LOG_ELEMS elements per iteration
+const BATCH_LOG_ELEMS: usize = 20;
+
+fn data<T: From<f32>>(n: usize) -> Vec<T> {
+    (0..n).map(|i| T::from((i as f32 * 0.37).sin())).collect()
+}
+
+fn bench_slice<T: Fht + Copy + From<f32>>(c: &mut Criterion, dtype: &str) {
+    let mut group = c.benchmark_group(format!("{}/{}", ffht::kernel_name(), dtype));
+    for &log_n in &LOG_SIZES {
+        let n = 1usize << log_n;
+        group.throughput(Throughput::Elements(n as u64));
+
+        let mut buf = data::<T>(n);
+        group.bench_with_input(BenchmarkId::new("inplace", log_n), &log_n, |b, _| {
+            b.iter(|| T::fht_inplace(black_box(&mut buf)).unwrap())
+        });
+
+        let input = data::<T>(n);
+        let mut output = data::<T>(n);
+        group.bench_with_input(BenchmarkId::new("oop", log_n), &log_n, |b, _| {
+            b.iter(|| T::fht(black_box(&input), black_box(&mut output)).unwrap())
+        });
+
+        if log_n >= 16 {
+            group.bench_with_input(BenchmarkId::new("mt", log_n), &log_n, |b, _| {
+                b.iter(|| T::fht_inplace_mt(black_box(&mut buf), 0).unwrap())
+            });
+        }
+
+        if log_n <= 16 {
+            let total = 1usize << BATCH_LOG_ELEMS;
+            let mut batch = data::<T>(total);
+            group.throughput(Throughput::Elements(total as u64));
+            group.bench_with_input(BenchmarkId::new("batch", log_n), &log_n, |b, _| {
+                b.iter(|| T::fht_batch_inplace(black_box(&mut batch), n).unwrap())
+            });
+        }
+    }
+    group.finish();
+}
+
+fn bench_plan(c: &mut Criterion) {
+    let mut group = c.benchmark_group(format!("{}/plan", ffht::kernel_name()));
+    for &log_n in &LOG_SIZES {
+        let n = 1usize << log_n;
+        group.throughput(Throughput::Elements(n as u64));
+
+        let plan = FhtPlan::<f32>::new(n).unwrap();
+        let mut buf = data::<f32>(n);
+        group.bench_with_input(BenchmarkId::new("f32", log_n), &log_n, |b, _| {
+            b.iter(|| plan.execute(black_box(&mut buf)).unwrap())
+        });
+
+        let plan = FhtPlan::<f64>::new(n).unwrap();
+        let mut buf = data::<f64>(n);
+        group.bench_with_input(BenchmarkId::new("f64", log_n), &log_n, |b, _| {
+            b.iter(|| plan.execute(black_box(&mut buf)).unwrap())
+        });
+    }
+    group.finish();
+}
+
+fn benches(c: &mut Criterion) {
+    bench_slice::<f32>(c, "f32");
+    bench_slice::<f64>(c, "f64");
+    bench_plan(c);
+}
+
+criterion_group!(fht_benches, benches);
+criterion_main!(fht_benches);
@@ -0,0 +1,211 @@
+/* Benchmark sweep: every kernel, log_n 1..30, float/double, in-place,
+ * out-of-place and batched.
+ *
+ *   ./benchmark [max_log_n] [--json]
+ *
+ * Each case reports ns per element and GFLOP/s (n log_n additions and
+ * subtractions per transform), next to a memory-bandwidth roofline: the
+ * GFLOP/s the case would reach if it streamed its data from DRAM exactly
+ * once (read and write) at the copy bandwidth measured at startup. Small
+ * sizes run from cache and beat the roofline; large ones should approach it.
+ *
+ * --json prints one JSON object per line instead of the table, for
+ * collecting results across machines. */
+#define _GNU_SOURCE  // sysconf(_SC_PHYS_PAGES), clock_gettime
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "fht.h"
+
+#define MAX_LOG_N 30
+/* Each measurement repeats the call for at least this long */
+#define MIN_TIME_NS 20e6
+/* Batched cases transform 2^BATCH_LOG_ELEMS elements in total, up to this size */
+#define BATCH_LOG_ELEMS 20
+#define BATCH_MAX_LOG_N 16
+/* Buffer for the bandwidth measurement */
+#define BANDWIDTH_BYTES ((size_t)256 << 20)
+
+static const char *const kernel_names[] = {"avx512", "avx", "sse", "sve", "neon"};
+
+#if defined(__x86_64__)
+#  define BENCH_ARCH "x86_64"
+#elif defined(__aarch64__)
+#  define BENCH_ARCH "aarch64"
+#else
+#  define BENCH_ARCH "other"
+#endif
+
+enum mode { MODE_INPLACE, MODE_OOP, MODE_BATCH };
+static const char *const mode_names[] = {"inplace", "oop", "batch"};
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static size_t phys_mem_bytes(void) {
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || page_size <= 0) {
+        return (size_t)1 << 32;
+    }
+    return (size_t)pages * (size_t)page_size;
+}
+
+/* Copy bandwidth in bytes/s, counting the read and the write */
+static double measure_bandwidth(size_t bytes) {
+    char *a = (char *)malloc(bytes);
+    char *b = (char *)malloc(bytes);
+    if (a == NULL || b == NULL) {
+        free(a);
+        free(b);
+        return 0.0;
+    }
+    memset(a, 1, bytes);
+    memset(b, 0, bytes);
+    double best = 0.0;
+    for (int rep = 0; rep < 5; rep++) {
+        double start = now_ns();
+        memcpy(b, a, bytes);
+        double elapsed = now_ns() - start;
+        double bw = 2.0 * (double)bytes / (elapsed * 1e-9);
+        if (bw > best) best = bw;
+    }
+    free(a);
+    free(b);
+    return best;
+}
+
+static int run_case(int is_double, enum mode mode, int log_n, size_t count, void *buf, void *out) {
+    size_t n = (size_t)1 << log_n;
+    if (is_double) {
+        switch (mode) {
+            case MODE_INPLACE: return fht_double((double *)buf, log_n);
+            case MODE_OOP: return fht_double_oop((double *)buf, (double *)out, log_n);
+            default: return fht_double_batch((double *)buf, log_n, count, n);
+        }
+    }
+    switch (mode) {
+        case MODE_INPLACE: return fht_float((float *)buf, log_n);
+        case MODE_OOP: return fht_float_oop((float *)buf, (float *)out, log_n);
+        default: return fht_float_batch((float *)buf, log_n, count, n);
+    }
+}
+
+/* Best time of three measurements, in ns per call; negative on failure */
+static double time_case(int is_double, enum mode mode, int log_n, size_t count, void *buf, void *out) {
+    if (run_case(is_double, mode, log_n, count, buf, out)) {  // warm-up
+        return -1.0;
+    }
+    double best = -1.0;
+    for (int rep = 0; rep < 3; rep++) {
+        long iters = 0;
+        double start = now_ns(), elapsed;
+        /* Repeated in-place transforms overflow to inf/NaN, which costs
+         * nothing extra in SIMD adds (unlike denormals, which growth never
+         * produces) */
+        do {
+            run_case(is_double, mode, log_n, count, buf, out);
+            iters++;
+            elapsed = now_ns() - start;
+        } while (elapsed < MIN_TIME_NS);
+        double per_call = elapsed / (double)iters;
+        if (best < 0.0 || per_call < best) best = per_call;
+    }
+    return best;
+}
+
+static void report(int json, const char *kernel, int is_double, enum mode mode, int log_n, size_t count,
+                   double ns_per_call, double bandwidth) {
+    size_t elem = is_double ? sizeof(double) : sizeof(float);
+    double elems = (double)count * (double)((size_t)1 << log_n);
+    double ns_per_elem = ns_per_call / elems;
+    double gflops = elems * log_n / ns_per_call;
+    /* One read and one write of every element */
+    double roofline = bandwidth * 1e-9 * (double)log_n / (2.0 * (double)elem);
+    const char *dtype = is_double ? "double" : "float";
+
+    if (json) {
+        printf("{\"arch\": \"" BENCH_ARCH "\", \"kernel\": \"%s\", \"dtype\": \"%s\", "
+               "\"mode\": \"%s\", \"log_n\": %d, \"count\": %zu, \"ns_per_elem\": %.4f, \"gflops\": %.3f, "
+               "\"roofline_gflops\": %.3f, \"bandwidth_gbs\": %.2f}\n",
+               kernel, dtype, mode_names[mode], log_n, count, ns_per_elem, gflops, roofline,
+               bandwidth * 1e-9);
+    } else {
+        printf("%-6s %-6s %-7s %2d %8zu %10.4f %9.3f %9.3f\n", kernel, dtype, mode_names[mode], log_n,
+               count, ns_per_elem, gflops, roofline);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+    int max_log_n = MAX_LOG_N;
+    int json = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = 1;
+        } else {
+            max_log_n = atoi(argv[i]);
+            if (max_log_n < 1 || max_log_n > MAX_LOG_N) {
+                fprintf(stderr, "usage: %s [max_log_n (1..%d)] [--json]\n", argv[0], MAX_LOG_N);
+                return 1;
+            }
+        }
+    }
+
+    /* Keep buffers to half of physical memory; larger sizes are skipped */
+    size_t mem_budget = phys_mem_bytes() / 2;
+    double bandwidth = measure_bandwidth(BANDWIDTH_BYTES < mem_budget / 2 ? BANDWIDTH_BYTES : mem_budget / 2);
+    if (!json) {
+        printf("copy bandwidth: %.2f GB/s (read + write)\n", bandwidth * 1e-9);
+        printf("%-6s %-6s %-7s %2s %8s %10s %9s %9s\n", "kern", "dtype", "mode", "lg", "count",
+               "ns/elem", "GFLOP/s", "roofline");
+    }
+
+    for (size_t k = 0; k < sizeof(kernel_names) / sizeof(kernel_names[0]); k++) {
+        if (fht_select_kernel(kernel_names[k]) != 0) {
+            continue;  // not built for this architecture, or not supported
+        }
+        for (int is_double = 0; is_double <= 1; is_double++) {
+            size_t elem = is_double ? sizeof(double) : sizeof(float);
+            for (int m = MODE_INPLACE; m <= MODE_BATCH; m++) {
+                for (int log_n = 1; log_n <= max_log_n; log_n++) {
+                    if (m == MODE_BATCH && log_n > BATCH_MAX_LOG_N) {
+                        break;
+                    }
+                    size_t count = (m == MODE_BATCH) ? (size_t)1 << (BATCH_LOG_ELEMS - log_n) : 1;
+                    size_t bytes = (count * elem) << log_n;
+                    if ((m == MODE_OOP ? 2 * bytes : bytes) > mem_budget) {
+                        break;
+                    }
+                    void *buf = malloc(bytes);
+                    void *out = (m == MODE_OOP) ? malloc(bytes) : NULL;
+                    if (buf == NULL || (m == MODE_OOP && out == NULL)) {
+                        free(buf);
+                        free(out);
+                        break;
+                    }
+                    for (size_t i = 0; i < (count << log_n); i++) {
+                        if (is_double) {
+                            ((double *)buf)[i] = (double)rand() / RAND_MAX - 0.5;
+                        } else {
+                            ((float *)buf)[i] = (float)rand() / RAND_MAX - 0.5f;
+                        }
+                    }
+                    double ns = time_case(is_double, (enum mode)m, log_n, count, buf, out);
+                    if (ns > 0.0) {
+                        report(json, kernel_names[k], is_double, (enum mode)m, log_n, count, ns, bandwidth);
+                    }
+                    free(buf);
+                    free(out);
+                }
+            }
+        }
+    }
+    fht_select_kernel(NULL);
+    return 0;
+}
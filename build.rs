@@ -1,5 +1,6 @@
 // Build script for FFHT Rust wrapper
-// Compiles the C library with appropriate architecture-specific optimizations
+// Compiles the C library with every SIMD backend for the target architecture;
+// the kernel is chosen at runtime from cpuid (see fht.c)
 
 use std::env;
 
@@ -7,9 +8,26 @@ fn main() {
     let mut build = cc::Build::new();
 
     // Common settings
-    // Compile fht.c which includes fast_copy.c (single translation unit to avoid linking issues)
+    // fht.c holds fast_copy and the runtime dispatcher; each backend is its own
+    // translation unit (backends for other architectures compile to nothing)
     build
         .file("fht.c")
+        .file("fht_mt.c")
+        .file("fht_xor.c")
+        .file("fht_int.c")
+        .file("fht_half.c")
+        .file("fht_strided.c")
+        .file("fht_sparse.c")
+        .file("fht_reduce.c")
+        .file("fht_order.c")
+        .file("fht_file.c")
+        .file("fht_wisdom.c")
+        .file("fht_stats.c")
+        .file("fht_kernel_avx512.c")
+        .file("fht_kernel_avx.c")
+        .file("fht_kernel_sse.c")
+        .file("fht_neon.c")
+        .file("fht_sve.c")
         .include(".")         // Include current directory FIRST
         .include("FFHT")      // Include FFHT headers for fht_sse.c, fht_avx.c, etc.
         .opt_level(3)
@@ -23,18 +41,13 @@ fn main() {
 
     match target_arch.as_str() {
         "x86_64" => {
-            // Use native architecture optimizations
-            // fht.c will automatically include the right SIMD version
-            if target_os != "windows" {
-                build.flag("-march=native");
-            }
-
+            // No -march=native: the crate must run on any x86_64 host.
+            // fht_kernel_avx.c and fht_kernel_avx512.c enable AVX/AVX-512F
+            // for themselves and are only called when cpuid reports them
             println!("cargo:rustc-cfg=has_simd");
-            println!("cargo:rustc-cfg=has_avx");
         }
         "aarch64" => {
-            // ARM64 with NEON
-            // fht.c will automatically include fht_neon.c
+            // ARM64 with NEON (baseline on aarch64)
             if target_os == "linux" || target_os == "android" {
                 build.flag("-march=armv8-a+simd");
             } else if target_os == "macos" {
@@ -46,19 +59,35 @@ fn main() {
             println!("cargo:rustc-cfg=has_neon");
         }
         _ => {
-            // Fallback: portable C implementation
-            // fht.c will include fht_sse.c
-            println!("cargo:warning=Building FFHT without SIMD optimizations for {}", target_arch);
+            // fht.c has no backend for other architectures
+            println!("cargo:warning=FFHT has no SIMD backend for {}", target_arch);
         }
     }
 
     build.compile("ffht");
 
     // Tell cargo to rerun if any of the C files change
-    println!("cargo:rerun-if-changed=FFHT/fht.c");
-    println!("cargo:rerun-if-changed=FFHT/fht.h");
+    println!("cargo:rerun-if-changed=fht.c");
+    println!("cargo:rerun-if-changed=fht.h");
+    println!("cargo:rerun-if-changed=fht_mt.c");
+    println!("cargo:rerun-if-changed=fht_xor.c");
+    println!("cargo:rerun-if-changed=fht_int.c");
+    println!("cargo:rerun-if-changed=fht_half.c");
+    println!("cargo:rerun-if-changed=fht_strided.c");
+    println!("cargo:rerun-if-changed=fht_sparse.c");
+    println!("cargo:rerun-if-changed=fht_reduce.c");
+    println!("cargo:rerun-if-changed=fht_order.c");
+    println!("cargo:rerun-if-changed=fht_file.c");
+    println!("cargo:rerun-if-changed=fht_wisdom.c");
+    println!("cargo:rerun-if-changed=fht_stats.c");
+    println!("cargo:rerun-if-changed=fht_kernel.h");
+    println!("cargo:rerun-if-changed=fht_kernel_avx512.c");
+    println!("cargo:rerun-if-changed=fht_kernel_avx.c");
+    println!("cargo:rerun-if-changed=fht_kernel_sse.c");
     // SIMD implementations (from FFHT submodule and our additions)
     println!("cargo:rerun-if-changed=FFHT/fht_sse.c");
     println!("cargo:rerun-if-changed=FFHT/fht_avx.c");
     println!("cargo:rerun-if-changed=fht_neon.c");  // Our new ARM NEON implementation
+    println!("cargo:rerun-if-changed=fht_neon_gen.c");  // Generated by gen_neon.py
+    println!("cargo:rerun-if-changed=fht_sve.c");
 }
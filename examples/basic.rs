@@ -1,7 +1,7 @@
 /// Basic usage example for FFHT Rust wrapper
 
 use ffht::{Fht, FhtArray};
-use ndarray::Array1;
+use ndarray::{Array1, Array2};
 
 fn main() {
     println!("=== FFHT Basic Usage Examples ===\n");
@@ -20,6 +20,9 @@ fn main() {
 
     // Example 5: Large transform
     example5_large();
+
+    // Example 6: Batched transform of many small vectors
+    example6_batch();
 }
 
 fn example1_inplace() {
@@ -132,3 +135,19 @@ fn example5_large() {
     println!("Max value: {:.2e}", max_val);
     println!("Sum: {:.2e}", sum);
 }
+
+fn example6_batch() {
+    println!();
+    println!("Example 6: Batched transform (1000 x 256, one call)");
+    println!("---------------------------------------------------");
+
+    // One message per row, as in clustered belief propagation
+    let mut messages = Array2::from_shape_fn((1000, 256), |(i, j)| if j == i % 256 { 1.0 } else { 0.0 });
+
+    let start = std::time::Instant::now();
+    messages.fht_inplace().unwrap();
+    let duration = start.elapsed();
+
+    println!("Batch completed in: {:?}", duration);
+    println!("Row 1, first 4 elements: {:?}", &messages.row(1).to_vec()[0..4]);
+}
@@ -50,35 +50,20 @@ fn cluster_xor_example() {
     println!("Input message c: peaked at 0x{:02X}", 0x24);
     println!();
 
-    // Transform to Walsh domain
-    let mut msg_b_walsh = msg_b.clone();
-    let mut msg_c_walsh = msg_c.clone();
+    // XOR in bit space = pointwise product in Walsh space. xor_convolve does
+    // FHT(b), FHT(c), the product and the scaled inverse FHT in one call,
+    // with the product fused into the last forward butterfly stage.
+    let mut msg_a = msg_b.xor_convolve(&msg_c).unwrap();
 
-    msg_b_walsh.fht_inplace().unwrap();
-    msg_c_walsh.fht_inplace().unwrap();
-
-    println!("Transformed to Walsh domain (WHT applied)");
-
-    // In Walsh domain, XOR becomes pointwise multiplication
-    let mut msg_a_walsh = &msg_b_walsh * &msg_c_walsh;
-
-    println!("Computed XOR via pointwise multiplication");
-
-    // Transform back to probability domain
-    msg_a_walsh.fht_inplace().unwrap();
-
-    // Scale (FHT is orthogonal but not normalized)
-    msg_a_walsh /= numvalues as f64;
+    println!("Computed XOR via Walsh-domain pointwise multiplication");
 
     // Normalize to probability
-    msg_a_walsh /= msg_a_walsh.sum();
-
-    println!("Transformed back to probability domain");
+    msg_a /= msg_a.sum();
     println!();
 
     // The result should be peaked at 0x42 ⊕ 0x24 = 0x66
     let expected = 0x42 ^ 0x24;
-    let peak_idx = msg_a_walsh
+    let peak_idx = msg_a
         .iter()
         .enumerate()
         .max_by(|(_, a), (_, b)| a.partial_cmp(b).unwrap())
@@ -87,7 +72,7 @@ fn cluster_xor_example() {
 
     println!("Expected peak: 0x{:02X}", expected);
     println!("Actual peak:   0x{:02X}", peak_idx);
-    println!("Peak probability: {:.4}", msg_a_walsh[peak_idx]);
+    println!("Peak probability: {:.4}", msg_a[peak_idx]);
 
     if peak_idx == expected {
         println!("✓ Correct! XOR constraint satisfied");
@@ -146,8 +131,7 @@ fn cluster_parity_example() {
     println!("Computed 5-way XOR via pointwise multiplication");
 
     // Transform back
-    result_walsh.fht_inplace().unwrap();
-    result_walsh /= numvalues as f64;
+    result_walsh.fht_inverse_inplace().unwrap();
     result_walsh /= result_walsh.sum();
 
     println!("Transformed back to probability domain");
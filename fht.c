@@ -1,26 +1,1098 @@
 #include "fht.h"
+#include "fht_kernel.h"
+#if defined(FHT_HAVE_SVE)
+#  include <sys/auxv.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#ifdef __AVX__
-#include "fht_avx.c"
-#elif defined(__aarch64__) || defined(__ARM_NEON)
-#include "fht_neon.c"
+/*
+ * Runtime kernel selection. All backends for the target architecture are
+ * linked in; the fastest one the host supports is picked once at load time
+ * (first call at the latest), so the same binary runs on every CPU of the
+ * architecture it was built for.
+ *
+ * Setting FFHT_KERNEL=<name> in the environment forces a specific kernel
+ * (if the host supports it), which is handy for testing and benchmarking.
+ *
+ * Wisdom (fht_wisdom.c) can name a different kernel per size; a kernel
+ * forced by FFHT_KERNEL or fht_select_kernel takes precedence over it.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__))
+static int cpu_has_avx512(void) {
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f");
+#else
+    return 0;
+#endif
+}
+
+static int cpu_has_avx(void) {
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx");
+#else
+    return 0;
+#endif
+}
+
+static int cpu_has_sse(void) {
+    return 1;  // SSE2 is part of the baseline ISA we build for
+}
+#elif (defined(__aarch64__) || defined(__ARM_NEON))
+static int cpu_has_neon(void) {
+    return 1;  // Advanced SIMD is mandatory on aarch64
+}
+
+#if defined(FHT_HAVE_SVE)
+#  ifndef HWCAP_SVE
+#    define HWCAP_SVE (1UL << 22)
+#  endif
+static int cpu_has_sve(void) {
+    return (getauxval(AT_HWCAP) & HWCAP_SVE) != 0;
+}
+#endif
+#endif
+
+// Ordered from most to least preferred
+static const struct {
+    const fht_kernel *kernel;
+    int (*supported)(void);
+} kernels[] = {
+#if (defined(__x86_64__) || defined(__i386__))
+    { &fht_kernel_avx512, cpu_has_avx512 },
+    { &fht_kernel_avx, cpu_has_avx },
+    { &fht_kernel_sse, cpu_has_sse },
+#elif (defined(__aarch64__) || defined(__ARM_NEON))
+#  if defined(FHT_HAVE_SVE)
+    { &fht_kernel_sve, cpu_has_sve },
+#  endif
+    { &fht_kernel_neon, cpu_has_neon },
 #else
-#include "fht_sse.c"
+#  error "ffht: no SIMD backend for this architecture"
+#endif
+};
+
+#define NUM_KERNELS (sizeof(kernels) / sizeof(kernels[0]))
+
+/*
+ * AVX-512 policy: transforms shorter than 2^FHT_AVX512_MIN_LOG_N (16 KiB of
+ * floats) run on the AVX kernel unless AVX-512 is forced or tuned for that
+ * size. They finish in microseconds, too soon for 512-bit throughput to make
+ * up for the lower clock some Intel parts (Skylake-SP, Ice Lake) apply to
+ * the core, and to the scalar code around the call, after zmm arithmetic.
+ * Sapphire Rapids and Zen 4 barely downclock; fht_tune measures the
+ * crossover per machine.
+ */
+#ifndef FHT_AVX512_MIN_LOG_N
+#  define FHT_AVX512_MIN_LOG_N 12
+#endif
+
+/*
+ * SVE policy: with 128-bit vectors (Neoverse V2, Graviton4) SVE is no wider
+ * than NEON, whose generated kernels are unrolled per size, so NEON stays
+ * the default there; the SVE kernel pays off from 256 bits (Neoverse V1,
+ * A64FX). FFHT_KERNEL=sve or wisdom still picks it on any SVE machine.
+ */
+static int preferred_by_default(const fht_kernel *k) {
+#if defined(FHT_HAVE_SVE)
+    if (k == &fht_kernel_sve) {
+        return fht_sve_vector_bytes() > 16;
+    }
 #endif
+    (void)k;
+    return 1;
+}
+
+static const fht_kernel *active_kernel = NULL;
+static int kernel_forced = 0;
+
+static const fht_kernel *find_kernel(const char *name) {
+    for (size_t i = 0; i < NUM_KERNELS; i++) {
+        if (strcmp(kernels[i].kernel->name, name) == 0) {
+            return kernels[i].supported() ? kernels[i].kernel : NULL;
+        }
+    }
+    return NULL;
+}
+
+static const fht_kernel *detect_kernel(void) {
+    const char *forced = getenv("FFHT_KERNEL");
+    if (forced != NULL && *forced != '\0') {
+        const fht_kernel *k = find_kernel(forced);
+        if (k != NULL) {
+            kernel_forced = 1;
+            return k;
+        }
+    }
+    for (size_t i = 0; i < NUM_KERNELS; i++) {
+        if (kernels[i].supported() && preferred_by_default(kernels[i].kernel)) {
+            return kernels[i].kernel;
+        }
+    }
+    return NULL;
+}
+
+static const fht_kernel *get_kernel(void) {
+    // Benign race: concurrent first callers all store the same pointer
+    if (active_kernel == NULL) {
+        active_kernel = detect_kernel();
+    }
+    return active_kernel;
+}
+
+// The kernel for one transform size: the wisdom's, unless one was forced
+static const fht_kernel *kernel_for(int is_double, int log_n) {
+    const fht_kernel *k = get_kernel();
+    if (!kernel_forced && log_n >= 0 && log_n <= 30 && fht_wisdom[is_double][log_n].kernel != NULL) {
+        return fht_wisdom[is_double][log_n].kernel;
+    }
+#if (defined(__x86_64__) || defined(__i386__))
+    if (!kernel_forced && k == &fht_kernel_avx512 && log_n < FHT_AVX512_MIN_LOG_N) {
+        return &fht_kernel_avx;  // every AVX-512 CPU has AVX
+    }
+#endif
+    return k;
+}
+
+const fht_kernel *fht_find_kernel(const char *name) {
+    return find_kernel(name);
+}
+
+#if defined(__GNUC__)
+__attribute__((constructor)) static void fht_init_kernel(void) {
+    get_kernel();
+}
+#endif
+
+const char *fht_kernel_name(void) {
+    const fht_kernel *k = get_kernel();
+    return k != NULL ? k->name : "none";
+}
+
+int fht_select_kernel(const char *name) {
+    kernel_forced = 0;  // detect_kernel sets it again for FFHT_KERNEL
+    const fht_kernel *k = (name == NULL) ? detect_kernel() : find_kernel(name);
+    if (k == NULL) {
+        return -1;
+    }
+    active_kernel = k;
+    kernel_forced = kernel_forced || name != NULL;
+    return 0;
+}
+
+const fht_kernel *fht_forced_kernel(void) {
+    return kernel_forced ? get_kernel() : NULL;
+}
+
+const char *fht_tuned_kernel_name(int log_n, int is_double) {
+    const fht_kernel *k = kernel_for(is_double != 0, log_n);
+    return k != NULL ? k->name : "none";
+}
+
+/*
+ * Out-of-cache transforms. Above 2^FHT_OOC_LOG_BLOCK_* elements (256 KiB,
+ * the L2 of most cores) the kernel only runs on blocks of that size. The
+ * transform recurses on eighths, and each level joins its eight parts with
+ * one radix-8 pass, so three butterfly levels cost one trip through memory.
+ * Just above the block a radix-4 or radix-2 pass takes what is left, where
+ * the data is still in cache. Each pass prefetches its streams
+ * FHT_OOC_PREFETCH_BYTES ahead: eight streams `part` apart are more than
+ * the hardware prefetchers of some cores follow.
+ *
+ * This sits above every backend, so the FFHT kernels (whose recursion is
+ * generated upstream) get the same treatment as the hand-written ones.
+ */
+#ifndef FHT_OOC_LOG_BLOCK_FLOAT
+#  define FHT_OOC_LOG_BLOCK_FLOAT 16
+#endif
+#ifndef FHT_OOC_LOG_BLOCK_DOUBLE
+#  define FHT_OOC_LOG_BLOCK_DOUBLE 15
+#endif
+#ifndef FHT_OOC_PREFETCH_BYTES
+#  define FHT_OOC_PREFETCH_BYTES 512
+#endif
+#if FHT_OOC_LOG_BLOCK_FLOAT < 4 || FHT_OOC_LOG_BLOCK_DOUBLE < 3
+#  error "FHT_OOC_LOG_BLOCK_* must cover a 64-byte line"
+#endif
+
+// Baseline vectors: the passes are bound by memory, not arithmetic
+#if defined(__SSE2__)
+typedef __m128 ooc_vf;
+typedef __m128d ooc_vd;
+#  define OOC_LANES_F 4
+#  define OOC_LANES_D 2
+#  define OOC_LOAD_F(p) _mm_loadu_ps(p)
+#  define OOC_LOAD_D(p) _mm_loadu_pd(p)
+#  define OOC_STORE_F(p, v) _mm_storeu_ps(p, v)
+#  define OOC_STORE_D(p, v) _mm_storeu_pd(p, v)
+#  define OOC_ADD_F(a, b) _mm_add_ps(a, b)
+#  define OOC_ADD_D(a, b) _mm_add_pd(a, b)
+#  define OOC_SUB_F(a, b) _mm_sub_ps(a, b)
+#  define OOC_SUB_D(a, b) _mm_sub_pd(a, b)
+#  define OOC_MUL_F(a, b) _mm_mul_ps(a, b)
+#  define OOC_MUL_D(a, b) _mm_mul_pd(a, b)
+#elif defined(__aarch64__)
+typedef float32x4_t ooc_vf;
+typedef float64x2_t ooc_vd;
+#  define OOC_LANES_F 4
+#  define OOC_LANES_D 2
+#  define OOC_LOAD_F(p) vld1q_f32(p)
+#  define OOC_LOAD_D(p) vld1q_f64(p)
+#  define OOC_STORE_F(p, v) vst1q_f32(p, v)
+#  define OOC_STORE_D(p, v) vst1q_f64(p, v)
+#  define OOC_ADD_F(a, b) vaddq_f32(a, b)
+#  define OOC_ADD_D(a, b) vaddq_f64(a, b)
+#  define OOC_SUB_F(a, b) vsubq_f32(a, b)
+#  define OOC_SUB_D(a, b) vsubq_f64(a, b)
+#  define OOC_MUL_F(a, b) vmulq_f32(a, b)
+#  define OOC_MUL_D(a, b) vmulq_f64(a, b)
+#else
+typedef float ooc_vf;
+typedef double ooc_vd;
+#  define OOC_LANES_F 1
+#  define OOC_LANES_D 1
+#  define OOC_LOAD_F(p) (*(p))
+#  define OOC_LOAD_D(p) (*(p))
+#  define OOC_STORE_F(p, v) (*(p) = (v))
+#  define OOC_STORE_D(p, v) (*(p) = (v))
+#  define OOC_ADD_F(a, b) ((a) + (b))
+#  define OOC_ADD_D(a, b) ((a) + (b))
+#  define OOC_SUB_F(a, b) ((a) - (b))
+#  define OOC_SUB_D(a, b) ((a) - (b))
+#  define OOC_MUL_F(a, b) ((a) * (b))
+#  define OOC_MUL_D(a, b) ((a) * (b))
+#endif
+
+#if defined(__GNUC__)
+#  define OOC_PREFETCH(p) __builtin_prefetch((p), 1)
+#else
+#  define OOC_PREFETCH(p) ((void)(p))
+#endif
+
+#define OOC_BF_F(a, b) do { ooc_vf _s = OOC_ADD_F(a, b); b = OOC_SUB_F(a, b); a = _s; } while (0)
+#define OOC_BF_D(a, b) do { ooc_vd _s = OOC_ADD_D(a, b); b = OOC_SUB_D(a, b); a = _s; } while (0)
+
+#define OOC_RADIX2(BF, r) BF(r[0], r[1])
+#define OOC_RADIX4(BF, r) \
+    BF(r[0], r[1]); BF(r[2], r[3]); \
+    BF(r[0], r[2]); BF(r[1], r[3])
+#define OOC_RADIX8(BF, r) \
+    BF(r[0], r[1]); BF(r[2], r[3]); BF(r[4], r[5]); BF(r[6], r[7]); \
+    BF(r[0], r[2]); BF(r[1], r[3]); BF(r[4], r[6]); BF(r[5], r[7]); \
+    BF(r[0], r[4]); BF(r[1], r[5]); BF(r[2], r[6]); BF(r[3], r[7])
+
+// log_radix stages (strides part .. part << (log_radix - 1)) across the
+// 2^log_radix parts of buf, one 64-byte line of each part at a time
+static void ooc_pass_float(float *buf, size_t part, int log_radix) {
+    const size_t line = 64 / sizeof(float);
+    int radix = 1 << log_radix;
+    ooc_vf r[8];
+    for (size_t i = 0; i < part; i += line) {
+        for (int q = 0; q < radix; q++) {
+            OOC_PREFETCH(buf + q * part + i + FHT_OOC_PREFETCH_BYTES / sizeof(float));
+        }
+        for (size_t j = i; j < i + line; j += OOC_LANES_F) {
+            float *p = buf + j;
+            for (int q = 0; q < radix; q++) {
+                r[q] = OOC_LOAD_F(p + q * part);
+            }
+            if (log_radix == 3) {
+                OOC_RADIX8(OOC_BF_F, r);
+            } else if (log_radix == 2) {
+                OOC_RADIX4(OOC_BF_F, r);
+            } else {
+                OOC_RADIX2(OOC_BF_F, r);
+            }
+            for (int q = 0; q < radix; q++) {
+                OOC_STORE_F(p + q * part, r[q]);
+            }
+        }
+    }
+}
+
+static void ooc_pass_double(double *buf, size_t part, int log_radix) {
+    const size_t line = 64 / sizeof(double);
+    int radix = 1 << log_radix;
+    ooc_vd r[8];
+    for (size_t i = 0; i < part; i += line) {
+        for (int q = 0; q < radix; q++) {
+            OOC_PREFETCH(buf + q * part + i + FHT_OOC_PREFETCH_BYTES / sizeof(double));
+        }
+        for (size_t j = i; j < i + line; j += OOC_LANES_D) {
+            double *p = buf + j;
+            for (int q = 0; q < radix; q++) {
+                r[q] = OOC_LOAD_D(p + q * part);
+            }
+            if (log_radix == 3) {
+                OOC_RADIX8(OOC_BF_D, r);
+            } else if (log_radix == 2) {
+                OOC_RADIX4(OOC_BF_D, r);
+            } else {
+                OOC_RADIX2(OOC_BF_D, r);
+            }
+            for (int q = 0; q < radix; q++) {
+                OOC_STORE_D(p + q * part, r[q]);
+            }
+        }
+    }
+}
+
+// Sign flips of a randomized Hadamard round (fht_*_hd below) on elements
+// base .. base + n - 1, base a multiple of 4: bit i of signs set negates
+// element i. `table` (hd_table_*) holds row p = +-scale for the 4-bit
+// pattern p, so four elements take one load and multiply per lane group.
+static void hd_signs_float(float *buf, size_t n, const uint64_t *signs, size_t base, const float *table) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float *row = table + 4 * ((signs[(base + i) >> 6] >> ((base + i) & 63)) & 15);
+        for (int l = 0; l < 4; l += OOC_LANES_F) {
+            OOC_STORE_F(buf + i + l, OOC_MUL_F(OOC_LOAD_F(buf + i + l), OOC_LOAD_F(row + l)));
+        }
+    }
+    for (; i < n; i++) {
+        buf[i] *= table[4 * ((signs[(base + i) >> 6] >> ((base + i) & 63)) & 1)];
+    }
+}
+
+static void hd_signs_double(double *buf, size_t n, const uint64_t *signs, size_t base, const double *table) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const double *row = table + 4 * ((signs[(base + i) >> 6] >> ((base + i) & 63)) & 15);
+        for (int l = 0; l < 4; l += OOC_LANES_D) {
+            OOC_STORE_D(buf + i + l, OOC_MUL_D(OOC_LOAD_D(buf + i + l), OOC_LOAD_D(row + l)));
+        }
+    }
+    for (; i < n; i++) {
+        buf[i] *= table[4 * ((signs[(base + i) >> 6] >> ((base + i) & 63)) & 1)];
+    }
+}
+
+static void hd_table_float(float table[64], float scale) {
+    for (int k = 0; k < 64; k++) {
+        table[k] = ((k >> 2) >> (k & 3)) & 1 ? -scale : scale;
+    }
+}
+
+static void hd_table_double(double table[64], double scale) {
+    for (int k = 0; k < 64; k++) {
+        table[k] = ((k >> 2) >> (k & 3)) & 1 ? -scale : scale;
+    }
+}
+
+// log_n > FHT_OOC_LOG_BLOCK_FLOAT (up to FHT_LARGE_MAX_LOG_N); blocks use the
+// kernel of their size. With signs, each block gets the sign flips of its
+// elements (base is the index of buf[0]) just before its kernel call, while
+// it is in cache.
+static int ooc_float(float *buf, int log_n, const uint64_t *signs, size_t base, const float *table) {
+    if (log_n <= FHT_OOC_LOG_BLOCK_FLOAT) {
+        const fht_kernel *k = kernel_for(0, log_n);
+        if (k != NULL && signs != NULL) {
+            hd_signs_float(buf, (size_t)1 << log_n, signs, base, table);
+        }
+        return k != NULL ? k->float_fn(buf, log_n) : -1;
+    }
+    int log_radix = log_n - FHT_OOC_LOG_BLOCK_FLOAT < 3 ? log_n - FHT_OOC_LOG_BLOCK_FLOAT : 3;
+    size_t part = (size_t)1 << (log_n - log_radix);
+    for (size_t q = 0; q < ((size_t)1 << log_radix); q++) {
+        int res = ooc_float(buf + q * part, log_n - log_radix, signs, base + q * part, table);
+        if (res) {
+            return res;
+        }
+    }
+    ooc_pass_float(buf, part, log_radix);
+    return 0;
+}
+
+static int ooc_double(double *buf, int log_n, const uint64_t *signs, size_t base, const double *table) {
+    if (log_n <= FHT_OOC_LOG_BLOCK_DOUBLE) {
+        const fht_kernel *k = kernel_for(1, log_n);
+        if (k != NULL && signs != NULL) {
+            hd_signs_double(buf, (size_t)1 << log_n, signs, base, table);
+        }
+        return k != NULL ? k->double_fn(buf, log_n) : -1;
+    }
+    int log_radix = log_n - FHT_OOC_LOG_BLOCK_DOUBLE < 3 ? log_n - FHT_OOC_LOG_BLOCK_DOUBLE : 3;
+    size_t part = (size_t)1 << (log_n - log_radix);
+    for (size_t q = 0; q < ((size_t)1 << log_radix); q++) {
+        int res = ooc_double(buf + q * part, log_n - log_radix, signs, base + q * part, table);
+        if (res) {
+            return res;
+        }
+    }
+    ooc_pass_double(buf, part, log_radix);
+    return 0;
+}
+
+static int float_inplace(float *buf, int log_n) {
+    const fht_kernel *k = kernel_for(0, log_n);
+    if (k == NULL) {
+        return -1;
+    }
+    if (log_n > FHT_OOC_LOG_BLOCK_FLOAT && log_n <= 30) {
+        return ooc_float(buf, log_n, NULL, 0, NULL);
+    }
+    return k->float_fn(buf, log_n);
+}
+
+static int double_inplace(double *buf, int log_n) {
+    const fht_kernel *k = kernel_for(1, log_n);
+    if (k == NULL) {
+        return -1;
+    }
+    if (log_n > FHT_OOC_LOG_BLOCK_DOUBLE && log_n <= 30) {
+        return ooc_double(buf, log_n, NULL, 0, NULL);
+    }
+    return k->double_fn(buf, log_n);
+}
+
+static int check_batch(int log_n, size_t count, size_t stride) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    // Vectors must not overlap
+    if (count > 1 && stride < ((size_t)1 << log_n)) {
+        return -1;
+    }
+    return 0;
+}
+
+static int float_batch(float *buf, int log_n, size_t count, size_t stride) {
+    const fht_kernel *k = kernel_for(0, log_n);
+    if (k == NULL || check_batch(log_n, count, stride)) {
+        return -1;
+    }
+    if (k->float_batch_fn != NULL && log_n <= FHT_OOC_LOG_BLOCK_FLOAT) {
+        return k->float_batch_fn(buf, log_n, count, stride);
+    }
+    for (size_t i = 0; i < count; i++) {
+        int res = float_inplace(buf + i * stride, log_n);
+        if (res) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+static int double_batch(double *buf, int log_n, size_t count, size_t stride) {
+    const fht_kernel *k = kernel_for(1, log_n);
+    if (k == NULL || check_batch(log_n, count, stride)) {
+        return -1;
+    }
+    if (k->double_batch_fn != NULL && log_n <= FHT_OOC_LOG_BLOCK_DOUBLE) {
+        return k->double_batch_fn(buf, log_n, count, stride);
+    }
+    for (size_t i = 0; i < count; i++) {
+        int res = double_inplace(buf + i * stride, log_n);
+        if (res) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+/*
+ * The fused variants below split the transform: the kernel handles halves or
+ * quarters, and this file runs the outermost butterfly stages with the extra
+ * work (scaling, reading from a separate input) folded in, so it costs no
+ * extra pass over the buffer. Below FHT_SPLIT_MIN_LOG_N the buffer is in L1
+ * anyway; those sizes take the plain route, so the kernel never sees a
+ * sub-block that has lost the caller's alignment.
+ */
+#define FHT_SPLIT_MIN_LOG_N 5
+
+/* Scaled transforms: the scale is applied in the last butterfly stage */
+
+static void last_stage_scaled_float(float *restrict lo, float *restrict hi, size_t half, float scale) {
+    for (size_t i = 0; i < half; i++) {
+        float u = lo[i];
+        float v = hi[i];
+        lo[i] = (u + v) * scale;
+        hi[i] = (u - v) * scale;
+    }
+}
+
+static void last_stage_scaled_double(double *restrict lo, double *restrict hi, size_t half, double scale) {
+    for (size_t i = 0; i < half; i++) {
+        double u = lo[i];
+        double v = hi[i];
+        lo[i] = (u + v) * scale;
+        hi[i] = (u - v) * scale;
+    }
+}
+
+static int float_scaled(float *buf, int log_n, float scale) {
+    const fht_kernel *k = kernel_for(0, log_n);
+    if (k == NULL || log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (log_n < FHT_SPLIT_MIN_LOG_N) {
+        int res = k->float_fn(buf, log_n);
+        for (size_t i = 0; res == 0 && i < ((size_t)1 << log_n); i++) {
+            buf[i] *= scale;
+        }
+        return res;
+    }
+    size_t half = (size_t)1 << (log_n - 1);
+    int res = float_inplace(buf, log_n - 1);
+    if (res == 0) {
+        res = float_inplace(buf + half, log_n - 1);
+    }
+    if (res == 0) {
+        last_stage_scaled_float(buf, buf + half, half, scale);
+    }
+    return res;
+}
+
+static int double_scaled(double *buf, int log_n, double scale) {
+    const fht_kernel *k = kernel_for(1, log_n);
+    if (k == NULL || log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (log_n < FHT_SPLIT_MIN_LOG_N) {
+        int res = k->double_fn(buf, log_n);
+        for (size_t i = 0; res == 0 && i < ((size_t)1 << log_n); i++) {
+            buf[i] *= scale;
+        }
+        return res;
+    }
+    size_t half = (size_t)1 << (log_n - 1);
+    int res = double_inplace(buf, log_n - 1);
+    if (res == 0) {
+        res = double_inplace(buf + half, log_n - 1);
+    }
+    if (res == 0) {
+        last_stage_scaled_double(buf, buf + half, half, scale);
+    }
+    return res;
+}
+
+// Small vectors go through the batch kernel and a scaling pass while they
+// are still in L1; the rest take the fused last stage one at a time
+static int float_scaled_batch(float *buf, int log_n, size_t count, size_t stride, float scale) {
+    if (check_batch(log_n, count, stride)) {
+        return -1;
+    }
+    if (log_n < FHT_SPLIT_MIN_LOG_N) {
+        int res = float_batch(buf, log_n, count, stride);
+        for (size_t v = 0; res == 0 && v < count; v++) {
+            for (size_t i = 0; i < ((size_t)1 << log_n); i++) {
+                buf[v * stride + i] *= scale;
+            }
+        }
+        return res;
+    }
+    for (size_t v = 0; v < count; v++) {
+        int res = float_scaled(buf + v * stride, log_n, scale);
+        if (res) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+static int double_scaled_batch(double *buf, int log_n, size_t count, size_t stride, double scale) {
+    if (check_batch(log_n, count, stride)) {
+        return -1;
+    }
+    if (log_n < FHT_SPLIT_MIN_LOG_N) {
+        int res = double_batch(buf, log_n, count, stride);
+        for (size_t v = 0; res == 0 && v < count; v++) {
+            for (size_t i = 0; i < ((size_t)1 << log_n); i++) {
+                buf[v * stride + i] *= scale;
+            }
+        }
+        return res;
+    }
+    for (size_t v = 0; v < count; v++) {
+        int res = double_scaled(buf + v * stride, log_n, scale);
+        if (res) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+// 2^(-log_n / 2), exact for even log_n; avoids pulling in libm
+static double orthonormal_scale(int log_n) {
+    double scale = (log_n & 1) ? 0.70710678118654752440 : 1.0;
+    for (int i = 0; i < log_n / 2; i++) {
+        scale *= 0.5;
+    }
+    return scale;
+}
+
+static double inverse_scale(int log_n) {
+    return (log_n >= 0 && log_n <= 30) ? 1.0 / (double)((size_t)1 << log_n) : 1.0;
+}
+
+int fht_float_orthonormal(float *buf, int log_n) {
+    return fht_float_scaled(buf, log_n, (float)orthonormal_scale(log_n));
+}
+
+int fht_double_orthonormal(double *buf, int log_n) {
+    return fht_double_scaled(buf, log_n, orthonormal_scale(log_n));
+}
+
+int fht_float_inverse(float *buf, int log_n) {
+    return fht_float_scaled(buf, log_n, (float)inverse_scale(log_n));
+}
+
+int fht_double_inverse(double *buf, int log_n) {
+    return fht_double_scaled(buf, log_n, inverse_scale(log_n));
+}
+
+/*
+ * Streaming transforms: the last stage, which writes every element once more,
+ * uses non-temporal stores so the result goes to memory without displacing
+ * the cache. Only the x86 baseline (SSE2) and AArch64 forms are used here;
+ * fht.c is not built with wider ISA flags.
+ */
+static void last_stage_stream_float(float *restrict lo, float *restrict hi, size_t half) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    // lo and hi are half * sizeof(float) apart, so one peel aligns both
+    for (; i < half && ((uintptr_t)(lo + i) & 15); i++) {
+        float u = lo[i];
+        float v = hi[i];
+        lo[i] = u + v;
+        hi[i] = u - v;
+    }
+    for (; i + 4 <= half; i += 4) {
+        __m128 u = _mm_load_ps(lo + i);
+        __m128 v = _mm_load_ps(hi + i);
+        _mm_stream_ps(lo + i, _mm_add_ps(u, v));
+        _mm_stream_ps(hi + i, _mm_sub_ps(u, v));
+    }
+    _mm_sfence();
+#elif defined(__aarch64__)
+    for (; i + 2 * 4 <= half; i += 2 * 4) {
+        float32x4_t u0 = vld1q_f32(lo + i), u1 = vld1q_f32(lo + i + 4);
+        float32x4_t v0 = vld1q_f32(hi + i), v1 = vld1q_f32(hi + i + 4);
+        float32x4_t s0 = vaddq_f32(u0, v0), s1 = vaddq_f32(u1, v1);
+        float32x4_t d0 = vsubq_f32(u0, v0), d1 = vsubq_f32(u1, v1);
+        __asm__ __volatile__("stnp %q0, %q1, [%2]" : : "w"(s0), "w"(s1), "r"(lo + i) : "memory");
+        __asm__ __volatile__("stnp %q0, %q1, [%2]" : : "w"(d0), "w"(d1), "r"(hi + i) : "memory");
+    }
+#endif
+    for (; i < half; i++) {
+        float u = lo[i];
+        float v = hi[i];
+        lo[i] = u + v;
+        hi[i] = u - v;
+    }
+}
+
+static void last_stage_stream_double(double *restrict lo, double *restrict hi, size_t half) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    // lo and hi are half * sizeof(double) apart, so one peel aligns both
+    for (; i < half && ((uintptr_t)(lo + i) & 15); i++) {
+        double u = lo[i];
+        double v = hi[i];
+        lo[i] = u + v;
+        hi[i] = u - v;
+    }
+    for (; i + 2 <= half; i += 2) {
+        __m128d u = _mm_load_pd(lo + i);
+        __m128d v = _mm_load_pd(hi + i);
+        _mm_stream_pd(lo + i, _mm_add_pd(u, v));
+        _mm_stream_pd(hi + i, _mm_sub_pd(u, v));
+    }
+    _mm_sfence();
+#elif defined(__aarch64__)
+    for (; i + 2 * 2 <= half; i += 2 * 2) {
+        float64x2_t u0 = vld1q_f64(lo + i), u1 = vld1q_f64(lo + i + 2);
+        float64x2_t v0 = vld1q_f64(hi + i), v1 = vld1q_f64(hi + i + 2);
+        float64x2_t s0 = vaddq_f64(u0, v0), s1 = vaddq_f64(u1, v1);
+        float64x2_t d0 = vsubq_f64(u0, v0), d1 = vsubq_f64(u1, v1);
+        __asm__ __volatile__("stnp %q0, %q1, [%2]" : : "w"(s0), "w"(s1), "r"(lo + i) : "memory");
+        __asm__ __volatile__("stnp %q0, %q1, [%2]" : : "w"(d0), "w"(d1), "r"(hi + i) : "memory");
+    }
+#endif
+    for (; i < half; i++) {
+        double u = lo[i];
+        double v = hi[i];
+        lo[i] = u + v;
+        hi[i] = u - v;
+    }
+}
+
+static int float_stream(float *buf, int log_n) {
+    const fht_kernel *k = kernel_for(0, log_n);
+    if (k == NULL || log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (log_n < FHT_SPLIT_MIN_LOG_N) {
+        return k->float_fn(buf, log_n);
+    }
+    size_t half = (size_t)1 << (log_n - 1);
+    int res = float_inplace(buf, log_n - 1);
+    if (res == 0) {
+        res = float_inplace(buf + half, log_n - 1);
+    }
+    if (res == 0) {
+        last_stage_stream_float(buf, buf + half, half);
+    }
+    return res;
+}
+
+static int double_stream(double *buf, int log_n) {
+    const fht_kernel *k = kernel_for(1, log_n);
+    if (k == NULL || log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (log_n < FHT_SPLIT_MIN_LOG_N) {
+        return k->double_fn(buf, log_n);
+    }
+    size_t half = (size_t)1 << (log_n - 1);
+    int res = double_inplace(buf, log_n - 1);
+    if (res == 0) {
+        res = double_inplace(buf + half, log_n - 1);
+    }
+    if (res == 0) {
+        last_stage_stream_double(buf, buf + half, half);
+    }
+    return res;
+}
+
+/*
+ * Out-of-place transforms. The stages commute, so the two outermost ones
+ * (strides n/2 and n/4) go first: they read `in` once and write the four
+ * quarters of `out`, and the kernel finishes each quarter in place. `in` is
+ * never written, and the data crosses the bus as often as for a plain copy.
+ */
+static void first_stages_oop_float(const float *restrict in, float *restrict out, size_t quarter) {
+    const float *in1 = in + quarter, *in2 = in + 2 * quarter, *in3 = in + 3 * quarter;
+    float *out1 = out + quarter, *out2 = out + 2 * quarter, *out3 = out + 3 * quarter;
+    for (size_t i = 0; i < quarter; i++) {
+        float t0 = in[i] + in2[i];
+        float t2 = in[i] - in2[i];
+        float t1 = in1[i] + in3[i];
+        float t3 = in1[i] - in3[i];
+        out[i] = t0 + t1;
+        out1[i] = t0 - t1;
+        out2[i] = t2 + t3;
+        out3[i] = t2 - t3;
+    }
+}
+
+static void first_stages_oop_double(const double *restrict in, double *restrict out, size_t quarter) {
+    const double *in1 = in + quarter, *in2 = in + 2 * quarter, *in3 = in + 3 * quarter;
+    double *out1 = out + quarter, *out2 = out + 2 * quarter, *out3 = out + 3 * quarter;
+    for (size_t i = 0; i < quarter; i++) {
+        double t0 = in[i] + in2[i];
+        double t2 = in[i] - in2[i];
+        double t1 = in1[i] + in3[i];
+        double t3 = in1[i] - in3[i];
+        out[i] = t0 + t1;
+        out1[i] = t0 - t1;
+        out2[i] = t2 + t3;
+        out3[i] = t2 - t3;
+    }
+}
+
+// `in` and `out` must either be the same buffer or not overlap
+static int float_oop(float *in, float *out, int log_n) {
+    const fht_kernel *k = kernel_for(0, log_n);
+    if (k == NULL || log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (in == out) {
+        return float_inplace(out, log_n);
+    }
+    if (log_n < FHT_SPLIT_MIN_LOG_N) {
+        fast_copy(out, in, sizeof(float) << log_n);
+        return k->float_fn(out, log_n);
+    }
+    size_t quarter = (size_t)1 << (log_n - 2);
+    first_stages_oop_float(in, out, quarter);
+    for (int q = 0; q < 4; q++) {
+        int res = float_inplace(out + q * quarter, log_n - 2);
+        if (res) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+static int double_oop(double *in, double *out, int log_n) {
+    const fht_kernel *k = kernel_for(1, log_n);
+    if (k == NULL || log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (in == out) {
+        return double_inplace(out, log_n);
+    }
+    if (log_n < FHT_SPLIT_MIN_LOG_N) {
+        fast_copy(out, in, sizeof(double) << log_n);
+        return k->double_fn(out, log_n);
+    }
+    size_t quarter = (size_t)1 << (log_n - 2);
+    first_stages_oop_double(in, out, quarter);
+    for (int q = 0; q < 4; q++) {
+        int res = double_inplace(out + q * quarter, log_n - 2);
+        if (res) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Randomized Hadamard transforms (H D_k) ... (H D_1), D_r the diagonal of
+ * +-1 signs in bits of round r. Each round's signs are applied to a cache
+ * block right before the kernel transforms it (ooc_* above, or the whole
+ * vector when it fits a block), so a round costs what a plain transform
+ * does, and the scale rides in the signs of the first round. A batch runs
+ * all rounds of one vector (or of a group of small vectors, through the
+ * batch kernel) before the next, so whatever fits in cache stays there for
+ * every round.
+ */
+static int check_hd(int log_n, size_t count, size_t stride, const uint64_t *sign_bits, int rounds) {
+    return check_batch(log_n, count, stride) || rounds < 1 || sign_bits == NULL;
+}
+
+// tables[0] carries the scale (first round), tables[1] is +-1
+static int hd_float(float *buf, int log_n, const fht_kernel *k, const uint64_t *sign_bits, int rounds,
+                  float tables[2][64]) {
+    size_t words = log_n > 6 ? (size_t)1 << (log_n - 6) : 1;
+    int res = 0;
+    for (int r = 0; res == 0 && r < rounds; r++) {
+        const uint64_t *signs = sign_bits + (size_t)r * words;
+        if (log_n > FHT_OOC_LOG_BLOCK_FLOAT) {
+            res = ooc_float(buf, log_n, signs, 0, tables[r > 0]);
+        } else {
+            hd_signs_float(buf, (size_t)1 << log_n, signs, 0, tables[r > 0]);
+            res = k->float_fn(buf, log_n);
+        }
+    }
+    return res;
+}
+
+static int hd_float_batch(float *buf, int log_n, size_t count, size_t stride, const uint64_t *sign_bits,
+                          int rounds, float scale) {
+    const fht_kernel *k = kernel_for(0, log_n);
+    if (k == NULL || check_hd(log_n, count, stride, sign_bits, rounds)) {
+        return -1;
+    }
+    float tables[2][64];
+    hd_table_float(tables[0], scale);
+    hd_table_float(tables[1], 1.0f);
+    if (k->float_batch_fn == NULL || log_n > FHT_OOC_LOG_BLOCK_FLOAT - 1) {
+        int res = 0;
+        for (size_t i = 0; res == 0 && i < count; i++) {
+            res = hd_float(buf + i * stride, log_n, k, sign_bits, rounds, tables);
+        }
+        return res;
+    }
+    // Groups of small vectors that fill half a cache block go through the
+    // batch kernel together, round by round
+    size_t n = (size_t)1 << log_n;
+    size_t words = log_n > 6 ? n >> 6 : 1;
+    size_t group = (size_t)1 << (FHT_OOC_LOG_BLOCK_FLOAT - 1 - log_n);
+    for (size_t v = 0; v < count; v += group) {
+        size_t m = count - v < group ? count - v : group;
+        for (int r = 0; r < rounds; r++) {
+            for (size_t i = v; i < v + m; i++) {
+                hd_signs_float(buf + i * stride, n, sign_bits + (size_t)r * words, 0, tables[r > 0]);
+            }
+            int res = k->float_batch_fn(buf + v * stride, log_n, m, stride);
+            if (res) {
+                return res;
+            }
+        }
+    }
+    return 0;
+}
+
+// tables[0] carries the scale (first round), tables[1] is +-1
+static int hd_double(double *buf, int log_n, const fht_kernel *k, const uint64_t *sign_bits, int rounds,
+                  double tables[2][64]) {
+    size_t words = log_n > 6 ? (size_t)1 << (log_n - 6) : 1;
+    int res = 0;
+    for (int r = 0; res == 0 && r < rounds; r++) {
+        const uint64_t *signs = sign_bits + (size_t)r * words;
+        if (log_n > FHT_OOC_LOG_BLOCK_DOUBLE) {
+            res = ooc_double(buf, log_n, signs, 0, tables[r > 0]);
+        } else {
+            hd_signs_double(buf, (size_t)1 << log_n, signs, 0, tables[r > 0]);
+            res = k->double_fn(buf, log_n);
+        }
+    }
+    return res;
+}
+
+static int hd_double_batch(double *buf, int log_n, size_t count, size_t stride, const uint64_t *sign_bits,
+                          int rounds, double scale) {
+    const fht_kernel *k = kernel_for(1, log_n);
+    if (k == NULL || check_hd(log_n, count, stride, sign_bits, rounds)) {
+        return -1;
+    }
+    double tables[2][64];
+    hd_table_double(tables[0], scale);
+    hd_table_double(tables[1], 1.0);
+    if (k->double_batch_fn == NULL || log_n > FHT_OOC_LOG_BLOCK_DOUBLE - 1) {
+        int res = 0;
+        for (size_t i = 0; res == 0 && i < count; i++) {
+            res = hd_double(buf + i * stride, log_n, k, sign_bits, rounds, tables);
+        }
+        return res;
+    }
+    // Groups of small vectors that fill half a cache block go through the
+    // batch kernel together, round by round
+    size_t n = (size_t)1 << log_n;
+    size_t words = log_n > 6 ? n >> 6 : 1;
+    size_t group = (size_t)1 << (FHT_OOC_LOG_BLOCK_DOUBLE - 1 - log_n);
+    for (size_t v = 0; v < count; v += group) {
+        size_t m = count - v < group ? count - v : group;
+        for (int r = 0; r < rounds; r++) {
+            for (size_t i = v; i < v + m; i++) {
+                hd_signs_double(buf + i * stride, n, sign_bits + (size_t)r * words, 0, tables[r > 0]);
+            }
+            int res = k->double_batch_fn(buf + v * stride, log_n, m, stride);
+            if (res) {
+                return res;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Public entry points: the transforms above, timed when instrumentation is
+ * on (fht_stats.c).
+ */
+int fht_float(float *buf, int log_n) {
+    uint64_t t0 = fht_stats_begin();
+    int res = float_inplace(buf, log_n);
+    fht_stats_end(t0, 0, FHT_STATS_INPLACE, log_n, 1);
+    return res;
+}
+
+int fht_double(double *buf, int log_n) {
+    uint64_t t0 = fht_stats_begin();
+    int res = double_inplace(buf, log_n);
+    fht_stats_end(t0, 1, FHT_STATS_INPLACE, log_n, 1);
+    return res;
+}
+
+// Past 2^30 the stats tables have no row for the size; those calls go
+// unrecorded
+static int check_large(int log_n, size_t elem) {
+    return log_n < 0 || log_n > FHT_LARGE_MAX_LOG_N || (SIZE_MAX / elem) >> log_n == 0;
+}
+
+int fht_float_large(float *buf, int log_n) {
+    if (log_n <= 30) {
+        return fht_float(buf, log_n);
+    }
+    return check_large(log_n, sizeof(float)) ? -1 : ooc_float(buf, log_n, NULL, 0, NULL);
+}
+
+int fht_double_large(double *buf, int log_n) {
+    if (log_n <= 30) {
+        return fht_double(buf, log_n);
+    }
+    return check_large(log_n, sizeof(double)) ? -1 : ooc_double(buf, log_n, NULL, 0, NULL);
+}
+
+int fht_float_batch(float *buf, int log_n, size_t count, size_t stride) {
+    uint64_t t0 = fht_stats_begin();
+    int res = float_batch(buf, log_n, count, stride);
+    fht_stats_end(t0, 0, FHT_STATS_BATCH, log_n, count);
+    return res;
+}
+
+int fht_double_batch(double *buf, int log_n, size_t count, size_t stride) {
+    uint64_t t0 = fht_stats_begin();
+    int res = double_batch(buf, log_n, count, stride);
+    fht_stats_end(t0, 1, FHT_STATS_BATCH, log_n, count);
+    return res;
+}
+
+int fht_float_scaled(float *buf, int log_n, float scale) {
+    uint64_t t0 = fht_stats_begin();
+    int res = float_scaled(buf, log_n, scale);
+    fht_stats_end(t0, 0, FHT_STATS_SCALED, log_n, 1);
+    return res;
+}
+
+int fht_double_scaled(double *buf, int log_n, double scale) {
+    uint64_t t0 = fht_stats_begin();
+    int res = double_scaled(buf, log_n, scale);
+    fht_stats_end(t0, 1, FHT_STATS_SCALED, log_n, 1);
+    return res;
+}
+
+int fht_float_scaled_batch(float *buf, int log_n, size_t count, size_t stride, float scale) {
+    uint64_t t0 = fht_stats_begin();
+    int res = float_scaled_batch(buf, log_n, count, stride, scale);
+    fht_stats_end(t0, 0, FHT_STATS_SCALED, log_n, count);
+    return res;
+}
+
+int fht_double_scaled_batch(double *buf, int log_n, size_t count, size_t stride, double scale) {
+    uint64_t t0 = fht_stats_begin();
+    int res = double_scaled_batch(buf, log_n, count, stride, scale);
+    fht_stats_end(t0, 1, FHT_STATS_SCALED, log_n, count);
+    return res;
+}
+
+int fht_float_stream(float *buf, int log_n) {
+    uint64_t t0 = fht_stats_begin();
+    int res = float_stream(buf, log_n);
+    fht_stats_end(t0, 0, FHT_STATS_STREAM, log_n, 1);
+    return res;
+}
+
+int fht_double_stream(double *buf, int log_n) {
+    uint64_t t0 = fht_stats_begin();
+    int res = double_stream(buf, log_n);
+    fht_stats_end(t0, 1, FHT_STATS_STREAM, log_n, 1);
+    return res;
+}
 
-// Define out-of-place functions here (after fast_copy is defined)
 int fht_float_oop(float *in, float *out, int log_n) {
-    fast_copy(out, in, sizeof(float) << log_n);
-    return fht_float(out, log_n);
+    uint64_t t0 = fht_stats_begin();
+    int res = float_oop(in, out, log_n);
+    fht_stats_end(t0, 0, FHT_STATS_OOP, log_n, in == out ? 1 : 2);
+    return res;
 }
 
 int fht_double_oop(double *in, double *out, int log_n) {
-    fast_copy(out, in, sizeof(double) << log_n);
-    return fht_double(out, log_n);
+    uint64_t t0 = fht_stats_begin();
+    int res = double_oop(in, out, log_n);
+    fht_stats_end(t0, 1, FHT_STATS_OOP, log_n, in == out ? 1 : 2);
+    return res;
+}
+
+int fht_float_hd(float *buf, int log_n, const uint64_t *sign_bits, int rounds) {
+    return fht_float_hd_batch(buf, log_n, 1, 0, sign_bits, rounds, 1.0f);
+}
+
+int fht_double_hd(double *buf, int log_n, const uint64_t *sign_bits, int rounds) {
+    return fht_double_hd_batch(buf, log_n, 1, 0, sign_bits, rounds, 1.0);
+}
+
+int fht_float_hd_batch(float *buf, int log_n, size_t count, size_t stride, const uint64_t *sign_bits, int rounds,
+                       float scale) {
+    uint64_t t0 = fht_stats_begin();
+    int res = hd_float_batch(buf, log_n, count, stride, sign_bits, rounds, scale);
+    fht_stats_end(t0, 0, FHT_STATS_HD, log_n, count);
+    return res;
+}
+
+int fht_double_hd_batch(double *buf, int log_n, size_t count, size_t stride, const uint64_t *sign_bits,
+                        int rounds, double scale) {
+    uint64_t t0 = fht_stats_begin();
+    int res = hd_double_batch(buf, log_n, count, stride, sign_bits, rounds, scale);
+    fht_stats_end(t0, 1, FHT_STATS_HD, log_n, count);
+    return res;
 }
 
 #ifdef __cplusplus
@@ -2,14 +2,26 @@
 #define _FHT_H_
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 #if (defined(__x86_64__) || defined(__i386__))
 #  include <x86intrin.h>
 #elif (defined(__aarch64__) || defined(__ARM_NEON))
 #  include <arm_neon.h>
 #endif
 
-#ifndef FAST_COPY_MEMCPY_THRESHOLD
-#  define FAST_COPY_MEMCPY_THRESHOLD ((size_t)1ull << 20)
+// From this many bytes fast_copy bypasses the cache: the destination is
+// aligned by a short memcpy, then written with non-temporal stores while the
+// source is prefetched ahead. FAST_COPY_MEMCPY_THRESHOLD is the old name.
+#ifndef FAST_COPY_STREAM_THRESHOLD
+#  ifdef FAST_COPY_MEMCPY_THRESHOLD
+#    define FAST_COPY_STREAM_THRESHOLD FAST_COPY_MEMCPY_THRESHOLD
+#  else
+#    define FAST_COPY_STREAM_THRESHOLD ((size_t)1ull << 20)
+#  endif
+#endif
+// How far ahead of the copy the source is prefetched, in bytes
+#ifndef FAST_COPY_PREFETCH_BYTES
+#  define FAST_COPY_PREFETCH_BYTES 512
 #endif
 
 #ifdef FHT_HEADER_ONLY
@@ -25,10 +37,29 @@ extern "C" {
 // These functions all assume that the size of memory being copied is a power of 2.
 
 #if _FEATURE_AVX512F
+// Large copies: peel to a 64-byte aligned destination, then stream whole
+// cache lines. One stream store per line.
+_STORAGE_ void *fast_copy_stream(void *out, void *in, size_t n) {
+    char *o = (char *)out, *i = (char *)in;
+    size_t head = (size_t)(-(uintptr_t)o & 63);
+    if(head > n) {
+        head = n;
+    }
+    memcpy(o, i, head);
+    o += head; i += head; n -= head;
+    for(; n >= 64; n -= 64, o += 64, i += 64) {
+        _mm_prefetch(i + FAST_COPY_PREFETCH_BYTES, _MM_HINT_NTA);
+        _mm512_stream_ps((float *)o, _mm512_loadu_ps((float *)i));
+    }
+    _mm_sfence();
+    memcpy(o, i, n);
+    return out;
+}
+
 // If n is less than 64, defaults to memcpy. Otherwise, being a power of 2, we can just use unaligned stores and loads.
 _STORAGE_ void *fast_copy(void *out, void *in, size_t n) {
-    if(n >= FAST_COPY_MEMCPY_THRESHOLD) {
-        return memcpy(out, in, n);
+    if(n >= FAST_COPY_STREAM_THRESHOLD) {
+        return fast_copy_stream(out, in, n);
     }
     if(n < 64) {
         return memcpy(out, in, n);
@@ -40,10 +71,30 @@ _STORAGE_ void *fast_copy(void *out, void *in, size_t n) {
     return out;
 }
 #elif __AVX2__
+// Large copies: peel to a 64-byte aligned destination, then stream whole
+// cache lines. Two stream stores per line.
+_STORAGE_ void *fast_copy_stream(void *out, void *in, size_t n) {
+    char *o = (char *)out, *i = (char *)in;
+    size_t head = (size_t)(-(uintptr_t)o & 63);
+    if(head > n) {
+        head = n;
+    }
+    memcpy(o, i, head);
+    o += head; i += head; n -= head;
+    for(; n >= 64; n -= 64, o += 64, i += 64) {
+        _mm_prefetch(i + FAST_COPY_PREFETCH_BYTES, _MM_HINT_NTA);
+        _mm256_stream_ps((float *)o, _mm256_loadu_ps((float *)i));
+        _mm256_stream_ps((float *)(o + 32), _mm256_loadu_ps((float *)(i + 32)));
+    }
+    _mm_sfence();
+    memcpy(o, i, n);
+    return out;
+}
+
 // If n is less than 32, defaults to memcpy. Otherwise, being a power of 2, we can just use unaligned stores and loads.
 _STORAGE_ void *fast_copy(void *out, void *in, size_t n) {
-    if(n >= FAST_COPY_MEMCPY_THRESHOLD) {
-        return memcpy(out, in, n);
+    if(n >= FAST_COPY_STREAM_THRESHOLD) {
+        return fast_copy_stream(out, in, n);
     }
     if(n < 32) {
         return memcpy(out, in, n);
@@ -55,10 +106,32 @@ _STORAGE_ void *fast_copy(void *out, void *in, size_t n) {
     return out;
 }
 #elif __SSE2__
+// Large copies: peel to a 64-byte aligned destination, then stream whole
+// cache lines. Four stream stores per line.
+_STORAGE_ void *fast_copy_stream(void *out, void *in, size_t n) {
+    char *o = (char *)out, *i = (char *)in;
+    size_t head = (size_t)(-(uintptr_t)o & 63);
+    if(head > n) {
+        head = n;
+    }
+    memcpy(o, i, head);
+    o += head; i += head; n -= head;
+    for(; n >= 64; n -= 64, o += 64, i += 64) {
+        _mm_prefetch(i + FAST_COPY_PREFETCH_BYTES, _MM_HINT_NTA);
+        _mm_stream_ps((float *)o, _mm_loadu_ps((float *)i));
+        _mm_stream_ps((float *)(o + 16), _mm_loadu_ps((float *)(i + 16)));
+        _mm_stream_ps((float *)(o + 32), _mm_loadu_ps((float *)(i + 32)));
+        _mm_stream_ps((float *)(o + 48), _mm_loadu_ps((float *)(i + 48)));
+    }
+    _mm_sfence();
+    memcpy(o, i, n);
+    return out;
+}
+
 // If n is less than 16, defaults to memcpy. Otherwise, being a power of 2, we can just use unaligned stores and loads.
 _STORAGE_ void *fast_copy(void *out, void *in, size_t n) {
-    if(n >= FAST_COPY_MEMCPY_THRESHOLD) {
-        return memcpy(out, in, n);
+    if(n >= FAST_COPY_STREAM_THRESHOLD) {
+        return fast_copy_stream(out, in, n);
     }
     if(n < 16) {
         return memcpy(out, in, n);
@@ -70,10 +143,39 @@ _STORAGE_ void *fast_copy(void *out, void *in, size_t n) {
     return out;
 }
 #elif defined(__aarch64__) || defined(__ARM_NEON)
+// Large copies: peel to a 64-byte aligned destination, then stream whole
+// cache lines. AArch64 stores with STNP pairs; 32-bit NEON has no
+// non-temporal store and falls back to plain vector stores.
+_STORAGE_ void *fast_copy_stream(void *out, void *in, size_t n) {
+    char *o = (char *)out, *i = (char *)in;
+    size_t head = (size_t)(-(uintptr_t)o & 63);
+    if(head > n) {
+        head = n;
+    }
+    memcpy(o, i, head);
+    o += head; i += head; n -= head;
+    for(; n >= 64; n -= 64, o += 64, i += 64) {
+        __builtin_prefetch(i + FAST_COPY_PREFETCH_BYTES, 0, 0);
+        float32x4_t a = vld1q_f32((float *)i), b = vld1q_f32((float *)(i + 16));
+        float32x4_t c = vld1q_f32((float *)(i + 32)), d = vld1q_f32((float *)(i + 48));
+#if defined(__aarch64__)
+        __asm__ __volatile__("stnp %q0, %q1, [%2]" : : "w"(a), "w"(b), "r"(o) : "memory");
+        __asm__ __volatile__("stnp %q0, %q1, [%2, #32]" : : "w"(c), "w"(d), "r"(o) : "memory");
+#else
+        vst1q_f32((float *)o, a);
+        vst1q_f32((float *)(o + 16), b);
+        vst1q_f32((float *)(o + 32), c);
+        vst1q_f32((float *)(o + 48), d);
+#endif
+    }
+    memcpy(o, i, n);
+    return out;
+}
+
 // ARM NEON: 128-bit vectors (16 bytes)
 _STORAGE_ void *fast_copy(void *out, void *in, size_t n) {
-    if(n >= FAST_COPY_MEMCPY_THRESHOLD) {
-        return memcpy(out, in, n);
+    if(n >= FAST_COPY_STREAM_THRESHOLD) {
+        return fast_copy_stream(out, in, n);
     }
     if(n < 16) {
         return memcpy(out, in, n);
@@ -85,6 +187,10 @@ _STORAGE_ void *fast_copy(void *out, void *in, size_t n) {
     return out;
 }
 #else
+_STORAGE_ void *fast_copy_stream(void *out, void *in, size_t n) {
+    return memcpy(out, in, n);
+}
+
 _STORAGE_ void *fast_copy(void *out, void *in, size_t n) {
     return memcpy(out, in, n);
 }
@@ -96,9 +202,305 @@ _STORAGE_ void *fast_copy(void *out, void *in, size_t n) {
 
 int fht_float(float *buf, int log_n);
 int fht_double(double *buf, int log_n);
+// Transform with the last butterfly stage written by non-temporal stores,
+// for results that will not be read again soon (e.g. written back to a
+// large output array): the output does not evict the working set.
+int fht_float_stream(float *buf, int log_n);
+int fht_double_stream(double *buf, int log_n);
+// Out-of-place: `in` is only read (the first two butterfly stages read it
+// and write `out`), so no separate copy pass. `in` and `out` must not overlap
+// unless they are the same buffer.
 int fht_float_oop(float *in, float *out, int log_n);
 int fht_double_oop(double *in, double *out, int log_n);
 
+// Output orders of fht_*_ordered
+enum {
+    FHT_ORDER_NATURAL,   // Hadamard order, as fht_float
+    FHT_ORDER_SEQUENCY,  // Walsh order: coefficient k has k sign changes
+    FHT_ORDER_PALEY,     // dyadic order: the natural one at bit-reversed k
+};
+
+// Transform of `in` into `out` in the given order (fht_order.c). The
+// permutation is applied to the input, by a cache-blocked gather that
+// replaces the copy of the out-of-place transform instead of a random-access
+// pass over the output. `in` and `out` must not overlap unless they are the
+// same buffer; in place, a temporary copy of 2^log_n elements is allocated.
+// Returns -1 for an unknown order.
+int fht_float_ordered(float *in, float *out, int log_n, int order);
+int fht_double_ordered(double *in, double *out, int log_n, int order);
+
+// Transform `count` vectors of length 2^log_n in place. Vector i starts at
+// buf + i * stride (stride in elements, at least 2^log_n). Arguments are
+// validated once for the whole batch.
+int fht_float_batch(float *buf, int log_n, size_t count, size_t stride);
+int fht_double_batch(double *buf, int log_n, size_t count, size_t stride);
+
+// Strided transforms (fht_strided.c): `count` vectors, vector j made of the
+// 2^log_n elements buf[j * batch_stride + i * stride]. With batch_stride 1
+// (the columns of a row-major matrix, stride = row length) the butterflies
+// run as vectorized row operations on column tiles, with no transpose copy.
+// Stride 1 is fht_*_batch; any other layout is gathered one vector at a time.
+// No two elements may coincide.
+int fht_float_strided(float *buf, int log_n, size_t stride, size_t count, size_t batch_stride);
+int fht_double_strided(double *buf, int log_n, size_t stride, size_t count, size_t batch_stride);
+// Partial transform: only the butterfly stages of the bit positions set in
+// dim_mask (bit s pairs elements 2^s apart), i.e. the Walsh transform along
+// those k of the log_n binary dimensions, in O(n k). Bits at or above log_n
+// are an error; a full mask equals fht_float.
+int fht_float_dims(float *buf, int log_n, uint32_t dim_mask);
+int fht_double_dims(double *buf, int log_n, uint32_t dim_mask);
+
+// Transform and multiply by `scale` in one pass: the scale is applied in the
+// last butterfly stage. _orthonormal uses 1/sqrt(n), which makes the transform
+// its own inverse; _inverse uses 1/n, which undoes a plain fht_float.
+int fht_float_scaled(float *buf, int log_n, float scale);
+int fht_double_scaled(double *buf, int log_n, double scale);
+int fht_float_orthonormal(float *buf, int log_n);
+int fht_double_orthonormal(double *buf, int log_n);
+int fht_float_inverse(float *buf, int log_n);
+int fht_double_inverse(double *buf, int log_n);
+// fht_*_scaled over `count` vectors `stride` apart, as fht_*_batch
+int fht_float_scaled_batch(float *buf, int log_n, size_t count, size_t stride, float scale);
+int fht_double_scaled_batch(double *buf, int log_n, size_t count, size_t stride, double scale);
+
+// Randomized Hadamard transform (H D_rounds) ... (H D_1) buf, the rotation of
+// cross-polytope LSH and SRHT sketches. D_r flips the signs of the elements
+// whose bits are set in round r of sign_bits: rounds blocks of
+// max(1, 2^log_n / 64) words, bit i of a block (word i / 64, bit i % 64)
+// negating element i. The flips are applied to each cache block just before
+// the kernel transforms it, so a round costs one plain transform. The batch
+// form applies the same signs to `count` vectors `stride` apart, all rounds
+// per vector in turn, and multiplies by `scale` for free (e.g. 2^(-log_n *
+// rounds / 2) for an orthonormal rotation).
+int fht_float_hd(float *buf, int log_n, const uint64_t *sign_bits, int rounds);
+int fht_double_hd(double *buf, int log_n, const uint64_t *sign_bits, int rounds);
+int fht_float_hd_batch(float *buf, int log_n, size_t count, size_t stride, const uint64_t *sign_bits, int rounds,
+                       float scale);
+int fht_double_hd_batch(double *buf, int log_n, size_t count, size_t stride, const uint64_t *sign_bits,
+                        int rounds, double scale);
+
+// Fused spectrum reductions (fht_reduce.c): transform in place and, while
+// the last butterfly stage writes the spectrum, compare each vector of
+// coefficients with the current bound (SSE2/NEON), so picking the few of
+// interest by magnitude needs no second pass. _argmax: the index of the
+// largest |coefficient| (with the sign of buf[index], the cross-polytope LSH
+// hash). _topk: the indices of the k largest, largest first. _threshold: the
+// indices with |coefficient| >= t in increasing order, at most `capacity` of
+// them (the lowest ones), with the full number in *count. Ties go to the
+// lower index and NaNs are never picked; _topk pads with SIZE_MAX if fewer
+// than k coefficients are not NaN. The values stay in buf. The _batch forms
+// take `count` vectors `stride` apart, as fht_*_batch, and write 1, k or
+// `capacity` indices per vector (and counts[v]). Returns 0, or -1 for bad
+// arguments (k of 0 or above 2^log_n) or a failed allocation.
+int fht_float_argmax(float *buf, int log_n, size_t *index);
+int fht_double_argmax(double *buf, int log_n, size_t *index);
+int fht_float_argmax_batch(float *buf, int log_n, size_t count, size_t stride, size_t *indices);
+int fht_double_argmax_batch(double *buf, int log_n, size_t count, size_t stride, size_t *indices);
+int fht_float_topk(float *buf, int log_n, size_t k, size_t *indices);
+int fht_double_topk(double *buf, int log_n, size_t k, size_t *indices);
+int fht_float_topk_batch(float *buf, int log_n, size_t count, size_t stride, size_t k, size_t *indices);
+int fht_double_topk_batch(double *buf, int log_n, size_t count, size_t stride, size_t k, size_t *indices);
+int fht_float_threshold(float *buf, int log_n, float t, size_t *indices, size_t capacity, size_t *count);
+int fht_double_threshold(double *buf, int log_n, double t, size_t *indices, size_t capacity, size_t *count);
+int fht_float_threshold_batch(float *buf, int log_n, size_t count, size_t stride, float t, size_t *indices,
+                              size_t capacity, size_t *counts);
+int fht_double_threshold_batch(double *buf, int log_n, size_t count, size_t stride, double t, size_t *indices,
+                               size_t capacity, size_t *counts);
+
+// XOR (dyadic) convolution (fht_xor.c): out[k] = sum over i ^ j == k of
+// a[i] * b[j], via the Hadamard transform with the product fused into the
+// last forward stage and the 1/n into the inverse. `scratch` holds 2^log_n
+// elements (NULL: allocated per call) and must not overlap the other
+// buffers; out may be a or b. Correlation over XOR is the same operation.
+int fht_xor_convolve_float(const float *a, const float *b, float *out, int log_n, float *scratch);
+int fht_xor_convolve_double(const double *a, const double *b, double *out, int log_n, double *scratch);
+int fht_xor_correlate_float(const float *a, const float *b, float *out, int log_n, float *scratch);
+int fht_xor_correlate_double(const double *a, const double *b, double *out, int log_n, double *scratch);
+// `count` independent convolutions, vector i at offset i * stride of a, b
+// and out; one scratch vector is reused for all of them.
+int fht_xor_convolve_float_batch(const float *a, const float *b, float *out, int log_n,
+                                 size_t count, size_t stride, float *scratch);
+int fht_xor_convolve_double_batch(const double *a, const double *b, double *out, int log_n,
+                                  size_t count, size_t stride, double *scratch);
+
+// Pruned transforms (fht_sparse.c). _sparse: the spectrum of a vector with
+// nnz nonzeros, values[j] at indices[j] (duplicates add up), written densely
+// to out. _select: out[j] = coefficient indices[j] of the transform of `in`,
+// which is left untouched; `scratch` holds 2^log_n elements (NULL: allocated
+// per call). Both evaluate few entries directly and otherwise skip the
+// butterflies that only see zeros or feed no requested output: about
+// log2(k) + 2 passes for k entries instead of log_n.
+int fht_float_sparse(const size_t *indices, const float *values, size_t nnz, float *out, int log_n);
+int fht_double_sparse(const size_t *indices, const double *values, size_t nnz, double *out, int log_n);
+int fht_float_select(const float *in, const size_t *indices, size_t count, float *out, int log_n, float *scratch);
+int fht_double_select(const double *in, const size_t *indices, size_t count, double *out, int log_n, double *scratch);
+// _update: the spectrum after `count` input changes, input[indices[j]] +=
+// deltas[j] (duplicates add up), as spectrum += H delta in place. Few
+// changes add their signed rows directly, 8 per pass over the spectrum;
+// past a size-dependent count (4 up to 2^16) the deltas go through _sparse
+// in `scratch` (2^log_n elements, NULL: allocated per call), which is added.
+// For a scaled spectrum, scale the deltas.
+int fht_float_update(float *spectrum, int log_n, const size_t *indices, const float *deltas, size_t count,
+                     float *scratch);
+int fht_double_update(double *spectrum, int log_n, const size_t *indices, const double *deltas, size_t count,
+                      double *scratch);
+
+// Exact integer transforms (fht_int.c), in place. int32/int64 arithmetic
+// wraps, so results are exact while they fit in the type (|x| * 2^log_n
+// below 2^31 or 2^63) and exact modulo 2^32/2^64 otherwise. int16 saturates
+// instead and returns 1 if any value was clipped, 0 otherwise.
+int fht_int16(int16_t *buf, int log_n);
+int fht_int32(int32_t *buf, int log_n);
+int fht_int64(int64_t *buf, int log_n);
+
+// 16-bit float storage (fht_half.c): IEEE fp16 or bfloat16 bit patterns,
+// widened to fp32 one cache block at a time, transformed in fp32 and rounded
+// back (once up to 2^12 elements, once per pass beyond that). Half the memory
+// traffic of fht_float. fp16 tops out at 65504, so scale inputs accordingly.
+int fht_half(uint16_t *buf, int log_n);
+int fht_bf16(uint16_t *buf, int log_n);
+
+// Multithreaded transforms (fht_mt.c). nthreads <= 0 uses the global setting.
+// Worth it from about log_n 20; smaller sizes run on the calling thread. The
+// workers are a pool started by the first call and kept for later ones.
+int fht_float_mt(float *buf, int log_n, int nthreads);
+int fht_double_mt(double *buf, int log_n, int nthreads);
+// Multithreaded fht_*_strided / fht_*_batch: threads take chunks of the
+// vectors, or, for fewer than nthreads contiguous vectors of 2^20 or more,
+// all threads transform each vector in turn. Batches under 2^16 elements in
+// total run on the calling thread.
+int fht_float_strided_mt(float *buf, int log_n, size_t stride, size_t count, size_t batch_stride, int nthreads);
+int fht_double_strided_mt(double *buf, int log_n, size_t stride, size_t count, size_t batch_stride,
+                          int nthreads);
+int fht_float_batch_mt(float *buf, int log_n, size_t count, size_t stride, int nthreads);
+int fht_double_batch_mt(double *buf, int log_n, size_t count, size_t stride, int nthreads);
+// Default thread count for the _mt calls; 0 means all online CPUs.
+int fht_set_num_threads(int nthreads);
+int fht_get_num_threads(void);
+// Pin worker t to cpus[t % ncpus] (Linux only). NULL clears the pinning.
+// Pool workers that are already running follow on the next _mt call.
+int fht_set_thread_affinity(const int *cpus, int ncpus);
+// Building block for external schedulers (rayon, OpenMP, ...): after each of
+// the 2^log_blocks contiguous blocks has been transformed, apply the
+// cross-block butterfly stages to offsets [begin, end) of every block.
+// Disjoint ranges may run concurrently.
+int fht_float_combine_blocks(float *buf, int log_n, int log_blocks, size_t begin, size_t end);
+int fht_double_combine_blocks(double *buf, int log_n, int log_blocks, size_t begin, size_t end);
+
+// Sizes past 2^30. fht_*_large transforms up to 2^FHT_LARGE_MAX_LOG_N
+// elements in memory (or over a buffer from mmap), on the calling thread:
+// the kernel sees 256 KiB blocks and the levels above run as cache-blocked
+// radix-8 passes. log_n <= 30 is the same as fht_float/fht_double.
+#define FHT_LARGE_MAX_LOG_N 48
+int fht_float_large(float *buf, int log_n);
+int fht_double_large(double *buf, int log_n);
+// Out-of-core transforms (fht_file.c, POSIX): the 2^log_n native-endian
+// elements at byte `offset` of `fd` (open for reading and writing),
+// transformed in place through two tiles that fit in mem_bytes. The first
+// pass transforms contiguous tiles; each further pass runs as many of the
+// remaining stages as a tile of 1 MiB segments allows, so e.g. 2^36 floats
+// with 4 GiB take two passes, each reading and writing the file once. A
+// helper thread writes the previous tile and reads the next while a tile is
+// transformed on nthreads threads (as for fht_float_mt). Returns -1 with
+// errno set on bad arguments (EINVAL), no memory or an I/O error; the file
+// is then partly transformed.
+int fht_float_file(int fd, uint64_t offset, int log_n, size_t mem_bytes, int nthreads);
+int fht_double_file(int fd, uint64_t offset, int log_n, size_t mem_bytes, int nthreads);
+
+// Wisdom (fht_wisdom.c): per-machine tuning in the style of FFTW. fht_tune
+// times fht_float and fht_double (out-of-cache passes included) with each
+// supported kernel forced in turn, for each log_n in [1, max_log_n], and
+// from 2^16 the thread count (powers of two up to max_threads, 0: all CPUs)
+// and block split of fht_*_mt. The caller's forced kernel, if any, is
+// restored afterwards, and the timing calls are not counted in the tuning
+// thread's stats (other threads keep counting). fht_float/fht_double and the
+// other entry points then use the fastest kernel for each size, unless a
+// kernel is forced (FFHT_KERNEL, fht_select_kernel), and fht_*_mt calls with
+// nthreads <= 0 use the tuned thread count. The wisdom file is plain text;
+// FFHT_WISDOM=<path> loads one when the library is loaded. Entries for
+// kernels this CPU lacks are skipped. Not thread-safe against concurrent
+// transforms: tune or load before starting work.
+int fht_tune(int max_log_n, int max_threads);
+int fht_wisdom_save(const char *path);
+int fht_wisdom_load(const char *path);
+void fht_wisdom_forget(void);
+// Kernel fht_float (is_double 0) or fht_double uses for 2^log_n
+const char *fht_tuned_kernel_name(int log_n, int is_double);
+
+// Instrumentation (fht_stats.c): calls, bytes and nanoseconds per dtype,
+// entry point and log_n, with a histogram of call times in powers of two
+// (bin b: [2^b, 2^(b+1)) ns, the last bin open-ended). Off until
+// fht_stats_enable(1) or FFHT_STATS=1 in the environment; while off, each
+// call pays one branch. -DFFHT_NO_STATS compiles it out, and the functions
+// below return -1. Each thread counts its own calls without locking; only
+// the outermost entry point of a call is recorded (an fht_xor_convolve_*
+// call is one "xor" call, not the fht_float calls it makes), and fht_*_mt
+// workers count as part of the _mt call. `bytes` is the size of the buffers
+// transformed (both buffers for _oop and out-of-place _ordered, both spectra
+// of each XOR convolution). Sizes past 2^30 (fht_*_large, fht_*_file) are not
+// recorded.
+#define FHT_STATS_HIST_BINS 24
+
+// Element types, the first index of fht_stats.counters
+enum {
+    FHT_STATS_F32,   // float
+    FHT_STATS_F64,   // double
+    FHT_STATS_F16,   // fht_half
+    FHT_STATS_BF16,  // fht_bf16
+    FHT_STATS_I16,   // fht_int16
+    FHT_STATS_I32,   // fht_int32
+    FHT_STATS_I64,   // fht_int64
+    FHT_STATS_NUM_DTYPES
+};
+
+enum {
+    FHT_STATS_INPLACE,  // fht_float, fht_double, fht_half, fht_bf16, fht_int*
+    FHT_STATS_OOP,      // fht_*_oop
+    FHT_STATS_BATCH,    // fht_*_batch
+    FHT_STATS_SCALED,   // fht_*_scaled, _scaled_batch, _orthonormal, _inverse
+    FHT_STATS_STREAM,   // fht_*_stream
+    FHT_STATS_MT,       // fht_*_mt, fht_*_batch_mt, fht_*_strided_mt
+    FHT_STATS_HD,       // fht_*_hd, fht_*_hd_batch
+    FHT_STATS_XOR,      // fht_xor_convolve_*, fht_xor_correlate_*
+    FHT_STATS_REDUCE,   // fht_*_argmax, _topk, _threshold and their batches
+    FHT_STATS_SPARSE,   // fht_*_sparse, fht_*_update, fht_*_select
+    FHT_STATS_ORDERED,  // fht_*_ordered
+    FHT_STATS_STRIDED,  // fht_*_strided, fht_*_dims
+    FHT_STATS_FILE,     // fht_*_file
+    FHT_STATS_NUM_ENTRIES
+};
+
+typedef struct fht_stats_counter {
+    uint64_t calls;
+    uint64_t bytes;
+    uint64_t ns;
+    uint64_t hist[FHT_STATS_HIST_BINS];
+} fht_stats_counter;
+
+typedef struct fht_stats {
+    // Indexed [dtype][entry][log_n]
+    fht_stats_counter counters[FHT_STATS_NUM_DTYPES][FHT_STATS_NUM_ENTRIES][31];
+    // Kernel each size runs on at snapshot time, as fht_tuned_kernel_name
+    // (16-bit floats run on the float kernel; "int" for the integer types)
+    const char *kernel[FHT_STATS_NUM_DTYPES][31];
+} fht_stats;
+
+// Turn recording on (1) or off (0); returns the previous state
+int fht_stats_enable(int on);
+// Copy the calling thread's counters, or with all_threads the sum over all
+// threads, including ones that have exited
+int fht_stats_snapshot(fht_stats *out, int all_threads);
+// Zero the calling thread's counters, or everyone's
+int fht_stats_reset(int all_threads);
+// "inplace", "oop", ... for FHT_STATS_INPLACE, ...
+const char *fht_stats_entry_name(int entry);
+
+// Name of the SIMD kernel picked at load time ("avx", "sse", "neon", ...).
+const char *fht_kernel_name(void);
+// Force a kernel by name, or pass NULL to go back to automatic selection.
+// Returns -1 if the kernel is unknown or not supported by this CPU.
+int fht_select_kernel(const char *name);
+
 
 #ifdef __cplusplus
 
@@ -112,6 +514,18 @@ static inline int fht(double *buf, int log_n) {
     return fht_double(buf, log_n);
 }
 
+static inline int fht(int16_t *buf, int log_n) {
+    return fht_int16(buf, log_n);
+}
+
+static inline int fht(int32_t *buf, int log_n) {
+    return fht_int32(buf, log_n);
+}
+
+static inline int fht(int64_t *buf, int log_n) {
+    return fht_int64(buf, log_n);
+}
+
 static inline int fht(float *buf, float *out, int log_n) {
     return fht_float_oop(buf, out, log_n);
 }
@@ -119,6 +533,305 @@ static inline int fht(float *buf, float *out, int log_n) {
 static inline int fht(double *buf, double *out, int log_n) {
     return fht_double_oop(buf, out, log_n);
 }
+static inline int fht_ordered(float *buf, float *out, int log_n, int order) {
+    return fht_float_ordered(buf, out, log_n, order);
+}
+static inline int fht_ordered(double *buf, double *out, int log_n, int order) {
+    return fht_double_ordered(buf, out, log_n, order);
+}
+
+static inline int fht_mt(float *buf, int log_n, int nthreads) {
+    return fht_float_mt(buf, log_n, nthreads);
+}
+
+static inline int fht_mt(double *buf, int log_n, int nthreads) {
+    return fht_double_mt(buf, log_n, nthreads);
+}
+
+static inline int fht_batch(float *buf, int log_n, size_t count, size_t stride) {
+    return fht_float_batch(buf, log_n, count, stride);
+}
+
+static inline int fht_batch(double *buf, int log_n, size_t count, size_t stride) {
+    return fht_double_batch(buf, log_n, count, stride);
+}
+
+static inline int fht_scaled(float *buf, int log_n, float scale) {
+    return fht_float_scaled(buf, log_n, scale);
+}
+
+static inline int fht_scaled(double *buf, int log_n, double scale) {
+    return fht_double_scaled(buf, log_n, scale);
+}
+
+static inline int fht_orthonormal(float *buf, int log_n) {
+    return fht_float_orthonormal(buf, log_n);
+}
+
+static inline int fht_orthonormal(double *buf, int log_n) {
+    return fht_double_orthonormal(buf, log_n);
+}
+
+static inline int fht_inverse(float *buf, int log_n) {
+    return fht_float_inverse(buf, log_n);
+}
+
+static inline int fht_inverse(double *buf, int log_n) {
+    return fht_double_inverse(buf, log_n);
+}
+
+static inline int fht_xor_convolve(const float *a, const float *b, float *out, int log_n, float *scratch) {
+    return fht_xor_convolve_float(a, b, out, log_n, scratch);
+}
+
+static inline int fht_xor_convolve(const double *a, const double *b, double *out, int log_n, double *scratch) {
+    return fht_xor_convolve_double(a, b, out, log_n, scratch);
+}
+
+static inline int fht_hd(float *buf, int log_n, const uint64_t *sign_bits, int rounds) {
+    return fht_float_hd(buf, log_n, sign_bits, rounds);
+}
+
+static inline int fht_hd(double *buf, int log_n, const uint64_t *sign_bits, int rounds) {
+    return fht_double_hd(buf, log_n, sign_bits, rounds);
+}
+
+static inline int fht_argmax(float *buf, int log_n, size_t *index) {
+    return fht_float_argmax(buf, log_n, index);
+}
+
+static inline int fht_argmax(double *buf, int log_n, size_t *index) {
+    return fht_double_argmax(buf, log_n, index);
+}
+
+static inline int fht_topk(float *buf, int log_n, size_t k, size_t *indices) {
+    return fht_float_topk(buf, log_n, k, indices);
+}
+
+static inline int fht_topk(double *buf, int log_n, size_t k, size_t *indices) {
+    return fht_double_topk(buf, log_n, k, indices);
+}
+
+static inline int fht_threshold(float *buf, int log_n, float t, size_t *indices, size_t capacity, size_t *count) {
+    return fht_float_threshold(buf, log_n, t, indices, capacity, count);
+}
+
+static inline int fht_threshold(double *buf, int log_n, double t, size_t *indices, size_t capacity,
+                                size_t *count) {
+    return fht_double_threshold(buf, log_n, t, indices, capacity, count);
+}
+
+// Compile-time sizes (C++17): fht<LogN>(buf), with the dtype deduced from
+// buf. Up to FHT_CXX_UNROLL_MAX_LOG_N the transform is expanded in place as a
+// fixed network of radix-4 stage pairs with constant strides, which the
+// compiler unrolls and vectorizes for the ISA it targets, so a small
+// transform costs its arithmetic and no call. Above that, or for int16_t
+// (which saturates and reports it), it is one direct call of the runtime
+// transform; opting in with FHT_CXX_INLINE_MAX_BYTES (e.g. 32768, an L1
+// data cache) keeps sizes up to that many bytes inline instead, the network
+// on each block and the remaining stage pairs as constant-stride loops. int32_t/int64_t wrap like fht_int32/fht_int64. std::array and
+// std::span of static extent take LogN from their size. Returns what the
+// runtime overloads return: 0, or 1 if an int16 transform saturated.
+//
+// The default of 2^5 is where the unrolled network stops beating a call into
+// the dispatched AVX-512 kernels, which also handle these sizes in
+// registers; builds for an ISA with no wide runtime kernel, or -march flags
+// wider than the baseline, can raise it. The blocked loops are vectorized
+// for the compile-time ISA only and lose to a wider runtime kernel (AVX-512
+// under a baseline build is 2-3x faster from 2^8), so they are off by default;
+// they pay off where the call is the cost, e.g. -march builds on CPUs
+// without a wide runtime kernel.
+#if __cplusplus >= 201703L
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#if __cplusplus > 201703L && __has_include(<span>)
+#  include <span>
+#endif
+
+#ifndef FHT_CXX_UNROLL_MAX_LOG_N
+#  define FHT_CXX_UNROLL_MAX_LOG_N 5
+#endif
+#ifndef FHT_CXX_INLINE_MAX_BYTES
+#  define FHT_CXX_INLINE_MAX_BYTES 0
+#endif
+
+namespace fht_detail {
+
+template <class T>
+inline constexpr bool supported =
+    std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int16_t> ||
+    std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>;
+
+// Integers add modulo 2^bits, without signed overflow
+template <class T>
+using arith = typename std::conditional_t<std::is_integral_v<T>, std::make_unsigned<T>, std::common_type<T>>::type;
+
+constexpr int log2_size(std::size_t n) {
+    int log_n = 0;
+    while ((std::size_t(1) << log_n) < n) {
+        log_n++;
+    }
+    return log_n;
+}
+
+// Stages H and 2H of every block of 4H elements
+template <class T, std::size_t N, std::size_t H>
+inline void radix4(T *buf) {
+    using A = arith<T>;
+    for (std::size_t i = 0; i < N; i += 4 * H) {
+        for (std::size_t j = i; j < i + H; j++) {
+            A a = A(buf[j]), b = A(buf[j + H]), c = A(buf[j + 2 * H]), d = A(buf[j + 3 * H]);
+            A s0 = a + b, d0 = a - b, s1 = c + d, d1 = c - d;
+            buf[j] = T(s0 + s1);
+            buf[j + H] = T(d0 + d1);
+            buf[j + 2 * H] = T(s0 - s1);
+            buf[j + 3 * H] = T(d0 - d1);
+        }
+    }
+}
+
+// The last stage of an odd LogN
+template <class T, std::size_t N>
+inline void radix2(T *buf) {
+    using A = arith<T>;
+    for (std::size_t j = 0; j < N / 2; j++) {
+        A a = A(buf[j]), b = A(buf[j + N / 2]);
+        buf[j] = T(a + b);
+        buf[j + N / 2] = T(a - b);
+    }
+}
+
+// Stages 1 and 2 of float vectors, stage 1 of double vectors in registers,
+// where the compiler would fall back to scalar code. Baseline ISA: SSE2 on
+// x86-64, NEON on aarch64.
+#if defined(__SSE2__)
+inline void low_stages(float *buf, std::size_t n) {
+    const __m128 odd = _mm_castsi128_ps(_mm_set_epi32(INT32_MIN, 0, INT32_MIN, 0));
+    const __m128 upper = _mm_castsi128_ps(_mm_set_epi32(INT32_MIN, INT32_MIN, 0, 0));
+    for (std::size_t i = 0; i < n; i += 4) {
+        __m128 v = _mm_loadu_ps(buf + i);
+        __m128 a = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 b = _mm_xor_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1)), odd);
+        v = _mm_add_ps(a, b);
+        a = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 1, 0));
+        b = _mm_xor_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 2, 3, 2)), upper);
+        _mm_storeu_ps(buf + i, _mm_add_ps(a, b));
+    }
+}
+
+inline void low_stages(double *buf, std::size_t n) {
+    const __m128d odd = _mm_castsi128_pd(_mm_set_epi64x(INT64_MIN, 0));
+    for (std::size_t i = 0; i < n; i += 2) {
+        __m128d v = _mm_loadu_pd(buf + i);
+        _mm_storeu_pd(buf + i, _mm_add_pd(_mm_unpacklo_pd(v, v), _mm_xor_pd(_mm_unpackhi_pd(v, v), odd)));
+    }
+}
+#define FHT_CXX_LOW_STAGES 1
+#elif defined(__aarch64__)
+inline void low_stages(float *buf, std::size_t n) {
+    for (std::size_t i = 0; i < n; i += 4) {
+        float32x4_t v = vld1q_f32(buf + i);
+        float32x4_t a = vtrn1q_f32(v, v), b = vtrn2q_f32(v, v);
+        v = vtrn1q_f32(vaddq_f32(a, b), vsubq_f32(a, b));
+        float64x2_t d = vreinterpretq_f64_f32(v);
+        a = vreinterpretq_f32_f64(vdupq_laneq_f64(d, 0));
+        b = vreinterpretq_f32_f64(vdupq_laneq_f64(d, 1));
+        vst1q_f32(buf + i, vcombine_f32(vget_low_f32(vaddq_f32(a, b)), vget_low_f32(vsubq_f32(a, b))));
+    }
+}
+
+inline void low_stages(double *buf, std::size_t n) {
+    for (std::size_t i = 0; i < n; i += 2) {
+        float64x2_t v = vld1q_f64(buf + i);
+        float64x2_t a = vdupq_laneq_f64(v, 0), b = vdupq_laneq_f64(v, 1);
+        vst1q_f64(buf + i, vcombine_f64(vget_low_f64(vaddq_f64(a, b)), vget_low_f64(vsubq_f64(a, b))));
+    }
+}
+#define FHT_CXX_LOW_STAGES 1
+#endif
+
+// Stages the low_stages above take for T, 0 for none
+template <class T>
+constexpr int low_stage_count(int log_n) {
+#if defined(FHT_CXX_LOW_STAGES)
+    if (std::is_same_v<T, float> && log_n >= 2) return 2;
+    if (std::is_same_v<T, double> && log_n >= 1) return 1;
+#endif
+    (void)log_n;
+    return 0;
+}
+
+template <class T, int LogN, int S = -1>
+inline void unrolled(T *buf) {
+    constexpr std::size_t n = std::size_t(1) << LogN;
+    if constexpr (S < 0) {
+        constexpr int low = low_stage_count<T>(LogN);
+        if constexpr (low > 0) {
+            low_stages(buf, n);
+        }
+        unrolled<T, LogN, low>(buf);
+    } else if constexpr (S + 2 <= LogN) {
+        radix4<T, n, (std::size_t(1) << S)>(buf);
+        unrolled<T, LogN, S + 2>(buf);
+    } else if constexpr (S + 1 == LogN) {
+        radix2<T, n>(buf);
+    }
+}
+
+// Past the unrolled sizes, up to FHT_CXX_INLINE_MAX_BYTES: the unrolled
+// network on each 2^FHT_CXX_UNROLL_MAX_LOG_N block, then the remaining stage
+// pairs as constant-stride loops, one pass each over a buffer still in L1
+template <class T, int LogN>
+inline void blocked(T *buf) {
+    constexpr std::size_t n = std::size_t(1) << LogN, block = std::size_t(1) << FHT_CXX_UNROLL_MAX_LOG_N;
+    for (std::size_t i = 0; i < n; i += block) {
+        unrolled<T, FHT_CXX_UNROLL_MAX_LOG_N>(buf + i);
+    }
+    unrolled<T, LogN, FHT_CXX_UNROLL_MAX_LOG_N>(buf);
+}
+
+}  // namespace fht_detail
+
+template <int LogN, class T>
+inline int fht(T *buf) {
+    static_assert(LogN >= 0 && LogN <= 30, "LogN must be between 0 and 30");
+    static_assert(fht_detail::supported<T>, "fht<LogN> takes float, double, int16_t, int32_t or int64_t");
+    if constexpr (std::is_same_v<T, int16_t>) {
+        return fht(buf, LogN);
+    } else if constexpr (LogN <= FHT_CXX_UNROLL_MAX_LOG_N) {
+        fht_detail::unrolled<T, LogN>(buf);
+        return 0;
+    } else if constexpr ((sizeof(T) << LogN) <= FHT_CXX_INLINE_MAX_BYTES) {
+        fht_detail::blocked<T, LogN>(buf);
+        return 0;
+    } else {
+        return fht(buf, LogN);
+    }
+}
+
+template <class T, std::size_t N>
+inline int fht(std::array<T, N> &a) {
+    static_assert(N != 0 && (N & (N - 1)) == 0, "std::array size must be a power of two");
+    return fht<fht_detail::log2_size(N)>(a.data());
+}
+
+#if defined(__cpp_lib_span)
+// A dynamic extent is checked at run time: -1 unless a power of two
+template <class T, std::size_t N>
+inline int fht(std::span<T, N> s) {
+    if constexpr (N == std::dynamic_extent) {
+        if (s.empty() || (s.size() & (s.size() - 1)) != 0 || s.size() > (std::size_t(1) << 30)) {
+            return -1;
+        }
+        return fht(s.data(), fht_detail::log2_size(s.size()));
+    } else {
+        static_assert(N != 0 && (N & (N - 1)) == 0, "std::span extent must be a power of two");
+        return fht<fht_detail::log2_size(N)>(s.data());
+    }
+}
+#endif
+#endif  // __cplusplus >= 201703L
 
 #endif
 
@@ -0,0 +1,205 @@
+// Out-of-core transforms: a vector stored in a file, transformed in place
+// through a bounded amount of memory.
+//
+// The memory budget holds two tiles of 2^log_t elements. The first pass
+// reads contiguous tiles and runs the log_t lowest stages on each. Every
+// further pass runs up to g of the remaining stages: a tile is then 2^g
+// segments of 2^(log_t - g) contiguous elements, `2^s` elements apart in the
+// file (s the first stage of the pass), and the stages are a column
+// transform of that 2^g x 2^(log_t - g) matrix (fht_*_strided). Segments are
+// kept at FILE_LOG_SEGMENT_BYTES or more so the file is read in large runs,
+// which bounds g; a pass count of 1 + ceil((log_n - log_t) / g) follows,
+// and every pass reads and writes each element once.
+//
+// While one tile is transformed, a helper thread writes the previous tile
+// and reads the next into the other buffer, so I/O overlaps the compute.
+// Passes follow each other strictly: the last write of a pass completes
+// before the next pass reads.
+
+#define _GNU_SOURCE  // pread, pwrite
+#define _FILE_OFFSET_BITS 64
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht.h"
+#include "fht_kernel.h"
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Shortest contiguous run read or written per segment (1 MiB)
+#define FILE_LOG_SEGMENT_BYTES 20
+
+// One pass: tiles of 2^g segments of 2^log_w elements, segment r of tile t
+// at element (t / lo_tiles) << (s + g) | r << s | (t % lo_tiles) << log_w.
+// The first pass is g = 0, s = log_w = log_t: contiguous tiles.
+typedef struct {
+    int fd;
+    uint64_t offset;  // byte offset of element 0
+    size_t elem;      // sizeof(float) or sizeof(double)
+    int s;
+    int g;
+    int log_w;
+} file_pass;
+
+static uint64_t segment_start(const file_pass *p, uint64_t tile, uint64_t r) {
+    uint64_t lo_tiles = (p->s > p->log_w) ? (uint64_t)1 << (p->s - p->log_w) : 1;
+    uint64_t hi = tile / lo_tiles, lo = tile % lo_tiles;
+    return (hi << (p->s + p->g)) | (r << p->s) | (lo << p->log_w);
+}
+
+// Read (write 0) or write tile `tile` to or from buf; 0 or an errno value
+static int tile_io(const file_pass *p, uint64_t tile, char *buf, int write) {
+    size_t seg_bytes = p->elem << p->log_w;
+    for (uint64_t r = 0; r < ((uint64_t)1 << p->g); r++) {
+        char *mem = buf + r * seg_bytes;
+        off_t pos = (off_t)(p->offset + segment_start(p, tile, r) * p->elem);
+        size_t done = 0;
+        while (done < seg_bytes) {
+            ssize_t got = write ? pwrite(p->fd, mem + done, seg_bytes - done, pos + (off_t)done)
+                                : pread(p->fd, mem + done, seg_bytes - done, pos + (off_t)done);
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            if (got <= 0) {
+                return got < 0 ? errno : EIO;  // EIO: the file ends early
+            }
+            done += (size_t)got;
+        }
+    }
+    return 0;
+}
+
+typedef struct {
+    const file_pass *pass;
+    char *buf;
+    int64_t write_tile;  // -1: none
+    int64_t read_tile;   // -1: none
+    int error;
+} file_io_job;
+
+static void *file_io_main(void *arg) {
+    file_io_job *job = (file_io_job *)arg;
+    job->error = 0;
+    if (job->write_tile >= 0) {
+        job->error = tile_io(job->pass, (uint64_t)job->write_tile, job->buf, 1);
+    }
+    if (job->error == 0 && job->read_tile >= 0) {
+        job->error = tile_io(job->pass, (uint64_t)job->read_tile, job->buf, 0);
+    }
+    return NULL;
+}
+
+// The stages of one pass on a tile in memory
+static int transform_tile(const file_pass *p, char *buf, int is_double, int nthreads) {
+    if (p->g == 0) {
+        int log_t = p->log_w;
+        if (log_t > 30) {
+            return is_double ? fht_double_large((double *)buf, log_t) : fht_float_large((float *)buf, log_t);
+        }
+        return is_double ? fht_double_mt((double *)buf, log_t, nthreads) : fht_float_mt((float *)buf, log_t, nthreads);
+    }
+    size_t w = (size_t)1 << p->log_w;
+    return is_double ? fht_double_strided_mt((double *)buf, p->g, w, w, 1, nthreads)
+                     : fht_float_strided_mt((float *)buf, p->g, w, w, 1, nthreads);
+}
+
+static int run_pass(const file_pass *p, char *bufs[2], uint64_t tiles, int is_double, int nthreads) {
+    int err = tile_io(p, 0, bufs[0], 0);
+    for (uint64_t k = 0; err == 0 && k < tiles; k++) {
+        file_io_job job = {p, bufs[(k + 1) & 1], k > 0 ? (int64_t)k - 1 : -1,
+                           k + 1 < tiles ? (int64_t)k + 1 : -1, 0};
+        pthread_t io;
+        int spawned = (job.write_tile >= 0 || job.read_tile >= 0) &&
+                      pthread_create(&io, NULL, file_io_main, &job) == 0;
+        int res = transform_tile(p, bufs[k & 1], is_double, nthreads);
+        if (spawned) {
+            pthread_join(io, NULL);
+        } else {
+            file_io_main(&job);  // no thread: the same I/O, serialized
+        }
+        err = res != 0 ? EINVAL : job.error;
+    }
+    if (err == 0) {
+        err = tile_io(p, tiles - 1, bufs[(tiles - 1) & 1], 1);
+    }
+    return err;
+}
+
+static int file_transform(int fd, uint64_t offset, int log_n, size_t mem_bytes, int nthreads, int is_double) {
+    size_t elem = is_double ? sizeof(double) : sizeof(float);
+    int log_elem = is_double ? 3 : 2;
+    // Two tiles fit the budget; the whole file if it is smaller
+    int log_t = 0;
+    while (log_t < log_n && log_t + 1 + log_elem < (int)(8 * sizeof(size_t)) &&
+           (elem << (log_t + 1)) <= mem_bytes / 2) {
+        log_t++;
+    }
+    if (fd < 0 || log_n < 0 || log_n > FHT_LARGE_MAX_LOG_N ||
+        offset > (UINT64_MAX >> 1) - ((uint64_t)elem << log_n) || (log_t < log_n && log_t < 2)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    char *bufs[2];
+    bufs[0] = (char *)malloc(elem << log_t);
+    bufs[1] = log_t < log_n ? (char *)malloc(elem << log_t) : bufs[0];
+    if (bufs[0] == NULL || bufs[1] == NULL) {
+        free(bufs[0]);
+        if (bufs[1] != bufs[0]) {
+            free(bufs[1]);
+        }
+        errno = ENOMEM;
+        return -1;
+    }
+
+    // g is capped by the segment length and by fht_*_strided (log_n <= 30)
+    int log_seg = FILE_LOG_SEGMENT_BYTES - log_elem;
+    int g_max = log_t - (log_seg < log_t - 1 ? log_seg : log_t - 1);
+    if (g_max > 30) {
+        g_max = 30;
+    }
+    file_pass pass = {fd, offset, elem, log_t, 0, log_t};
+    int err = run_pass(&pass, bufs, (uint64_t)1 << (log_n - log_t), is_double, nthreads);
+    int s = log_t;
+    while (err == 0 && s < log_n) {
+        int passes_left = (log_n - s + g_max - 1) / g_max;
+        pass.s = s;
+        pass.g = (log_n - s + passes_left - 1) / passes_left;
+        pass.log_w = log_t - pass.g;
+        err = run_pass(&pass, bufs, (uint64_t)1 << (log_n - log_t), is_double, nthreads);
+        s += pass.g;
+    }
+
+    free(bufs[0]);
+    if (bufs[1] != bufs[0]) {
+        free(bufs[1]);
+    }
+    if (err != 0) {
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+int fht_float_file(int fd, uint64_t offset, int log_n, size_t mem_bytes, int nthreads) {
+    uint64_t t0 = fht_stats_begin();
+    int res = file_transform(fd, offset, log_n, mem_bytes, nthreads, 0);
+    fht_stats_end(t0, 0, FHT_STATS_FILE, log_n, 1);
+    return res;
+}
+
+int fht_double_file(int fd, uint64_t offset, int log_n, size_t mem_bytes, int nthreads) {
+    uint64_t t0 = fht_stats_begin();
+    int res = file_transform(fd, offset, log_n, mem_bytes, nthreads, 1);
+    fht_stats_end(t0, 1, FHT_STATS_FILE, log_n, 1);
+    return res;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
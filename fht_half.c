@@ -0,0 +1,287 @@
+// Transforms of 16-bit floats (IEEE fp16 and bfloat16) with fp32 arithmetic.
+//
+// DRAM traffic is what limits large transforms, and 16-bit storage halves it.
+// The data stays 16-bit in memory; each pass loads one cache block, widens
+// it to fp32, runs the butterflies there with the regular float kernel, and
+// rounds back once on the way out:
+//
+//   * the first pass transforms each contiguous block of 2^HALF_LOG_CHUNK;
+//   * every further pass gathers 2^g rows of the same offset range from
+//     blocks a stride apart and runs g cross-block stages on them
+//     (fht_float_combine_blocks).
+//
+// Up to 2^HALF_LOG_CHUNK elements that is a single rounding. 2^20 takes two
+// passes and 2^26 takes three.
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht.h"
+#include "fht_kernel.h"
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#  include <cpuid.h>
+#  define HALF_HAVE_F16C 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// fp32 staging block (16 KiB, sits in L1 next to the 16-bit source)
+#define HALF_LOG_CHUNK 12
+// Shortest contiguous run a gather pass reads (32 halves = one cache line)
+#define HALF_LOG_MIN_RUN 5
+
+typedef void (*widen_fn)(const uint16_t *in, float *out, size_t n);
+typedef void (*narrow_fn)(const float *in, uint16_t *out, size_t n);
+
+/* Portable conversions, round to nearest even */
+
+static float half_to_float(uint16_t h) {
+    uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    uint32_t exp = (h >> 10) & 0x1F;
+    uint32_t man = h & 0x3FF;
+    uint32_t bits;
+    if (exp == 0x1F) {
+        bits = sign | 0x7F800000 | (man << 13);
+    } else if (exp != 0) {
+        bits = sign | ((exp + 112) << 23) | (man << 13);
+    } else if (man == 0) {
+        bits = sign;
+    } else {
+        // Subnormal: normalize the mantissa
+        exp = 113;
+        while (!(man & 0x400)) {
+            man <<= 1;
+            exp--;
+        }
+        bits = sign | (exp << 23) | ((man & 0x3FF) << 13);
+    }
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static uint16_t float_to_half(float f) {
+    uint32_t x;
+    memcpy(&x, &f, sizeof(x));
+    uint16_t sign = (uint16_t)((x >> 16) & 0x8000);
+    uint32_t absx = x & 0x7FFFFFFF;
+
+    if (absx >= 0x7F800000) {  // inf, NaN (kept quiet)
+        return sign | 0x7C00 | (absx > 0x7F800000 ? 0x200 : 0);
+    }
+    if (absx >= 0x477FF000) {  // rounds to 65520 or more
+        return sign | 0x7C00;
+    }
+    if (absx < 0x38800000) {  // below 2^-14: subnormal or zero
+        if (absx <= 0x33000000) {
+            return sign;
+        }
+        uint32_t e = absx >> 23;
+        uint32_t m = (absx & 0x7FFFFF) | 0x800000;
+        uint32_t shift = 126 - e;
+        uint32_t r = m >> shift;
+        uint32_t rem = m & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rem > halfway || (rem == halfway && (r & 1))) {
+            r++;
+        }
+        return sign | (uint16_t)r;
+    }
+    uint32_t r = (absx - 0x38000000) >> 13;  // rebias the exponent
+    uint32_t rem = absx & 0x1FFF;
+    if (rem > 0x1000 || (rem == 0x1000 && (r & 1))) {
+        r++;
+    }
+    return sign | (uint16_t)r;
+}
+
+static void widen_half_scalar(const uint16_t *in, float *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = half_to_float(in[i]);
+    }
+}
+
+static void narrow_half_scalar(const float *in, uint16_t *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = float_to_half(in[i]);
+    }
+}
+
+// bf16 is the top half of an fp32, so these loops vectorize as they are
+static void widen_bf16(const uint16_t *in, float *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        uint32_t bits = (uint32_t)in[i] << 16;
+        memcpy(out + i, &bits, sizeof(bits));
+    }
+}
+
+static void narrow_bf16(const float *in, uint16_t *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        uint32_t x;
+        memcpy(&x, in + i, sizeof(x));
+        if ((x & 0x7FFFFFFF) > 0x7F800000) {
+            out[i] = (uint16_t)((x >> 16) | 0x40);  // quiet NaN
+        } else {
+            out[i] = (uint16_t)((x + 0x7FFF + ((x >> 16) & 1)) >> 16);
+        }
+    }
+}
+
+/* Hardware fp16 conversions */
+
+#if defined(HALF_HAVE_F16C)
+// The library is built for the baseline ISA; only these two functions use
+// F16C, and they are only called after cpuid reports it
+__attribute__((target("avx,f16c")))
+static void widen_half_f16c(const uint16_t *in, float *out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128((const __m128i *)(in + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+    }
+    widen_half_scalar(in + i, out + i, n - i);
+}
+
+__attribute__((target("avx,f16c")))
+static void narrow_half_f16c(const float *in, uint16_t *out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i *)(out + i), h);
+    }
+    narrow_half_scalar(in + i, out + i, n - i);
+}
+
+static int cpu_has_f16c(void) {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+    // F16C needs the OS to save ymm state, which the AVX check covers
+    __builtin_cpu_init();
+    return (ecx & bit_F16C) && __builtin_cpu_supports("avx");
+}
+#elif defined(__aarch64__)
+static void widen_half_neon(const uint16_t *in, float *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(out + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(in + i))));
+    }
+    widen_half_scalar(in + i, out + i, n - i);
+}
+
+static void narrow_half_neon(const float *in, uint16_t *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1_u16(out + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in + i))));
+    }
+    narrow_half_scalar(in + i, out + i, n - i);
+}
+#endif
+
+typedef struct {
+    widen_fn widen;
+    narrow_fn narrow;
+} half_codec;
+
+static const half_codec half_scalar = { widen_half_scalar, narrow_half_scalar };
+static const half_codec bf16_codec = { widen_bf16, narrow_bf16 };
+#if defined(HALF_HAVE_F16C)
+static const half_codec half_f16c = { widen_half_f16c, narrow_half_f16c };
+#elif defined(__aarch64__)
+static const half_codec half_neon = { widen_half_neon, narrow_half_neon };
+#endif
+
+static const half_codec *active_half = NULL;
+
+static const half_codec *get_half_codec(void) {
+    // Benign race: concurrent first callers all store the same pointer
+    if (active_half == NULL) {
+#if defined(HALF_HAVE_F16C)
+        active_half = cpu_has_f16c() ? &half_f16c : &half_scalar;
+#elif defined(__aarch64__)
+        active_half = &half_neon;
+#else
+        active_half = &half_scalar;
+#endif
+    }
+    return active_half;
+}
+
+static int transform16(uint16_t *buf, int log_n, const half_codec *codec) {
+    widen_fn widen = codec->widen;
+    narrow_fn narrow = codec->narrow;
+    float tile[1 << HALF_LOG_CHUNK];
+    size_t n = (size_t)1 << log_n;
+
+    if (log_n <= HALF_LOG_CHUNK) {
+        widen(buf, tile, n);
+        int res = fht_float(tile, log_n);
+        narrow(tile, buf, n);
+        return res;
+    }
+
+    size_t blk = (size_t)1 << HALF_LOG_CHUNK;
+    for (size_t b = 0; b < n; b += blk) {
+        widen(buf + b, tile, blk);
+        int res = fht_float(tile, HALF_LOG_CHUNK);
+        if (res) {
+            return res;
+        }
+        narrow(tile, buf + b, blk);
+    }
+
+    // Cross-block stages, up to HALF_LOG_CHUNK - HALF_LOG_MIN_RUN per pass
+    int total = log_n - HALF_LOG_CHUNK;
+    for (int done = 0; done < total;) {
+        int g = total - done;
+        if (g > HALF_LOG_CHUNK - HALF_LOG_MIN_RUN) {
+            g = HALF_LOG_CHUNK - HALF_LOG_MIN_RUN;
+        }
+        size_t stride = blk << done;   // distance between partner rows
+        size_t run = blk >> g;         // contiguous elements per row
+        size_t rows = (size_t)1 << g;
+        for (size_t base = 0; base < n; base += stride << g) {
+            for (size_t off = 0; off < stride; off += run) {
+                for (size_t r = 0; r < rows; r++) {
+                    widen(buf + base + off + r * stride, tile + r * run, run);
+                }
+                int res = fht_float_combine_blocks(tile, HALF_LOG_CHUNK, g, 0, run);
+                if (res) {
+                    return res;
+                }
+                for (size_t r = 0; r < rows; r++) {
+                    narrow(tile + r * run, buf + base + off + r * stride, run);
+                }
+            }
+        }
+        done += g;
+    }
+    return 0;
+}
+
+int fht_half(uint16_t *buf, int log_n) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    uint64_t t0 = fht_stats_begin();
+    int res = transform16(buf, log_n, get_half_codec());
+    fht_stats_end(t0, FHT_STATS_F16, FHT_STATS_INPLACE, log_n, 1);
+    return res;
+}
+
+int fht_bf16(uint16_t *buf, int log_n) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    uint64_t t0 = fht_stats_begin();
+    int res = transform16(buf, log_n, &bf16_codec);
+    fht_stats_end(t0, FHT_STATS_BF16, FHT_STATS_INPLACE, log_n, 1);
+    return res;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,512 @@
+// Exact integer Walsh-Hadamard transforms (int16/int32/int64).
+//
+// Same structure as the float kernels: an iterative pass over L1-sized
+// chunks (stages inside a vector by swap + blend, the rest as radix-4 passes
+// of whole vectors) and a recursive radix-2 combine above the chunk.
+//
+// int32/int64 wrap modulo 2^32/2^64, so results are exact whenever they fit
+// and exact modulo the word size otherwise (e.g. for {-1, 1} inputs int32 is
+// exact up to log_n 30). int16 saturates at every stage and reports it.
+//
+// The vector width is 128 bits (SSE2 on x86, the baseline, and NEON), so an
+// int16 register holds four times as many elements as a double one.
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht.h"
+#include "fht_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bytes of one iterative chunk; larger sizes recurse
+#define INT_LOG_CHUNK_BYTES 15
+
+static inline int16_t sat16(int32_t x, int *overflow) {
+    if (x > INT16_MAX) {
+        *overflow = 1;
+        return INT16_MAX;
+    }
+    if (x < INT16_MIN) {
+        *overflow = 1;
+        return INT16_MIN;
+    }
+    return (int16_t)x;
+}
+
+static inline int32_t wrap32(uint32_t x) {
+    return (int32_t)x;
+}
+
+static inline int64_t wrap64(uint64_t x) {
+    return (int64_t)x;
+}
+
+/*
+ * Vector layer: load/store/add/sub per element type, plus stage(v, h), one
+ * butterfly stage of stride h < lanes inside a register. stage swaps the
+ * partners with a shuffle and keeps a + b in the low lanes of each pair and
+ * b - a in the high ones.
+ */
+#if defined(__SSE2__)
+
+#define I16_LOG_LANES 3
+#define I32_LOG_LANES 2
+#define I64_LOG_LANES 1
+typedef __m128i vi16;
+typedef __m128i vi32;
+typedef __m128i vi64;
+
+static inline __m128i vi_load(const void *p) { return _mm_loadu_si128((const __m128i *)p); }
+static inline void vi_store(void *p, __m128i v) { _mm_storeu_si128((__m128i *)p, v); }
+// mask ? a : b
+static inline __m128i vi_blend(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+#define i16_load(p) vi_load(p)
+#define i16_store(p, v) vi_store(p, v)
+#define i32_load(p) vi_load(p)
+#define i32_store(p, v) vi_store(p, v)
+#define i64_load(p) vi_load(p)
+#define i64_store(p, v) vi_store(p, v)
+#define i32_add _mm_add_epi32
+#define i32_sub _mm_sub_epi32
+#define i64_add _mm_add_epi64
+#define i64_sub _mm_sub_epi64
+
+// Saturating, and records in *flag the lanes where saturation changed the result
+static inline __m128i i16_add(__m128i a, __m128i b, __m128i *flag) {
+    __m128i s = _mm_adds_epi16(a, b);
+    *flag = _mm_or_si128(*flag, _mm_xor_si128(s, _mm_add_epi16(a, b)));
+    return s;
+}
+
+static inline __m128i i16_sub(__m128i a, __m128i b, __m128i *flag) {
+    __m128i s = _mm_subs_epi16(a, b);
+    *flag = _mm_or_si128(*flag, _mm_xor_si128(s, _mm_sub_epi16(a, b)));
+    return s;
+}
+
+static inline __m128i i16_zero(void) { return _mm_setzero_si128(); }
+
+static inline int i16_any(__m128i flag) {
+    return _mm_movemask_epi8(_mm_cmpeq_epi16(flag, _mm_setzero_si128())) != 0xFFFF;
+}
+
+static inline __m128i i16_stage(__m128i v, int h, __m128i *flag) {
+    __m128i w, mask;
+    if (h == 1) {
+        w = _mm_or_si128(_mm_slli_epi32(v, 16), _mm_srli_epi32(v, 16));
+        mask = _mm_set_epi16(-1, 0, -1, 0, -1, 0, -1, 0);
+    } else if (h == 2) {
+        w = _mm_shuffle_epi32(v, 0xB1);
+        mask = _mm_set_epi16(-1, -1, 0, 0, -1, -1, 0, 0);
+    } else {
+        w = _mm_shuffle_epi32(v, 0x4E);
+        mask = _mm_set_epi16(-1, -1, -1, -1, 0, 0, 0, 0);
+    }
+    // Only the flags of the kept lanes count: b - a can clip where a - b does not
+    __m128i fs = _mm_setzero_si128(), fa = _mm_setzero_si128();
+    __m128i r = vi_blend(mask, i16_sub(w, v, &fs), i16_add(v, w, &fa));
+    *flag = _mm_or_si128(*flag, vi_blend(mask, fs, fa));
+    return r;
+}
+
+static inline __m128i i32_stage(__m128i v, int h) {
+    if (h == 1) {
+        __m128i w = _mm_shuffle_epi32(v, 0xB1);
+        return vi_blend(_mm_set_epi32(-1, 0, -1, 0), _mm_sub_epi32(w, v), _mm_add_epi32(v, w));
+    }
+    __m128i w = _mm_shuffle_epi32(v, 0x4E);
+    return vi_blend(_mm_set_epi32(-1, -1, 0, 0), _mm_sub_epi32(w, v), _mm_add_epi32(v, w));
+}
+
+static inline __m128i i64_stage(__m128i v, int h) {
+    (void)h;
+    __m128i w = _mm_shuffle_epi32(v, 0x4E);
+    return vi_blend(_mm_set_epi32(-1, -1, 0, 0), _mm_sub_epi64(w, v), _mm_add_epi64(v, w));
+}
+
+#elif defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+#define I16_LOG_LANES 3
+#define I32_LOG_LANES 2
+#define I64_LOG_LANES 1
+typedef int16x8_t vi16;
+typedef int32x4_t vi32;
+typedef int64x2_t vi64;
+
+#define i16_load(p) vld1q_s16(p)
+#define i16_store(p, v) vst1q_s16(p, v)
+#define i32_load(p) vld1q_s32(p)
+#define i32_store(p, v) vst1q_s32(p, v)
+#define i64_load(p) vld1q_s64(p)
+#define i64_store(p, v) vst1q_s64(p, v)
+#define i32_add vaddq_s32
+#define i32_sub vsubq_s32
+#define i64_add vaddq_s64
+#define i64_sub vsubq_s64
+
+static inline int16x8_t i16_add(int16x8_t a, int16x8_t b, int16x8_t *flag) {
+    int16x8_t s = vqaddq_s16(a, b);
+    *flag = vorrq_s16(*flag, veorq_s16(s, vaddq_s16(a, b)));
+    return s;
+}
+
+static inline int16x8_t i16_sub(int16x8_t a, int16x8_t b, int16x8_t *flag) {
+    int16x8_t s = vqsubq_s16(a, b);
+    *flag = vorrq_s16(*flag, veorq_s16(s, vsubq_s16(a, b)));
+    return s;
+}
+
+static inline int16x8_t i16_zero(void) { return vdupq_n_s16(0); }
+
+static inline int i16_any(int16x8_t flag) {
+    int16_t lanes[8];
+    vst1q_s16(lanes, flag);
+    int any = 0;
+    for (int i = 0; i < 8; i++) {
+        any |= lanes[i];
+    }
+    return any != 0;
+}
+
+static const uint16_t i16_masks[3][8] = {
+    {0, 0xFFFF, 0, 0xFFFF, 0, 0xFFFF, 0, 0xFFFF},
+    {0, 0, 0xFFFF, 0xFFFF, 0, 0, 0xFFFF, 0xFFFF},
+    {0, 0, 0, 0, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF},
+};
+static const uint32_t i32_masks[2][4] = {
+    {0, 0xFFFFFFFFu, 0, 0xFFFFFFFFu},
+    {0, 0, 0xFFFFFFFFu, 0xFFFFFFFFu},
+};
+static const uint64_t i64_mask[2] = {0, ~(uint64_t)0};
+
+static inline int16x8_t i16_stage(int16x8_t v, int h, int16x8_t *flag) {
+    int16x8_t w;
+    uint16x8_t mask;
+    if (h == 1) {
+        w = vrev32q_s16(v);
+        mask = vld1q_u16(i16_masks[0]);
+    } else if (h == 2) {
+        w = vreinterpretq_s16_s32(vrev64q_s32(vreinterpretq_s32_s16(v)));
+        mask = vld1q_u16(i16_masks[1]);
+    } else {
+        w = vextq_s16(v, v, 4);
+        mask = vld1q_u16(i16_masks[2]);
+    }
+    int16x8_t fs = vdupq_n_s16(0), fa = vdupq_n_s16(0);
+    int16x8_t r = vbslq_s16(mask, i16_sub(w, v, &fs), i16_add(v, w, &fa));
+    *flag = vorrq_s16(*flag, vbslq_s16(mask, fs, fa));
+    return r;
+}
+
+static inline int32x4_t i32_stage(int32x4_t v, int h) {
+    if (h == 1) {
+        int32x4_t w = vrev64q_s32(v);
+        return vbslq_s32(vld1q_u32(i32_masks[0]), vsubq_s32(w, v), vaddq_s32(v, w));
+    }
+    int32x4_t w = vextq_s32(v, v, 2);
+    return vbslq_s32(vld1q_u32(i32_masks[1]), vsubq_s32(w, v), vaddq_s32(v, w));
+}
+
+static inline int64x2_t i64_stage(int64x2_t v, int h) {
+    (void)h;
+    int64x2_t w = vextq_s64(v, v, 1);
+    return vbslq_s64(vld1q_u64(i64_mask), vsubq_s64(w, v), vaddq_s64(v, w));
+}
+
+#else
+
+// Portable fallback: one element per "vector", no in-register stages
+#define I16_LOG_LANES 0
+#define I32_LOG_LANES 0
+#define I64_LOG_LANES 0
+typedef int16_t vi16;
+typedef int32_t vi32;
+typedef int64_t vi64;
+
+#define i16_load(p) (*(p))
+#define i16_store(p, v) (*(p) = (v))
+#define i32_load(p) (*(p))
+#define i32_store(p, v) (*(p) = (v))
+#define i64_load(p) (*(p))
+#define i64_store(p, v) (*(p) = (v))
+
+static inline int32_t i32_add(int32_t a, int32_t b) { return wrap32((uint32_t)a + (uint32_t)b); }
+static inline int32_t i32_sub(int32_t a, int32_t b) { return wrap32((uint32_t)a - (uint32_t)b); }
+static inline int64_t i64_add(int64_t a, int64_t b) { return wrap64((uint64_t)a + (uint64_t)b); }
+static inline int64_t i64_sub(int64_t a, int64_t b) { return wrap64((uint64_t)a - (uint64_t)b); }
+
+static inline int16_t i16_add(int16_t a, int16_t b, int16_t *flag) {
+    int overflow = 0;
+    int16_t s = sat16((int32_t)a + b, &overflow);
+    *flag |= (int16_t)overflow;
+    return s;
+}
+
+static inline int16_t i16_sub(int16_t a, int16_t b, int16_t *flag) {
+    int overflow = 0;
+    int16_t s = sat16((int32_t)a - b, &overflow);
+    *flag |= (int16_t)overflow;
+    return s;
+}
+
+static inline int16_t i16_zero(void) { return 0; }
+static inline int i16_any(int16_t flag) { return flag != 0; }
+static inline int16_t i16_stage(int16_t v, int h, int16_t *flag) { (void)h; (void)flag; return v; }
+static inline int32_t i32_stage(int32_t v, int h) { (void)h; return v; }
+static inline int64_t i64_stage(int64_t v, int h) { (void)h; return v; }
+
+#endif
+
+#define I16_LANES (1 << I16_LOG_LANES)
+#define I32_LANES (1 << I32_LOG_LANES)
+#define I64_LANES (1 << I64_LOG_LANES)
+
+/* Scalar transform, for sizes below one vector */
+
+static int scalar_int16(int16_t *buf, size_t n) {
+    int overflow = 0;
+    for (size_t h = 1; h < n; h <<= 1) {
+        for (size_t i = 0; i < n; i += 2 * h) {
+            for (size_t j = i; j < i + h; j++) {
+                int32_t u = buf[j], v = buf[j + h];
+                buf[j] = sat16(u + v, &overflow);
+                buf[j + h] = sat16(u - v, &overflow);
+            }
+        }
+    }
+    return overflow;
+}
+
+static void scalar_int32(int32_t *buf, size_t n) {
+    for (size_t h = 1; h < n; h <<= 1) {
+        for (size_t i = 0; i < n; i += 2 * h) {
+            for (size_t j = i; j < i + h; j++) {
+                uint32_t u = (uint32_t)buf[j], v = (uint32_t)buf[j + h];
+                buf[j] = wrap32(u + v);
+                buf[j + h] = wrap32(u - v);
+            }
+        }
+    }
+}
+
+static void scalar_int64(int64_t *buf, size_t n) {
+    for (size_t h = 1; h < n; h <<= 1) {
+        for (size_t i = 0; i < n; i += 2 * h) {
+            for (size_t j = i; j < i + h; j++) {
+                uint64_t u = (uint64_t)buf[j], v = (uint64_t)buf[j + h];
+                buf[j] = wrap64(u + v);
+                buf[j + h] = wrap64(u - v);
+            }
+        }
+    }
+}
+
+/*
+ * Iterative transform of one chunk (n >= lanes): in-register stages first,
+ * then radix-4 passes over whole vectors, and one radix-2 pass if the number
+ * of remaining stages is odd.
+ */
+
+static void iterative_int32(int32_t *buf, int log_n) {
+    size_t n = (size_t)1 << log_n;
+    for (size_t i = 0; i < n; i += I32_LANES) {
+        vi32 v = i32_load(buf + i);
+        for (int h = 1; h < I32_LANES; h <<= 1) {
+            v = i32_stage(v, h);
+        }
+        i32_store(buf + i, v);
+    }
+    size_t h = I32_LANES;
+    for (; 4 * h <= n; h *= 4) {
+        for (size_t i = 0; i < n; i += 4 * h) {
+            for (size_t j = i; j < i + h; j += I32_LANES) {
+                vi32 a = i32_load(buf + j), b = i32_load(buf + j + h);
+                vi32 c = i32_load(buf + j + 2 * h), d = i32_load(buf + j + 3 * h);
+                vi32 s0 = i32_add(a, b), d0 = i32_sub(a, b);
+                vi32 s1 = i32_add(c, d), d1 = i32_sub(c, d);
+                i32_store(buf + j, i32_add(s0, s1));
+                i32_store(buf + j + h, i32_add(d0, d1));
+                i32_store(buf + j + 2 * h, i32_sub(s0, s1));
+                i32_store(buf + j + 3 * h, i32_sub(d0, d1));
+            }
+        }
+    }
+    if (h < n) {
+        for (size_t j = 0; j < h; j += I32_LANES) {
+            vi32 a = i32_load(buf + j), b = i32_load(buf + j + h);
+            i32_store(buf + j, i32_add(a, b));
+            i32_store(buf + j + h, i32_sub(a, b));
+        }
+    }
+}
+
+static void iterative_int64(int64_t *buf, int log_n) {
+    size_t n = (size_t)1 << log_n;
+    for (size_t i = 0; i < n; i += I64_LANES) {
+        vi64 v = i64_load(buf + i);
+        for (int h = 1; h < I64_LANES; h <<= 1) {
+            v = i64_stage(v, h);
+        }
+        i64_store(buf + i, v);
+    }
+    size_t h = I64_LANES;
+    for (; 4 * h <= n; h *= 4) {
+        for (size_t i = 0; i < n; i += 4 * h) {
+            for (size_t j = i; j < i + h; j += I64_LANES) {
+                vi64 a = i64_load(buf + j), b = i64_load(buf + j + h);
+                vi64 c = i64_load(buf + j + 2 * h), d = i64_load(buf + j + 3 * h);
+                vi64 s0 = i64_add(a, b), d0 = i64_sub(a, b);
+                vi64 s1 = i64_add(c, d), d1 = i64_sub(c, d);
+                i64_store(buf + j, i64_add(s0, s1));
+                i64_store(buf + j + h, i64_add(d0, d1));
+                i64_store(buf + j + 2 * h, i64_sub(s0, s1));
+                i64_store(buf + j + 3 * h, i64_sub(d0, d1));
+            }
+        }
+    }
+    if (h < n) {
+        for (size_t j = 0; j < h; j += I64_LANES) {
+            vi64 a = i64_load(buf + j), b = i64_load(buf + j + h);
+            i64_store(buf + j, i64_add(a, b));
+            i64_store(buf + j + h, i64_sub(a, b));
+        }
+    }
+}
+
+// Saturating: the order of the stages matters once values clip, so int16
+// keeps the natural order (stride 1 first) rather than radix-4 passes.
+static void iterative_int16(int16_t *buf, int log_n, vi16 *flag) {
+    size_t n = (size_t)1 << log_n;
+    for (size_t i = 0; i < n; i += I16_LANES) {
+        vi16 v = i16_load(buf + i);
+        for (int h = 1; h < I16_LANES; h <<= 1) {
+            v = i16_stage(v, h, flag);
+        }
+        i16_store(buf + i, v);
+    }
+    for (size_t h = I16_LANES; h < n; h <<= 1) {
+        for (size_t i = 0; i < n; i += 2 * h) {
+            for (size_t j = i; j < i + h; j += I16_LANES) {
+                vi16 a = i16_load(buf + j), b = i16_load(buf + j + h);
+                i16_store(buf + j, i16_add(a, b, flag));
+                i16_store(buf + j + h, i16_sub(a, b, flag));
+            }
+        }
+    }
+}
+
+/* Above the chunk: transform both halves, then one radix-2 stage across them */
+
+static void recursive_int32(int32_t *buf, int log_n) {
+    if (log_n <= INT_LOG_CHUNK_BYTES - 2) {
+        iterative_int32(buf, log_n);
+        return;
+    }
+    size_t half = (size_t)1 << (log_n - 1);
+    recursive_int32(buf, log_n - 1);
+    recursive_int32(buf + half, log_n - 1);
+    for (size_t j = 0; j < half; j += I32_LANES) {
+        vi32 a = i32_load(buf + j), b = i32_load(buf + j + half);
+        i32_store(buf + j, i32_add(a, b));
+        i32_store(buf + j + half, i32_sub(a, b));
+    }
+}
+
+static void recursive_int64(int64_t *buf, int log_n) {
+    if (log_n <= INT_LOG_CHUNK_BYTES - 3) {
+        iterative_int64(buf, log_n);
+        return;
+    }
+    size_t half = (size_t)1 << (log_n - 1);
+    recursive_int64(buf, log_n - 1);
+    recursive_int64(buf + half, log_n - 1);
+    for (size_t j = 0; j < half; j += I64_LANES) {
+        vi64 a = i64_load(buf + j), b = i64_load(buf + j + half);
+        i64_store(buf + j, i64_add(a, b));
+        i64_store(buf + j + half, i64_sub(a, b));
+    }
+}
+
+static void recursive_int16(int16_t *buf, int log_n, vi16 *flag) {
+    if (log_n <= INT_LOG_CHUNK_BYTES - 1) {
+        iterative_int16(buf, log_n, flag);
+        return;
+    }
+    size_t half = (size_t)1 << (log_n - 1);
+    recursive_int16(buf, log_n - 1, flag);
+    recursive_int16(buf + half, log_n - 1, flag);
+    for (size_t j = 0; j < half; j += I16_LANES) {
+        vi16 a = i16_load(buf + j), b = i16_load(buf + j + half);
+        i16_store(buf + j, i16_add(a, b, flag));
+        i16_store(buf + j + half, i16_sub(a, b, flag));
+    }
+}
+
+static int int16_inplace(int16_t *buf, int log_n) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (log_n < I16_LOG_LANES) {
+        return scalar_int16(buf, (size_t)1 << log_n);
+    }
+    vi16 flag = i16_zero();
+    recursive_int16(buf, log_n, &flag);
+    return i16_any(flag);
+}
+
+static int int32_inplace(int32_t *buf, int log_n) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (log_n < I32_LOG_LANES) {
+        scalar_int32(buf, (size_t)1 << log_n);
+    } else {
+        recursive_int32(buf, log_n);
+    }
+    return 0;
+}
+
+static int int64_inplace(int64_t *buf, int log_n) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (log_n < I64_LOG_LANES) {
+        scalar_int64(buf, (size_t)1 << log_n);
+    } else {
+        recursive_int64(buf, log_n);
+    }
+    return 0;
+}
+
+int fht_int16(int16_t *buf, int log_n) {
+    uint64_t t0 = fht_stats_begin();
+    int res = int16_inplace(buf, log_n);
+    fht_stats_end(t0, FHT_STATS_I16, FHT_STATS_INPLACE, log_n, 1);
+    return res;
+}
+
+int fht_int32(int32_t *buf, int log_n) {
+    uint64_t t0 = fht_stats_begin();
+    int res = int32_inplace(buf, log_n);
+    fht_stats_end(t0, FHT_STATS_I32, FHT_STATS_INPLACE, log_n, 1);
+    return res;
+}
+
+int fht_int64(int64_t *buf, int log_n) {
+    uint64_t t0 = fht_stats_begin();
+    int res = int64_inplace(buf, log_n);
+    fht_stats_end(t0, FHT_STATS_I64, FHT_STATS_INPLACE, log_n, 1);
+    return res;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
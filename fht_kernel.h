@@ -0,0 +1,118 @@
+#ifndef _FHT_KERNEL_H_
+#define _FHT_KERNEL_H_
+
+/*
+ * Internal interface between the runtime dispatcher in fht.c and the SIMD
+ * backends. Every backend is compiled in its own translation unit (the FFHT
+ * generated kernels all use the same static helper names) and exports one
+ * table of entry points. Nothing in here is part of the public API.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct fht_kernel {
+    const char *name;
+    int (*float_fn)(float *buf, int log_n);
+    int (*double_fn)(double *buf, int log_n);
+    // Optional: transform `count` vectors spaced `stride` elements apart.
+    // Arguments are already validated. NULL means fht.c loops over float_fn.
+    int (*float_batch_fn)(float *buf, int log_n, size_t count, size_t stride);
+    int (*double_batch_fn)(double *buf, int log_n, size_t count, size_t stride);
+} fht_kernel;
+
+#if (defined(__x86_64__) || defined(__i386__))
+extern const fht_kernel fht_kernel_avx512;
+extern const fht_kernel fht_kernel_avx;
+extern const fht_kernel fht_kernel_sse;
+#elif (defined(__aarch64__) || defined(__ARM_NEON))
+extern const fht_kernel fht_kernel_neon;
+#endif
+
+// SVE (fht_sve.c) needs a compiler that can target it per translation unit:
+// GCC 10+, or any compiler when the whole build already enables SVE
+#if defined(__aarch64__) && defined(__linux__) && \
+    (defined(__ARM_FEATURE_SVE) || (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 10))
+#  define FHT_HAVE_SVE 1
+extern const fht_kernel fht_kernel_sve;
+// Hardware vector length; call only when HWCAP reports SVE
+int fht_sve_vector_bytes(void);
+#endif
+
+// Kernel by name, NULL if unknown or not supported by this CPU (fht.c)
+const fht_kernel *fht_find_kernel(const char *name);
+// The kernel FFHT_KERNEL or fht_select_kernel forced, NULL if none (fht.c)
+const fht_kernel *fht_forced_kernel(void);
+
+// Tuned settings of one (dtype, log_n), filled by fht_tune or
+// fht_wisdom_load (fht_wisdom.c). A NULL kernel means no entry; threads and
+// log_blocks 0 leave the fht_mt.c defaults.
+typedef struct fht_wisdom_entry {
+    const fht_kernel *kernel;
+    int threads;
+    int log_blocks;
+} fht_wisdom_entry;
+
+// Indexed [is_double][log_n]
+extern fht_wisdom_entry fht_wisdom[2][31];
+
+// Cross-block split fht_mt.c uses without wisdom
+int fht_mt_default_log_blocks(int log_n, int nthreads);
+
+// Instrumentation hooks (fht_stats.c). An entry point brackets its work with
+//
+//   uint64_t t0 = fht_stats_begin();
+//   ...
+//   fht_stats_end(t0, FHT_STATS_<DTYPE>, FHT_STATS_<ENTRY>, log_n, vectors);
+//
+// where `vectors` counts the 2^log_n-element buffers it touches, and an
+// is_double flag serves as the dtype of the float/double entry points. t0 is
+// 0 when nothing is recorded, which is all the disabled path costs: calls an
+// entry point makes to others see t0 == 0 and stay out of the counts.
+#ifndef FFHT_NO_STATS
+extern int fht_stats_active;
+uint64_t fht_stats_start(void);
+void fht_stats_stop(uint64_t t0, int dtype, int entry, int log_n, size_t count);
+// Record nothing on the calling thread from now on (fht_mt.c workers)
+void fht_stats_ignore_thread(void);
+// Record nothing on the calling thread until the matching resume; other
+// threads keep counting (fht_tune)
+void fht_stats_suspend_thread(void);
+void fht_stats_resume_thread(void);
+
+static inline uint64_t fht_stats_begin(void) {
+    return fht_stats_active ? fht_stats_start() : 0;
+}
+
+static inline void fht_stats_end(uint64_t t0, int dtype, int entry, int log_n, size_t count) {
+    if (t0 != 0) {
+        fht_stats_stop(t0, dtype, entry, log_n, count);
+    }
+}
+#else
+static inline uint64_t fht_stats_begin(void) {
+    return 0;
+}
+
+static inline void fht_stats_end(uint64_t t0, int dtype, int entry, int log_n, size_t count) {
+    (void)t0;
+    (void)dtype;
+    (void)entry;
+    (void)log_n;
+    (void)count;
+}
+
+static inline void fht_stats_ignore_thread(void) {}
+static inline void fht_stats_suspend_thread(void) {}
+static inline void fht_stats_resume_thread(void) {}
+#endif
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
@@ -0,0 +1,44 @@
+/* AVX backend: the FFHT generated kernel exported under a backend-specific name */
+#if (defined(__x86_64__) || defined(__i386__))
+
+/*
+ * The library is built for the baseline ISA; only this translation unit is
+ * allowed to emit AVX, and fht.c calls into it after cpuid reports AVX.
+ */
+#if defined(__clang__)
+#  pragma clang attribute push (__attribute__((target("avx"))), apply_to = function)
+#elif defined(__GNUC__)
+#  pragma GCC target("avx")
+#endif
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+
+#include "fht.h"
+#include "fht_kernel.h"
+
+int fht_float_avx(float *buf, int log_n);
+int fht_double_avx(double *buf, int log_n);
+
+#define fht_float fht_float_avx
+#define fht_double fht_double_avx
+#include "fht_avx.c"
+#undef fht_float
+#undef fht_double
+
+#if defined(__clang__)
+#  pragma clang attribute pop
+#endif
+
+const fht_kernel fht_kernel_avx = {
+    "avx",
+    fht_float_avx,
+    fht_double_avx,
+    NULL,
+    NULL,
+};
+
+#else
+typedef int fht_kernel_avx_unused;  // ISO C forbids an empty translation unit
+#endif
@@ -0,0 +1,355 @@
+/* AVX-512F backend, hand-written like fht_neon.c (FFHT has no 512-bit kernel) */
+#if (defined(__x86_64__) || defined(__i386__))
+
+/*
+ * As for fht_kernel_avx.c, only this translation unit emits AVX-512, and
+ * fht.c calls into it after cpuid reports AVX-512F.
+ */
+#if defined(__clang__)
+#  pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#  pragma GCC target("avx512f")
+#endif
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+
+#include "fht.h"
+#include "fht_kernel.h"
+#include <immintrin.h>
+
+/*
+ * Layout of the kernel, per 2^FHT_AVX512_LOG_CHUNK_* block (16 KiB, inside
+ * L1):
+ *
+ * - the first pass loads up to 16 zmm registers of consecutive elements,
+ *   runs the stages inside each register (strides 1-8 for float, 1-4 for
+ *   double) and then up to four stages across the registers, so 8 (float)
+ *   or 7 (double) stages cost one load and one store per element;
+ * - each further pass runs four stages at once on 16 registers loaded
+ *   `h` elements apart, with a radix-8/4/2 pass for what is left.
+ *
+ * In-register stages swap the partner lanes with one in-lane permute or
+ * 128-bit lane shuffle, and a masked subtract writes the differences into
+ * the upper lanes. Vectors shorter than a register use masked loads and
+ * stores, so there are no scalar tails. Above the chunk the recursion
+ * splits into eighths and joins them with one radix-8 pass.
+ */
+#ifndef FHT_AVX512_LOG_CHUNK_FLOAT
+#  define FHT_AVX512_LOG_CHUNK_FLOAT 12
+#endif
+#ifndef FHT_AVX512_LOG_CHUNK_DOUBLE
+#  define FHT_AVX512_LOG_CHUNK_DOUBLE 11
+#endif
+
+/* Register lists */
+#define FOR2(X) X(0) X(1)
+#define FOR4(X) FOR2(X) X(2) X(3)
+#define FOR8(X) FOR4(X) X(4) X(5) X(6) X(7)
+#define FOR16(X) FOR8(X) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15)
+
+/* Stages across registers r[0..2^k), butterflies on whole registers */
+#define RADIX2(BF, r) BF(r[0], r[1])
+#define RADIX4(BF, r) \
+    BF(r[0], r[1]); BF(r[2], r[3]); \
+    BF(r[0], r[2]); BF(r[1], r[3])
+#define RADIX8(BF, r) \
+    BF(r[0], r[1]); BF(r[2], r[3]); BF(r[4], r[5]); BF(r[6], r[7]); \
+    BF(r[0], r[2]); BF(r[1], r[3]); BF(r[4], r[6]); BF(r[5], r[7]); \
+    BF(r[0], r[4]); BF(r[1], r[5]); BF(r[2], r[6]); BF(r[3], r[7])
+#define RADIX16(BF, r) \
+    BF(r[0], r[1]); BF(r[2], r[3]); BF(r[4], r[5]); BF(r[6], r[7]); \
+    BF(r[8], r[9]); BF(r[10], r[11]); BF(r[12], r[13]); BF(r[14], r[15]); \
+    BF(r[0], r[2]); BF(r[1], r[3]); BF(r[4], r[6]); BF(r[5], r[7]); \
+    BF(r[8], r[10]); BF(r[9], r[11]); BF(r[12], r[14]); BF(r[13], r[15]); \
+    BF(r[0], r[4]); BF(r[1], r[5]); BF(r[2], r[6]); BF(r[3], r[7]); \
+    BF(r[8], r[12]); BF(r[9], r[13]); BF(r[10], r[14]); BF(r[11], r[15]); \
+    BF(r[0], r[8]); BF(r[1], r[9]); BF(r[2], r[10]); BF(r[3], r[11]); \
+    BF(r[4], r[12]); BF(r[5], r[13]); BF(r[6], r[14]); BF(r[7], r[15])
+
+/* Butterfly between two registers */
+#define BUTTERFLY_PS(a, b) do { \
+    __m512 _s = _mm512_add_ps(a, b); \
+    b = _mm512_sub_ps(a, b); \
+    a = _s; \
+} while (0)
+
+/* One stage inside a register: `p` holds every lane's partner, `high` marks
+ * the lanes that take the difference */
+static inline __m512 stage_in_reg_ps(__m512 v, __m512 p, __mmask16 high) {
+    return _mm512_mask_sub_ps(_mm512_add_ps(v, p), high, p, v);
+}
+
+/* The first `stages` (at most 4) stages of every 16-float group */
+static inline __m512 stages_in_reg_ps(__m512 v, int stages) {
+    if (stages > 0) v = stage_in_reg_ps(v, _mm512_permute_ps(v, 0xB1), 0xAAAA);
+    if (stages > 1) v = stage_in_reg_ps(v, _mm512_permute_ps(v, 0x4E), 0xCCCC);
+    if (stages > 2) v = stage_in_reg_ps(v, _mm512_shuffle_f32x4(v, v, 0xB1), 0xF0F0);
+    if (stages > 3) v = stage_in_reg_ps(v, _mm512_shuffle_f32x4(v, v, 0x4E), 0xFF00);
+    return v;
+}
+
+/* Vectors of at most 16 floats: one masked register */
+static inline void small_float(float *buf, int log_n) {
+    __mmask16 m = (__mmask16)((1u << (1 << log_n)) - 1);
+    __m512 v = _mm512_maskz_loadu_ps(m, buf);
+    _mm512_mask_storeu_ps(buf, m, stages_in_reg_ps(v, log_n));
+}
+
+/* First pass: stages 1-4 in every register, then log(nr) stages across nr
+ * consecutive registers */
+#define LOAD_PS(i) r[i] = stages_in_reg_ps(_mm512_loadu_ps(p + 16 * (i)), 4);
+#define STORE_PS(i) _mm512_storeu_ps(p + 16 * (i), r[i]);
+static inline void pass_float_first(float *buf, size_t n, int log_regs) {
+    __m512 r[16];
+    for (size_t i = 0; i < n; i += (size_t)16 << log_regs) {
+        float *p = buf + i;
+        switch (log_regs) {
+            case 1: FOR2(LOAD_PS) RADIX2(BUTTERFLY_PS, r); FOR2(STORE_PS) break;
+            case 2: FOR4(LOAD_PS) RADIX4(BUTTERFLY_PS, r); FOR4(STORE_PS) break;
+            case 3: FOR8(LOAD_PS) RADIX8(BUTTERFLY_PS, r); FOR8(STORE_PS) break;
+            default: FOR16(LOAD_PS) RADIX16(BUTTERFLY_PS, r); FOR16(STORE_PS) break;
+        }
+    }
+}
+#undef LOAD_PS
+#undef STORE_PS
+
+/* Later passes: log_radix stages (strides h .. h << (log_radix - 1)) per
+ * load/store of 2^log_radix registers `h` floats apart */
+#define LOAD_PS(i) r[i] = _mm512_loadu_ps(p + (i) * h);
+#define STORE_PS(i) _mm512_storeu_ps(p + (i) * h, r[i]);
+static inline void pass_float(float *buf, size_t n, size_t h, int log_radix) {
+    __m512 r[16];
+    for (size_t base = 0; base < n; base += h << log_radix) {
+        for (size_t j = base; j < base + h; j += 16) {
+            float *p = buf + j;
+            switch (log_radix) {
+                case 1: FOR2(LOAD_PS) RADIX2(BUTTERFLY_PS, r); FOR2(STORE_PS) break;
+                case 2: FOR4(LOAD_PS) RADIX4(BUTTERFLY_PS, r); FOR4(STORE_PS) break;
+                case 3: FOR8(LOAD_PS) RADIX8(BUTTERFLY_PS, r); FOR8(STORE_PS) break;
+                default: FOR16(LOAD_PS) RADIX16(BUTTERFLY_PS, r); FOR16(STORE_PS) break;
+            }
+        }
+    }
+}
+#undef LOAD_PS
+#undef STORE_PS
+
+/* L1-resident blocks, 5 <= log_n <= FHT_AVX512_LOG_CHUNK_FLOAT */
+static void helper_float_iterative(float *buf, int log_n) {
+    size_t n = (size_t)1 << log_n;
+    int log_regs = log_n - 4 < 4 ? log_n - 4 : 4;
+    int stage = 4 + log_regs;
+
+    pass_float_first(buf, n, log_regs);
+    for (; stage + 4 <= log_n; stage += 4) {
+        pass_float(buf, n, (size_t)1 << stage, 4);
+    }
+    if (stage < log_n) {
+        pass_float(buf, n, (size_t)1 << stage, log_n - stage);
+    }
+}
+
+static void helper_float_recursive(float *buf, int log_n) {
+    if (log_n <= 4) {
+        small_float(buf, log_n);
+        return;
+    }
+    if (log_n <= FHT_AVX512_LOG_CHUNK_FLOAT) {
+        helper_float_iterative(buf, log_n);
+        return;
+    }
+    // Eighths joined by a radix-8 pass, so every three levels cost one
+    // pass over memory; quarters or halves just above the chunk
+    int log_radix = log_n - FHT_AVX512_LOG_CHUNK_FLOAT < 3 ? log_n - FHT_AVX512_LOG_CHUNK_FLOAT : 3;
+    size_t part = (size_t)1 << (log_n - log_radix);
+    for (size_t q = 0; q < ((size_t)1 << log_radix); q++) {
+        helper_float_recursive(buf + q * part, log_n - log_radix);
+    }
+    pass_float(buf, (size_t)1 << log_n, part, log_radix);
+}
+
+static int fht_float_avx512(float *buf, int log_n) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (log_n > 0) {
+        helper_float_recursive(buf, log_n);
+    }
+    return 0;
+}
+
+/* Batched entry point for float (arguments validated by fht.c) */
+static int fht_float_batch_avx512(float *buf, int log_n, size_t count, size_t stride) {
+    if (log_n == 0) {
+        return 0;
+    }
+    if (log_n <= 4 && stride == ((size_t)1 << log_n)) {
+        // Back-to-back short vectors: 16 / n of them per register, since the
+        // in-register stages never mix lanes of different vectors
+        size_t total = count << log_n, i = 0;
+        for (; i + 16 <= total; i += 16) {
+            _mm512_storeu_ps(buf + i, stages_in_reg_ps(_mm512_loadu_ps(buf + i), log_n));
+        }
+        if (i < total) {
+            __mmask16 m = (__mmask16)((1u << (total - i)) - 1);
+            __m512 v = _mm512_maskz_loadu_ps(m, buf + i);
+            _mm512_mask_storeu_ps(buf + i, m, stages_in_reg_ps(v, log_n));
+        }
+        return 0;
+    }
+    for (size_t i = 0; i < count; i++) {
+        helper_float_recursive(buf + i * stride, log_n);
+    }
+    return 0;
+}
+
+/* ========== Double precision versions ========== */
+
+/* Butterfly between two registers */
+#define BUTTERFLY_PD(a, b) do { \
+    __m512d _s = _mm512_add_pd(a, b); \
+    b = _mm512_sub_pd(a, b); \
+    a = _s; \
+} while (0)
+
+static inline __m512d stage_in_reg_pd(__m512d v, __m512d p, __mmask8 high) {
+    return _mm512_mask_sub_pd(_mm512_add_pd(v, p), high, p, v);
+}
+
+/* The first `stages` (at most 3) stages of every 8-double group */
+static inline __m512d stages_in_reg_pd(__m512d v, int stages) {
+    if (stages > 0) v = stage_in_reg_pd(v, _mm512_permute_pd(v, 0x55), 0xAA);
+    if (stages > 1) v = stage_in_reg_pd(v, _mm512_permutex_pd(v, 0x4E), 0xCC);
+    if (stages > 2) v = stage_in_reg_pd(v, _mm512_shuffle_f64x2(v, v, 0x4E), 0xF0);
+    return v;
+}
+
+/* Vectors of at most 8 doubles: one masked register */
+static inline void small_double(double *buf, int log_n) {
+    __mmask8 m = (__mmask8)((1u << (1 << log_n)) - 1);
+    __m512d v = _mm512_maskz_loadu_pd(m, buf);
+    _mm512_mask_storeu_pd(buf, m, stages_in_reg_pd(v, log_n));
+}
+
+/* First pass: stages 1-3 in every register, then log(nr) stages across nr
+ * consecutive registers */
+#define LOAD_PD(i) r[i] = stages_in_reg_pd(_mm512_loadu_pd(p + 8 * (i)), 3);
+#define STORE_PD(i) _mm512_storeu_pd(p + 8 * (i), r[i]);
+static inline void pass_double_first(double *buf, size_t n, int log_regs) {
+    __m512d r[16];
+    for (size_t i = 0; i < n; i += (size_t)8 << log_regs) {
+        double *p = buf + i;
+        switch (log_regs) {
+            case 1: FOR2(LOAD_PD) RADIX2(BUTTERFLY_PD, r); FOR2(STORE_PD) break;
+            case 2: FOR4(LOAD_PD) RADIX4(BUTTERFLY_PD, r); FOR4(STORE_PD) break;
+            case 3: FOR8(LOAD_PD) RADIX8(BUTTERFLY_PD, r); FOR8(STORE_PD) break;
+            default: FOR16(LOAD_PD) RADIX16(BUTTERFLY_PD, r); FOR16(STORE_PD) break;
+        }
+    }
+}
+#undef LOAD_PD
+#undef STORE_PD
+
+#define LOAD_PD(i) r[i] = _mm512_loadu_pd(p + (i) * h);
+#define STORE_PD(i) _mm512_storeu_pd(p + (i) * h, r[i]);
+static inline void pass_double(double *buf, size_t n, size_t h, int log_radix) {
+    __m512d r[16];
+    for (size_t base = 0; base < n; base += h << log_radix) {
+        for (size_t j = base; j < base + h; j += 8) {
+            double *p = buf + j;
+            switch (log_radix) {
+                case 1: FOR2(LOAD_PD) RADIX2(BUTTERFLY_PD, r); FOR2(STORE_PD) break;
+                case 2: FOR4(LOAD_PD) RADIX4(BUTTERFLY_PD, r); FOR4(STORE_PD) break;
+                case 3: FOR8(LOAD_PD) RADIX8(BUTTERFLY_PD, r); FOR8(STORE_PD) break;
+                default: FOR16(LOAD_PD) RADIX16(BUTTERFLY_PD, r); FOR16(STORE_PD) break;
+            }
+        }
+    }
+}
+#undef LOAD_PD
+#undef STORE_PD
+
+/* L1-resident blocks, 4 <= log_n <= FHT_AVX512_LOG_CHUNK_DOUBLE */
+static void helper_double_iterative(double *buf, int log_n) {
+    size_t n = (size_t)1 << log_n;
+    int log_regs = log_n - 3 < 4 ? log_n - 3 : 4;
+    int stage = 3 + log_regs;
+
+    pass_double_first(buf, n, log_regs);
+    for (; stage + 4 <= log_n; stage += 4) {
+        pass_double(buf, n, (size_t)1 << stage, 4);
+    }
+    if (stage < log_n) {
+        pass_double(buf, n, (size_t)1 << stage, log_n - stage);
+    }
+}
+
+static void helper_double_recursive(double *buf, int log_n) {
+    if (log_n <= 3) {
+        small_double(buf, log_n);
+        return;
+    }
+    if (log_n <= FHT_AVX512_LOG_CHUNK_DOUBLE) {
+        helper_double_iterative(buf, log_n);
+        return;
+    }
+    int log_radix = log_n - FHT_AVX512_LOG_CHUNK_DOUBLE < 3 ? log_n - FHT_AVX512_LOG_CHUNK_DOUBLE : 3;
+    size_t part = (size_t)1 << (log_n - log_radix);
+    for (size_t q = 0; q < ((size_t)1 << log_radix); q++) {
+        helper_double_recursive(buf + q * part, log_n - log_radix);
+    }
+    pass_double(buf, (size_t)1 << log_n, part, log_radix);
+}
+
+static int fht_double_avx512(double *buf, int log_n) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (log_n > 0) {
+        helper_double_recursive(buf, log_n);
+    }
+    return 0;
+}
+
+/* Batched entry point for double (arguments validated by fht.c) */
+static int fht_double_batch_avx512(double *buf, int log_n, size_t count, size_t stride) {
+    if (log_n == 0) {
+        return 0;
+    }
+    if (log_n <= 3 && stride == ((size_t)1 << log_n)) {
+        // Back-to-back short vectors, 8 / n per register
+        size_t total = count << log_n, i = 0;
+        for (; i + 8 <= total; i += 8) {
+            _mm512_storeu_pd(buf + i, stages_in_reg_pd(_mm512_loadu_pd(buf + i), log_n));
+        }
+        if (i < total) {
+            __mmask8 m = (__mmask8)((1u << (total - i)) - 1);
+            __m512d v = _mm512_maskz_loadu_pd(m, buf + i);
+            _mm512_mask_storeu_pd(buf + i, m, stages_in_reg_pd(v, log_n));
+        }
+        return 0;
+    }
+    for (size_t i = 0; i < count; i++) {
+        helper_double_recursive(buf + i * stride, log_n);
+    }
+    return 0;
+}
+
+#if defined(__clang__)
+#  pragma clang attribute pop
+#endif
+
+const fht_kernel fht_kernel_avx512 = {
+    "avx512",
+    fht_float_avx512,
+    fht_double_avx512,
+    fht_float_batch_avx512,
+    fht_double_batch_avx512,
+};
+
+#else
+typedef int fht_kernel_avx512_unused;  // ISO C forbids an empty translation unit
+#endif
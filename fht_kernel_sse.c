@@ -0,0 +1,30 @@
+/* SSE backend: the FFHT generated kernel exported under a backend-specific name */
+#if (defined(__x86_64__) || defined(__i386__))
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+
+#include "fht.h"
+#include "fht_kernel.h"
+
+int fht_float_sse(float *buf, int log_n);
+int fht_double_sse(double *buf, int log_n);
+
+#define fht_float fht_float_sse
+#define fht_double fht_double_sse
+#include "fht_sse.c"
+#undef fht_float
+#undef fht_double
+
+const fht_kernel fht_kernel_sse = {
+    "sse",
+    fht_float_sse,
+    fht_double_sse,
+    NULL,
+    NULL,
+};
+
+#else
+typedef int fht_kernel_sse_unused;  // ISO C forbids an empty translation unit
+#endif
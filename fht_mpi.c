@@ -0,0 +1,155 @@
+// Distributed transforms over MPI: a block-distributed vector, local stages
+// on each rank and pairwise block exchanges for the stages over the rank bits.
+//
+// Stage b over the ranks pairs r with r ^ 2^b. The lower rank of a pair
+// keeps a + b and the upper one a - b, where a is the lower rank's block, so
+// each rank needs its partner's whole block once per stage. The block is
+// sent and received in chunks: up to FHT_MPI_DEPTH chunks are posted ahead,
+// and chunk k is combined once both its receive and its send (which reads
+// the same elements of `local`) have completed, so the transfer of the next
+// chunks overlaps the butterfly of this one. Tags need no chunk number: MPI
+// delivers the messages of a pair in order, and a stage completes all its
+// requests before the next stage picks a different partner.
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht_mpi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bytes per message of the cross-rank stages
+#ifndef FHT_MPI_CHUNK_BYTES
+#  define FHT_MPI_CHUNK_BYTES ((size_t)1 << 22)
+#endif
+// Chunks in flight per stage
+#ifndef FHT_MPI_DEPTH
+#  define FHT_MPI_DEPTH 4
+#endif
+#define FHT_MPI_TAG 0x4648
+
+static void butterfly_float(float *local, const float *remote, size_t n, int upper) {
+    if (upper) {
+        for (size_t i = 0; i < n; i++) {
+            local[i] = remote[i] - local[i];
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            local[i] += remote[i];
+        }
+    }
+}
+
+static void butterfly_double(double *local, const double *remote, size_t n, int upper) {
+    if (upper) {
+        for (size_t i = 0; i < n; i++) {
+            local[i] = remote[i] - local[i];
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            local[i] += remote[i];
+        }
+    }
+}
+
+// One stage over the rank bits: swap the block with `partner` chunk by
+// chunk. Returns the first MPI error (only seen with an error handler that
+// returns); the remaining chunks still go through, so the partner is not
+// left waiting on a message
+static int exchange_stage(char *local, char *recv, size_t n, size_t chunk, int is_double, int partner,
+                           int upper, MPI_Comm comm) {
+    size_t elem = is_double ? sizeof(double) : sizeof(float);
+    MPI_Datatype type = is_double ? MPI_DOUBLE : MPI_FLOAT;
+    size_t chunks = (n + chunk - 1) / chunk;
+    MPI_Request reqs[FHT_MPI_DEPTH][2];
+    int err = MPI_SUCCESS;
+
+    size_t posted = 0;
+    for (size_t k = 0; k < chunks; k++) {
+        while (posted < chunks && posted < k + FHT_MPI_DEPTH) {
+            size_t begin = posted * chunk;
+            int count = (int)(n - begin < chunk ? n - begin : chunk);
+            char *slot = recv + (posted % FHT_MPI_DEPTH) * chunk * elem;
+            int e = MPI_Irecv(slot, count, type, partner, FHT_MPI_TAG, comm, &reqs[posted % FHT_MPI_DEPTH][0]);
+            err = err != MPI_SUCCESS ? err : e;
+            e = MPI_Isend(local + begin * elem, count, type, partner, FHT_MPI_TAG, comm,
+                          &reqs[posted % FHT_MPI_DEPTH][1]);
+            err = err != MPI_SUCCESS ? err : e;
+            posted++;
+        }
+        int e = MPI_Waitall(2, reqs[k % FHT_MPI_DEPTH], MPI_STATUSES_IGNORE);
+        err = err != MPI_SUCCESS ? err : e;
+        size_t begin = k * chunk;
+        size_t count = n - begin < chunk ? n - begin : chunk;
+        const char *slot = recv + (k % FHT_MPI_DEPTH) * chunk * elem;
+        if (is_double) {
+            butterfly_double((double *)(local + begin * elem), (const double *)slot, count, upper);
+        } else {
+            butterfly_float((float *)(local + begin * elem), (const float *)slot, count, upper);
+        }
+    }
+    return err;
+}
+
+static int mpi_transform(void *local, int log_local, MPI_Comm comm, int nthreads, int is_double) {
+    size_t elem = is_double ? sizeof(double) : sizeof(float);
+    int rank, nranks;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nranks);
+    int log_ranks = 0;
+    while ((1 << log_ranks) < nranks) {
+        log_ranks++;
+    }
+
+    int bad = log_local < 0 || (1 << log_ranks) != nranks || log_local + log_ranks > FHT_LARGE_MAX_LOG_N ||
+              (log_local > 0 && local == NULL);
+    size_t n = (size_t)1 << (bad ? 0 : log_local);
+    size_t chunk = FHT_MPI_CHUNK_BYTES / elem;
+    if (chunk > n) {
+        chunk = n;
+    }
+    char *recv = NULL;
+    if (!bad && log_ranks > 0) {
+        recv = (char *)malloc(chunk * elem * FHT_MPI_DEPTH);
+        bad = recv == NULL;
+    }
+    // Agree on the arguments and the allocations, so all ranks fail together
+    int check[3] = {bad, log_local, -log_local};
+    MPI_Allreduce(MPI_IN_PLACE, check, 3, MPI_INT, MPI_MAX, comm);
+    if (check[0] || check[1] != -check[2]) {
+        free(recv);
+        return -1;
+    }
+
+    int res = log_local > 30 ? (is_double ? fht_double_large((double *)local, log_local)
+                                          : fht_float_large((float *)local, log_local))
+                             : (is_double ? fht_double_mt((double *)local, log_local, nthreads)
+                                          : fht_float_mt((float *)local, log_local, nthreads));
+    // A rank that stops alone would leave its partners blocked in the
+    // exchange, so the ranks agree on the status before the cross-rank
+    // stages and after each of them, and all return the same
+    int failed = res != 0;
+    MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, comm);
+    for (int b = 0; !failed && b < log_ranks; b++) {
+        int partner = rank ^ (1 << b);
+        failed = exchange_stage((char *)local, recv, n, chunk, is_double, partner, rank > partner, comm) !=
+                 MPI_SUCCESS;
+        MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, comm);
+    }
+    free(recv);
+    return failed ? -1 : 0;
+}
+
+int fht_float_mpi(float *local, int log_local, MPI_Comm comm, int nthreads) {
+    return mpi_transform(local, log_local, comm, nthreads, 0);
+}
+
+int fht_double_mpi(double *local, int log_local, MPI_Comm comm, int nthreads) {
+    return mpi_transform(local, log_local, comm, nthreads, 1);
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,36 @@
+#ifndef _FHT_MPI_H_
+#define _FHT_MPI_H_
+#include <mpi.h>
+#include "fht.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Distributed transforms (fht_mpi.c, optional: build with mpicc, see
+// `make test_mpi`). The 2^(log_local + log2 P) vector is block-distributed
+// over the P ranks of comm, P a power of two: rank r holds the elements
+// r * 2^log_local ... (r + 1) * 2^log_local - 1 in `local`, in place. Every
+// rank calls with the same log_local.
+//
+// The low log_local stages run on each rank through fht_float_mt (nthreads
+// as there) or fht_float_large past 2^30. Each of the log2 P stages over the
+// rank bits pairs rank r with r ^ 2^b and swaps the whole block with it:
+// the block goes in FHT_MPI_CHUNK_BYTES messages, and the butterfly on one
+// chunk runs while the next FHT_MPI_DEPTH - 1 are in flight. A stage moves
+// each rank's block once, so the transform sends N log2 P elements in total.
+//
+// Every rank returns the same status: 0, or -1 if the ranks disagree on
+// log_local, P is not a power of two, the global size passes
+// 2^FHT_LARGE_MAX_LOG_N, a buffer cannot be allocated, or on any rank the
+// local stages fail or an exchange reports an MPI error. MPI errors go
+// through comm's error handler first; the default aborts, so they only come
+// back with one that returns, such as MPI_ERRORS_RETURN.
+int fht_float_mpi(float *local, int log_local, MPI_Comm comm, int nthreads);
+int fht_double_mpi(double *local, int log_local, MPI_Comm comm, int nthreads);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif
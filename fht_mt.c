@@ -0,0 +1,641 @@
+// Multithreaded transforms for large log_n.
+//
+// A size-2^log_n transform factors into 2^log_blocks independent transforms
+// of the contiguous blocks, followed by log_blocks butterfly stages across
+// blocks. Workers take blocks from a shared counter for the first phase;
+// for the second phase every worker owns a range of offsets and runs all
+// cross-block stages on it tile by tile, so the second phase is a single
+// pass over memory.
+//
+// Batches of smaller vectors (fht_*_strided_mt, fht_*_batch_mt) split the
+// vectors instead: workers take chunks of them from the same counter and run
+// the single-threaded strided/batch code on each chunk.
+//
+// Workers live in a pool started by the first call and parked between calls,
+// and one call runs all its phases on the same workers, with a barrier
+// between the phases. A call that overlaps another thread's _mt call spawns
+// its own workers for the call instead; thread start-up costs tens of
+// microseconds, small next to the milliseconds these calls run for.
+
+#define _GNU_SOURCE  // pthread_attr_setaffinity_np, sysconf
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht.h"
+#include "fht_kernel.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+#if defined(__linux__)
+#  include <sched.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Below this block size the first phase is too short to be worth a thread
+#define MT_MIN_LOG_BLOCK 12
+// Working set of one tile of the cross-block pass (all blocks), in bytes
+#define MT_COMBINE_TILE_BYTES ((size_t)1 << 17)
+// Largest affinity list we keep
+#define MT_MAX_CPUS 1024
+// Smallest batch (in elements) worth more than the calling thread
+#define MT_MIN_LOG_BATCH 16
+// Vectors this long are transformed one at a time by all threads
+#define MT_MIN_LOG_SPLIT 20
+
+static int default_threads = 0;  // 0: number of online CPUs
+static int affinity_cpus[MT_MAX_CPUS];
+static int affinity_count = 0;
+static int affinity_round = 0;  // bumped by every fht_set_thread_affinity
+
+int fht_set_num_threads(int nthreads) {
+    if (nthreads < 0) {
+        return -1;
+    }
+    default_threads = nthreads;
+    return 0;
+}
+
+int fht_get_num_threads(void) {
+    if (default_threads > 0) {
+        return default_threads;
+    }
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    return ncpu > 0 ? (int)ncpu : 1;
+}
+
+int fht_set_thread_affinity(const int *cpus, int ncpus) {
+    if (cpus == NULL || ncpus <= 0) {
+        affinity_count = 0;
+        affinity_round++;
+        return 0;
+    }
+#if defined(__linux__)
+    if (ncpus > MT_MAX_CPUS) {
+        return -1;
+    }
+    for (int i = 0; i < ncpus; i++) {
+        if (cpus[i] < 0 || cpus[i] >= CPU_SETSIZE) {
+            return -1;
+        }
+        affinity_cpus[i] = cpus[i];
+    }
+    affinity_count = ncpus;
+    affinity_round++;
+    return 0;
+#else
+    return -1;  // no portable way to pin threads
+#endif
+}
+
+static size_t combine_tile(int log_blocks, size_t elem_size, size_t blk) {
+    size_t tile = MT_COMBINE_TILE_BYTES / (elem_size << log_blocks);
+    if (tile < 16) {
+        tile = 16;
+    }
+    return tile < blk ? tile : blk;
+}
+
+static void combine_float(float *buf, size_t blk, int log_blocks, size_t begin, size_t end) {
+    size_t nblocks = (size_t)1 << log_blocks;
+    size_t tile = combine_tile(log_blocks, sizeof(float), blk);
+    for (size_t lo = begin; lo < end; lo += tile) {
+        size_t len = (end - lo < tile) ? end - lo : tile;
+        for (size_t h = 1; h < nblocks; h <<= 1) {
+            for (size_t b = 0; b < nblocks; b += 2 * h) {
+                for (size_t bb = b; bb < b + h; bb++) {
+                    float *x = buf + bb * blk + lo;
+                    float *y = x + h * blk;
+                    for (size_t j = 0; j < len; j++) {
+                        float u = x[j];
+                        float v = y[j];
+                        x[j] = u + v;
+                        y[j] = u - v;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void combine_double(double *buf, size_t blk, int log_blocks, size_t begin, size_t end) {
+    size_t nblocks = (size_t)1 << log_blocks;
+    size_t tile = combine_tile(log_blocks, sizeof(double), blk);
+    for (size_t lo = begin; lo < end; lo += tile) {
+        size_t len = (end - lo < tile) ? end - lo : tile;
+        for (size_t h = 1; h < nblocks; h <<= 1) {
+            for (size_t b = 0; b < nblocks; b += 2 * h) {
+                for (size_t bb = b; bb < b + h; bb++) {
+                    double *x = buf + bb * blk + lo;
+                    double *y = x + h * blk;
+                    for (size_t j = 0; j < len; j++) {
+                        double u = x[j];
+                        double v = y[j];
+                        x[j] = u + v;
+                        y[j] = u - v;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static int check_combine(int log_n, int log_blocks, size_t begin, size_t end) {
+    if (log_n < 0 || log_n > 30 || log_blocks < 0 || log_blocks > log_n) {
+        return -1;
+    }
+    if (begin > end || end > ((size_t)1 << (log_n - log_blocks))) {
+        return -1;
+    }
+    return 0;
+}
+
+int fht_float_combine_blocks(float *buf, int log_n, int log_blocks, size_t begin, size_t end) {
+    if (check_combine(log_n, log_blocks, begin, end)) {
+        return -1;
+    }
+    combine_float(buf, (size_t)1 << (log_n - log_blocks), log_blocks, begin, end);
+    return 0;
+}
+
+int fht_double_combine_blocks(double *buf, int log_n, int log_blocks, size_t begin, size_t end) {
+    if (check_combine(log_n, log_blocks, begin, end)) {
+        return -1;
+    }
+    combine_double(buf, (size_t)1 << (log_n - log_blocks), log_blocks, begin, end);
+    return 0;
+}
+
+typedef struct {
+    float *fbuf;  // exactly one of fbuf/dbuf is set
+    double *dbuf;
+    int log_n;
+    int log_blocks;
+    int nthreads;
+    int phase;       // 0, 1: blocks, cross-block stages; 2: chunks of a batch
+    int last_phase;  // phases phase..last_phase run, a barrier between each
+    size_t stride;   // batch layout, as for fht_*_strided
+    size_t count;
+    size_t batch_stride;
+    size_t chunk;  // vectors per chunk
+    pthread_mutex_t lock;
+    pthread_cond_t barrier;
+    int arrived;  // workers waiting at the barrier
+    unsigned barrier_round;
+    size_t next_block;
+    int error;
+} mt_job;
+
+typedef struct {
+    mt_job *job;
+    int id;
+} mt_worker;
+
+// Worker `id`'s share of one phase
+static void mt_work(mt_job *job, int phase, int id) {
+    int log_blk = job->log_n - job->log_blocks;
+    size_t blk = (size_t)1 << log_blk;
+
+    if (phase == 0) {
+        size_t nblocks = (size_t)1 << job->log_blocks;
+        for (;;) {
+            pthread_mutex_lock(&job->lock);
+            size_t b = job->next_block++;
+            pthread_mutex_unlock(&job->lock);
+            if (b >= nblocks) {
+                break;
+            }
+            int res = job->fbuf ? fht_float(job->fbuf + b * blk, log_blk)
+                                : fht_double(job->dbuf + b * blk, log_blk);
+            if (res) {
+                pthread_mutex_lock(&job->lock);
+                job->error = res;
+                pthread_mutex_unlock(&job->lock);
+            }
+        }
+    } else if (phase == 2) {
+        for (;;) {
+            pthread_mutex_lock(&job->lock);
+            size_t first = job->next_block++ * job->chunk;
+            pthread_mutex_unlock(&job->lock);
+            if (first >= job->count) {
+                break;
+            }
+            size_t count = job->count - first < job->chunk ? job->count - first : job->chunk;
+            int res = job->fbuf
+                ? fht_float_strided(job->fbuf + first * job->batch_stride, job->log_n, job->stride, count, job->batch_stride)
+                : fht_double_strided(job->dbuf + first * job->batch_stride, job->log_n, job->stride, count, job->batch_stride);
+            if (res) {
+                pthread_mutex_lock(&job->lock);
+                job->error = res;
+                pthread_mutex_unlock(&job->lock);
+            }
+        }
+    } else {
+        // Offsets split evenly, rounded to whole cache lines
+        size_t begin = (blk * id / job->nthreads) & ~(size_t)15;
+        size_t end = (id + 1 == job->nthreads) ? blk : (blk * (id + 1) / job->nthreads) & ~(size_t)15;
+        if (job->fbuf) {
+            combine_float(job->fbuf, blk, job->log_blocks, begin, end);
+        } else {
+            combine_double(job->dbuf, blk, job->log_blocks, begin, end);
+        }
+    }
+}
+
+// Wait until all job->nthreads workers have arrived; returns the error so far
+static int mt_barrier(mt_job *job) {
+    pthread_mutex_lock(&job->lock);
+    unsigned round = job->barrier_round;
+    if (++job->arrived == job->nthreads) {
+        job->arrived = 0;
+        job->barrier_round++;
+        pthread_cond_broadcast(&job->barrier);
+    } else {
+        while (round == job->barrier_round) {
+            pthread_cond_wait(&job->barrier, &job->lock);
+        }
+    }
+    int error = job->error;
+    pthread_mutex_unlock(&job->lock);
+    return error;
+}
+
+// All phases of a job as worker `id`, each phase waiting for the last
+static void mt_work_all(mt_job *job, int id) {
+    for (int phase = job->phase; phase <= job->last_phase; phase++) {
+        if (phase > job->phase && mt_barrier(job) != 0) {
+            break;
+        }
+        mt_work(job, phase, id);
+    }
+}
+
+static void mt_job_init(mt_job *job) {
+    job->next_block = 0;
+    job->error = 0;
+    job->arrived = 0;
+    job->barrier_round = 0;
+    pthread_mutex_init(&job->lock, NULL);
+    pthread_cond_init(&job->barrier, NULL);
+}
+
+static void mt_job_destroy(mt_job *job) {
+    pthread_cond_destroy(&job->barrier);
+    pthread_mutex_destroy(&job->lock);
+}
+
+#if defined(__linux__)
+// CPU set of worker t under the current affinity setting
+static void worker_cpus(int t, cpu_set_t *set) {
+    CPU_ZERO(set);
+    if (affinity_count > 0) {
+        CPU_SET(affinity_cpus[t % affinity_count], set);
+    } else {
+        for (int c = 0; c < CPU_SETSIZE; c++) {
+            CPU_SET(c, set);
+        }
+    }
+}
+#endif
+
+// The worker pool: started on the first _mt call that needs it, grown to the
+// largest thread count asked for, and parked on a condition variable between
+// calls. One caller uses it at a time; a call that finds it busy (an _mt call
+// on another thread) spawns its own workers instead.
+static struct {
+    pthread_mutex_t busy;  // held by the caller using the pool
+    pthread_mutex_t lock;  // guards the fields below
+    pthread_cond_t wake;   // a new job was posted
+    pthread_cond_t done;   // the last worker of a job finished
+    pthread_t threads[MT_MAX_CPUS];
+    unsigned long born[MT_MAX_CPUS];  // pool.round when each worker started
+    int size;
+    mt_job *job;
+    int job_threads;      // workers 0..job_threads-1 run the current job
+    unsigned long round;  // bumped per posted job
+    int running;          // workers of the current job still at work
+    int affinity_round;   // affinity_round the workers are pinned for
+} pool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+          PTHREAD_COND_INITIALIZER, {0}, {0}, 0, NULL, 0, 0, 0, 0};
+
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+
+// A forked child has none of the parent's threads
+static void pool_after_fork(void) {
+    pthread_mutex_init(&pool.busy, NULL);
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.wake, NULL);
+    pthread_cond_init(&pool.done, NULL);
+    pool.size = 0;
+    pool.running = 0;
+}
+
+static void pool_register_fork(void) {
+    pthread_atfork(NULL, NULL, pool_after_fork);
+}
+
+// Pool workers: their transforms are part of the _mt call, not calls of
+// their own
+static void *pool_main(void *arg) {
+    int id = (int)(intptr_t)arg;
+    fht_stats_ignore_thread();
+    pthread_mutex_lock(&pool.lock);
+    unsigned long seen = pool.born[id];  // the job it was started for may be posted already
+    for (;;) {
+        while (pool.round == seen) {
+            pthread_cond_wait(&pool.wake, &pool.lock);
+        }
+        seen = pool.round;
+        if (id >= pool.job_threads) {
+            continue;  // sits this one out; the job may already be gone
+        }
+        mt_job *job = pool.job;
+        pthread_mutex_unlock(&pool.lock);
+        mt_work_all(job, id);
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.running == 0) {
+            pthread_cond_signal(&pool.done);
+        }
+    }
+    return NULL;
+}
+
+// Grow the pool to nthreads workers (pool.busy held); returns its size
+static int pool_grow(int nthreads) {
+    pthread_once(&pool_once, pool_register_fork);
+    while (pool.size < nthreads) {
+        int t = pool.size;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+#if defined(__linux__)
+        if (affinity_count > 0) {
+            cpu_set_t set;
+            worker_cpus(t, &set);
+            pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+        }
+#endif
+        pool.born[t] = pool.round;
+        int ok = pthread_create(&pool.threads[t], &attr, pool_main, (void *)(intptr_t)t) == 0;
+        pthread_attr_destroy(&attr);
+        if (!ok) {
+            break;
+        }
+        pool.size++;
+    }
+    return pool.size;
+}
+
+// Run the job's phases on the pool; -1 if it is busy or has no workers
+static int pool_run(mt_job *job) {
+    if (pthread_mutex_trylock(&pool.busy) != 0) {
+        return -1;
+    }
+    int old_size = pool.size;
+    int size = pool_grow(job->nthreads);
+    if (size == 0) {
+        pthread_mutex_unlock(&pool.busy);
+        return -1;
+    }
+#if defined(__linux__)
+    // Workers started before the last fht_set_thread_affinity follow it now
+    if (pool.affinity_round != affinity_round) {
+        for (int t = 0; t < old_size; t++) {
+            cpu_set_t set;
+            worker_cpus(t, &set);
+            pthread_setaffinity_np(pool.threads[t], sizeof(set), &set);
+        }
+        pool.affinity_round = affinity_round;
+    }
+#else
+    (void)old_size;
+#endif
+    if (job->nthreads > size) {
+        job->nthreads = size;  // out of threads: split over the ones there are
+    }
+    pthread_mutex_lock(&pool.lock);
+    pool.job = job;
+    pool.job_threads = job->nthreads;
+    pool.running = job->nthreads;
+    pool.round++;
+    pthread_cond_broadcast(&pool.wake);
+    while (pool.running > 0) {
+        pthread_cond_wait(&pool.done, &pool.lock);
+    }
+    pthread_mutex_unlock(&pool.lock);
+    pthread_mutex_unlock(&pool.busy);
+    return 0;
+}
+
+// Spawned workers, for calls that overlap one running on the pool. They
+// wait for the caller at a first barrier, once the number that started is
+// known.
+static void *mt_thread_main(void *arg) {
+    mt_worker *w = (mt_worker *)arg;
+    fht_stats_ignore_thread();
+    mt_barrier(w->job);
+    mt_work_all(w->job, w->id);
+    return NULL;
+}
+
+// Run the job's phases on job->nthreads - 1 spawned workers and the calling
+// thread, which takes the last share
+static void mt_spawn_run(mt_job *job) {
+    pthread_t threads[MT_MAX_CPUS];
+    mt_worker workers[MT_MAX_CPUS];
+    int started = 0;
+
+    for (int t = 0; t + 1 < job->nthreads; t++) {
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+#if defined(__linux__)
+        if (affinity_count > 0) {
+            cpu_set_t set;
+            worker_cpus(t, &set);
+            pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+        }
+#endif
+        workers[t].job = job;
+        workers[t].id = t;
+        int ok = pthread_create(&threads[t], &attr, mt_thread_main, &workers[t]) == 0;
+        pthread_attr_destroy(&attr);
+        if (!ok) {
+            break;  // out of threads: split over the ones there are
+        }
+        started++;
+    }
+    // No worker has passed the first barrier yet, so the count can still
+    // shrink
+    pthread_mutex_lock(&job->lock);
+    job->nthreads = started + 1;
+    pthread_mutex_unlock(&job->lock);
+    mt_barrier(job);
+    mt_work_all(job, started);
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+}
+
+// Run phases first..last of a job, on the pool when it is free
+static void mt_run(mt_job *job, int first, int last) {
+    job->phase = first;
+    job->last_phase = last;
+    if (pool_run(job) != 0) {
+        mt_spawn_run(job);
+    }
+}
+
+int fht_mt_default_log_blocks(int log_n, int nthreads) {
+    // About four blocks per thread so the first phase balances well
+    int log_blocks = 0;
+    while (((size_t)1 << log_blocks) < (size_t)nthreads * 4) {
+        log_blocks++;
+    }
+    if (log_blocks > log_n - MT_MIN_LOG_BLOCK) {
+        log_blocks = log_n - MT_MIN_LOG_BLOCK;
+    }
+    return log_blocks;
+}
+
+static int resolve_threads(int nthreads) {
+    if (nthreads <= 0) {
+        nthreads = fht_get_num_threads();
+    }
+    return nthreads > MT_MAX_CPUS ? MT_MAX_CPUS : nthreads;
+}
+
+static int mt_transform(float *fbuf, double *dbuf, int log_n, int nthreads) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    // Tuned settings apply to calls that leave the thread count to us
+    const fht_wisdom_entry *w = &fht_wisdom[dbuf != NULL][log_n];
+    if (nthreads <= 0 && w->threads > 0) {
+        nthreads = w->threads;
+    }
+    nthreads = resolve_threads(nthreads);
+
+    int log_blocks = fht_mt_default_log_blocks(log_n, nthreads);
+    if (w->log_blocks > 0 && w->threads == nthreads) {
+        log_blocks = w->log_blocks < log_n - MT_MIN_LOG_BLOCK ? w->log_blocks : log_n - MT_MIN_LOG_BLOCK;
+    }
+    if (nthreads == 1 || log_blocks <= 0) {
+        return fbuf ? fht_float(fbuf, log_n) : fht_double(dbuf, log_n);
+    }
+
+    mt_job job;
+    job.fbuf = fbuf;
+    job.dbuf = dbuf;
+    job.log_n = log_n;
+    job.log_blocks = log_blocks;
+    job.nthreads = nthreads;
+    mt_job_init(&job);
+
+    mt_run(&job, 0, 1);
+
+    mt_job_destroy(&job);
+    return job.error;
+}
+
+int fht_float_mt(float *buf, int log_n, int nthreads) {
+    uint64_t t0 = fht_stats_begin();
+    int res = mt_transform(buf, NULL, log_n, nthreads);
+    fht_stats_end(t0, 0, FHT_STATS_MT, log_n, 1);
+    return res;
+}
+
+int fht_double_mt(double *buf, int log_n, int nthreads) {
+    uint64_t t0 = fht_stats_begin();
+    int res = mt_transform(NULL, buf, log_n, nthreads);
+    fht_stats_end(t0, 1, FHT_STATS_MT, log_n, 1);
+    return res;
+}
+
+static int mt_strided(float *fbuf, double *dbuf, int log_n, size_t stride, size_t count,
+                      size_t batch_stride, int nthreads) {
+    // Same rules as fht_*_strided, checked up front: chunks see fewer vectors
+    if (log_n < 0 || log_n > 30 || (log_n > 0 && stride == 0) || (count > 1 && batch_stride == 0) ||
+        (batch_stride == 1 && stride != 1 && count > stride) ||
+        (stride == 1 && count > 1 && batch_stride < ((size_t)1 << log_n))) {
+        return -1;
+    }
+    nthreads = resolve_threads(nthreads);
+
+    if (stride == 1 && log_n >= MT_MIN_LOG_SPLIT && count < (size_t)nthreads) {
+        // Few long vectors: every thread works on each of them in turn
+        for (size_t j = 0; j < count; j++) {
+            int res = mt_transform(fbuf ? fbuf + j * batch_stride : NULL,
+                                   dbuf ? dbuf + j * batch_stride : NULL, log_n, nthreads);
+            if (res) {
+                return res;
+            }
+        }
+        return 0;
+    }
+
+    // About four chunks per thread, each at least 2^MT_MIN_LOG_BLOCK elements
+    size_t chunk = (count + (size_t)nthreads * 4 - 1) / ((size_t)nthreads * 4);
+    size_t min_chunk = log_n >= MT_MIN_LOG_BLOCK ? 1 : (size_t)1 << (MT_MIN_LOG_BLOCK - log_n);
+    if (chunk < min_chunk) {
+        chunk = min_chunk;
+    }
+    if (batch_stride == 1 && stride != 1) {
+        // Interleaved columns: whole cache lines per chunk
+        chunk = (chunk + 15) & ~(size_t)15;
+    }
+    if (nthreads == 1 || ((size_t)count << log_n) < ((size_t)1 << MT_MIN_LOG_BATCH) || chunk >= count) {
+        return fbuf ? fht_float_strided(fbuf, log_n, stride, count, batch_stride)
+                    : fht_double_strided(dbuf, log_n, stride, count, batch_stride);
+    }
+    size_t nchunks = (count + chunk - 1) / chunk;
+    if ((size_t)nthreads > nchunks) {
+        nthreads = (int)nchunks;
+    }
+
+    mt_job job;
+    job.fbuf = fbuf;
+    job.dbuf = dbuf;
+    job.log_n = log_n;
+    job.log_blocks = 0;
+    job.nthreads = nthreads;
+    job.stride = stride;
+    job.count = count;
+    job.batch_stride = batch_stride;
+    job.chunk = chunk;
+    mt_job_init(&job);
+
+    mt_run(&job, 2, 2);
+
+    mt_job_destroy(&job);
+    return job.error;
+}
+
+int fht_float_strided_mt(float *buf, int log_n, size_t stride, size_t count, size_t batch_stride, int nthreads) {
+    uint64_t t0 = fht_stats_begin();
+    int res = mt_strided(buf, NULL, log_n, stride, count, batch_stride, nthreads);
+    fht_stats_end(t0, 0, FHT_STATS_MT, log_n, count);
+    return res;
+}
+
+int fht_double_strided_mt(double *buf, int log_n, size_t stride, size_t count, size_t batch_stride,
+                          int nthreads) {
+    uint64_t t0 = fht_stats_begin();
+    int res = mt_strided(NULL, buf, log_n, stride, count, batch_stride, nthreads);
+    fht_stats_end(t0, 1, FHT_STATS_MT, log_n, count);
+    return res;
+}
+
+int fht_float_batch_mt(float *buf, int log_n, size_t count, size_t stride, int nthreads) {
+    return fht_float_strided_mt(buf, log_n, 1, count, stride, nthreads);
+}
+
+int fht_double_batch_mt(double *buf, int log_n, size_t count, size_t stride, int nthreads) {
+    return fht_double_strided_mt(buf, log_n, 1, count, stride, nthreads);
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
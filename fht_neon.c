@@ -1,123 +1,174 @@
+#if (defined(__aarch64__) || defined(__ARM_NEON))
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  /* keep fast_copy local to fht.c */
+#endif
+
 #include "fht.h"
+#include "fht_kernel.h"
 #include <arm_neon.h>
 
 /* ARM NEON implementation of Fast Hadamard Transform */
 
-/* Helper for log_n = 1: size 2 */
-static inline void helper_float_1(float *buf) {
-    float u = buf[0];
-    float v = buf[1];
-    buf[0] = u + v;
-    buf[1] = u - v;
-}
-
-/* Helper for log_n = 2: size 4 */
-static inline void helper_float_2(float *buf) {
-    /* Load [a, b, c, d] */
-    float a = buf[0], b = buf[1], c = buf[2], d = buf[3];
-
-    /* Stage 1: pairs with stride 1 */
-    float t0 = a + b;
-    float t1 = a - b;
-    float t2 = c + d;
-    float t3 = c - d;
-
-    /* Stage 2: pairs with stride 2 */
-    buf[0] = t0 + t2;
-    buf[1] = t1 + t3;
-    buf[2] = t0 - t2;
-    buf[3] = t1 - t3;
-}
-
-/* Helper for log_n = 3: size 8 using NEON */
-static inline void helper_float_3(float *buf) {
-    /* Load data */
-    float32x4_t v0 = vld1q_f32(buf);      /* [0,1,2,3] */
-    float32x4_t v1 = vld1q_f32(buf + 4);  /* [4,5,6,7] */
-
-    /* Stage 1: butterfly stride 1 */
-    /* We need to process pairs: (0,1), (2,3), (4,5), (6,7) */
-    float32x2_t lo0 = vget_low_f32(v0);   /* [0,1] */
-    float32x2_t hi0 = vget_high_f32(v0);  /* [2,3] */
-    float32x2_t lo1 = vget_low_f32(v1);   /* [4,5] */
-    float32x2_t hi1 = vget_high_f32(v1);  /* [6,7] */
-
-    /* Transpose pairs to separate even/odd */
-    float32x2x2_t t0 = vtrn_f32(lo0, lo0);  /* [[0,0],[1,1]] */
-    float32x2x2_t t1 = vtrn_f32(hi0, hi0);  /* [[2,2],[3,3]] */
-    float32x2x2_t t2 = vtrn_f32(lo1, lo1);  /* [[4,4],[5,5]] */
-    float32x2x2_t t3 = vtrn_f32(hi1, hi1);  /* [[6,6],[7,7]] */
-
-    float32x2_t s0 = vadd_f32(t0.val[0], t0.val[1]);  /* [0+1, 0+1] -> use [0] */
-    float32x2_t d0 = vsub_f32(t0.val[0], t0.val[1]);  /* [0-1, 0-1] -> use [0] */
-    float32x2_t s1 = vadd_f32(t1.val[0], t1.val[1]);
-    float32x2_t d1 = vsub_f32(t1.val[0], t1.val[1]);
-    float32x2_t s2 = vadd_f32(t2.val[0], t2.val[1]);
-    float32x2_t d2 = vsub_f32(t2.val[0], t2.val[1]);
-    float32x2_t s3 = vadd_f32(t3.val[0], t3.val[1]);
-    float32x2_t d3 = vsub_f32(t3.val[0], t3.val[1]);
-
-    /* Reconstruct as [s0[0], d0[0], s1[0], d1[0]] and [s2[0], d2[0], s3[0], d3[0]] */
-    v0 = vcombine_f32(vzip_f32(s0, d0).val[0], vzip_f32(s1, d1).val[0]);
-    v1 = vcombine_f32(vzip_f32(s2, d2).val[0], vzip_f32(s3, d3).val[0]);
-
-    /* Stage 2: butterfly stride 2 */
-    lo0 = vget_low_f32(v0);
-    hi0 = vget_high_f32(v0);
-    lo1 = vget_low_f32(v1);
-    hi1 = vget_high_f32(v1);
-
-    v0 = vcombine_f32(vadd_f32(lo0, hi0), vsub_f32(lo0, hi0));
-    v1 = vcombine_f32(vadd_f32(lo1, hi1), vsub_f32(lo1, hi1));
-
-    /* Stage 3: butterfly stride 4 */
-    float32x4_t sum = vaddq_f32(v0, v1);
-    float32x4_t diff = vsubq_f32(v0, v1);
-
-    vst1q_f32(buf, sum);
-    vst1q_f32(buf + 4, diff);
+/*
+ * Blocks of up to 2^FHT_NEON_LOG_CHUNK_* elements (16 KiB by default, well
+ * inside L1) are transformed by the unrolled per-size kernels generated by
+ * gen_neon.py; the recursion only handles the levels above that. If the
+ * chunk is raised past the generated sizes, the iterative kernel below
+ * covers the gap.
+ */
+#ifndef FHT_NEON_LOG_CHUNK_FLOAT
+#  define FHT_NEON_LOG_CHUNK_FLOAT 12
+#endif
+#ifndef FHT_NEON_LOG_CHUNK_DOUBLE
+#  define FHT_NEON_LOG_CHUNK_DOUBLE 11
+#endif
+/* The passes joining chunks work on whole registers */
+#if FHT_NEON_LOG_CHUNK_FLOAT < 2 || FHT_NEON_LOG_CHUNK_DOUBLE < 1
+#  error "FHT_NEON_LOG_CHUNK_FLOAT must be at least 2, FHT_NEON_LOG_CHUNK_DOUBLE at least 1"
+#endif
+
+#include "fht_neon_gen.c"
+
+/* Butterfly between two registers */
+#define BUTTERFLY_F32(a, b) do { \
+    float32x4_t _s = vaddq_f32(a, b); \
+    b = vsubq_f32(a, b); \
+    a = _s; \
+} while (0)
+
+/* Stages with stride 1 and 2 inside one register:
+ * [a,b,c,d] -> [b,a,d,c] + [a,-b,c,-d] -> swap halves + [x,y,-z,-w] */
+static inline float32x4_t stages_1_2_f32(float32x4_t v, float32x4_t sign1, float32x4_t sign2) {
+    v = vfmaq_f32(vrev64q_f32(v), v, sign1);
+    return vfmaq_f32(vextq_f32(v, v, 2), v, sign2);
 }
 
-/* Generic recursive helper for larger sizes */
-static void helper_float_recursive(float *buf, int log_n) {
-    if (log_n <= 3) {
-        if (log_n == 1) helper_float_1(buf);
-        else if (log_n == 2) helper_float_2(buf);
-        else if (log_n == 3) helper_float_3(buf);
-        return;
+/* First pass of the iterative kernel: stages 1-5 on every 32-float group */
+static inline void pass_float_first(float *buf, size_t n) {
+    static const float s1[4] = {1.0f, -1.0f, 1.0f, -1.0f};
+    static const float s2[4] = {1.0f, 1.0f, -1.0f, -1.0f};
+    const float32x4_t sign1 = vld1q_f32(s1);
+    const float32x4_t sign2 = vld1q_f32(s2);
+
+    for (size_t i = 0; i < n; i += 32) {
+        float *p = buf + i;
+        float32x4_t r0 = stages_1_2_f32(vld1q_f32(p), sign1, sign2);
+        float32x4_t r1 = stages_1_2_f32(vld1q_f32(p + 4), sign1, sign2);
+        float32x4_t r2 = stages_1_2_f32(vld1q_f32(p + 8), sign1, sign2);
+        float32x4_t r3 = stages_1_2_f32(vld1q_f32(p + 12), sign1, sign2);
+        float32x4_t r4 = stages_1_2_f32(vld1q_f32(p + 16), sign1, sign2);
+        float32x4_t r5 = stages_1_2_f32(vld1q_f32(p + 20), sign1, sign2);
+        float32x4_t r6 = stages_1_2_f32(vld1q_f32(p + 24), sign1, sign2);
+        float32x4_t r7 = stages_1_2_f32(vld1q_f32(p + 28), sign1, sign2);
+
+        BUTTERFLY_F32(r0, r1); BUTTERFLY_F32(r2, r3); BUTTERFLY_F32(r4, r5); BUTTERFLY_F32(r6, r7);
+        BUTTERFLY_F32(r0, r2); BUTTERFLY_F32(r1, r3); BUTTERFLY_F32(r4, r6); BUTTERFLY_F32(r5, r7);
+        BUTTERFLY_F32(r0, r4); BUTTERFLY_F32(r1, r5); BUTTERFLY_F32(r2, r6); BUTTERFLY_F32(r3, r7);
+
+        vst1q_f32(p, r0); vst1q_f32(p + 4, r1); vst1q_f32(p + 8, r2); vst1q_f32(p + 12, r3);
+        vst1q_f32(p + 16, r4); vst1q_f32(p + 20, r5); vst1q_f32(p + 24, r6); vst1q_f32(p + 28, r7);
+    }
+}
+
+/* Three stages (strides h, 2h, 4h) per load/store */
+static inline void pass_float_radix8(float *buf, size_t n, size_t h) {
+    for (size_t base = 0; base < n; base += 8 * h) {
+        for (size_t j = base; j < base + h; j += 4) {
+            float *p = buf + j;
+            float32x4_t r0 = vld1q_f32(p), r1 = vld1q_f32(p + h);
+            float32x4_t r2 = vld1q_f32(p + 2 * h), r3 = vld1q_f32(p + 3 * h);
+            float32x4_t r4 = vld1q_f32(p + 4 * h), r5 = vld1q_f32(p + 5 * h);
+            float32x4_t r6 = vld1q_f32(p + 6 * h), r7 = vld1q_f32(p + 7 * h);
+
+            BUTTERFLY_F32(r0, r1); BUTTERFLY_F32(r2, r3); BUTTERFLY_F32(r4, r5); BUTTERFLY_F32(r6, r7);
+            BUTTERFLY_F32(r0, r2); BUTTERFLY_F32(r1, r3); BUTTERFLY_F32(r4, r6); BUTTERFLY_F32(r5, r7);
+            BUTTERFLY_F32(r0, r4); BUTTERFLY_F32(r1, r5); BUTTERFLY_F32(r2, r6); BUTTERFLY_F32(r3, r7);
+
+            vst1q_f32(p, r0); vst1q_f32(p + h, r1);
+            vst1q_f32(p + 2 * h, r2); vst1q_f32(p + 3 * h, r3);
+            vst1q_f32(p + 4 * h, r4); vst1q_f32(p + 5 * h, r5);
+            vst1q_f32(p + 6 * h, r6); vst1q_f32(p + 7 * h, r7);
+        }
+    }
+}
+
+/* Two stages (strides h, 2h) per load/store */
+static inline void pass_float_radix4(float *buf, size_t n, size_t h) {
+    for (size_t base = 0; base < n; base += 4 * h) {
+        for (size_t j = base; j < base + h; j += 4) {
+            float *p = buf + j;
+            float32x4_t r0 = vld1q_f32(p), r1 = vld1q_f32(p + h);
+            float32x4_t r2 = vld1q_f32(p + 2 * h), r3 = vld1q_f32(p + 3 * h);
+
+            BUTTERFLY_F32(r0, r1); BUTTERFLY_F32(r2, r3);
+            BUTTERFLY_F32(r0, r2); BUTTERFLY_F32(r1, r3);
+
+            vst1q_f32(p, r0); vst1q_f32(p + h, r1);
+            vst1q_f32(p + 2 * h, r2); vst1q_f32(p + 3 * h, r3);
+        }
     }
+}
 
-    int n = 1 << log_n;
-    int half = n / 2;
+/* One stage (stride h) */
+static inline void pass_float_radix2(float *buf, size_t n, size_t h) {
+    for (size_t base = 0; base < n; base += 2 * h) {
+        for (size_t j = base; j < base + h; j += 4) {
+            float32x4_t a = vld1q_f32(buf + j);
+            float32x4_t b = vld1q_f32(buf + j + h);
+            vst1q_f32(buf + j, vaddq_f32(a, b));
+            vst1q_f32(buf + j + h, vsubq_f32(a, b));
+        }
+    }
+}
 
-    /* Recursively transform both halves */
-    helper_float_recursive(buf, log_n - 1);
-    helper_float_recursive(buf + half, log_n - 1);
+/* Iterative kernel for L1-resident blocks, 5 <= log_n <= FHT_NEON_LOG_CHUNK_FLOAT */
+static void helper_float_iterative(float *buf, int log_n) {
+    size_t n = (size_t)1 << log_n;
+    int stage = 5;
 
-    /* Combine: butterfly with stride = half */
-    /* Use NEON for the final combining step */
-    for (int i = 0; i < half; i += 4) {
-        if (i + 4 <= half) {
-            float32x4_t a = vld1q_f32(buf + i);
-            float32x4_t b = vld1q_f32(buf + half + i);
-            float32x4_t sum = vaddq_f32(a, b);
-            float32x4_t diff = vsubq_f32(a, b);
-            vst1q_f32(buf + i, sum);
-            vst1q_f32(buf + half + i, diff);
+    pass_float_first(buf, n);
+    for (; stage + 3 <= log_n; stage += 3) {
+        pass_float_radix8(buf, n, (size_t)1 << stage);
+    }
+    if (stage + 2 == log_n) {
+        pass_float_radix4(buf, n, (size_t)1 << stage);
+    } else if (stage + 1 == log_n) {
+        pass_float_radix2(buf, n, (size_t)1 << stage);
+    }
+}
+
+/* Generic recursive helper for larger sizes */
+static void helper_float_recursive(float *buf, int log_n) {
+    if (log_n <= FHT_NEON_LOG_CHUNK_FLOAT) {
+        if (log_n <= FHT_NEON_GEN_MAX_LOG_FLOAT) {
+            fht_neon_gen_float(buf, log_n);
         } else {
-            /* Handle remaining elements */
-            for (int j = i; j < half; j++) {
-                float a = buf[j];
-                float b = buf[half + j];
-                buf[j] = a + b;
-                buf[half + j] = a - b;
-            }
+            /* Chunk raised past the generated kernels */
+            helper_float_iterative(buf, log_n);
         }
+        return;
+    }
+
+    /* Eighths joined by one radix-8 pass, so three levels cost one trip
+     * through memory; quarters or halves just above the chunk */
+    size_t n = (size_t)1 << log_n;
+    int log_radix = log_n - FHT_NEON_LOG_CHUNK_FLOAT < 3 ? log_n - FHT_NEON_LOG_CHUNK_FLOAT : 3;
+    size_t part = n >> log_radix;
+    for (size_t q = 0; q < ((size_t)1 << log_radix); q++) {
+        helper_float_recursive(buf + q * part, log_n - log_radix);
+    }
+    if (log_radix == 3) {
+        pass_float_radix8(buf, n, part);
+    } else if (log_radix == 2) {
+        pass_float_radix4(buf, n, part);
+    } else {
+        pass_float_radix2(buf, n, part);
     }
 }
 
 /* Main entry point for float */
-int fht_float(float *buf, int log_n) {
+static int fht_float_neon(float *buf, int log_n) {
     if (log_n < 0 || log_n > 30) {
         return -1;
     }
@@ -129,79 +180,291 @@ int fht_float(float *buf, int log_n) {
     return 0;
 }
 
+/* Transpose a 4x4 block of floats held in four registers */
+static inline void transpose_float_4x4(float32x4_t *r0, float32x4_t *r1,
+                                       float32x4_t *r2, float32x4_t *r3) {
+    float32x4_t t0 = vtrn1q_f32(*r0, *r1);
+    float32x4_t t1 = vtrn2q_f32(*r0, *r1);
+    float32x4_t t2 = vtrn1q_f32(*r2, *r3);
+    float32x4_t t3 = vtrn2q_f32(*r2, *r3);
+    *r0 = vreinterpretq_f32_f64(vtrn1q_f64(vreinterpretq_f64_f32(t0), vreinterpretq_f64_f32(t2)));
+    *r1 = vreinterpretq_f32_f64(vtrn1q_f64(vreinterpretq_f64_f32(t1), vreinterpretq_f64_f32(t3)));
+    *r2 = vreinterpretq_f32_f64(vtrn2q_f64(vreinterpretq_f64_f32(t0), vreinterpretq_f64_f32(t2)));
+    *r3 = vreinterpretq_f32_f64(vtrn2q_f64(vreinterpretq_f64_f32(t1), vreinterpretq_f64_f32(t3)));
+}
+
+/* Four size-4 transforms at once: after the transpose every lane holds a
+ * different vector, so all stages are plain register-to-register butterflies */
+static inline void helper_float_2_x4(float *b0, float *b1, float *b2, float *b3) {
+    float32x4_t e0 = vld1q_f32(b0);
+    float32x4_t e1 = vld1q_f32(b1);
+    float32x4_t e2 = vld1q_f32(b2);
+    float32x4_t e3 = vld1q_f32(b3);
+    transpose_float_4x4(&e0, &e1, &e2, &e3);
+
+    BUTTERFLY_F32(e0, e1);
+    BUTTERFLY_F32(e2, e3);
+    BUTTERFLY_F32(e0, e2);
+    BUTTERFLY_F32(e1, e3);
+
+    transpose_float_4x4(&e0, &e1, &e2, &e3);
+    vst1q_f32(b0, e0);
+    vst1q_f32(b1, e1);
+    vst1q_f32(b2, e2);
+    vst1q_f32(b3, e3);
+}
+
+/* Four size-8 transforms at once, same idea as helper_float_2_x4 */
+static inline void helper_float_3_x4(float *b0, float *b1, float *b2, float *b3) {
+    float32x4_t e0 = vld1q_f32(b0), e4 = vld1q_f32(b0 + 4);
+    float32x4_t e1 = vld1q_f32(b1), e5 = vld1q_f32(b1 + 4);
+    float32x4_t e2 = vld1q_f32(b2), e6 = vld1q_f32(b2 + 4);
+    float32x4_t e3 = vld1q_f32(b3), e7 = vld1q_f32(b3 + 4);
+    transpose_float_4x4(&e0, &e1, &e2, &e3);
+    transpose_float_4x4(&e4, &e5, &e6, &e7);
+
+    BUTTERFLY_F32(e0, e1);
+    BUTTERFLY_F32(e2, e3);
+    BUTTERFLY_F32(e4, e5);
+    BUTTERFLY_F32(e6, e7);
+    BUTTERFLY_F32(e0, e2);
+    BUTTERFLY_F32(e1, e3);
+    BUTTERFLY_F32(e4, e6);
+    BUTTERFLY_F32(e5, e7);
+    BUTTERFLY_F32(e0, e4);
+    BUTTERFLY_F32(e1, e5);
+    BUTTERFLY_F32(e2, e6);
+    BUTTERFLY_F32(e3, e7);
+
+    transpose_float_4x4(&e0, &e1, &e2, &e3);
+    transpose_float_4x4(&e4, &e5, &e6, &e7);
+    vst1q_f32(b0, e0); vst1q_f32(b0 + 4, e4);
+    vst1q_f32(b1, e1); vst1q_f32(b1 + 4, e5);
+    vst1q_f32(b2, e2); vst1q_f32(b2 + 4, e6);
+    vst1q_f32(b3, e3); vst1q_f32(b3 + 4, e7);
+}
+
+/* Batched entry point for float (arguments validated by fht.c) */
+static int fht_float_batch_neon(float *buf, int log_n, size_t count, size_t stride) {
+    size_t i = 0;
+
+    if (log_n == 0) {
+        return 0;
+    }
+
+    /* Small vectors only fill a fraction of the pipeline each, so process
+     * four of them side by side */
+    if (log_n == 2) {
+        for (; i + 4 <= count; i += 4) {
+            float *b = buf + i * stride;
+            helper_float_2_x4(b, b + stride, b + 2 * stride, b + 3 * stride);
+        }
+    } else if (log_n == 3) {
+        for (; i + 4 <= count; i += 4) {
+            float *b = buf + i * stride;
+            helper_float_3_x4(b, b + stride, b + 2 * stride, b + 3 * stride);
+        }
+    }
+
+    for (; i < count; i++) {
+        helper_float_recursive(buf + i * stride, log_n);
+    }
+    return 0;
+}
+
 /* ========== Double precision versions ========== */
 
-/* Helper for log_n = 1: size 2 */
-static inline void helper_double_1(double *buf) {
-    double u = buf[0];
-    double v = buf[1];
-    buf[0] = u + v;
-    buf[1] = u - v;
+/* Butterfly between two registers */
+#define BUTTERFLY_F64(a, b) do { \
+    float64x2_t _s = vaddq_f64(a, b); \
+    b = vsubq_f64(a, b); \
+    a = _s; \
+} while (0)
+
+/* Stage with stride 1 inside one register: [a,b] -> [b,a] + [a,-b] */
+static inline float64x2_t stage_1_f64(float64x2_t v, float64x2_t sign1) {
+    return vfmaq_f64(vextq_f64(v, v, 1), v, sign1);
+}
+
+/* First pass of the iterative kernel: stages 1-4 on every 16-double group */
+static inline void pass_double_first(double *buf, size_t n) {
+    static const double s1[2] = {1.0, -1.0};
+    const float64x2_t sign1 = vld1q_f64(s1);
+
+    for (size_t i = 0; i < n; i += 16) {
+        double *p = buf + i;
+        float64x2_t r0 = stage_1_f64(vld1q_f64(p), sign1);
+        float64x2_t r1 = stage_1_f64(vld1q_f64(p + 2), sign1);
+        float64x2_t r2 = stage_1_f64(vld1q_f64(p + 4), sign1);
+        float64x2_t r3 = stage_1_f64(vld1q_f64(p + 6), sign1);
+        float64x2_t r4 = stage_1_f64(vld1q_f64(p + 8), sign1);
+        float64x2_t r5 = stage_1_f64(vld1q_f64(p + 10), sign1);
+        float64x2_t r6 = stage_1_f64(vld1q_f64(p + 12), sign1);
+        float64x2_t r7 = stage_1_f64(vld1q_f64(p + 14), sign1);
+
+        BUTTERFLY_F64(r0, r1); BUTTERFLY_F64(r2, r3); BUTTERFLY_F64(r4, r5); BUTTERFLY_F64(r6, r7);
+        BUTTERFLY_F64(r0, r2); BUTTERFLY_F64(r1, r3); BUTTERFLY_F64(r4, r6); BUTTERFLY_F64(r5, r7);
+        BUTTERFLY_F64(r0, r4); BUTTERFLY_F64(r1, r5); BUTTERFLY_F64(r2, r6); BUTTERFLY_F64(r3, r7);
+
+        vst1q_f64(p, r0); vst1q_f64(p + 2, r1); vst1q_f64(p + 4, r2); vst1q_f64(p + 6, r3);
+        vst1q_f64(p + 8, r4); vst1q_f64(p + 10, r5); vst1q_f64(p + 12, r6); vst1q_f64(p + 14, r7);
+    }
+}
+
+/* Three stages (strides h, 2h, 4h) per load/store */
+static inline void pass_double_radix8(double *buf, size_t n, size_t h) {
+    for (size_t base = 0; base < n; base += 8 * h) {
+        for (size_t j = base; j < base + h; j += 2) {
+            double *p = buf + j;
+            float64x2_t r0 = vld1q_f64(p), r1 = vld1q_f64(p + h);
+            float64x2_t r2 = vld1q_f64(p + 2 * h), r3 = vld1q_f64(p + 3 * h);
+            float64x2_t r4 = vld1q_f64(p + 4 * h), r5 = vld1q_f64(p + 5 * h);
+            float64x2_t r6 = vld1q_f64(p + 6 * h), r7 = vld1q_f64(p + 7 * h);
+
+            BUTTERFLY_F64(r0, r1); BUTTERFLY_F64(r2, r3); BUTTERFLY_F64(r4, r5); BUTTERFLY_F64(r6, r7);
+            BUTTERFLY_F64(r0, r2); BUTTERFLY_F64(r1, r3); BUTTERFLY_F64(r4, r6); BUTTERFLY_F64(r5, r7);
+            BUTTERFLY_F64(r0, r4); BUTTERFLY_F64(r1, r5); BUTTERFLY_F64(r2, r6); BUTTERFLY_F64(r3, r7);
+
+            vst1q_f64(p, r0); vst1q_f64(p + h, r1);
+            vst1q_f64(p + 2 * h, r2); vst1q_f64(p + 3 * h, r3);
+            vst1q_f64(p + 4 * h, r4); vst1q_f64(p + 5 * h, r5);
+            vst1q_f64(p + 6 * h, r6); vst1q_f64(p + 7 * h, r7);
+        }
+    }
 }
 
-/* Helper for log_n = 2: size 4 */
-static inline void helper_double_2(double *buf) {
-    /* NEON has 2 doubles per 128-bit vector */
-    float64x2_t v0 = vld1q_f64(buf);
-    float64x2_t v1 = vld1q_f64(buf + 2);
+/* Two stages (strides h, 2h) per load/store */
+static inline void pass_double_radix4(double *buf, size_t n, size_t h) {
+    for (size_t base = 0; base < n; base += 4 * h) {
+        for (size_t j = base; j < base + h; j += 2) {
+            double *p = buf + j;
+            float64x2_t r0 = vld1q_f64(p), r1 = vld1q_f64(p + h);
+            float64x2_t r2 = vld1q_f64(p + 2 * h), r3 = vld1q_f64(p + 3 * h);
 
-    /* Stage 1: butterfly within each pair */
-    double t0 = vgetq_lane_f64(v0, 0);
-    double t1 = vgetq_lane_f64(v0, 1);
-    v0 = vsetq_lane_f64(t0 + t1, v0, 0);
-    v0 = vsetq_lane_f64(t0 - t1, v0, 1);
+            BUTTERFLY_F64(r0, r1); BUTTERFLY_F64(r2, r3);
+            BUTTERFLY_F64(r0, r2); BUTTERFLY_F64(r1, r3);
 
-    t0 = vgetq_lane_f64(v1, 0);
-    t1 = vgetq_lane_f64(v1, 1);
-    v1 = vsetq_lane_f64(t0 + t1, v1, 0);
-    v1 = vsetq_lane_f64(t0 - t1, v1, 1);
+            vst1q_f64(p, r0); vst1q_f64(p + h, r1);
+            vst1q_f64(p + 2 * h, r2); vst1q_f64(p + 3 * h, r3);
+        }
+    }
+}
 
-    /* Stage 2: butterfly with stride 2 */
-    float64x2_t sum = vaddq_f64(v0, v1);
-    float64x2_t diff = vsubq_f64(v0, v1);
+/* One stage (stride h) */
+static inline void pass_double_radix2(double *buf, size_t n, size_t h) {
+    for (size_t base = 0; base < n; base += 2 * h) {
+        for (size_t j = base; j < base + h; j += 2) {
+            float64x2_t a = vld1q_f64(buf + j);
+            float64x2_t b = vld1q_f64(buf + j + h);
+            vst1q_f64(buf + j, vaddq_f64(a, b));
+            vst1q_f64(buf + j + h, vsubq_f64(a, b));
+        }
+    }
+}
+
+/* Iterative kernel for L1-resident blocks, 4 <= log_n <= FHT_NEON_LOG_CHUNK_DOUBLE */
+static void helper_double_iterative(double *buf, int log_n) {
+    size_t n = (size_t)1 << log_n;
+    int stage = 4;
 
-    vst1q_f64(buf, sum);
-    vst1q_f64(buf + 2, diff);
+    pass_double_first(buf, n);
+    for (; stage + 3 <= log_n; stage += 3) {
+        pass_double_radix8(buf, n, (size_t)1 << stage);
+    }
+    if (stage + 2 == log_n) {
+        pass_double_radix4(buf, n, (size_t)1 << stage);
+    } else if (stage + 1 == log_n) {
+        pass_double_radix2(buf, n, (size_t)1 << stage);
+    }
 }
 
 /* Generic recursive helper for larger sizes */
 static void helper_double_recursive(double *buf, int log_n) {
-    if (log_n <= 2) {
-        if (log_n == 1) helper_double_1(buf);
-        else if (log_n == 2) helper_double_2(buf);
+    if (log_n <= FHT_NEON_LOG_CHUNK_DOUBLE) {
+        if (log_n <= FHT_NEON_GEN_MAX_LOG_DOUBLE) {
+            fht_neon_gen_double(buf, log_n);
+        } else {
+            /* Chunk raised past the generated kernels */
+            helper_double_iterative(buf, log_n);
+        }
         return;
     }
 
-    int n = 1 << log_n;
-    int half = n / 2;
+    size_t n = (size_t)1 << log_n;
+    int log_radix = log_n - FHT_NEON_LOG_CHUNK_DOUBLE < 3 ? log_n - FHT_NEON_LOG_CHUNK_DOUBLE : 3;
+    size_t part = n >> log_radix;
+    for (size_t q = 0; q < ((size_t)1 << log_radix); q++) {
+        helper_double_recursive(buf + q * part, log_n - log_radix);
+    }
+    if (log_radix == 3) {
+        pass_double_radix8(buf, n, part);
+    } else if (log_radix == 2) {
+        pass_double_radix4(buf, n, part);
+    } else {
+        pass_double_radix2(buf, n, part);
+    }
+}
 
-    /* Recursively transform both halves */
-    helper_double_recursive(buf, log_n - 1);
-    helper_double_recursive(buf + half, log_n - 1);
+/* Two size-2 transforms at once: lane j of every register belongs to vector j */
+static inline void helper_double_1_x2(double *b0, double *b1) {
+    float64x2_t a = vld1q_f64(b0);
+    float64x2_t b = vld1q_f64(b1);
+    float64x2_t e0 = vtrn1q_f64(a, b);
+    float64x2_t e1 = vtrn2q_f64(a, b);
 
-    /* Combine: butterfly with stride = half */
-    for (int i = 0; i < half; i += 2) {
-        if (i + 2 <= half) {
-            float64x2_t a = vld1q_f64(buf + i);
-            float64x2_t b = vld1q_f64(buf + half + i);
-            float64x2_t sum = vaddq_f64(a, b);
-            float64x2_t diff = vsubq_f64(a, b);
-            vst1q_f64(buf + i, sum);
-            vst1q_f64(buf + half + i, diff);
-        } else {
-            /* Handle remaining elements */
-            for (int j = i; j < half; j++) {
-                double a = buf[j];
-                double b = buf[half + j];
-                buf[j] = a + b;
-                buf[half + j] = a - b;
-            }
+    BUTTERFLY_F64(e0, e1);
+
+    vst1q_f64(b0, vtrn1q_f64(e0, e1));
+    vst1q_f64(b1, vtrn2q_f64(e0, e1));
+}
+
+/* Two size-4 transforms at once, same idea as helper_double_1_x2 */
+static inline void helper_double_2_x2(double *b0, double *b1) {
+    float64x2_t a0 = vld1q_f64(b0), a1 = vld1q_f64(b0 + 2);
+    float64x2_t c0 = vld1q_f64(b1), c1 = vld1q_f64(b1 + 2);
+    float64x2_t e0 = vtrn1q_f64(a0, c0);
+    float64x2_t e1 = vtrn2q_f64(a0, c0);
+    float64x2_t e2 = vtrn1q_f64(a1, c1);
+    float64x2_t e3 = vtrn2q_f64(a1, c1);
+
+    BUTTERFLY_F64(e0, e1);
+    BUTTERFLY_F64(e2, e3);
+    BUTTERFLY_F64(e0, e2);
+    BUTTERFLY_F64(e1, e3);
+
+    vst1q_f64(b0, vtrn1q_f64(e0, e1));
+    vst1q_f64(b0 + 2, vtrn1q_f64(e2, e3));
+    vst1q_f64(b1, vtrn2q_f64(e0, e1));
+    vst1q_f64(b1 + 2, vtrn2q_f64(e2, e3));
+}
+
+/* Batched entry point for double (arguments validated by fht.c) */
+static int fht_double_batch_neon(double *buf, int log_n, size_t count, size_t stride) {
+    size_t i = 0;
+
+    if (log_n == 0) {
+        return 0;
+    }
+
+    /* Small vectors: process two side by side, one per lane */
+    if (log_n == 1) {
+        for (; i + 2 <= count; i += 2) {
+            helper_double_1_x2(buf + i * stride, buf + (i + 1) * stride);
         }
+    } else if (log_n == 2) {
+        for (; i + 2 <= count; i += 2) {
+            helper_double_2_x2(buf + i * stride, buf + (i + 1) * stride);
+        }
+    }
+
+    for (; i < count; i++) {
+        helper_double_recursive(buf + i * stride, log_n);
     }
+    return 0;
 }
 
 /* Main entry point for double */
-int fht_double(double *buf, int log_n) {
+static int fht_double_neon(double *buf, int log_n) {
     if (log_n < 0 || log_n > 30) {
         return -1;
     }
@@ -212,3 +475,15 @@ int fht_double(double *buf, int log_n) {
     helper_double_recursive(buf, log_n);
     return 0;
 }
+
+const fht_kernel fht_kernel_neon = {
+    "neon",
+    fht_float_neon,
+    fht_double_neon,
+    fht_float_batch_neon,
+    fht_double_batch_neon,
+};
+
+#else
+typedef int fht_neon_unused;  /* ISO C forbids an empty translation unit */
+#endif
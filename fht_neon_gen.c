@@ -0,0 +1,4431 @@
+/* Generated by gen_neon.py -- do not edit by hand. */
+/* Included by fht_neon.c after <arm_neon.h>. */
+
+#define FHT_NEON_GEN_MAX_LOG_FLOAT 12
+#define FHT_NEON_GEN_MAX_LOG_DOUBLE 11
+
+static void fht_neon_gen_float_1(float *buf) {
+    float u = buf[0], v = buf[1];
+    buf[0] = u + v;
+    buf[1] = u - v;
+}
+
+static void fht_neon_gen_float_2(float *buf) {
+    float32x4_t v = vld1q_f32(buf);
+    float32x4_t x = vuzp1q_f32(v, v), y = vuzp2q_f32(v, v);
+    float32x4_t z = vzip1q_f32(vaddq_f32(x, y), vsubq_f32(x, y));
+    float32x2_t lo = vget_low_f32(z), hi = vget_high_f32(z);
+    vst1q_f32(buf, vcombine_f32(vadd_f32(lo, hi), vsub_f32(lo, hi)));
+}
+
+static void fht_neon_gen_float_3(float *buf) {
+    float32x4_t r0 = vld1q_f32(buf + 0);
+    float32x4_t r1 = vld1q_f32(buf + 4);
+    {
+        float32x4_t ev = vtrn1q_f32(r0, r1), od = vtrn2q_f32(r0, r1);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r0 = vuzp1q_f32(x, y);
+        r1 = vuzp2q_f32(x, y);
+    }
+    { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+    vst1q_f32(buf + 0, r0);
+    vst1q_f32(buf + 4, r1);
+}
+
+static void fht_neon_gen_float_4(float *buf) {
+    float32x4_t r0 = vld1q_f32(buf + 0);
+    float32x4_t r1 = vld1q_f32(buf + 4);
+    {
+        float32x4_t ev = vtrn1q_f32(r0, r1), od = vtrn2q_f32(r0, r1);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r0 = vuzp1q_f32(x, y);
+        r1 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r2 = vld1q_f32(buf + 8);
+    float32x4_t r3 = vld1q_f32(buf + 12);
+    {
+        float32x4_t ev = vtrn1q_f32(r2, r3), od = vtrn2q_f32(r2, r3);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r2 = vuzp1q_f32(x, y);
+        r3 = vuzp2q_f32(x, y);
+    }
+    { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+    vst1q_f32(buf + 0, r0);
+    vst1q_f32(buf + 4, r1);
+    vst1q_f32(buf + 8, r2);
+    vst1q_f32(buf + 12, r3);
+}
+
+static void fht_neon_gen_float_5(float *buf) {
+    float32x4_t r0 = vld1q_f32(buf + 0);
+    float32x4_t r1 = vld1q_f32(buf + 4);
+    {
+        float32x4_t ev = vtrn1q_f32(r0, r1), od = vtrn2q_f32(r0, r1);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r0 = vuzp1q_f32(x, y);
+        r1 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r2 = vld1q_f32(buf + 8);
+    float32x4_t r3 = vld1q_f32(buf + 12);
+    {
+        float32x4_t ev = vtrn1q_f32(r2, r3), od = vtrn2q_f32(r2, r3);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r2 = vuzp1q_f32(x, y);
+        r3 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r4 = vld1q_f32(buf + 16);
+    float32x4_t r5 = vld1q_f32(buf + 20);
+    {
+        float32x4_t ev = vtrn1q_f32(r4, r5), od = vtrn2q_f32(r4, r5);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r4 = vuzp1q_f32(x, y);
+        r5 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r6 = vld1q_f32(buf + 24);
+    float32x4_t r7 = vld1q_f32(buf + 28);
+    {
+        float32x4_t ev = vtrn1q_f32(r6, r7), od = vtrn2q_f32(r6, r7);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r6 = vuzp1q_f32(x, y);
+        r7 = vuzp2q_f32(x, y);
+    }
+    { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r4, r5); r5 = vsubq_f32(r4, r5); r4 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r6, r7); r7 = vsubq_f32(r6, r7); r6 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r4, r6); r6 = vsubq_f32(r4, r6); r4 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r5, r7); r7 = vsubq_f32(r5, r7); r5 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r0, r4); r4 = vsubq_f32(r0, r4); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r1, r5); r5 = vsubq_f32(r1, r5); r1 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r2, r6); r6 = vsubq_f32(r2, r6); r2 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r3, r7); r7 = vsubq_f32(r3, r7); r3 = tmp; }
+    vst1q_f32(buf + 0, r0);
+    vst1q_f32(buf + 4, r1);
+    vst1q_f32(buf + 8, r2);
+    vst1q_f32(buf + 12, r3);
+    vst1q_f32(buf + 16, r4);
+    vst1q_f32(buf + 20, r5);
+    vst1q_f32(buf + 24, r6);
+    vst1q_f32(buf + 28, r7);
+}
+
+static void fht_neon_gen_float_6(float *buf) {
+    float32x4_t r0 = vld1q_f32(buf + 0);
+    float32x4_t r1 = vld1q_f32(buf + 4);
+    {
+        float32x4_t ev = vtrn1q_f32(r0, r1), od = vtrn2q_f32(r0, r1);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r0 = vuzp1q_f32(x, y);
+        r1 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r2 = vld1q_f32(buf + 8);
+    float32x4_t r3 = vld1q_f32(buf + 12);
+    {
+        float32x4_t ev = vtrn1q_f32(r2, r3), od = vtrn2q_f32(r2, r3);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r2 = vuzp1q_f32(x, y);
+        r3 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r4 = vld1q_f32(buf + 16);
+    float32x4_t r5 = vld1q_f32(buf + 20);
+    {
+        float32x4_t ev = vtrn1q_f32(r4, r5), od = vtrn2q_f32(r4, r5);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r4 = vuzp1q_f32(x, y);
+        r5 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r6 = vld1q_f32(buf + 24);
+    float32x4_t r7 = vld1q_f32(buf + 28);
+    {
+        float32x4_t ev = vtrn1q_f32(r6, r7), od = vtrn2q_f32(r6, r7);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r6 = vuzp1q_f32(x, y);
+        r7 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r8 = vld1q_f32(buf + 32);
+    float32x4_t r9 = vld1q_f32(buf + 36);
+    {
+        float32x4_t ev = vtrn1q_f32(r8, r9), od = vtrn2q_f32(r8, r9);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r8 = vuzp1q_f32(x, y);
+        r9 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r10 = vld1q_f32(buf + 40);
+    float32x4_t r11 = vld1q_f32(buf + 44);
+    {
+        float32x4_t ev = vtrn1q_f32(r10, r11), od = vtrn2q_f32(r10, r11);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r10 = vuzp1q_f32(x, y);
+        r11 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r12 = vld1q_f32(buf + 48);
+    float32x4_t r13 = vld1q_f32(buf + 52);
+    {
+        float32x4_t ev = vtrn1q_f32(r12, r13), od = vtrn2q_f32(r12, r13);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r12 = vuzp1q_f32(x, y);
+        r13 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r14 = vld1q_f32(buf + 56);
+    float32x4_t r15 = vld1q_f32(buf + 60);
+    {
+        float32x4_t ev = vtrn1q_f32(r14, r15), od = vtrn2q_f32(r14, r15);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r14 = vuzp1q_f32(x, y);
+        r15 = vuzp2q_f32(x, y);
+    }
+    { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r4, r5); r5 = vsubq_f32(r4, r5); r4 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r6, r7); r7 = vsubq_f32(r6, r7); r6 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r8, r9); r9 = vsubq_f32(r8, r9); r8 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r10, r11); r11 = vsubq_f32(r10, r11); r10 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r12, r13); r13 = vsubq_f32(r12, r13); r12 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r14, r15); r15 = vsubq_f32(r14, r15); r14 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r4, r6); r6 = vsubq_f32(r4, r6); r4 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r5, r7); r7 = vsubq_f32(r5, r7); r5 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r8, r10); r10 = vsubq_f32(r8, r10); r8 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r9, r11); r11 = vsubq_f32(r9, r11); r9 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r12, r14); r14 = vsubq_f32(r12, r14); r12 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r13, r15); r15 = vsubq_f32(r13, r15); r13 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r0, r4); r4 = vsubq_f32(r0, r4); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r1, r5); r5 = vsubq_f32(r1, r5); r1 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r2, r6); r6 = vsubq_f32(r2, r6); r2 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r3, r7); r7 = vsubq_f32(r3, r7); r3 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r8, r12); r12 = vsubq_f32(r8, r12); r8 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r9, r13); r13 = vsubq_f32(r9, r13); r9 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r10, r14); r14 = vsubq_f32(r10, r14); r10 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r11, r15); r15 = vsubq_f32(r11, r15); r11 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r0, r8); r8 = vsubq_f32(r0, r8); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r1, r9); r9 = vsubq_f32(r1, r9); r1 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r2, r10); r10 = vsubq_f32(r2, r10); r2 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r3, r11); r11 = vsubq_f32(r3, r11); r3 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r4, r12); r12 = vsubq_f32(r4, r12); r4 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r5, r13); r13 = vsubq_f32(r5, r13); r5 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r6, r14); r14 = vsubq_f32(r6, r14); r6 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r7, r15); r15 = vsubq_f32(r7, r15); r7 = tmp; }
+    vst1q_f32(buf + 0, r0);
+    vst1q_f32(buf + 4, r1);
+    vst1q_f32(buf + 8, r2);
+    vst1q_f32(buf + 12, r3);
+    vst1q_f32(buf + 16, r4);
+    vst1q_f32(buf + 20, r5);
+    vst1q_f32(buf + 24, r6);
+    vst1q_f32(buf + 28, r7);
+    vst1q_f32(buf + 32, r8);
+    vst1q_f32(buf + 36, r9);
+    vst1q_f32(buf + 40, r10);
+    vst1q_f32(buf + 44, r11);
+    vst1q_f32(buf + 48, r12);
+    vst1q_f32(buf + 52, r13);
+    vst1q_f32(buf + 56, r14);
+    vst1q_f32(buf + 60, r15);
+}
+
+static void fht_neon_gen_float_7(float *buf) {
+    float32x4_t r0 = vld1q_f32(buf + 0);
+    float32x4_t r1 = vld1q_f32(buf + 4);
+    {
+        float32x4_t ev = vtrn1q_f32(r0, r1), od = vtrn2q_f32(r0, r1);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r0 = vuzp1q_f32(x, y);
+        r1 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r2 = vld1q_f32(buf + 8);
+    float32x4_t r3 = vld1q_f32(buf + 12);
+    {
+        float32x4_t ev = vtrn1q_f32(r2, r3), od = vtrn2q_f32(r2, r3);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r2 = vuzp1q_f32(x, y);
+        r3 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r4 = vld1q_f32(buf + 16);
+    float32x4_t r5 = vld1q_f32(buf + 20);
+    {
+        float32x4_t ev = vtrn1q_f32(r4, r5), od = vtrn2q_f32(r4, r5);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r4 = vuzp1q_f32(x, y);
+        r5 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r6 = vld1q_f32(buf + 24);
+    float32x4_t r7 = vld1q_f32(buf + 28);
+    {
+        float32x4_t ev = vtrn1q_f32(r6, r7), od = vtrn2q_f32(r6, r7);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r6 = vuzp1q_f32(x, y);
+        r7 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r8 = vld1q_f32(buf + 32);
+    float32x4_t r9 = vld1q_f32(buf + 36);
+    {
+        float32x4_t ev = vtrn1q_f32(r8, r9), od = vtrn2q_f32(r8, r9);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r8 = vuzp1q_f32(x, y);
+        r9 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r10 = vld1q_f32(buf + 40);
+    float32x4_t r11 = vld1q_f32(buf + 44);
+    {
+        float32x4_t ev = vtrn1q_f32(r10, r11), od = vtrn2q_f32(r10, r11);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r10 = vuzp1q_f32(x, y);
+        r11 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r12 = vld1q_f32(buf + 48);
+    float32x4_t r13 = vld1q_f32(buf + 52);
+    {
+        float32x4_t ev = vtrn1q_f32(r12, r13), od = vtrn2q_f32(r12, r13);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r12 = vuzp1q_f32(x, y);
+        r13 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r14 = vld1q_f32(buf + 56);
+    float32x4_t r15 = vld1q_f32(buf + 60);
+    {
+        float32x4_t ev = vtrn1q_f32(r14, r15), od = vtrn2q_f32(r14, r15);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r14 = vuzp1q_f32(x, y);
+        r15 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r16 = vld1q_f32(buf + 64);
+    float32x4_t r17 = vld1q_f32(buf + 68);
+    {
+        float32x4_t ev = vtrn1q_f32(r16, r17), od = vtrn2q_f32(r16, r17);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r16 = vuzp1q_f32(x, y);
+        r17 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r18 = vld1q_f32(buf + 72);
+    float32x4_t r19 = vld1q_f32(buf + 76);
+    {
+        float32x4_t ev = vtrn1q_f32(r18, r19), od = vtrn2q_f32(r18, r19);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r18 = vuzp1q_f32(x, y);
+        r19 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r20 = vld1q_f32(buf + 80);
+    float32x4_t r21 = vld1q_f32(buf + 84);
+    {
+        float32x4_t ev = vtrn1q_f32(r20, r21), od = vtrn2q_f32(r20, r21);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r20 = vuzp1q_f32(x, y);
+        r21 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r22 = vld1q_f32(buf + 88);
+    float32x4_t r23 = vld1q_f32(buf + 92);
+    {
+        float32x4_t ev = vtrn1q_f32(r22, r23), od = vtrn2q_f32(r22, r23);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r22 = vuzp1q_f32(x, y);
+        r23 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r24 = vld1q_f32(buf + 96);
+    float32x4_t r25 = vld1q_f32(buf + 100);
+    {
+        float32x4_t ev = vtrn1q_f32(r24, r25), od = vtrn2q_f32(r24, r25);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r24 = vuzp1q_f32(x, y);
+        r25 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r26 = vld1q_f32(buf + 104);
+    float32x4_t r27 = vld1q_f32(buf + 108);
+    {
+        float32x4_t ev = vtrn1q_f32(r26, r27), od = vtrn2q_f32(r26, r27);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r26 = vuzp1q_f32(x, y);
+        r27 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r28 = vld1q_f32(buf + 112);
+    float32x4_t r29 = vld1q_f32(buf + 116);
+    {
+        float32x4_t ev = vtrn1q_f32(r28, r29), od = vtrn2q_f32(r28, r29);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r28 = vuzp1q_f32(x, y);
+        r29 = vuzp2q_f32(x, y);
+    }
+    float32x4_t r30 = vld1q_f32(buf + 120);
+    float32x4_t r31 = vld1q_f32(buf + 124);
+    {
+        float32x4_t ev = vtrn1q_f32(r30, r31), od = vtrn2q_f32(r30, r31);
+        float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+        float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+        float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+        float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+        float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+        r30 = vuzp1q_f32(x, y);
+        r31 = vuzp2q_f32(x, y);
+    }
+    { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r4, r5); r5 = vsubq_f32(r4, r5); r4 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r6, r7); r7 = vsubq_f32(r6, r7); r6 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r8, r9); r9 = vsubq_f32(r8, r9); r8 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r10, r11); r11 = vsubq_f32(r10, r11); r10 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r12, r13); r13 = vsubq_f32(r12, r13); r12 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r14, r15); r15 = vsubq_f32(r14, r15); r14 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r16, r17); r17 = vsubq_f32(r16, r17); r16 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r18, r19); r19 = vsubq_f32(r18, r19); r18 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r20, r21); r21 = vsubq_f32(r20, r21); r20 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r22, r23); r23 = vsubq_f32(r22, r23); r22 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r24, r25); r25 = vsubq_f32(r24, r25); r24 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r26, r27); r27 = vsubq_f32(r26, r27); r26 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r28, r29); r29 = vsubq_f32(r28, r29); r28 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r30, r31); r31 = vsubq_f32(r30, r31); r30 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r4, r6); r6 = vsubq_f32(r4, r6); r4 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r5, r7); r7 = vsubq_f32(r5, r7); r5 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r8, r10); r10 = vsubq_f32(r8, r10); r8 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r9, r11); r11 = vsubq_f32(r9, r11); r9 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r12, r14); r14 = vsubq_f32(r12, r14); r12 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r13, r15); r15 = vsubq_f32(r13, r15); r13 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r16, r18); r18 = vsubq_f32(r16, r18); r16 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r17, r19); r19 = vsubq_f32(r17, r19); r17 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r20, r22); r22 = vsubq_f32(r20, r22); r20 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r21, r23); r23 = vsubq_f32(r21, r23); r21 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r24, r26); r26 = vsubq_f32(r24, r26); r24 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r25, r27); r27 = vsubq_f32(r25, r27); r25 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r28, r30); r30 = vsubq_f32(r28, r30); r28 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r29, r31); r31 = vsubq_f32(r29, r31); r29 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r0, r4); r4 = vsubq_f32(r0, r4); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r1, r5); r5 = vsubq_f32(r1, r5); r1 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r2, r6); r6 = vsubq_f32(r2, r6); r2 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r3, r7); r7 = vsubq_f32(r3, r7); r3 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r8, r12); r12 = vsubq_f32(r8, r12); r8 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r9, r13); r13 = vsubq_f32(r9, r13); r9 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r10, r14); r14 = vsubq_f32(r10, r14); r10 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r11, r15); r15 = vsubq_f32(r11, r15); r11 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r16, r20); r20 = vsubq_f32(r16, r20); r16 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r17, r21); r21 = vsubq_f32(r17, r21); r17 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r18, r22); r22 = vsubq_f32(r18, r22); r18 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r19, r23); r23 = vsubq_f32(r19, r23); r19 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r24, r28); r28 = vsubq_f32(r24, r28); r24 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r25, r29); r29 = vsubq_f32(r25, r29); r25 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r26, r30); r30 = vsubq_f32(r26, r30); r26 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r27, r31); r31 = vsubq_f32(r27, r31); r27 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r0, r8); r8 = vsubq_f32(r0, r8); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r1, r9); r9 = vsubq_f32(r1, r9); r1 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r2, r10); r10 = vsubq_f32(r2, r10); r2 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r3, r11); r11 = vsubq_f32(r3, r11); r3 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r4, r12); r12 = vsubq_f32(r4, r12); r4 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r5, r13); r13 = vsubq_f32(r5, r13); r5 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r6, r14); r14 = vsubq_f32(r6, r14); r6 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r7, r15); r15 = vsubq_f32(r7, r15); r7 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r16, r24); r24 = vsubq_f32(r16, r24); r16 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r17, r25); r25 = vsubq_f32(r17, r25); r17 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r18, r26); r26 = vsubq_f32(r18, r26); r18 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r19, r27); r27 = vsubq_f32(r19, r27); r19 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r20, r28); r28 = vsubq_f32(r20, r28); r20 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r21, r29); r29 = vsubq_f32(r21, r29); r21 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r22, r30); r30 = vsubq_f32(r22, r30); r22 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r23, r31); r31 = vsubq_f32(r23, r31); r23 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r0, r16); r16 = vsubq_f32(r0, r16); r0 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r1, r17); r17 = vsubq_f32(r1, r17); r1 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r2, r18); r18 = vsubq_f32(r2, r18); r2 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r3, r19); r19 = vsubq_f32(r3, r19); r3 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r4, r20); r20 = vsubq_f32(r4, r20); r4 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r5, r21); r21 = vsubq_f32(r5, r21); r5 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r6, r22); r22 = vsubq_f32(r6, r22); r6 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r7, r23); r23 = vsubq_f32(r7, r23); r7 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r8, r24); r24 = vsubq_f32(r8, r24); r8 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r9, r25); r25 = vsubq_f32(r9, r25); r9 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r10, r26); r26 = vsubq_f32(r10, r26); r10 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r11, r27); r27 = vsubq_f32(r11, r27); r11 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r12, r28); r28 = vsubq_f32(r12, r28); r12 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r13, r29); r29 = vsubq_f32(r13, r29); r13 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r14, r30); r30 = vsubq_f32(r14, r30); r14 = tmp; }
+    { float32x4_t tmp = vaddq_f32(r15, r31); r31 = vsubq_f32(r15, r31); r15 = tmp; }
+    vst1q_f32(buf + 0, r0);
+    vst1q_f32(buf + 4, r1);
+    vst1q_f32(buf + 8, r2);
+    vst1q_f32(buf + 12, r3);
+    vst1q_f32(buf + 16, r4);
+    vst1q_f32(buf + 20, r5);
+    vst1q_f32(buf + 24, r6);
+    vst1q_f32(buf + 28, r7);
+    vst1q_f32(buf + 32, r8);
+    vst1q_f32(buf + 36, r9);
+    vst1q_f32(buf + 40, r10);
+    vst1q_f32(buf + 44, r11);
+    vst1q_f32(buf + 48, r12);
+    vst1q_f32(buf + 52, r13);
+    vst1q_f32(buf + 56, r14);
+    vst1q_f32(buf + 60, r15);
+    vst1q_f32(buf + 64, r16);
+    vst1q_f32(buf + 68, r17);
+    vst1q_f32(buf + 72, r18);
+    vst1q_f32(buf + 76, r19);
+    vst1q_f32(buf + 80, r20);
+    vst1q_f32(buf + 84, r21);
+    vst1q_f32(buf + 88, r22);
+    vst1q_f32(buf + 92, r23);
+    vst1q_f32(buf + 96, r24);
+    vst1q_f32(buf + 100, r25);
+    vst1q_f32(buf + 104, r26);
+    vst1q_f32(buf + 108, r27);
+    vst1q_f32(buf + 112, r28);
+    vst1q_f32(buf + 116, r29);
+    vst1q_f32(buf + 120, r30);
+    vst1q_f32(buf + 124, r31);
+}
+
+static void fht_neon_gen_float_8(float *buf) {
+    for (size_t i = 0; i < 256; i += 128) {
+        float *p = buf + i;
+        float32x4_t r0 = vld1q_f32(p + 0);
+        float32x4_t r1 = vld1q_f32(p + 4);
+        {
+            float32x4_t ev = vtrn1q_f32(r0, r1), od = vtrn2q_f32(r0, r1);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r0 = vuzp1q_f32(x, y);
+            r1 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r2 = vld1q_f32(p + 8);
+        float32x4_t r3 = vld1q_f32(p + 12);
+        {
+            float32x4_t ev = vtrn1q_f32(r2, r3), od = vtrn2q_f32(r2, r3);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r2 = vuzp1q_f32(x, y);
+            r3 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r4 = vld1q_f32(p + 16);
+        float32x4_t r5 = vld1q_f32(p + 20);
+        {
+            float32x4_t ev = vtrn1q_f32(r4, r5), od = vtrn2q_f32(r4, r5);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r4 = vuzp1q_f32(x, y);
+            r5 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r6 = vld1q_f32(p + 24);
+        float32x4_t r7 = vld1q_f32(p + 28);
+        {
+            float32x4_t ev = vtrn1q_f32(r6, r7), od = vtrn2q_f32(r6, r7);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r6 = vuzp1q_f32(x, y);
+            r7 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r8 = vld1q_f32(p + 32);
+        float32x4_t r9 = vld1q_f32(p + 36);
+        {
+            float32x4_t ev = vtrn1q_f32(r8, r9), od = vtrn2q_f32(r8, r9);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r8 = vuzp1q_f32(x, y);
+            r9 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r10 = vld1q_f32(p + 40);
+        float32x4_t r11 = vld1q_f32(p + 44);
+        {
+            float32x4_t ev = vtrn1q_f32(r10, r11), od = vtrn2q_f32(r10, r11);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r10 = vuzp1q_f32(x, y);
+            r11 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r12 = vld1q_f32(p + 48);
+        float32x4_t r13 = vld1q_f32(p + 52);
+        {
+            float32x4_t ev = vtrn1q_f32(r12, r13), od = vtrn2q_f32(r12, r13);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r12 = vuzp1q_f32(x, y);
+            r13 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r14 = vld1q_f32(p + 56);
+        float32x4_t r15 = vld1q_f32(p + 60);
+        {
+            float32x4_t ev = vtrn1q_f32(r14, r15), od = vtrn2q_f32(r14, r15);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r14 = vuzp1q_f32(x, y);
+            r15 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r16 = vld1q_f32(p + 64);
+        float32x4_t r17 = vld1q_f32(p + 68);
+        {
+            float32x4_t ev = vtrn1q_f32(r16, r17), od = vtrn2q_f32(r16, r17);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r16 = vuzp1q_f32(x, y);
+            r17 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r18 = vld1q_f32(p + 72);
+        float32x4_t r19 = vld1q_f32(p + 76);
+        {
+            float32x4_t ev = vtrn1q_f32(r18, r19), od = vtrn2q_f32(r18, r19);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r18 = vuzp1q_f32(x, y);
+            r19 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r20 = vld1q_f32(p + 80);
+        float32x4_t r21 = vld1q_f32(p + 84);
+        {
+            float32x4_t ev = vtrn1q_f32(r20, r21), od = vtrn2q_f32(r20, r21);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r20 = vuzp1q_f32(x, y);
+            r21 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r22 = vld1q_f32(p + 88);
+        float32x4_t r23 = vld1q_f32(p + 92);
+        {
+            float32x4_t ev = vtrn1q_f32(r22, r23), od = vtrn2q_f32(r22, r23);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r22 = vuzp1q_f32(x, y);
+            r23 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r24 = vld1q_f32(p + 96);
+        float32x4_t r25 = vld1q_f32(p + 100);
+        {
+            float32x4_t ev = vtrn1q_f32(r24, r25), od = vtrn2q_f32(r24, r25);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r24 = vuzp1q_f32(x, y);
+            r25 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r26 = vld1q_f32(p + 104);
+        float32x4_t r27 = vld1q_f32(p + 108);
+        {
+            float32x4_t ev = vtrn1q_f32(r26, r27), od = vtrn2q_f32(r26, r27);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r26 = vuzp1q_f32(x, y);
+            r27 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r28 = vld1q_f32(p + 112);
+        float32x4_t r29 = vld1q_f32(p + 116);
+        {
+            float32x4_t ev = vtrn1q_f32(r28, r29), od = vtrn2q_f32(r28, r29);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r28 = vuzp1q_f32(x, y);
+            r29 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r30 = vld1q_f32(p + 120);
+        float32x4_t r31 = vld1q_f32(p + 124);
+        {
+            float32x4_t ev = vtrn1q_f32(r30, r31), od = vtrn2q_f32(r30, r31);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r30 = vuzp1q_f32(x, y);
+            r31 = vuzp2q_f32(x, y);
+        }
+        { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r5); r5 = vsubq_f32(r4, r5); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r7); r7 = vsubq_f32(r6, r7); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r9); r9 = vsubq_f32(r8, r9); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r11); r11 = vsubq_f32(r10, r11); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r13); r13 = vsubq_f32(r12, r13); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r14, r15); r15 = vsubq_f32(r14, r15); r14 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r17); r17 = vsubq_f32(r16, r17); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r19); r19 = vsubq_f32(r18, r19); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r21); r21 = vsubq_f32(r20, r21); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r22, r23); r23 = vsubq_f32(r22, r23); r22 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r25); r25 = vsubq_f32(r24, r25); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r26, r27); r27 = vsubq_f32(r26, r27); r26 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r28, r29); r29 = vsubq_f32(r28, r29); r28 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r30, r31); r31 = vsubq_f32(r30, r31); r30 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r6); r6 = vsubq_f32(r4, r6); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r7); r7 = vsubq_f32(r5, r7); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r10); r10 = vsubq_f32(r8, r10); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r11); r11 = vsubq_f32(r9, r11); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r14); r14 = vsubq_f32(r12, r14); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r13, r15); r15 = vsubq_f32(r13, r15); r13 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r18); r18 = vsubq_f32(r16, r18); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r19); r19 = vsubq_f32(r17, r19); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r22); r22 = vsubq_f32(r20, r22); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r21, r23); r23 = vsubq_f32(r21, r23); r21 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r26); r26 = vsubq_f32(r24, r26); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r25, r27); r27 = vsubq_f32(r25, r27); r25 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r28, r30); r30 = vsubq_f32(r28, r30); r28 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r29, r31); r31 = vsubq_f32(r29, r31); r29 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r4); r4 = vsubq_f32(r0, r4); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r5); r5 = vsubq_f32(r1, r5); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r6); r6 = vsubq_f32(r2, r6); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r7); r7 = vsubq_f32(r3, r7); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r12); r12 = vsubq_f32(r8, r12); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r13); r13 = vsubq_f32(r9, r13); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r14); r14 = vsubq_f32(r10, r14); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r11, r15); r15 = vsubq_f32(r11, r15); r11 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r20); r20 = vsubq_f32(r16, r20); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r21); r21 = vsubq_f32(r17, r21); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r22); r22 = vsubq_f32(r18, r22); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r19, r23); r23 = vsubq_f32(r19, r23); r19 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r28); r28 = vsubq_f32(r24, r28); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r25, r29); r29 = vsubq_f32(r25, r29); r25 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r26, r30); r30 = vsubq_f32(r26, r30); r26 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r27, r31); r31 = vsubq_f32(r27, r31); r27 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r8); r8 = vsubq_f32(r0, r8); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r9); r9 = vsubq_f32(r1, r9); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r10); r10 = vsubq_f32(r2, r10); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r11); r11 = vsubq_f32(r3, r11); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r12); r12 = vsubq_f32(r4, r12); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r13); r13 = vsubq_f32(r5, r13); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r14); r14 = vsubq_f32(r6, r14); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r7, r15); r15 = vsubq_f32(r7, r15); r7 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r24); r24 = vsubq_f32(r16, r24); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r25); r25 = vsubq_f32(r17, r25); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r26); r26 = vsubq_f32(r18, r26); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r19, r27); r27 = vsubq_f32(r19, r27); r19 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r28); r28 = vsubq_f32(r20, r28); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r21, r29); r29 = vsubq_f32(r21, r29); r21 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r22, r30); r30 = vsubq_f32(r22, r30); r22 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r23, r31); r31 = vsubq_f32(r23, r31); r23 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r16); r16 = vsubq_f32(r0, r16); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r17); r17 = vsubq_f32(r1, r17); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r18); r18 = vsubq_f32(r2, r18); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r19); r19 = vsubq_f32(r3, r19); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r20); r20 = vsubq_f32(r4, r20); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r21); r21 = vsubq_f32(r5, r21); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r22); r22 = vsubq_f32(r6, r22); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r7, r23); r23 = vsubq_f32(r7, r23); r7 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r24); r24 = vsubq_f32(r8, r24); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r25); r25 = vsubq_f32(r9, r25); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r26); r26 = vsubq_f32(r10, r26); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r11, r27); r27 = vsubq_f32(r11, r27); r11 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r28); r28 = vsubq_f32(r12, r28); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r13, r29); r29 = vsubq_f32(r13, r29); r13 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r14, r30); r30 = vsubq_f32(r14, r30); r14 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r15, r31); r31 = vsubq_f32(r15, r31); r15 = tmp; }
+        vst1q_f32(p + 0, r0);
+        vst1q_f32(p + 4, r1);
+        vst1q_f32(p + 8, r2);
+        vst1q_f32(p + 12, r3);
+        vst1q_f32(p + 16, r4);
+        vst1q_f32(p + 20, r5);
+        vst1q_f32(p + 24, r6);
+        vst1q_f32(p + 28, r7);
+        vst1q_f32(p + 32, r8);
+        vst1q_f32(p + 36, r9);
+        vst1q_f32(p + 40, r10);
+        vst1q_f32(p + 44, r11);
+        vst1q_f32(p + 48, r12);
+        vst1q_f32(p + 52, r13);
+        vst1q_f32(p + 56, r14);
+        vst1q_f32(p + 60, r15);
+        vst1q_f32(p + 64, r16);
+        vst1q_f32(p + 68, r17);
+        vst1q_f32(p + 72, r18);
+        vst1q_f32(p + 76, r19);
+        vst1q_f32(p + 80, r20);
+        vst1q_f32(p + 84, r21);
+        vst1q_f32(p + 88, r22);
+        vst1q_f32(p + 92, r23);
+        vst1q_f32(p + 96, r24);
+        vst1q_f32(p + 100, r25);
+        vst1q_f32(p + 104, r26);
+        vst1q_f32(p + 108, r27);
+        vst1q_f32(p + 112, r28);
+        vst1q_f32(p + 116, r29);
+        vst1q_f32(p + 120, r30);
+        vst1q_f32(p + 124, r31);
+    }
+    for (size_t i = 0; i < 256; i += 256) {
+        for (size_t j = i; j < i + 128; j += 4) {
+            float *p = buf + j;
+            float32x4_t r0 = vld1q_f32(p + 0);
+            float32x4_t r1 = vld1q_f32(p + 128);
+            { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+            vst1q_f32(p + 0, r0);
+            vst1q_f32(p + 128, r1);
+        }
+    }
+}
+
+static void fht_neon_gen_float_9(float *buf) {
+    for (size_t i = 0; i < 512; i += 128) {
+        float *p = buf + i;
+        float32x4_t r0 = vld1q_f32(p + 0);
+        float32x4_t r1 = vld1q_f32(p + 4);
+        {
+            float32x4_t ev = vtrn1q_f32(r0, r1), od = vtrn2q_f32(r0, r1);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r0 = vuzp1q_f32(x, y);
+            r1 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r2 = vld1q_f32(p + 8);
+        float32x4_t r3 = vld1q_f32(p + 12);
+        {
+            float32x4_t ev = vtrn1q_f32(r2, r3), od = vtrn2q_f32(r2, r3);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r2 = vuzp1q_f32(x, y);
+            r3 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r4 = vld1q_f32(p + 16);
+        float32x4_t r5 = vld1q_f32(p + 20);
+        {
+            float32x4_t ev = vtrn1q_f32(r4, r5), od = vtrn2q_f32(r4, r5);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r4 = vuzp1q_f32(x, y);
+            r5 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r6 = vld1q_f32(p + 24);
+        float32x4_t r7 = vld1q_f32(p + 28);
+        {
+            float32x4_t ev = vtrn1q_f32(r6, r7), od = vtrn2q_f32(r6, r7);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r6 = vuzp1q_f32(x, y);
+            r7 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r8 = vld1q_f32(p + 32);
+        float32x4_t r9 = vld1q_f32(p + 36);
+        {
+            float32x4_t ev = vtrn1q_f32(r8, r9), od = vtrn2q_f32(r8, r9);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r8 = vuzp1q_f32(x, y);
+            r9 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r10 = vld1q_f32(p + 40);
+        float32x4_t r11 = vld1q_f32(p + 44);
+        {
+            float32x4_t ev = vtrn1q_f32(r10, r11), od = vtrn2q_f32(r10, r11);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r10 = vuzp1q_f32(x, y);
+            r11 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r12 = vld1q_f32(p + 48);
+        float32x4_t r13 = vld1q_f32(p + 52);
+        {
+            float32x4_t ev = vtrn1q_f32(r12, r13), od = vtrn2q_f32(r12, r13);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r12 = vuzp1q_f32(x, y);
+            r13 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r14 = vld1q_f32(p + 56);
+        float32x4_t r15 = vld1q_f32(p + 60);
+        {
+            float32x4_t ev = vtrn1q_f32(r14, r15), od = vtrn2q_f32(r14, r15);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r14 = vuzp1q_f32(x, y);
+            r15 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r16 = vld1q_f32(p + 64);
+        float32x4_t r17 = vld1q_f32(p + 68);
+        {
+            float32x4_t ev = vtrn1q_f32(r16, r17), od = vtrn2q_f32(r16, r17);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r16 = vuzp1q_f32(x, y);
+            r17 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r18 = vld1q_f32(p + 72);
+        float32x4_t r19 = vld1q_f32(p + 76);
+        {
+            float32x4_t ev = vtrn1q_f32(r18, r19), od = vtrn2q_f32(r18, r19);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r18 = vuzp1q_f32(x, y);
+            r19 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r20 = vld1q_f32(p + 80);
+        float32x4_t r21 = vld1q_f32(p + 84);
+        {
+            float32x4_t ev = vtrn1q_f32(r20, r21), od = vtrn2q_f32(r20, r21);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r20 = vuzp1q_f32(x, y);
+            r21 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r22 = vld1q_f32(p + 88);
+        float32x4_t r23 = vld1q_f32(p + 92);
+        {
+            float32x4_t ev = vtrn1q_f32(r22, r23), od = vtrn2q_f32(r22, r23);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r22 = vuzp1q_f32(x, y);
+            r23 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r24 = vld1q_f32(p + 96);
+        float32x4_t r25 = vld1q_f32(p + 100);
+        {
+            float32x4_t ev = vtrn1q_f32(r24, r25), od = vtrn2q_f32(r24, r25);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r24 = vuzp1q_f32(x, y);
+            r25 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r26 = vld1q_f32(p + 104);
+        float32x4_t r27 = vld1q_f32(p + 108);
+        {
+            float32x4_t ev = vtrn1q_f32(r26, r27), od = vtrn2q_f32(r26, r27);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r26 = vuzp1q_f32(x, y);
+            r27 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r28 = vld1q_f32(p + 112);
+        float32x4_t r29 = vld1q_f32(p + 116);
+        {
+            float32x4_t ev = vtrn1q_f32(r28, r29), od = vtrn2q_f32(r28, r29);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r28 = vuzp1q_f32(x, y);
+            r29 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r30 = vld1q_f32(p + 120);
+        float32x4_t r31 = vld1q_f32(p + 124);
+        {
+            float32x4_t ev = vtrn1q_f32(r30, r31), od = vtrn2q_f32(r30, r31);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r30 = vuzp1q_f32(x, y);
+            r31 = vuzp2q_f32(x, y);
+        }
+        { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r5); r5 = vsubq_f32(r4, r5); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r7); r7 = vsubq_f32(r6, r7); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r9); r9 = vsubq_f32(r8, r9); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r11); r11 = vsubq_f32(r10, r11); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r13); r13 = vsubq_f32(r12, r13); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r14, r15); r15 = vsubq_f32(r14, r15); r14 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r17); r17 = vsubq_f32(r16, r17); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r19); r19 = vsubq_f32(r18, r19); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r21); r21 = vsubq_f32(r20, r21); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r22, r23); r23 = vsubq_f32(r22, r23); r22 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r25); r25 = vsubq_f32(r24, r25); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r26, r27); r27 = vsubq_f32(r26, r27); r26 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r28, r29); r29 = vsubq_f32(r28, r29); r28 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r30, r31); r31 = vsubq_f32(r30, r31); r30 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r6); r6 = vsubq_f32(r4, r6); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r7); r7 = vsubq_f32(r5, r7); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r10); r10 = vsubq_f32(r8, r10); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r11); r11 = vsubq_f32(r9, r11); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r14); r14 = vsubq_f32(r12, r14); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r13, r15); r15 = vsubq_f32(r13, r15); r13 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r18); r18 = vsubq_f32(r16, r18); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r19); r19 = vsubq_f32(r17, r19); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r22); r22 = vsubq_f32(r20, r22); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r21, r23); r23 = vsubq_f32(r21, r23); r21 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r26); r26 = vsubq_f32(r24, r26); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r25, r27); r27 = vsubq_f32(r25, r27); r25 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r28, r30); r30 = vsubq_f32(r28, r30); r28 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r29, r31); r31 = vsubq_f32(r29, r31); r29 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r4); r4 = vsubq_f32(r0, r4); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r5); r5 = vsubq_f32(r1, r5); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r6); r6 = vsubq_f32(r2, r6); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r7); r7 = vsubq_f32(r3, r7); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r12); r12 = vsubq_f32(r8, r12); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r13); r13 = vsubq_f32(r9, r13); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r14); r14 = vsubq_f32(r10, r14); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r11, r15); r15 = vsubq_f32(r11, r15); r11 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r20); r20 = vsubq_f32(r16, r20); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r21); r21 = vsubq_f32(r17, r21); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r22); r22 = vsubq_f32(r18, r22); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r19, r23); r23 = vsubq_f32(r19, r23); r19 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r28); r28 = vsubq_f32(r24, r28); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r25, r29); r29 = vsubq_f32(r25, r29); r25 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r26, r30); r30 = vsubq_f32(r26, r30); r26 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r27, r31); r31 = vsubq_f32(r27, r31); r27 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r8); r8 = vsubq_f32(r0, r8); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r9); r9 = vsubq_f32(r1, r9); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r10); r10 = vsubq_f32(r2, r10); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r11); r11 = vsubq_f32(r3, r11); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r12); r12 = vsubq_f32(r4, r12); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r13); r13 = vsubq_f32(r5, r13); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r14); r14 = vsubq_f32(r6, r14); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r7, r15); r15 = vsubq_f32(r7, r15); r7 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r24); r24 = vsubq_f32(r16, r24); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r25); r25 = vsubq_f32(r17, r25); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r26); r26 = vsubq_f32(r18, r26); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r19, r27); r27 = vsubq_f32(r19, r27); r19 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r28); r28 = vsubq_f32(r20, r28); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r21, r29); r29 = vsubq_f32(r21, r29); r21 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r22, r30); r30 = vsubq_f32(r22, r30); r22 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r23, r31); r31 = vsubq_f32(r23, r31); r23 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r16); r16 = vsubq_f32(r0, r16); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r17); r17 = vsubq_f32(r1, r17); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r18); r18 = vsubq_f32(r2, r18); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r19); r19 = vsubq_f32(r3, r19); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r20); r20 = vsubq_f32(r4, r20); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r21); r21 = vsubq_f32(r5, r21); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r22); r22 = vsubq_f32(r6, r22); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r7, r23); r23 = vsubq_f32(r7, r23); r7 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r24); r24 = vsubq_f32(r8, r24); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r25); r25 = vsubq_f32(r9, r25); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r26); r26 = vsubq_f32(r10, r26); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r11, r27); r27 = vsubq_f32(r11, r27); r11 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r28); r28 = vsubq_f32(r12, r28); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r13, r29); r29 = vsubq_f32(r13, r29); r13 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r14, r30); r30 = vsubq_f32(r14, r30); r14 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r15, r31); r31 = vsubq_f32(r15, r31); r15 = tmp; }
+        vst1q_f32(p + 0, r0);
+        vst1q_f32(p + 4, r1);
+        vst1q_f32(p + 8, r2);
+        vst1q_f32(p + 12, r3);
+        vst1q_f32(p + 16, r4);
+        vst1q_f32(p + 20, r5);
+        vst1q_f32(p + 24, r6);
+        vst1q_f32(p + 28, r7);
+        vst1q_f32(p + 32, r8);
+        vst1q_f32(p + 36, r9);
+        vst1q_f32(p + 40, r10);
+        vst1q_f32(p + 44, r11);
+        vst1q_f32(p + 48, r12);
+        vst1q_f32(p + 52, r13);
+        vst1q_f32(p + 56, r14);
+        vst1q_f32(p + 60, r15);
+        vst1q_f32(p + 64, r16);
+        vst1q_f32(p + 68, r17);
+        vst1q_f32(p + 72, r18);
+        vst1q_f32(p + 76, r19);
+        vst1q_f32(p + 80, r20);
+        vst1q_f32(p + 84, r21);
+        vst1q_f32(p + 88, r22);
+        vst1q_f32(p + 92, r23);
+        vst1q_f32(p + 96, r24);
+        vst1q_f32(p + 100, r25);
+        vst1q_f32(p + 104, r26);
+        vst1q_f32(p + 108, r27);
+        vst1q_f32(p + 112, r28);
+        vst1q_f32(p + 116, r29);
+        vst1q_f32(p + 120, r30);
+        vst1q_f32(p + 124, r31);
+    }
+    for (size_t i = 0; i < 512; i += 512) {
+        for (size_t j = i; j < i + 128; j += 4) {
+            float *p = buf + j;
+            float32x4_t r0 = vld1q_f32(p + 0);
+            float32x4_t r1 = vld1q_f32(p + 128);
+            float32x4_t r2 = vld1q_f32(p + 256);
+            float32x4_t r3 = vld1q_f32(p + 384);
+            { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+            vst1q_f32(p + 0, r0);
+            vst1q_f32(p + 128, r1);
+            vst1q_f32(p + 256, r2);
+            vst1q_f32(p + 384, r3);
+        }
+    }
+}
+
+static void fht_neon_gen_float_10(float *buf) {
+    for (size_t i = 0; i < 1024; i += 128) {
+        float *p = buf + i;
+        float32x4_t r0 = vld1q_f32(p + 0);
+        float32x4_t r1 = vld1q_f32(p + 4);
+        {
+            float32x4_t ev = vtrn1q_f32(r0, r1), od = vtrn2q_f32(r0, r1);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r0 = vuzp1q_f32(x, y);
+            r1 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r2 = vld1q_f32(p + 8);
+        float32x4_t r3 = vld1q_f32(p + 12);
+        {
+            float32x4_t ev = vtrn1q_f32(r2, r3), od = vtrn2q_f32(r2, r3);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r2 = vuzp1q_f32(x, y);
+            r3 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r4 = vld1q_f32(p + 16);
+        float32x4_t r5 = vld1q_f32(p + 20);
+        {
+            float32x4_t ev = vtrn1q_f32(r4, r5), od = vtrn2q_f32(r4, r5);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r4 = vuzp1q_f32(x, y);
+            r5 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r6 = vld1q_f32(p + 24);
+        float32x4_t r7 = vld1q_f32(p + 28);
+        {
+            float32x4_t ev = vtrn1q_f32(r6, r7), od = vtrn2q_f32(r6, r7);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r6 = vuzp1q_f32(x, y);
+            r7 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r8 = vld1q_f32(p + 32);
+        float32x4_t r9 = vld1q_f32(p + 36);
+        {
+            float32x4_t ev = vtrn1q_f32(r8, r9), od = vtrn2q_f32(r8, r9);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r8 = vuzp1q_f32(x, y);
+            r9 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r10 = vld1q_f32(p + 40);
+        float32x4_t r11 = vld1q_f32(p + 44);
+        {
+            float32x4_t ev = vtrn1q_f32(r10, r11), od = vtrn2q_f32(r10, r11);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r10 = vuzp1q_f32(x, y);
+            r11 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r12 = vld1q_f32(p + 48);
+        float32x4_t r13 = vld1q_f32(p + 52);
+        {
+            float32x4_t ev = vtrn1q_f32(r12, r13), od = vtrn2q_f32(r12, r13);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r12 = vuzp1q_f32(x, y);
+            r13 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r14 = vld1q_f32(p + 56);
+        float32x4_t r15 = vld1q_f32(p + 60);
+        {
+            float32x4_t ev = vtrn1q_f32(r14, r15), od = vtrn2q_f32(r14, r15);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r14 = vuzp1q_f32(x, y);
+            r15 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r16 = vld1q_f32(p + 64);
+        float32x4_t r17 = vld1q_f32(p + 68);
+        {
+            float32x4_t ev = vtrn1q_f32(r16, r17), od = vtrn2q_f32(r16, r17);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r16 = vuzp1q_f32(x, y);
+            r17 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r18 = vld1q_f32(p + 72);
+        float32x4_t r19 = vld1q_f32(p + 76);
+        {
+            float32x4_t ev = vtrn1q_f32(r18, r19), od = vtrn2q_f32(r18, r19);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r18 = vuzp1q_f32(x, y);
+            r19 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r20 = vld1q_f32(p + 80);
+        float32x4_t r21 = vld1q_f32(p + 84);
+        {
+            float32x4_t ev = vtrn1q_f32(r20, r21), od = vtrn2q_f32(r20, r21);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r20 = vuzp1q_f32(x, y);
+            r21 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r22 = vld1q_f32(p + 88);
+        float32x4_t r23 = vld1q_f32(p + 92);
+        {
+            float32x4_t ev = vtrn1q_f32(r22, r23), od = vtrn2q_f32(r22, r23);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r22 = vuzp1q_f32(x, y);
+            r23 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r24 = vld1q_f32(p + 96);
+        float32x4_t r25 = vld1q_f32(p + 100);
+        {
+            float32x4_t ev = vtrn1q_f32(r24, r25), od = vtrn2q_f32(r24, r25);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r24 = vuzp1q_f32(x, y);
+            r25 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r26 = vld1q_f32(p + 104);
+        float32x4_t r27 = vld1q_f32(p + 108);
+        {
+            float32x4_t ev = vtrn1q_f32(r26, r27), od = vtrn2q_f32(r26, r27);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r26 = vuzp1q_f32(x, y);
+            r27 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r28 = vld1q_f32(p + 112);
+        float32x4_t r29 = vld1q_f32(p + 116);
+        {
+            float32x4_t ev = vtrn1q_f32(r28, r29), od = vtrn2q_f32(r28, r29);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r28 = vuzp1q_f32(x, y);
+            r29 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r30 = vld1q_f32(p + 120);
+        float32x4_t r31 = vld1q_f32(p + 124);
+        {
+            float32x4_t ev = vtrn1q_f32(r30, r31), od = vtrn2q_f32(r30, r31);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r30 = vuzp1q_f32(x, y);
+            r31 = vuzp2q_f32(x, y);
+        }
+        { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r5); r5 = vsubq_f32(r4, r5); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r7); r7 = vsubq_f32(r6, r7); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r9); r9 = vsubq_f32(r8, r9); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r11); r11 = vsubq_f32(r10, r11); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r13); r13 = vsubq_f32(r12, r13); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r14, r15); r15 = vsubq_f32(r14, r15); r14 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r17); r17 = vsubq_f32(r16, r17); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r19); r19 = vsubq_f32(r18, r19); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r21); r21 = vsubq_f32(r20, r21); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r22, r23); r23 = vsubq_f32(r22, r23); r22 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r25); r25 = vsubq_f32(r24, r25); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r26, r27); r27 = vsubq_f32(r26, r27); r26 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r28, r29); r29 = vsubq_f32(r28, r29); r28 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r30, r31); r31 = vsubq_f32(r30, r31); r30 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r6); r6 = vsubq_f32(r4, r6); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r7); r7 = vsubq_f32(r5, r7); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r10); r10 = vsubq_f32(r8, r10); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r11); r11 = vsubq_f32(r9, r11); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r14); r14 = vsubq_f32(r12, r14); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r13, r15); r15 = vsubq_f32(r13, r15); r13 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r18); r18 = vsubq_f32(r16, r18); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r19); r19 = vsubq_f32(r17, r19); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r22); r22 = vsubq_f32(r20, r22); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r21, r23); r23 = vsubq_f32(r21, r23); r21 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r26); r26 = vsubq_f32(r24, r26); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r25, r27); r27 = vsubq_f32(r25, r27); r25 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r28, r30); r30 = vsubq_f32(r28, r30); r28 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r29, r31); r31 = vsubq_f32(r29, r31); r29 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r4); r4 = vsubq_f32(r0, r4); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r5); r5 = vsubq_f32(r1, r5); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r6); r6 = vsubq_f32(r2, r6); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r7); r7 = vsubq_f32(r3, r7); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r12); r12 = vsubq_f32(r8, r12); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r13); r13 = vsubq_f32(r9, r13); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r14); r14 = vsubq_f32(r10, r14); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r11, r15); r15 = vsubq_f32(r11, r15); r11 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r20); r20 = vsubq_f32(r16, r20); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r21); r21 = vsubq_f32(r17, r21); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r22); r22 = vsubq_f32(r18, r22); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r19, r23); r23 = vsubq_f32(r19, r23); r19 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r28); r28 = vsubq_f32(r24, r28); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r25, r29); r29 = vsubq_f32(r25, r29); r25 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r26, r30); r30 = vsubq_f32(r26, r30); r26 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r27, r31); r31 = vsubq_f32(r27, r31); r27 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r8); r8 = vsubq_f32(r0, r8); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r9); r9 = vsubq_f32(r1, r9); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r10); r10 = vsubq_f32(r2, r10); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r11); r11 = vsubq_f32(r3, r11); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r12); r12 = vsubq_f32(r4, r12); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r13); r13 = vsubq_f32(r5, r13); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r14); r14 = vsubq_f32(r6, r14); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r7, r15); r15 = vsubq_f32(r7, r15); r7 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r24); r24 = vsubq_f32(r16, r24); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r25); r25 = vsubq_f32(r17, r25); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r26); r26 = vsubq_f32(r18, r26); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r19, r27); r27 = vsubq_f32(r19, r27); r19 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r28); r28 = vsubq_f32(r20, r28); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r21, r29); r29 = vsubq_f32(r21, r29); r21 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r22, r30); r30 = vsubq_f32(r22, r30); r22 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r23, r31); r31 = vsubq_f32(r23, r31); r23 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r16); r16 = vsubq_f32(r0, r16); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r17); r17 = vsubq_f32(r1, r17); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r18); r18 = vsubq_f32(r2, r18); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r19); r19 = vsubq_f32(r3, r19); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r20); r20 = vsubq_f32(r4, r20); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r21); r21 = vsubq_f32(r5, r21); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r22); r22 = vsubq_f32(r6, r22); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r7, r23); r23 = vsubq_f32(r7, r23); r7 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r24); r24 = vsubq_f32(r8, r24); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r25); r25 = vsubq_f32(r9, r25); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r26); r26 = vsubq_f32(r10, r26); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r11, r27); r27 = vsubq_f32(r11, r27); r11 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r28); r28 = vsubq_f32(r12, r28); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r13, r29); r29 = vsubq_f32(r13, r29); r13 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r14, r30); r30 = vsubq_f32(r14, r30); r14 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r15, r31); r31 = vsubq_f32(r15, r31); r15 = tmp; }
+        vst1q_f32(p + 0, r0);
+        vst1q_f32(p + 4, r1);
+        vst1q_f32(p + 8, r2);
+        vst1q_f32(p + 12, r3);
+        vst1q_f32(p + 16, r4);
+        vst1q_f32(p + 20, r5);
+        vst1q_f32(p + 24, r6);
+        vst1q_f32(p + 28, r7);
+        vst1q_f32(p + 32, r8);
+        vst1q_f32(p + 36, r9);
+        vst1q_f32(p + 40, r10);
+        vst1q_f32(p + 44, r11);
+        vst1q_f32(p + 48, r12);
+        vst1q_f32(p + 52, r13);
+        vst1q_f32(p + 56, r14);
+        vst1q_f32(p + 60, r15);
+        vst1q_f32(p + 64, r16);
+        vst1q_f32(p + 68, r17);
+        vst1q_f32(p + 72, r18);
+        vst1q_f32(p + 76, r19);
+        vst1q_f32(p + 80, r20);
+        vst1q_f32(p + 84, r21);
+        vst1q_f32(p + 88, r22);
+        vst1q_f32(p + 92, r23);
+        vst1q_f32(p + 96, r24);
+        vst1q_f32(p + 100, r25);
+        vst1q_f32(p + 104, r26);
+        vst1q_f32(p + 108, r27);
+        vst1q_f32(p + 112, r28);
+        vst1q_f32(p + 116, r29);
+        vst1q_f32(p + 120, r30);
+        vst1q_f32(p + 124, r31);
+    }
+    for (size_t i = 0; i < 1024; i += 1024) {
+        for (size_t j = i; j < i + 128; j += 4) {
+            float *p = buf + j;
+            float32x4_t r0 = vld1q_f32(p + 0);
+            float32x4_t r1 = vld1q_f32(p + 128);
+            float32x4_t r2 = vld1q_f32(p + 256);
+            float32x4_t r3 = vld1q_f32(p + 384);
+            float32x4_t r4 = vld1q_f32(p + 512);
+            float32x4_t r5 = vld1q_f32(p + 640);
+            float32x4_t r6 = vld1q_f32(p + 768);
+            float32x4_t r7 = vld1q_f32(p + 896);
+            { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r4, r5); r5 = vsubq_f32(r4, r5); r4 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r6, r7); r7 = vsubq_f32(r6, r7); r6 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r4, r6); r6 = vsubq_f32(r4, r6); r4 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r5, r7); r7 = vsubq_f32(r5, r7); r5 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r0, r4); r4 = vsubq_f32(r0, r4); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r1, r5); r5 = vsubq_f32(r1, r5); r1 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r2, r6); r6 = vsubq_f32(r2, r6); r2 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r3, r7); r7 = vsubq_f32(r3, r7); r3 = tmp; }
+            vst1q_f32(p + 0, r0);
+            vst1q_f32(p + 128, r1);
+            vst1q_f32(p + 256, r2);
+            vst1q_f32(p + 384, r3);
+            vst1q_f32(p + 512, r4);
+            vst1q_f32(p + 640, r5);
+            vst1q_f32(p + 768, r6);
+            vst1q_f32(p + 896, r7);
+        }
+    }
+}
+
+static void fht_neon_gen_float_11(float *buf) {
+    for (size_t i = 0; i < 2048; i += 128) {
+        float *p = buf + i;
+        float32x4_t r0 = vld1q_f32(p + 0);
+        float32x4_t r1 = vld1q_f32(p + 4);
+        {
+            float32x4_t ev = vtrn1q_f32(r0, r1), od = vtrn2q_f32(r0, r1);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r0 = vuzp1q_f32(x, y);
+            r1 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r2 = vld1q_f32(p + 8);
+        float32x4_t r3 = vld1q_f32(p + 12);
+        {
+            float32x4_t ev = vtrn1q_f32(r2, r3), od = vtrn2q_f32(r2, r3);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r2 = vuzp1q_f32(x, y);
+            r3 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r4 = vld1q_f32(p + 16);
+        float32x4_t r5 = vld1q_f32(p + 20);
+        {
+            float32x4_t ev = vtrn1q_f32(r4, r5), od = vtrn2q_f32(r4, r5);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r4 = vuzp1q_f32(x, y);
+            r5 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r6 = vld1q_f32(p + 24);
+        float32x4_t r7 = vld1q_f32(p + 28);
+        {
+            float32x4_t ev = vtrn1q_f32(r6, r7), od = vtrn2q_f32(r6, r7);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r6 = vuzp1q_f32(x, y);
+            r7 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r8 = vld1q_f32(p + 32);
+        float32x4_t r9 = vld1q_f32(p + 36);
+        {
+            float32x4_t ev = vtrn1q_f32(r8, r9), od = vtrn2q_f32(r8, r9);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r8 = vuzp1q_f32(x, y);
+            r9 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r10 = vld1q_f32(p + 40);
+        float32x4_t r11 = vld1q_f32(p + 44);
+        {
+            float32x4_t ev = vtrn1q_f32(r10, r11), od = vtrn2q_f32(r10, r11);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r10 = vuzp1q_f32(x, y);
+            r11 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r12 = vld1q_f32(p + 48);
+        float32x4_t r13 = vld1q_f32(p + 52);
+        {
+            float32x4_t ev = vtrn1q_f32(r12, r13), od = vtrn2q_f32(r12, r13);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r12 = vuzp1q_f32(x, y);
+            r13 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r14 = vld1q_f32(p + 56);
+        float32x4_t r15 = vld1q_f32(p + 60);
+        {
+            float32x4_t ev = vtrn1q_f32(r14, r15), od = vtrn2q_f32(r14, r15);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r14 = vuzp1q_f32(x, y);
+            r15 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r16 = vld1q_f32(p + 64);
+        float32x4_t r17 = vld1q_f32(p + 68);
+        {
+            float32x4_t ev = vtrn1q_f32(r16, r17), od = vtrn2q_f32(r16, r17);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r16 = vuzp1q_f32(x, y);
+            r17 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r18 = vld1q_f32(p + 72);
+        float32x4_t r19 = vld1q_f32(p + 76);
+        {
+            float32x4_t ev = vtrn1q_f32(r18, r19), od = vtrn2q_f32(r18, r19);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r18 = vuzp1q_f32(x, y);
+            r19 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r20 = vld1q_f32(p + 80);
+        float32x4_t r21 = vld1q_f32(p + 84);
+        {
+            float32x4_t ev = vtrn1q_f32(r20, r21), od = vtrn2q_f32(r20, r21);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r20 = vuzp1q_f32(x, y);
+            r21 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r22 = vld1q_f32(p + 88);
+        float32x4_t r23 = vld1q_f32(p + 92);
+        {
+            float32x4_t ev = vtrn1q_f32(r22, r23), od = vtrn2q_f32(r22, r23);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r22 = vuzp1q_f32(x, y);
+            r23 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r24 = vld1q_f32(p + 96);
+        float32x4_t r25 = vld1q_f32(p + 100);
+        {
+            float32x4_t ev = vtrn1q_f32(r24, r25), od = vtrn2q_f32(r24, r25);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r24 = vuzp1q_f32(x, y);
+            r25 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r26 = vld1q_f32(p + 104);
+        float32x4_t r27 = vld1q_f32(p + 108);
+        {
+            float32x4_t ev = vtrn1q_f32(r26, r27), od = vtrn2q_f32(r26, r27);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r26 = vuzp1q_f32(x, y);
+            r27 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r28 = vld1q_f32(p + 112);
+        float32x4_t r29 = vld1q_f32(p + 116);
+        {
+            float32x4_t ev = vtrn1q_f32(r28, r29), od = vtrn2q_f32(r28, r29);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r28 = vuzp1q_f32(x, y);
+            r29 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r30 = vld1q_f32(p + 120);
+        float32x4_t r31 = vld1q_f32(p + 124);
+        {
+            float32x4_t ev = vtrn1q_f32(r30, r31), od = vtrn2q_f32(r30, r31);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r30 = vuzp1q_f32(x, y);
+            r31 = vuzp2q_f32(x, y);
+        }
+        { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r5); r5 = vsubq_f32(r4, r5); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r7); r7 = vsubq_f32(r6, r7); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r9); r9 = vsubq_f32(r8, r9); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r11); r11 = vsubq_f32(r10, r11); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r13); r13 = vsubq_f32(r12, r13); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r14, r15); r15 = vsubq_f32(r14, r15); r14 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r17); r17 = vsubq_f32(r16, r17); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r19); r19 = vsubq_f32(r18, r19); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r21); r21 = vsubq_f32(r20, r21); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r22, r23); r23 = vsubq_f32(r22, r23); r22 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r25); r25 = vsubq_f32(r24, r25); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r26, r27); r27 = vsubq_f32(r26, r27); r26 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r28, r29); r29 = vsubq_f32(r28, r29); r28 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r30, r31); r31 = vsubq_f32(r30, r31); r30 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r6); r6 = vsubq_f32(r4, r6); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r7); r7 = vsubq_f32(r5, r7); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r10); r10 = vsubq_f32(r8, r10); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r11); r11 = vsubq_f32(r9, r11); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r14); r14 = vsubq_f32(r12, r14); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r13, r15); r15 = vsubq_f32(r13, r15); r13 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r18); r18 = vsubq_f32(r16, r18); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r19); r19 = vsubq_f32(r17, r19); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r22); r22 = vsubq_f32(r20, r22); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r21, r23); r23 = vsubq_f32(r21, r23); r21 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r26); r26 = vsubq_f32(r24, r26); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r25, r27); r27 = vsubq_f32(r25, r27); r25 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r28, r30); r30 = vsubq_f32(r28, r30); r28 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r29, r31); r31 = vsubq_f32(r29, r31); r29 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r4); r4 = vsubq_f32(r0, r4); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r5); r5 = vsubq_f32(r1, r5); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r6); r6 = vsubq_f32(r2, r6); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r7); r7 = vsubq_f32(r3, r7); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r12); r12 = vsubq_f32(r8, r12); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r13); r13 = vsubq_f32(r9, r13); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r14); r14 = vsubq_f32(r10, r14); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r11, r15); r15 = vsubq_f32(r11, r15); r11 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r20); r20 = vsubq_f32(r16, r20); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r21); r21 = vsubq_f32(r17, r21); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r22); r22 = vsubq_f32(r18, r22); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r19, r23); r23 = vsubq_f32(r19, r23); r19 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r28); r28 = vsubq_f32(r24, r28); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r25, r29); r29 = vsubq_f32(r25, r29); r25 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r26, r30); r30 = vsubq_f32(r26, r30); r26 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r27, r31); r31 = vsubq_f32(r27, r31); r27 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r8); r8 = vsubq_f32(r0, r8); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r9); r9 = vsubq_f32(r1, r9); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r10); r10 = vsubq_f32(r2, r10); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r11); r11 = vsubq_f32(r3, r11); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r12); r12 = vsubq_f32(r4, r12); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r13); r13 = vsubq_f32(r5, r13); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r14); r14 = vsubq_f32(r6, r14); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r7, r15); r15 = vsubq_f32(r7, r15); r7 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r24); r24 = vsubq_f32(r16, r24); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r25); r25 = vsubq_f32(r17, r25); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r26); r26 = vsubq_f32(r18, r26); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r19, r27); r27 = vsubq_f32(r19, r27); r19 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r28); r28 = vsubq_f32(r20, r28); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r21, r29); r29 = vsubq_f32(r21, r29); r21 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r22, r30); r30 = vsubq_f32(r22, r30); r22 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r23, r31); r31 = vsubq_f32(r23, r31); r23 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r16); r16 = vsubq_f32(r0, r16); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r17); r17 = vsubq_f32(r1, r17); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r18); r18 = vsubq_f32(r2, r18); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r19); r19 = vsubq_f32(r3, r19); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r20); r20 = vsubq_f32(r4, r20); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r21); r21 = vsubq_f32(r5, r21); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r22); r22 = vsubq_f32(r6, r22); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r7, r23); r23 = vsubq_f32(r7, r23); r7 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r24); r24 = vsubq_f32(r8, r24); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r25); r25 = vsubq_f32(r9, r25); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r26); r26 = vsubq_f32(r10, r26); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r11, r27); r27 = vsubq_f32(r11, r27); r11 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r28); r28 = vsubq_f32(r12, r28); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r13, r29); r29 = vsubq_f32(r13, r29); r13 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r14, r30); r30 = vsubq_f32(r14, r30); r14 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r15, r31); r31 = vsubq_f32(r15, r31); r15 = tmp; }
+        vst1q_f32(p + 0, r0);
+        vst1q_f32(p + 4, r1);
+        vst1q_f32(p + 8, r2);
+        vst1q_f32(p + 12, r3);
+        vst1q_f32(p + 16, r4);
+        vst1q_f32(p + 20, r5);
+        vst1q_f32(p + 24, r6);
+        vst1q_f32(p + 28, r7);
+        vst1q_f32(p + 32, r8);
+        vst1q_f32(p + 36, r9);
+        vst1q_f32(p + 40, r10);
+        vst1q_f32(p + 44, r11);
+        vst1q_f32(p + 48, r12);
+        vst1q_f32(p + 52, r13);
+        vst1q_f32(p + 56, r14);
+        vst1q_f32(p + 60, r15);
+        vst1q_f32(p + 64, r16);
+        vst1q_f32(p + 68, r17);
+        vst1q_f32(p + 72, r18);
+        vst1q_f32(p + 76, r19);
+        vst1q_f32(p + 80, r20);
+        vst1q_f32(p + 84, r21);
+        vst1q_f32(p + 88, r22);
+        vst1q_f32(p + 92, r23);
+        vst1q_f32(p + 96, r24);
+        vst1q_f32(p + 100, r25);
+        vst1q_f32(p + 104, r26);
+        vst1q_f32(p + 108, r27);
+        vst1q_f32(p + 112, r28);
+        vst1q_f32(p + 116, r29);
+        vst1q_f32(p + 120, r30);
+        vst1q_f32(p + 124, r31);
+    }
+    for (size_t i = 0; i < 2048; i += 2048) {
+        for (size_t j = i; j < i + 128; j += 4) {
+            float *p = buf + j;
+            float32x4_t r0 = vld1q_f32(p + 0);
+            float32x4_t r1 = vld1q_f32(p + 128);
+            float32x4_t r2 = vld1q_f32(p + 256);
+            float32x4_t r3 = vld1q_f32(p + 384);
+            float32x4_t r4 = vld1q_f32(p + 512);
+            float32x4_t r5 = vld1q_f32(p + 640);
+            float32x4_t r6 = vld1q_f32(p + 768);
+            float32x4_t r7 = vld1q_f32(p + 896);
+            float32x4_t r8 = vld1q_f32(p + 1024);
+            float32x4_t r9 = vld1q_f32(p + 1152);
+            float32x4_t r10 = vld1q_f32(p + 1280);
+            float32x4_t r11 = vld1q_f32(p + 1408);
+            float32x4_t r12 = vld1q_f32(p + 1536);
+            float32x4_t r13 = vld1q_f32(p + 1664);
+            float32x4_t r14 = vld1q_f32(p + 1792);
+            float32x4_t r15 = vld1q_f32(p + 1920);
+            { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r4, r5); r5 = vsubq_f32(r4, r5); r4 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r6, r7); r7 = vsubq_f32(r6, r7); r6 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r8, r9); r9 = vsubq_f32(r8, r9); r8 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r10, r11); r11 = vsubq_f32(r10, r11); r10 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r12, r13); r13 = vsubq_f32(r12, r13); r12 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r14, r15); r15 = vsubq_f32(r14, r15); r14 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r4, r6); r6 = vsubq_f32(r4, r6); r4 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r5, r7); r7 = vsubq_f32(r5, r7); r5 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r8, r10); r10 = vsubq_f32(r8, r10); r8 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r9, r11); r11 = vsubq_f32(r9, r11); r9 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r12, r14); r14 = vsubq_f32(r12, r14); r12 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r13, r15); r15 = vsubq_f32(r13, r15); r13 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r0, r4); r4 = vsubq_f32(r0, r4); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r1, r5); r5 = vsubq_f32(r1, r5); r1 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r2, r6); r6 = vsubq_f32(r2, r6); r2 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r3, r7); r7 = vsubq_f32(r3, r7); r3 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r8, r12); r12 = vsubq_f32(r8, r12); r8 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r9, r13); r13 = vsubq_f32(r9, r13); r9 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r10, r14); r14 = vsubq_f32(r10, r14); r10 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r11, r15); r15 = vsubq_f32(r11, r15); r11 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r0, r8); r8 = vsubq_f32(r0, r8); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r1, r9); r9 = vsubq_f32(r1, r9); r1 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r2, r10); r10 = vsubq_f32(r2, r10); r2 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r3, r11); r11 = vsubq_f32(r3, r11); r3 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r4, r12); r12 = vsubq_f32(r4, r12); r4 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r5, r13); r13 = vsubq_f32(r5, r13); r5 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r6, r14); r14 = vsubq_f32(r6, r14); r6 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r7, r15); r15 = vsubq_f32(r7, r15); r7 = tmp; }
+            vst1q_f32(p + 0, r0);
+            vst1q_f32(p + 128, r1);
+            vst1q_f32(p + 256, r2);
+            vst1q_f32(p + 384, r3);
+            vst1q_f32(p + 512, r4);
+            vst1q_f32(p + 640, r5);
+            vst1q_f32(p + 768, r6);
+            vst1q_f32(p + 896, r7);
+            vst1q_f32(p + 1024, r8);
+            vst1q_f32(p + 1152, r9);
+            vst1q_f32(p + 1280, r10);
+            vst1q_f32(p + 1408, r11);
+            vst1q_f32(p + 1536, r12);
+            vst1q_f32(p + 1664, r13);
+            vst1q_f32(p + 1792, r14);
+            vst1q_f32(p + 1920, r15);
+        }
+    }
+}
+
+static void fht_neon_gen_float_12(float *buf) {
+    for (size_t i = 0; i < 4096; i += 128) {
+        float *p = buf + i;
+        float32x4_t r0 = vld1q_f32(p + 0);
+        float32x4_t r1 = vld1q_f32(p + 4);
+        {
+            float32x4_t ev = vtrn1q_f32(r0, r1), od = vtrn2q_f32(r0, r1);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r0 = vuzp1q_f32(x, y);
+            r1 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r2 = vld1q_f32(p + 8);
+        float32x4_t r3 = vld1q_f32(p + 12);
+        {
+            float32x4_t ev = vtrn1q_f32(r2, r3), od = vtrn2q_f32(r2, r3);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r2 = vuzp1q_f32(x, y);
+            r3 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r4 = vld1q_f32(p + 16);
+        float32x4_t r5 = vld1q_f32(p + 20);
+        {
+            float32x4_t ev = vtrn1q_f32(r4, r5), od = vtrn2q_f32(r4, r5);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r4 = vuzp1q_f32(x, y);
+            r5 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r6 = vld1q_f32(p + 24);
+        float32x4_t r7 = vld1q_f32(p + 28);
+        {
+            float32x4_t ev = vtrn1q_f32(r6, r7), od = vtrn2q_f32(r6, r7);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r6 = vuzp1q_f32(x, y);
+            r7 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r8 = vld1q_f32(p + 32);
+        float32x4_t r9 = vld1q_f32(p + 36);
+        {
+            float32x4_t ev = vtrn1q_f32(r8, r9), od = vtrn2q_f32(r8, r9);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r8 = vuzp1q_f32(x, y);
+            r9 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r10 = vld1q_f32(p + 40);
+        float32x4_t r11 = vld1q_f32(p + 44);
+        {
+            float32x4_t ev = vtrn1q_f32(r10, r11), od = vtrn2q_f32(r10, r11);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r10 = vuzp1q_f32(x, y);
+            r11 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r12 = vld1q_f32(p + 48);
+        float32x4_t r13 = vld1q_f32(p + 52);
+        {
+            float32x4_t ev = vtrn1q_f32(r12, r13), od = vtrn2q_f32(r12, r13);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r12 = vuzp1q_f32(x, y);
+            r13 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r14 = vld1q_f32(p + 56);
+        float32x4_t r15 = vld1q_f32(p + 60);
+        {
+            float32x4_t ev = vtrn1q_f32(r14, r15), od = vtrn2q_f32(r14, r15);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r14 = vuzp1q_f32(x, y);
+            r15 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r16 = vld1q_f32(p + 64);
+        float32x4_t r17 = vld1q_f32(p + 68);
+        {
+            float32x4_t ev = vtrn1q_f32(r16, r17), od = vtrn2q_f32(r16, r17);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r16 = vuzp1q_f32(x, y);
+            r17 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r18 = vld1q_f32(p + 72);
+        float32x4_t r19 = vld1q_f32(p + 76);
+        {
+            float32x4_t ev = vtrn1q_f32(r18, r19), od = vtrn2q_f32(r18, r19);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r18 = vuzp1q_f32(x, y);
+            r19 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r20 = vld1q_f32(p + 80);
+        float32x4_t r21 = vld1q_f32(p + 84);
+        {
+            float32x4_t ev = vtrn1q_f32(r20, r21), od = vtrn2q_f32(r20, r21);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r20 = vuzp1q_f32(x, y);
+            r21 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r22 = vld1q_f32(p + 88);
+        float32x4_t r23 = vld1q_f32(p + 92);
+        {
+            float32x4_t ev = vtrn1q_f32(r22, r23), od = vtrn2q_f32(r22, r23);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r22 = vuzp1q_f32(x, y);
+            r23 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r24 = vld1q_f32(p + 96);
+        float32x4_t r25 = vld1q_f32(p + 100);
+        {
+            float32x4_t ev = vtrn1q_f32(r24, r25), od = vtrn2q_f32(r24, r25);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r24 = vuzp1q_f32(x, y);
+            r25 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r26 = vld1q_f32(p + 104);
+        float32x4_t r27 = vld1q_f32(p + 108);
+        {
+            float32x4_t ev = vtrn1q_f32(r26, r27), od = vtrn2q_f32(r26, r27);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r26 = vuzp1q_f32(x, y);
+            r27 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r28 = vld1q_f32(p + 112);
+        float32x4_t r29 = vld1q_f32(p + 116);
+        {
+            float32x4_t ev = vtrn1q_f32(r28, r29), od = vtrn2q_f32(r28, r29);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r28 = vuzp1q_f32(x, y);
+            r29 = vuzp2q_f32(x, y);
+        }
+        float32x4_t r30 = vld1q_f32(p + 120);
+        float32x4_t r31 = vld1q_f32(p + 124);
+        {
+            float32x4_t ev = vtrn1q_f32(r30, r31), od = vtrn2q_f32(r30, r31);
+            float32x4_t sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);
+            float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);
+            float32x4_t u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));
+            float32x4_t w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));
+            float32x4_t x = vaddq_f32(u, w), y = vsubq_f32(u, w);
+            r30 = vuzp1q_f32(x, y);
+            r31 = vuzp2q_f32(x, y);
+        }
+        { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r5); r5 = vsubq_f32(r4, r5); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r7); r7 = vsubq_f32(r6, r7); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r9); r9 = vsubq_f32(r8, r9); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r11); r11 = vsubq_f32(r10, r11); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r13); r13 = vsubq_f32(r12, r13); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r14, r15); r15 = vsubq_f32(r14, r15); r14 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r17); r17 = vsubq_f32(r16, r17); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r19); r19 = vsubq_f32(r18, r19); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r21); r21 = vsubq_f32(r20, r21); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r22, r23); r23 = vsubq_f32(r22, r23); r22 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r25); r25 = vsubq_f32(r24, r25); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r26, r27); r27 = vsubq_f32(r26, r27); r26 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r28, r29); r29 = vsubq_f32(r28, r29); r28 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r30, r31); r31 = vsubq_f32(r30, r31); r30 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r6); r6 = vsubq_f32(r4, r6); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r7); r7 = vsubq_f32(r5, r7); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r10); r10 = vsubq_f32(r8, r10); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r11); r11 = vsubq_f32(r9, r11); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r14); r14 = vsubq_f32(r12, r14); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r13, r15); r15 = vsubq_f32(r13, r15); r13 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r18); r18 = vsubq_f32(r16, r18); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r19); r19 = vsubq_f32(r17, r19); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r22); r22 = vsubq_f32(r20, r22); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r21, r23); r23 = vsubq_f32(r21, r23); r21 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r26); r26 = vsubq_f32(r24, r26); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r25, r27); r27 = vsubq_f32(r25, r27); r25 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r28, r30); r30 = vsubq_f32(r28, r30); r28 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r29, r31); r31 = vsubq_f32(r29, r31); r29 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r4); r4 = vsubq_f32(r0, r4); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r5); r5 = vsubq_f32(r1, r5); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r6); r6 = vsubq_f32(r2, r6); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r7); r7 = vsubq_f32(r3, r7); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r12); r12 = vsubq_f32(r8, r12); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r13); r13 = vsubq_f32(r9, r13); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r14); r14 = vsubq_f32(r10, r14); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r11, r15); r15 = vsubq_f32(r11, r15); r11 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r20); r20 = vsubq_f32(r16, r20); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r21); r21 = vsubq_f32(r17, r21); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r22); r22 = vsubq_f32(r18, r22); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r19, r23); r23 = vsubq_f32(r19, r23); r19 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r24, r28); r28 = vsubq_f32(r24, r28); r24 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r25, r29); r29 = vsubq_f32(r25, r29); r25 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r26, r30); r30 = vsubq_f32(r26, r30); r26 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r27, r31); r31 = vsubq_f32(r27, r31); r27 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r8); r8 = vsubq_f32(r0, r8); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r9); r9 = vsubq_f32(r1, r9); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r10); r10 = vsubq_f32(r2, r10); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r11); r11 = vsubq_f32(r3, r11); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r12); r12 = vsubq_f32(r4, r12); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r13); r13 = vsubq_f32(r5, r13); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r14); r14 = vsubq_f32(r6, r14); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r7, r15); r15 = vsubq_f32(r7, r15); r7 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r16, r24); r24 = vsubq_f32(r16, r24); r16 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r17, r25); r25 = vsubq_f32(r17, r25); r17 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r18, r26); r26 = vsubq_f32(r18, r26); r18 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r19, r27); r27 = vsubq_f32(r19, r27); r19 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r20, r28); r28 = vsubq_f32(r20, r28); r20 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r21, r29); r29 = vsubq_f32(r21, r29); r21 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r22, r30); r30 = vsubq_f32(r22, r30); r22 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r23, r31); r31 = vsubq_f32(r23, r31); r23 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r0, r16); r16 = vsubq_f32(r0, r16); r0 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r1, r17); r17 = vsubq_f32(r1, r17); r1 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r2, r18); r18 = vsubq_f32(r2, r18); r2 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r3, r19); r19 = vsubq_f32(r3, r19); r3 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r4, r20); r20 = vsubq_f32(r4, r20); r4 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r5, r21); r21 = vsubq_f32(r5, r21); r5 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r6, r22); r22 = vsubq_f32(r6, r22); r6 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r7, r23); r23 = vsubq_f32(r7, r23); r7 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r8, r24); r24 = vsubq_f32(r8, r24); r8 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r9, r25); r25 = vsubq_f32(r9, r25); r9 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r10, r26); r26 = vsubq_f32(r10, r26); r10 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r11, r27); r27 = vsubq_f32(r11, r27); r11 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r12, r28); r28 = vsubq_f32(r12, r28); r12 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r13, r29); r29 = vsubq_f32(r13, r29); r13 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r14, r30); r30 = vsubq_f32(r14, r30); r14 = tmp; }
+        { float32x4_t tmp = vaddq_f32(r15, r31); r31 = vsubq_f32(r15, r31); r15 = tmp; }
+        vst1q_f32(p + 0, r0);
+        vst1q_f32(p + 4, r1);
+        vst1q_f32(p + 8, r2);
+        vst1q_f32(p + 12, r3);
+        vst1q_f32(p + 16, r4);
+        vst1q_f32(p + 20, r5);
+        vst1q_f32(p + 24, r6);
+        vst1q_f32(p + 28, r7);
+        vst1q_f32(p + 32, r8);
+        vst1q_f32(p + 36, r9);
+        vst1q_f32(p + 40, r10);
+        vst1q_f32(p + 44, r11);
+        vst1q_f32(p + 48, r12);
+        vst1q_f32(p + 52, r13);
+        vst1q_f32(p + 56, r14);
+        vst1q_f32(p + 60, r15);
+        vst1q_f32(p + 64, r16);
+        vst1q_f32(p + 68, r17);
+        vst1q_f32(p + 72, r18);
+        vst1q_f32(p + 76, r19);
+        vst1q_f32(p + 80, r20);
+        vst1q_f32(p + 84, r21);
+        vst1q_f32(p + 88, r22);
+        vst1q_f32(p + 92, r23);
+        vst1q_f32(p + 96, r24);
+        vst1q_f32(p + 100, r25);
+        vst1q_f32(p + 104, r26);
+        vst1q_f32(p + 108, r27);
+        vst1q_f32(p + 112, r28);
+        vst1q_f32(p + 116, r29);
+        vst1q_f32(p + 120, r30);
+        vst1q_f32(p + 124, r31);
+    }
+    for (size_t i = 0; i < 4096; i += 4096) {
+        for (size_t j = i; j < i + 128; j += 4) {
+            float *p = buf + j;
+            float32x4_t r0 = vld1q_f32(p + 0);
+            float32x4_t r1 = vld1q_f32(p + 128);
+            float32x4_t r2 = vld1q_f32(p + 256);
+            float32x4_t r3 = vld1q_f32(p + 384);
+            float32x4_t r4 = vld1q_f32(p + 512);
+            float32x4_t r5 = vld1q_f32(p + 640);
+            float32x4_t r6 = vld1q_f32(p + 768);
+            float32x4_t r7 = vld1q_f32(p + 896);
+            float32x4_t r8 = vld1q_f32(p + 1024);
+            float32x4_t r9 = vld1q_f32(p + 1152);
+            float32x4_t r10 = vld1q_f32(p + 1280);
+            float32x4_t r11 = vld1q_f32(p + 1408);
+            float32x4_t r12 = vld1q_f32(p + 1536);
+            float32x4_t r13 = vld1q_f32(p + 1664);
+            float32x4_t r14 = vld1q_f32(p + 1792);
+            float32x4_t r15 = vld1q_f32(p + 1920);
+            float32x4_t r16 = vld1q_f32(p + 2048);
+            float32x4_t r17 = vld1q_f32(p + 2176);
+            float32x4_t r18 = vld1q_f32(p + 2304);
+            float32x4_t r19 = vld1q_f32(p + 2432);
+            float32x4_t r20 = vld1q_f32(p + 2560);
+            float32x4_t r21 = vld1q_f32(p + 2688);
+            float32x4_t r22 = vld1q_f32(p + 2816);
+            float32x4_t r23 = vld1q_f32(p + 2944);
+            float32x4_t r24 = vld1q_f32(p + 3072);
+            float32x4_t r25 = vld1q_f32(p + 3200);
+            float32x4_t r26 = vld1q_f32(p + 3328);
+            float32x4_t r27 = vld1q_f32(p + 3456);
+            float32x4_t r28 = vld1q_f32(p + 3584);
+            float32x4_t r29 = vld1q_f32(p + 3712);
+            float32x4_t r30 = vld1q_f32(p + 3840);
+            float32x4_t r31 = vld1q_f32(p + 3968);
+            { float32x4_t tmp = vaddq_f32(r0, r1); r1 = vsubq_f32(r0, r1); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r2, r3); r3 = vsubq_f32(r2, r3); r2 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r4, r5); r5 = vsubq_f32(r4, r5); r4 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r6, r7); r7 = vsubq_f32(r6, r7); r6 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r8, r9); r9 = vsubq_f32(r8, r9); r8 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r10, r11); r11 = vsubq_f32(r10, r11); r10 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r12, r13); r13 = vsubq_f32(r12, r13); r12 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r14, r15); r15 = vsubq_f32(r14, r15); r14 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r16, r17); r17 = vsubq_f32(r16, r17); r16 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r18, r19); r19 = vsubq_f32(r18, r19); r18 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r20, r21); r21 = vsubq_f32(r20, r21); r20 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r22, r23); r23 = vsubq_f32(r22, r23); r22 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r24, r25); r25 = vsubq_f32(r24, r25); r24 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r26, r27); r27 = vsubq_f32(r26, r27); r26 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r28, r29); r29 = vsubq_f32(r28, r29); r28 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r30, r31); r31 = vsubq_f32(r30, r31); r30 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r0, r2); r2 = vsubq_f32(r0, r2); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r1, r3); r3 = vsubq_f32(r1, r3); r1 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r4, r6); r6 = vsubq_f32(r4, r6); r4 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r5, r7); r7 = vsubq_f32(r5, r7); r5 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r8, r10); r10 = vsubq_f32(r8, r10); r8 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r9, r11); r11 = vsubq_f32(r9, r11); r9 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r12, r14); r14 = vsubq_f32(r12, r14); r12 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r13, r15); r15 = vsubq_f32(r13, r15); r13 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r16, r18); r18 = vsubq_f32(r16, r18); r16 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r17, r19); r19 = vsubq_f32(r17, r19); r17 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r20, r22); r22 = vsubq_f32(r20, r22); r20 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r21, r23); r23 = vsubq_f32(r21, r23); r21 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r24, r26); r26 = vsubq_f32(r24, r26); r24 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r25, r27); r27 = vsubq_f32(r25, r27); r25 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r28, r30); r30 = vsubq_f32(r28, r30); r28 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r29, r31); r31 = vsubq_f32(r29, r31); r29 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r0, r4); r4 = vsubq_f32(r0, r4); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r1, r5); r5 = vsubq_f32(r1, r5); r1 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r2, r6); r6 = vsubq_f32(r2, r6); r2 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r3, r7); r7 = vsubq_f32(r3, r7); r3 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r8, r12); r12 = vsubq_f32(r8, r12); r8 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r9, r13); r13 = vsubq_f32(r9, r13); r9 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r10, r14); r14 = vsubq_f32(r10, r14); r10 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r11, r15); r15 = vsubq_f32(r11, r15); r11 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r16, r20); r20 = vsubq_f32(r16, r20); r16 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r17, r21); r21 = vsubq_f32(r17, r21); r17 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r18, r22); r22 = vsubq_f32(r18, r22); r18 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r19, r23); r23 = vsubq_f32(r19, r23); r19 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r24, r28); r28 = vsubq_f32(r24, r28); r24 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r25, r29); r29 = vsubq_f32(r25, r29); r25 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r26, r30); r30 = vsubq_f32(r26, r30); r26 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r27, r31); r31 = vsubq_f32(r27, r31); r27 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r0, r8); r8 = vsubq_f32(r0, r8); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r1, r9); r9 = vsubq_f32(r1, r9); r1 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r2, r10); r10 = vsubq_f32(r2, r10); r2 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r3, r11); r11 = vsubq_f32(r3, r11); r3 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r4, r12); r12 = vsubq_f32(r4, r12); r4 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r5, r13); r13 = vsubq_f32(r5, r13); r5 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r6, r14); r14 = vsubq_f32(r6, r14); r6 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r7, r15); r15 = vsubq_f32(r7, r15); r7 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r16, r24); r24 = vsubq_f32(r16, r24); r16 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r17, r25); r25 = vsubq_f32(r17, r25); r17 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r18, r26); r26 = vsubq_f32(r18, r26); r18 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r19, r27); r27 = vsubq_f32(r19, r27); r19 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r20, r28); r28 = vsubq_f32(r20, r28); r20 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r21, r29); r29 = vsubq_f32(r21, r29); r21 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r22, r30); r30 = vsubq_f32(r22, r30); r22 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r23, r31); r31 = vsubq_f32(r23, r31); r23 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r0, r16); r16 = vsubq_f32(r0, r16); r0 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r1, r17); r17 = vsubq_f32(r1, r17); r1 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r2, r18); r18 = vsubq_f32(r2, r18); r2 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r3, r19); r19 = vsubq_f32(r3, r19); r3 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r4, r20); r20 = vsubq_f32(r4, r20); r4 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r5, r21); r21 = vsubq_f32(r5, r21); r5 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r6, r22); r22 = vsubq_f32(r6, r22); r6 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r7, r23); r23 = vsubq_f32(r7, r23); r7 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r8, r24); r24 = vsubq_f32(r8, r24); r8 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r9, r25); r25 = vsubq_f32(r9, r25); r9 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r10, r26); r26 = vsubq_f32(r10, r26); r10 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r11, r27); r27 = vsubq_f32(r11, r27); r11 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r12, r28); r28 = vsubq_f32(r12, r28); r12 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r13, r29); r29 = vsubq_f32(r13, r29); r13 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r14, r30); r30 = vsubq_f32(r14, r30); r14 = tmp; }
+            { float32x4_t tmp = vaddq_f32(r15, r31); r31 = vsubq_f32(r15, r31); r15 = tmp; }
+            vst1q_f32(p + 0, r0);
+            vst1q_f32(p + 128, r1);
+            vst1q_f32(p + 256, r2);
+            vst1q_f32(p + 384, r3);
+            vst1q_f32(p + 512, r4);
+            vst1q_f32(p + 640, r5);
+            vst1q_f32(p + 768, r6);
+            vst1q_f32(p + 896, r7);
+            vst1q_f32(p + 1024, r8);
+            vst1q_f32(p + 1152, r9);
+            vst1q_f32(p + 1280, r10);
+            vst1q_f32(p + 1408, r11);
+            vst1q_f32(p + 1536, r12);
+            vst1q_f32(p + 1664, r13);
+            vst1q_f32(p + 1792, r14);
+            vst1q_f32(p + 1920, r15);
+            vst1q_f32(p + 2048, r16);
+            vst1q_f32(p + 2176, r17);
+            vst1q_f32(p + 2304, r18);
+            vst1q_f32(p + 2432, r19);
+            vst1q_f32(p + 2560, r20);
+            vst1q_f32(p + 2688, r21);
+            vst1q_f32(p + 2816, r22);
+            vst1q_f32(p + 2944, r23);
+            vst1q_f32(p + 3072, r24);
+            vst1q_f32(p + 3200, r25);
+            vst1q_f32(p + 3328, r26);
+            vst1q_f32(p + 3456, r27);
+            vst1q_f32(p + 3584, r28);
+            vst1q_f32(p + 3712, r29);
+            vst1q_f32(p + 3840, r30);
+            vst1q_f32(p + 3968, r31);
+        }
+    }
+}
+
+/* Transform 2^log_n elements, 1 <= log_n <= FHT_NEON_GEN_MAX_LOG_FLOAT */
+static void fht_neon_gen_float(float *buf, int log_n) {
+    switch (log_n) {
+    case 1: fht_neon_gen_float_1(buf); break;
+    case 2: fht_neon_gen_float_2(buf); break;
+    case 3: fht_neon_gen_float_3(buf); break;
+    case 4: fht_neon_gen_float_4(buf); break;
+    case 5: fht_neon_gen_float_5(buf); break;
+    case 6: fht_neon_gen_float_6(buf); break;
+    case 7: fht_neon_gen_float_7(buf); break;
+    case 8: fht_neon_gen_float_8(buf); break;
+    case 9: fht_neon_gen_float_9(buf); break;
+    case 10: fht_neon_gen_float_10(buf); break;
+    case 11: fht_neon_gen_float_11(buf); break;
+    case 12: fht_neon_gen_float_12(buf); break;
+    default: break;
+    }
+}
+
+static void fht_neon_gen_double_1(double *buf) {
+    double u = buf[0], v = buf[1];
+    buf[0] = u + v;
+    buf[1] = u - v;
+}
+
+static void fht_neon_gen_double_2(double *buf) {
+    float64x2_t r0 = vld1q_f64(buf + 0);
+    float64x2_t r1 = vld1q_f64(buf + 2);
+    {
+        float64x2_t ev = vtrn1q_f64(r0, r1), od = vtrn2q_f64(r0, r1);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r0 = vtrn1q_f64(sm, df);
+        r1 = vtrn2q_f64(sm, df);
+    }
+    { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+    vst1q_f64(buf + 0, r0);
+    vst1q_f64(buf + 2, r1);
+}
+
+static void fht_neon_gen_double_3(double *buf) {
+    float64x2_t r0 = vld1q_f64(buf + 0);
+    float64x2_t r1 = vld1q_f64(buf + 2);
+    {
+        float64x2_t ev = vtrn1q_f64(r0, r1), od = vtrn2q_f64(r0, r1);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r0 = vtrn1q_f64(sm, df);
+        r1 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r2 = vld1q_f64(buf + 4);
+    float64x2_t r3 = vld1q_f64(buf + 6);
+    {
+        float64x2_t ev = vtrn1q_f64(r2, r3), od = vtrn2q_f64(r2, r3);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r2 = vtrn1q_f64(sm, df);
+        r3 = vtrn2q_f64(sm, df);
+    }
+    { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+    vst1q_f64(buf + 0, r0);
+    vst1q_f64(buf + 2, r1);
+    vst1q_f64(buf + 4, r2);
+    vst1q_f64(buf + 6, r3);
+}
+
+static void fht_neon_gen_double_4(double *buf) {
+    float64x2_t r0 = vld1q_f64(buf + 0);
+    float64x2_t r1 = vld1q_f64(buf + 2);
+    {
+        float64x2_t ev = vtrn1q_f64(r0, r1), od = vtrn2q_f64(r0, r1);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r0 = vtrn1q_f64(sm, df);
+        r1 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r2 = vld1q_f64(buf + 4);
+    float64x2_t r3 = vld1q_f64(buf + 6);
+    {
+        float64x2_t ev = vtrn1q_f64(r2, r3), od = vtrn2q_f64(r2, r3);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r2 = vtrn1q_f64(sm, df);
+        r3 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r4 = vld1q_f64(buf + 8);
+    float64x2_t r5 = vld1q_f64(buf + 10);
+    {
+        float64x2_t ev = vtrn1q_f64(r4, r5), od = vtrn2q_f64(r4, r5);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r4 = vtrn1q_f64(sm, df);
+        r5 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r6 = vld1q_f64(buf + 12);
+    float64x2_t r7 = vld1q_f64(buf + 14);
+    {
+        float64x2_t ev = vtrn1q_f64(r6, r7), od = vtrn2q_f64(r6, r7);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r6 = vtrn1q_f64(sm, df);
+        r7 = vtrn2q_f64(sm, df);
+    }
+    { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r4, r5); r5 = vsubq_f64(r4, r5); r4 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r6, r7); r7 = vsubq_f64(r6, r7); r6 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r4, r6); r6 = vsubq_f64(r4, r6); r4 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r5, r7); r7 = vsubq_f64(r5, r7); r5 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r0, r4); r4 = vsubq_f64(r0, r4); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r1, r5); r5 = vsubq_f64(r1, r5); r1 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r2, r6); r6 = vsubq_f64(r2, r6); r2 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r3, r7); r7 = vsubq_f64(r3, r7); r3 = tmp; }
+    vst1q_f64(buf + 0, r0);
+    vst1q_f64(buf + 2, r1);
+    vst1q_f64(buf + 4, r2);
+    vst1q_f64(buf + 6, r3);
+    vst1q_f64(buf + 8, r4);
+    vst1q_f64(buf + 10, r5);
+    vst1q_f64(buf + 12, r6);
+    vst1q_f64(buf + 14, r7);
+}
+
+static void fht_neon_gen_double_5(double *buf) {
+    float64x2_t r0 = vld1q_f64(buf + 0);
+    float64x2_t r1 = vld1q_f64(buf + 2);
+    {
+        float64x2_t ev = vtrn1q_f64(r0, r1), od = vtrn2q_f64(r0, r1);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r0 = vtrn1q_f64(sm, df);
+        r1 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r2 = vld1q_f64(buf + 4);
+    float64x2_t r3 = vld1q_f64(buf + 6);
+    {
+        float64x2_t ev = vtrn1q_f64(r2, r3), od = vtrn2q_f64(r2, r3);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r2 = vtrn1q_f64(sm, df);
+        r3 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r4 = vld1q_f64(buf + 8);
+    float64x2_t r5 = vld1q_f64(buf + 10);
+    {
+        float64x2_t ev = vtrn1q_f64(r4, r5), od = vtrn2q_f64(r4, r5);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r4 = vtrn1q_f64(sm, df);
+        r5 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r6 = vld1q_f64(buf + 12);
+    float64x2_t r7 = vld1q_f64(buf + 14);
+    {
+        float64x2_t ev = vtrn1q_f64(r6, r7), od = vtrn2q_f64(r6, r7);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r6 = vtrn1q_f64(sm, df);
+        r7 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r8 = vld1q_f64(buf + 16);
+    float64x2_t r9 = vld1q_f64(buf + 18);
+    {
+        float64x2_t ev = vtrn1q_f64(r8, r9), od = vtrn2q_f64(r8, r9);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r8 = vtrn1q_f64(sm, df);
+        r9 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r10 = vld1q_f64(buf + 20);
+    float64x2_t r11 = vld1q_f64(buf + 22);
+    {
+        float64x2_t ev = vtrn1q_f64(r10, r11), od = vtrn2q_f64(r10, r11);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r10 = vtrn1q_f64(sm, df);
+        r11 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r12 = vld1q_f64(buf + 24);
+    float64x2_t r13 = vld1q_f64(buf + 26);
+    {
+        float64x2_t ev = vtrn1q_f64(r12, r13), od = vtrn2q_f64(r12, r13);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r12 = vtrn1q_f64(sm, df);
+        r13 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r14 = vld1q_f64(buf + 28);
+    float64x2_t r15 = vld1q_f64(buf + 30);
+    {
+        float64x2_t ev = vtrn1q_f64(r14, r15), od = vtrn2q_f64(r14, r15);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r14 = vtrn1q_f64(sm, df);
+        r15 = vtrn2q_f64(sm, df);
+    }
+    { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r4, r5); r5 = vsubq_f64(r4, r5); r4 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r6, r7); r7 = vsubq_f64(r6, r7); r6 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r8, r9); r9 = vsubq_f64(r8, r9); r8 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r10, r11); r11 = vsubq_f64(r10, r11); r10 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r12, r13); r13 = vsubq_f64(r12, r13); r12 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r14, r15); r15 = vsubq_f64(r14, r15); r14 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r4, r6); r6 = vsubq_f64(r4, r6); r4 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r5, r7); r7 = vsubq_f64(r5, r7); r5 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r8, r10); r10 = vsubq_f64(r8, r10); r8 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r9, r11); r11 = vsubq_f64(r9, r11); r9 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r12, r14); r14 = vsubq_f64(r12, r14); r12 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r13, r15); r15 = vsubq_f64(r13, r15); r13 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r0, r4); r4 = vsubq_f64(r0, r4); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r1, r5); r5 = vsubq_f64(r1, r5); r1 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r2, r6); r6 = vsubq_f64(r2, r6); r2 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r3, r7); r7 = vsubq_f64(r3, r7); r3 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r8, r12); r12 = vsubq_f64(r8, r12); r8 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r9, r13); r13 = vsubq_f64(r9, r13); r9 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r10, r14); r14 = vsubq_f64(r10, r14); r10 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r11, r15); r15 = vsubq_f64(r11, r15); r11 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r0, r8); r8 = vsubq_f64(r0, r8); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r1, r9); r9 = vsubq_f64(r1, r9); r1 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r2, r10); r10 = vsubq_f64(r2, r10); r2 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r3, r11); r11 = vsubq_f64(r3, r11); r3 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r4, r12); r12 = vsubq_f64(r4, r12); r4 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r5, r13); r13 = vsubq_f64(r5, r13); r5 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r6, r14); r14 = vsubq_f64(r6, r14); r6 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r7, r15); r15 = vsubq_f64(r7, r15); r7 = tmp; }
+    vst1q_f64(buf + 0, r0);
+    vst1q_f64(buf + 2, r1);
+    vst1q_f64(buf + 4, r2);
+    vst1q_f64(buf + 6, r3);
+    vst1q_f64(buf + 8, r4);
+    vst1q_f64(buf + 10, r5);
+    vst1q_f64(buf + 12, r6);
+    vst1q_f64(buf + 14, r7);
+    vst1q_f64(buf + 16, r8);
+    vst1q_f64(buf + 18, r9);
+    vst1q_f64(buf + 20, r10);
+    vst1q_f64(buf + 22, r11);
+    vst1q_f64(buf + 24, r12);
+    vst1q_f64(buf + 26, r13);
+    vst1q_f64(buf + 28, r14);
+    vst1q_f64(buf + 30, r15);
+}
+
+static void fht_neon_gen_double_6(double *buf) {
+    float64x2_t r0 = vld1q_f64(buf + 0);
+    float64x2_t r1 = vld1q_f64(buf + 2);
+    {
+        float64x2_t ev = vtrn1q_f64(r0, r1), od = vtrn2q_f64(r0, r1);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r0 = vtrn1q_f64(sm, df);
+        r1 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r2 = vld1q_f64(buf + 4);
+    float64x2_t r3 = vld1q_f64(buf + 6);
+    {
+        float64x2_t ev = vtrn1q_f64(r2, r3), od = vtrn2q_f64(r2, r3);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r2 = vtrn1q_f64(sm, df);
+        r3 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r4 = vld1q_f64(buf + 8);
+    float64x2_t r5 = vld1q_f64(buf + 10);
+    {
+        float64x2_t ev = vtrn1q_f64(r4, r5), od = vtrn2q_f64(r4, r5);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r4 = vtrn1q_f64(sm, df);
+        r5 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r6 = vld1q_f64(buf + 12);
+    float64x2_t r7 = vld1q_f64(buf + 14);
+    {
+        float64x2_t ev = vtrn1q_f64(r6, r7), od = vtrn2q_f64(r6, r7);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r6 = vtrn1q_f64(sm, df);
+        r7 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r8 = vld1q_f64(buf + 16);
+    float64x2_t r9 = vld1q_f64(buf + 18);
+    {
+        float64x2_t ev = vtrn1q_f64(r8, r9), od = vtrn2q_f64(r8, r9);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r8 = vtrn1q_f64(sm, df);
+        r9 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r10 = vld1q_f64(buf + 20);
+    float64x2_t r11 = vld1q_f64(buf + 22);
+    {
+        float64x2_t ev = vtrn1q_f64(r10, r11), od = vtrn2q_f64(r10, r11);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r10 = vtrn1q_f64(sm, df);
+        r11 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r12 = vld1q_f64(buf + 24);
+    float64x2_t r13 = vld1q_f64(buf + 26);
+    {
+        float64x2_t ev = vtrn1q_f64(r12, r13), od = vtrn2q_f64(r12, r13);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r12 = vtrn1q_f64(sm, df);
+        r13 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r14 = vld1q_f64(buf + 28);
+    float64x2_t r15 = vld1q_f64(buf + 30);
+    {
+        float64x2_t ev = vtrn1q_f64(r14, r15), od = vtrn2q_f64(r14, r15);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r14 = vtrn1q_f64(sm, df);
+        r15 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r16 = vld1q_f64(buf + 32);
+    float64x2_t r17 = vld1q_f64(buf + 34);
+    {
+        float64x2_t ev = vtrn1q_f64(r16, r17), od = vtrn2q_f64(r16, r17);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r16 = vtrn1q_f64(sm, df);
+        r17 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r18 = vld1q_f64(buf + 36);
+    float64x2_t r19 = vld1q_f64(buf + 38);
+    {
+        float64x2_t ev = vtrn1q_f64(r18, r19), od = vtrn2q_f64(r18, r19);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r18 = vtrn1q_f64(sm, df);
+        r19 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r20 = vld1q_f64(buf + 40);
+    float64x2_t r21 = vld1q_f64(buf + 42);
+    {
+        float64x2_t ev = vtrn1q_f64(r20, r21), od = vtrn2q_f64(r20, r21);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r20 = vtrn1q_f64(sm, df);
+        r21 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r22 = vld1q_f64(buf + 44);
+    float64x2_t r23 = vld1q_f64(buf + 46);
+    {
+        float64x2_t ev = vtrn1q_f64(r22, r23), od = vtrn2q_f64(r22, r23);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r22 = vtrn1q_f64(sm, df);
+        r23 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r24 = vld1q_f64(buf + 48);
+    float64x2_t r25 = vld1q_f64(buf + 50);
+    {
+        float64x2_t ev = vtrn1q_f64(r24, r25), od = vtrn2q_f64(r24, r25);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r24 = vtrn1q_f64(sm, df);
+        r25 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r26 = vld1q_f64(buf + 52);
+    float64x2_t r27 = vld1q_f64(buf + 54);
+    {
+        float64x2_t ev = vtrn1q_f64(r26, r27), od = vtrn2q_f64(r26, r27);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r26 = vtrn1q_f64(sm, df);
+        r27 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r28 = vld1q_f64(buf + 56);
+    float64x2_t r29 = vld1q_f64(buf + 58);
+    {
+        float64x2_t ev = vtrn1q_f64(r28, r29), od = vtrn2q_f64(r28, r29);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r28 = vtrn1q_f64(sm, df);
+        r29 = vtrn2q_f64(sm, df);
+    }
+    float64x2_t r30 = vld1q_f64(buf + 60);
+    float64x2_t r31 = vld1q_f64(buf + 62);
+    {
+        float64x2_t ev = vtrn1q_f64(r30, r31), od = vtrn2q_f64(r30, r31);
+        float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+        r30 = vtrn1q_f64(sm, df);
+        r31 = vtrn2q_f64(sm, df);
+    }
+    { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r4, r5); r5 = vsubq_f64(r4, r5); r4 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r6, r7); r7 = vsubq_f64(r6, r7); r6 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r8, r9); r9 = vsubq_f64(r8, r9); r8 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r10, r11); r11 = vsubq_f64(r10, r11); r10 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r12, r13); r13 = vsubq_f64(r12, r13); r12 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r14, r15); r15 = vsubq_f64(r14, r15); r14 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r16, r17); r17 = vsubq_f64(r16, r17); r16 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r18, r19); r19 = vsubq_f64(r18, r19); r18 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r20, r21); r21 = vsubq_f64(r20, r21); r20 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r22, r23); r23 = vsubq_f64(r22, r23); r22 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r24, r25); r25 = vsubq_f64(r24, r25); r24 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r26, r27); r27 = vsubq_f64(r26, r27); r26 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r28, r29); r29 = vsubq_f64(r28, r29); r28 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r30, r31); r31 = vsubq_f64(r30, r31); r30 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r4, r6); r6 = vsubq_f64(r4, r6); r4 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r5, r7); r7 = vsubq_f64(r5, r7); r5 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r8, r10); r10 = vsubq_f64(r8, r10); r8 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r9, r11); r11 = vsubq_f64(r9, r11); r9 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r12, r14); r14 = vsubq_f64(r12, r14); r12 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r13, r15); r15 = vsubq_f64(r13, r15); r13 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r16, r18); r18 = vsubq_f64(r16, r18); r16 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r17, r19); r19 = vsubq_f64(r17, r19); r17 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r20, r22); r22 = vsubq_f64(r20, r22); r20 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r21, r23); r23 = vsubq_f64(r21, r23); r21 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r24, r26); r26 = vsubq_f64(r24, r26); r24 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r25, r27); r27 = vsubq_f64(r25, r27); r25 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r28, r30); r30 = vsubq_f64(r28, r30); r28 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r29, r31); r31 = vsubq_f64(r29, r31); r29 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r0, r4); r4 = vsubq_f64(r0, r4); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r1, r5); r5 = vsubq_f64(r1, r5); r1 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r2, r6); r6 = vsubq_f64(r2, r6); r2 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r3, r7); r7 = vsubq_f64(r3, r7); r3 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r8, r12); r12 = vsubq_f64(r8, r12); r8 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r9, r13); r13 = vsubq_f64(r9, r13); r9 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r10, r14); r14 = vsubq_f64(r10, r14); r10 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r11, r15); r15 = vsubq_f64(r11, r15); r11 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r16, r20); r20 = vsubq_f64(r16, r20); r16 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r17, r21); r21 = vsubq_f64(r17, r21); r17 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r18, r22); r22 = vsubq_f64(r18, r22); r18 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r19, r23); r23 = vsubq_f64(r19, r23); r19 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r24, r28); r28 = vsubq_f64(r24, r28); r24 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r25, r29); r29 = vsubq_f64(r25, r29); r25 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r26, r30); r30 = vsubq_f64(r26, r30); r26 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r27, r31); r31 = vsubq_f64(r27, r31); r27 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r0, r8); r8 = vsubq_f64(r0, r8); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r1, r9); r9 = vsubq_f64(r1, r9); r1 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r2, r10); r10 = vsubq_f64(r2, r10); r2 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r3, r11); r11 = vsubq_f64(r3, r11); r3 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r4, r12); r12 = vsubq_f64(r4, r12); r4 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r5, r13); r13 = vsubq_f64(r5, r13); r5 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r6, r14); r14 = vsubq_f64(r6, r14); r6 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r7, r15); r15 = vsubq_f64(r7, r15); r7 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r16, r24); r24 = vsubq_f64(r16, r24); r16 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r17, r25); r25 = vsubq_f64(r17, r25); r17 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r18, r26); r26 = vsubq_f64(r18, r26); r18 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r19, r27); r27 = vsubq_f64(r19, r27); r19 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r20, r28); r28 = vsubq_f64(r20, r28); r20 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r21, r29); r29 = vsubq_f64(r21, r29); r21 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r22, r30); r30 = vsubq_f64(r22, r30); r22 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r23, r31); r31 = vsubq_f64(r23, r31); r23 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r0, r16); r16 = vsubq_f64(r0, r16); r0 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r1, r17); r17 = vsubq_f64(r1, r17); r1 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r2, r18); r18 = vsubq_f64(r2, r18); r2 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r3, r19); r19 = vsubq_f64(r3, r19); r3 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r4, r20); r20 = vsubq_f64(r4, r20); r4 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r5, r21); r21 = vsubq_f64(r5, r21); r5 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r6, r22); r22 = vsubq_f64(r6, r22); r6 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r7, r23); r23 = vsubq_f64(r7, r23); r7 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r8, r24); r24 = vsubq_f64(r8, r24); r8 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r9, r25); r25 = vsubq_f64(r9, r25); r9 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r10, r26); r26 = vsubq_f64(r10, r26); r10 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r11, r27); r27 = vsubq_f64(r11, r27); r11 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r12, r28); r28 = vsubq_f64(r12, r28); r12 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r13, r29); r29 = vsubq_f64(r13, r29); r13 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r14, r30); r30 = vsubq_f64(r14, r30); r14 = tmp; }
+    { float64x2_t tmp = vaddq_f64(r15, r31); r31 = vsubq_f64(r15, r31); r15 = tmp; }
+    vst1q_f64(buf + 0, r0);
+    vst1q_f64(buf + 2, r1);
+    vst1q_f64(buf + 4, r2);
+    vst1q_f64(buf + 6, r3);
+    vst1q_f64(buf + 8, r4);
+    vst1q_f64(buf + 10, r5);
+    vst1q_f64(buf + 12, r6);
+    vst1q_f64(buf + 14, r7);
+    vst1q_f64(buf + 16, r8);
+    vst1q_f64(buf + 18, r9);
+    vst1q_f64(buf + 20, r10);
+    vst1q_f64(buf + 22, r11);
+    vst1q_f64(buf + 24, r12);
+    vst1q_f64(buf + 26, r13);
+    vst1q_f64(buf + 28, r14);
+    vst1q_f64(buf + 30, r15);
+    vst1q_f64(buf + 32, r16);
+    vst1q_f64(buf + 34, r17);
+    vst1q_f64(buf + 36, r18);
+    vst1q_f64(buf + 38, r19);
+    vst1q_f64(buf + 40, r20);
+    vst1q_f64(buf + 42, r21);
+    vst1q_f64(buf + 44, r22);
+    vst1q_f64(buf + 46, r23);
+    vst1q_f64(buf + 48, r24);
+    vst1q_f64(buf + 50, r25);
+    vst1q_f64(buf + 52, r26);
+    vst1q_f64(buf + 54, r27);
+    vst1q_f64(buf + 56, r28);
+    vst1q_f64(buf + 58, r29);
+    vst1q_f64(buf + 60, r30);
+    vst1q_f64(buf + 62, r31);
+}
+
+static void fht_neon_gen_double_7(double *buf) {
+    for (size_t i = 0; i < 128; i += 64) {
+        double *p = buf + i;
+        float64x2_t r0 = vld1q_f64(p + 0);
+        float64x2_t r1 = vld1q_f64(p + 2);
+        {
+            float64x2_t ev = vtrn1q_f64(r0, r1), od = vtrn2q_f64(r0, r1);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r0 = vtrn1q_f64(sm, df);
+            r1 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r2 = vld1q_f64(p + 4);
+        float64x2_t r3 = vld1q_f64(p + 6);
+        {
+            float64x2_t ev = vtrn1q_f64(r2, r3), od = vtrn2q_f64(r2, r3);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r2 = vtrn1q_f64(sm, df);
+            r3 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r4 = vld1q_f64(p + 8);
+        float64x2_t r5 = vld1q_f64(p + 10);
+        {
+            float64x2_t ev = vtrn1q_f64(r4, r5), od = vtrn2q_f64(r4, r5);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r4 = vtrn1q_f64(sm, df);
+            r5 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r6 = vld1q_f64(p + 12);
+        float64x2_t r7 = vld1q_f64(p + 14);
+        {
+            float64x2_t ev = vtrn1q_f64(r6, r7), od = vtrn2q_f64(r6, r7);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r6 = vtrn1q_f64(sm, df);
+            r7 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r8 = vld1q_f64(p + 16);
+        float64x2_t r9 = vld1q_f64(p + 18);
+        {
+            float64x2_t ev = vtrn1q_f64(r8, r9), od = vtrn2q_f64(r8, r9);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r8 = vtrn1q_f64(sm, df);
+            r9 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r10 = vld1q_f64(p + 20);
+        float64x2_t r11 = vld1q_f64(p + 22);
+        {
+            float64x2_t ev = vtrn1q_f64(r10, r11), od = vtrn2q_f64(r10, r11);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r10 = vtrn1q_f64(sm, df);
+            r11 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r12 = vld1q_f64(p + 24);
+        float64x2_t r13 = vld1q_f64(p + 26);
+        {
+            float64x2_t ev = vtrn1q_f64(r12, r13), od = vtrn2q_f64(r12, r13);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r12 = vtrn1q_f64(sm, df);
+            r13 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r14 = vld1q_f64(p + 28);
+        float64x2_t r15 = vld1q_f64(p + 30);
+        {
+            float64x2_t ev = vtrn1q_f64(r14, r15), od = vtrn2q_f64(r14, r15);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r14 = vtrn1q_f64(sm, df);
+            r15 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r16 = vld1q_f64(p + 32);
+        float64x2_t r17 = vld1q_f64(p + 34);
+        {
+            float64x2_t ev = vtrn1q_f64(r16, r17), od = vtrn2q_f64(r16, r17);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r16 = vtrn1q_f64(sm, df);
+            r17 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r18 = vld1q_f64(p + 36);
+        float64x2_t r19 = vld1q_f64(p + 38);
+        {
+            float64x2_t ev = vtrn1q_f64(r18, r19), od = vtrn2q_f64(r18, r19);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r18 = vtrn1q_f64(sm, df);
+            r19 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r20 = vld1q_f64(p + 40);
+        float64x2_t r21 = vld1q_f64(p + 42);
+        {
+            float64x2_t ev = vtrn1q_f64(r20, r21), od = vtrn2q_f64(r20, r21);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r20 = vtrn1q_f64(sm, df);
+            r21 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r22 = vld1q_f64(p + 44);
+        float64x2_t r23 = vld1q_f64(p + 46);
+        {
+            float64x2_t ev = vtrn1q_f64(r22, r23), od = vtrn2q_f64(r22, r23);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r22 = vtrn1q_f64(sm, df);
+            r23 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r24 = vld1q_f64(p + 48);
+        float64x2_t r25 = vld1q_f64(p + 50);
+        {
+            float64x2_t ev = vtrn1q_f64(r24, r25), od = vtrn2q_f64(r24, r25);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r24 = vtrn1q_f64(sm, df);
+            r25 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r26 = vld1q_f64(p + 52);
+        float64x2_t r27 = vld1q_f64(p + 54);
+        {
+            float64x2_t ev = vtrn1q_f64(r26, r27), od = vtrn2q_f64(r26, r27);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r26 = vtrn1q_f64(sm, df);
+            r27 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r28 = vld1q_f64(p + 56);
+        float64x2_t r29 = vld1q_f64(p + 58);
+        {
+            float64x2_t ev = vtrn1q_f64(r28, r29), od = vtrn2q_f64(r28, r29);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r28 = vtrn1q_f64(sm, df);
+            r29 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r30 = vld1q_f64(p + 60);
+        float64x2_t r31 = vld1q_f64(p + 62);
+        {
+            float64x2_t ev = vtrn1q_f64(r30, r31), od = vtrn2q_f64(r30, r31);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r30 = vtrn1q_f64(sm, df);
+            r31 = vtrn2q_f64(sm, df);
+        }
+        { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r5); r5 = vsubq_f64(r4, r5); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r7); r7 = vsubq_f64(r6, r7); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r9); r9 = vsubq_f64(r8, r9); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r11); r11 = vsubq_f64(r10, r11); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r13); r13 = vsubq_f64(r12, r13); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r14, r15); r15 = vsubq_f64(r14, r15); r14 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r17); r17 = vsubq_f64(r16, r17); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r19); r19 = vsubq_f64(r18, r19); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r21); r21 = vsubq_f64(r20, r21); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r22, r23); r23 = vsubq_f64(r22, r23); r22 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r25); r25 = vsubq_f64(r24, r25); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r26, r27); r27 = vsubq_f64(r26, r27); r26 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r28, r29); r29 = vsubq_f64(r28, r29); r28 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r30, r31); r31 = vsubq_f64(r30, r31); r30 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r6); r6 = vsubq_f64(r4, r6); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r7); r7 = vsubq_f64(r5, r7); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r10); r10 = vsubq_f64(r8, r10); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r11); r11 = vsubq_f64(r9, r11); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r14); r14 = vsubq_f64(r12, r14); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r13, r15); r15 = vsubq_f64(r13, r15); r13 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r18); r18 = vsubq_f64(r16, r18); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r19); r19 = vsubq_f64(r17, r19); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r22); r22 = vsubq_f64(r20, r22); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r21, r23); r23 = vsubq_f64(r21, r23); r21 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r26); r26 = vsubq_f64(r24, r26); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r25, r27); r27 = vsubq_f64(r25, r27); r25 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r28, r30); r30 = vsubq_f64(r28, r30); r28 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r29, r31); r31 = vsubq_f64(r29, r31); r29 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r4); r4 = vsubq_f64(r0, r4); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r5); r5 = vsubq_f64(r1, r5); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r6); r6 = vsubq_f64(r2, r6); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r7); r7 = vsubq_f64(r3, r7); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r12); r12 = vsubq_f64(r8, r12); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r13); r13 = vsubq_f64(r9, r13); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r14); r14 = vsubq_f64(r10, r14); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r11, r15); r15 = vsubq_f64(r11, r15); r11 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r20); r20 = vsubq_f64(r16, r20); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r21); r21 = vsubq_f64(r17, r21); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r22); r22 = vsubq_f64(r18, r22); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r19, r23); r23 = vsubq_f64(r19, r23); r19 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r28); r28 = vsubq_f64(r24, r28); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r25, r29); r29 = vsubq_f64(r25, r29); r25 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r26, r30); r30 = vsubq_f64(r26, r30); r26 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r27, r31); r31 = vsubq_f64(r27, r31); r27 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r8); r8 = vsubq_f64(r0, r8); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r9); r9 = vsubq_f64(r1, r9); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r10); r10 = vsubq_f64(r2, r10); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r11); r11 = vsubq_f64(r3, r11); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r12); r12 = vsubq_f64(r4, r12); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r13); r13 = vsubq_f64(r5, r13); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r14); r14 = vsubq_f64(r6, r14); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r7, r15); r15 = vsubq_f64(r7, r15); r7 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r24); r24 = vsubq_f64(r16, r24); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r25); r25 = vsubq_f64(r17, r25); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r26); r26 = vsubq_f64(r18, r26); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r19, r27); r27 = vsubq_f64(r19, r27); r19 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r28); r28 = vsubq_f64(r20, r28); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r21, r29); r29 = vsubq_f64(r21, r29); r21 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r22, r30); r30 = vsubq_f64(r22, r30); r22 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r23, r31); r31 = vsubq_f64(r23, r31); r23 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r16); r16 = vsubq_f64(r0, r16); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r17); r17 = vsubq_f64(r1, r17); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r18); r18 = vsubq_f64(r2, r18); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r19); r19 = vsubq_f64(r3, r19); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r20); r20 = vsubq_f64(r4, r20); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r21); r21 = vsubq_f64(r5, r21); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r22); r22 = vsubq_f64(r6, r22); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r7, r23); r23 = vsubq_f64(r7, r23); r7 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r24); r24 = vsubq_f64(r8, r24); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r25); r25 = vsubq_f64(r9, r25); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r26); r26 = vsubq_f64(r10, r26); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r11, r27); r27 = vsubq_f64(r11, r27); r11 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r28); r28 = vsubq_f64(r12, r28); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r13, r29); r29 = vsubq_f64(r13, r29); r13 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r14, r30); r30 = vsubq_f64(r14, r30); r14 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r15, r31); r31 = vsubq_f64(r15, r31); r15 = tmp; }
+        vst1q_f64(p + 0, r0);
+        vst1q_f64(p + 2, r1);
+        vst1q_f64(p + 4, r2);
+        vst1q_f64(p + 6, r3);
+        vst1q_f64(p + 8, r4);
+        vst1q_f64(p + 10, r5);
+        vst1q_f64(p + 12, r6);
+        vst1q_f64(p + 14, r7);
+        vst1q_f64(p + 16, r8);
+        vst1q_f64(p + 18, r9);
+        vst1q_f64(p + 20, r10);
+        vst1q_f64(p + 22, r11);
+        vst1q_f64(p + 24, r12);
+        vst1q_f64(p + 26, r13);
+        vst1q_f64(p + 28, r14);
+        vst1q_f64(p + 30, r15);
+        vst1q_f64(p + 32, r16);
+        vst1q_f64(p + 34, r17);
+        vst1q_f64(p + 36, r18);
+        vst1q_f64(p + 38, r19);
+        vst1q_f64(p + 40, r20);
+        vst1q_f64(p + 42, r21);
+        vst1q_f64(p + 44, r22);
+        vst1q_f64(p + 46, r23);
+        vst1q_f64(p + 48, r24);
+        vst1q_f64(p + 50, r25);
+        vst1q_f64(p + 52, r26);
+        vst1q_f64(p + 54, r27);
+        vst1q_f64(p + 56, r28);
+        vst1q_f64(p + 58, r29);
+        vst1q_f64(p + 60, r30);
+        vst1q_f64(p + 62, r31);
+    }
+    for (size_t i = 0; i < 128; i += 128) {
+        for (size_t j = i; j < i + 64; j += 2) {
+            double *p = buf + j;
+            float64x2_t r0 = vld1q_f64(p + 0);
+            float64x2_t r1 = vld1q_f64(p + 64);
+            { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+            vst1q_f64(p + 0, r0);
+            vst1q_f64(p + 64, r1);
+        }
+    }
+}
+
+static void fht_neon_gen_double_8(double *buf) {
+    for (size_t i = 0; i < 256; i += 64) {
+        double *p = buf + i;
+        float64x2_t r0 = vld1q_f64(p + 0);
+        float64x2_t r1 = vld1q_f64(p + 2);
+        {
+            float64x2_t ev = vtrn1q_f64(r0, r1), od = vtrn2q_f64(r0, r1);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r0 = vtrn1q_f64(sm, df);
+            r1 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r2 = vld1q_f64(p + 4);
+        float64x2_t r3 = vld1q_f64(p + 6);
+        {
+            float64x2_t ev = vtrn1q_f64(r2, r3), od = vtrn2q_f64(r2, r3);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r2 = vtrn1q_f64(sm, df);
+            r3 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r4 = vld1q_f64(p + 8);
+        float64x2_t r5 = vld1q_f64(p + 10);
+        {
+            float64x2_t ev = vtrn1q_f64(r4, r5), od = vtrn2q_f64(r4, r5);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r4 = vtrn1q_f64(sm, df);
+            r5 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r6 = vld1q_f64(p + 12);
+        float64x2_t r7 = vld1q_f64(p + 14);
+        {
+            float64x2_t ev = vtrn1q_f64(r6, r7), od = vtrn2q_f64(r6, r7);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r6 = vtrn1q_f64(sm, df);
+            r7 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r8 = vld1q_f64(p + 16);
+        float64x2_t r9 = vld1q_f64(p + 18);
+        {
+            float64x2_t ev = vtrn1q_f64(r8, r9), od = vtrn2q_f64(r8, r9);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r8 = vtrn1q_f64(sm, df);
+            r9 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r10 = vld1q_f64(p + 20);
+        float64x2_t r11 = vld1q_f64(p + 22);
+        {
+            float64x2_t ev = vtrn1q_f64(r10, r11), od = vtrn2q_f64(r10, r11);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r10 = vtrn1q_f64(sm, df);
+            r11 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r12 = vld1q_f64(p + 24);
+        float64x2_t r13 = vld1q_f64(p + 26);
+        {
+            float64x2_t ev = vtrn1q_f64(r12, r13), od = vtrn2q_f64(r12, r13);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r12 = vtrn1q_f64(sm, df);
+            r13 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r14 = vld1q_f64(p + 28);
+        float64x2_t r15 = vld1q_f64(p + 30);
+        {
+            float64x2_t ev = vtrn1q_f64(r14, r15), od = vtrn2q_f64(r14, r15);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r14 = vtrn1q_f64(sm, df);
+            r15 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r16 = vld1q_f64(p + 32);
+        float64x2_t r17 = vld1q_f64(p + 34);
+        {
+            float64x2_t ev = vtrn1q_f64(r16, r17), od = vtrn2q_f64(r16, r17);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r16 = vtrn1q_f64(sm, df);
+            r17 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r18 = vld1q_f64(p + 36);
+        float64x2_t r19 = vld1q_f64(p + 38);
+        {
+            float64x2_t ev = vtrn1q_f64(r18, r19), od = vtrn2q_f64(r18, r19);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r18 = vtrn1q_f64(sm, df);
+            r19 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r20 = vld1q_f64(p + 40);
+        float64x2_t r21 = vld1q_f64(p + 42);
+        {
+            float64x2_t ev = vtrn1q_f64(r20, r21), od = vtrn2q_f64(r20, r21);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r20 = vtrn1q_f64(sm, df);
+            r21 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r22 = vld1q_f64(p + 44);
+        float64x2_t r23 = vld1q_f64(p + 46);
+        {
+            float64x2_t ev = vtrn1q_f64(r22, r23), od = vtrn2q_f64(r22, r23);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r22 = vtrn1q_f64(sm, df);
+            r23 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r24 = vld1q_f64(p + 48);
+        float64x2_t r25 = vld1q_f64(p + 50);
+        {
+            float64x2_t ev = vtrn1q_f64(r24, r25), od = vtrn2q_f64(r24, r25);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r24 = vtrn1q_f64(sm, df);
+            r25 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r26 = vld1q_f64(p + 52);
+        float64x2_t r27 = vld1q_f64(p + 54);
+        {
+            float64x2_t ev = vtrn1q_f64(r26, r27), od = vtrn2q_f64(r26, r27);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r26 = vtrn1q_f64(sm, df);
+            r27 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r28 = vld1q_f64(p + 56);
+        float64x2_t r29 = vld1q_f64(p + 58);
+        {
+            float64x2_t ev = vtrn1q_f64(r28, r29), od = vtrn2q_f64(r28, r29);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r28 = vtrn1q_f64(sm, df);
+            r29 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r30 = vld1q_f64(p + 60);
+        float64x2_t r31 = vld1q_f64(p + 62);
+        {
+            float64x2_t ev = vtrn1q_f64(r30, r31), od = vtrn2q_f64(r30, r31);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r30 = vtrn1q_f64(sm, df);
+            r31 = vtrn2q_f64(sm, df);
+        }
+        { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r5); r5 = vsubq_f64(r4, r5); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r7); r7 = vsubq_f64(r6, r7); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r9); r9 = vsubq_f64(r8, r9); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r11); r11 = vsubq_f64(r10, r11); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r13); r13 = vsubq_f64(r12, r13); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r14, r15); r15 = vsubq_f64(r14, r15); r14 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r17); r17 = vsubq_f64(r16, r17); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r19); r19 = vsubq_f64(r18, r19); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r21); r21 = vsubq_f64(r20, r21); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r22, r23); r23 = vsubq_f64(r22, r23); r22 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r25); r25 = vsubq_f64(r24, r25); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r26, r27); r27 = vsubq_f64(r26, r27); r26 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r28, r29); r29 = vsubq_f64(r28, r29); r28 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r30, r31); r31 = vsubq_f64(r30, r31); r30 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r6); r6 = vsubq_f64(r4, r6); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r7); r7 = vsubq_f64(r5, r7); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r10); r10 = vsubq_f64(r8, r10); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r11); r11 = vsubq_f64(r9, r11); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r14); r14 = vsubq_f64(r12, r14); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r13, r15); r15 = vsubq_f64(r13, r15); r13 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r18); r18 = vsubq_f64(r16, r18); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r19); r19 = vsubq_f64(r17, r19); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r22); r22 = vsubq_f64(r20, r22); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r21, r23); r23 = vsubq_f64(r21, r23); r21 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r26); r26 = vsubq_f64(r24, r26); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r25, r27); r27 = vsubq_f64(r25, r27); r25 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r28, r30); r30 = vsubq_f64(r28, r30); r28 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r29, r31); r31 = vsubq_f64(r29, r31); r29 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r4); r4 = vsubq_f64(r0, r4); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r5); r5 = vsubq_f64(r1, r5); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r6); r6 = vsubq_f64(r2, r6); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r7); r7 = vsubq_f64(r3, r7); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r12); r12 = vsubq_f64(r8, r12); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r13); r13 = vsubq_f64(r9, r13); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r14); r14 = vsubq_f64(r10, r14); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r11, r15); r15 = vsubq_f64(r11, r15); r11 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r20); r20 = vsubq_f64(r16, r20); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r21); r21 = vsubq_f64(r17, r21); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r22); r22 = vsubq_f64(r18, r22); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r19, r23); r23 = vsubq_f64(r19, r23); r19 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r28); r28 = vsubq_f64(r24, r28); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r25, r29); r29 = vsubq_f64(r25, r29); r25 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r26, r30); r30 = vsubq_f64(r26, r30); r26 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r27, r31); r31 = vsubq_f64(r27, r31); r27 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r8); r8 = vsubq_f64(r0, r8); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r9); r9 = vsubq_f64(r1, r9); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r10); r10 = vsubq_f64(r2, r10); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r11); r11 = vsubq_f64(r3, r11); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r12); r12 = vsubq_f64(r4, r12); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r13); r13 = vsubq_f64(r5, r13); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r14); r14 = vsubq_f64(r6, r14); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r7, r15); r15 = vsubq_f64(r7, r15); r7 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r24); r24 = vsubq_f64(r16, r24); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r25); r25 = vsubq_f64(r17, r25); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r26); r26 = vsubq_f64(r18, r26); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r19, r27); r27 = vsubq_f64(r19, r27); r19 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r28); r28 = vsubq_f64(r20, r28); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r21, r29); r29 = vsubq_f64(r21, r29); r21 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r22, r30); r30 = vsubq_f64(r22, r30); r22 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r23, r31); r31 = vsubq_f64(r23, r31); r23 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r16); r16 = vsubq_f64(r0, r16); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r17); r17 = vsubq_f64(r1, r17); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r18); r18 = vsubq_f64(r2, r18); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r19); r19 = vsubq_f64(r3, r19); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r20); r20 = vsubq_f64(r4, r20); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r21); r21 = vsubq_f64(r5, r21); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r22); r22 = vsubq_f64(r6, r22); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r7, r23); r23 = vsubq_f64(r7, r23); r7 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r24); r24 = vsubq_f64(r8, r24); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r25); r25 = vsubq_f64(r9, r25); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r26); r26 = vsubq_f64(r10, r26); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r11, r27); r27 = vsubq_f64(r11, r27); r11 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r28); r28 = vsubq_f64(r12, r28); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r13, r29); r29 = vsubq_f64(r13, r29); r13 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r14, r30); r30 = vsubq_f64(r14, r30); r14 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r15, r31); r31 = vsubq_f64(r15, r31); r15 = tmp; }
+        vst1q_f64(p + 0, r0);
+        vst1q_f64(p + 2, r1);
+        vst1q_f64(p + 4, r2);
+        vst1q_f64(p + 6, r3);
+        vst1q_f64(p + 8, r4);
+        vst1q_f64(p + 10, r5);
+        vst1q_f64(p + 12, r6);
+        vst1q_f64(p + 14, r7);
+        vst1q_f64(p + 16, r8);
+        vst1q_f64(p + 18, r9);
+        vst1q_f64(p + 20, r10);
+        vst1q_f64(p + 22, r11);
+        vst1q_f64(p + 24, r12);
+        vst1q_f64(p + 26, r13);
+        vst1q_f64(p + 28, r14);
+        vst1q_f64(p + 30, r15);
+        vst1q_f64(p + 32, r16);
+        vst1q_f64(p + 34, r17);
+        vst1q_f64(p + 36, r18);
+        vst1q_f64(p + 38, r19);
+        vst1q_f64(p + 40, r20);
+        vst1q_f64(p + 42, r21);
+        vst1q_f64(p + 44, r22);
+        vst1q_f64(p + 46, r23);
+        vst1q_f64(p + 48, r24);
+        vst1q_f64(p + 50, r25);
+        vst1q_f64(p + 52, r26);
+        vst1q_f64(p + 54, r27);
+        vst1q_f64(p + 56, r28);
+        vst1q_f64(p + 58, r29);
+        vst1q_f64(p + 60, r30);
+        vst1q_f64(p + 62, r31);
+    }
+    for (size_t i = 0; i < 256; i += 256) {
+        for (size_t j = i; j < i + 64; j += 2) {
+            double *p = buf + j;
+            float64x2_t r0 = vld1q_f64(p + 0);
+            float64x2_t r1 = vld1q_f64(p + 64);
+            float64x2_t r2 = vld1q_f64(p + 128);
+            float64x2_t r3 = vld1q_f64(p + 192);
+            { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+            vst1q_f64(p + 0, r0);
+            vst1q_f64(p + 64, r1);
+            vst1q_f64(p + 128, r2);
+            vst1q_f64(p + 192, r3);
+        }
+    }
+}
+
+static void fht_neon_gen_double_9(double *buf) {
+    for (size_t i = 0; i < 512; i += 64) {
+        double *p = buf + i;
+        float64x2_t r0 = vld1q_f64(p + 0);
+        float64x2_t r1 = vld1q_f64(p + 2);
+        {
+            float64x2_t ev = vtrn1q_f64(r0, r1), od = vtrn2q_f64(r0, r1);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r0 = vtrn1q_f64(sm, df);
+            r1 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r2 = vld1q_f64(p + 4);
+        float64x2_t r3 = vld1q_f64(p + 6);
+        {
+            float64x2_t ev = vtrn1q_f64(r2, r3), od = vtrn2q_f64(r2, r3);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r2 = vtrn1q_f64(sm, df);
+            r3 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r4 = vld1q_f64(p + 8);
+        float64x2_t r5 = vld1q_f64(p + 10);
+        {
+            float64x2_t ev = vtrn1q_f64(r4, r5), od = vtrn2q_f64(r4, r5);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r4 = vtrn1q_f64(sm, df);
+            r5 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r6 = vld1q_f64(p + 12);
+        float64x2_t r7 = vld1q_f64(p + 14);
+        {
+            float64x2_t ev = vtrn1q_f64(r6, r7), od = vtrn2q_f64(r6, r7);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r6 = vtrn1q_f64(sm, df);
+            r7 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r8 = vld1q_f64(p + 16);
+        float64x2_t r9 = vld1q_f64(p + 18);
+        {
+            float64x2_t ev = vtrn1q_f64(r8, r9), od = vtrn2q_f64(r8, r9);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r8 = vtrn1q_f64(sm, df);
+            r9 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r10 = vld1q_f64(p + 20);
+        float64x2_t r11 = vld1q_f64(p + 22);
+        {
+            float64x2_t ev = vtrn1q_f64(r10, r11), od = vtrn2q_f64(r10, r11);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r10 = vtrn1q_f64(sm, df);
+            r11 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r12 = vld1q_f64(p + 24);
+        float64x2_t r13 = vld1q_f64(p + 26);
+        {
+            float64x2_t ev = vtrn1q_f64(r12, r13), od = vtrn2q_f64(r12, r13);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r12 = vtrn1q_f64(sm, df);
+            r13 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r14 = vld1q_f64(p + 28);
+        float64x2_t r15 = vld1q_f64(p + 30);
+        {
+            float64x2_t ev = vtrn1q_f64(r14, r15), od = vtrn2q_f64(r14, r15);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r14 = vtrn1q_f64(sm, df);
+            r15 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r16 = vld1q_f64(p + 32);
+        float64x2_t r17 = vld1q_f64(p + 34);
+        {
+            float64x2_t ev = vtrn1q_f64(r16, r17), od = vtrn2q_f64(r16, r17);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r16 = vtrn1q_f64(sm, df);
+            r17 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r18 = vld1q_f64(p + 36);
+        float64x2_t r19 = vld1q_f64(p + 38);
+        {
+            float64x2_t ev = vtrn1q_f64(r18, r19), od = vtrn2q_f64(r18, r19);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r18 = vtrn1q_f64(sm, df);
+            r19 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r20 = vld1q_f64(p + 40);
+        float64x2_t r21 = vld1q_f64(p + 42);
+        {
+            float64x2_t ev = vtrn1q_f64(r20, r21), od = vtrn2q_f64(r20, r21);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r20 = vtrn1q_f64(sm, df);
+            r21 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r22 = vld1q_f64(p + 44);
+        float64x2_t r23 = vld1q_f64(p + 46);
+        {
+            float64x2_t ev = vtrn1q_f64(r22, r23), od = vtrn2q_f64(r22, r23);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r22 = vtrn1q_f64(sm, df);
+            r23 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r24 = vld1q_f64(p + 48);
+        float64x2_t r25 = vld1q_f64(p + 50);
+        {
+            float64x2_t ev = vtrn1q_f64(r24, r25), od = vtrn2q_f64(r24, r25);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r24 = vtrn1q_f64(sm, df);
+            r25 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r26 = vld1q_f64(p + 52);
+        float64x2_t r27 = vld1q_f64(p + 54);
+        {
+            float64x2_t ev = vtrn1q_f64(r26, r27), od = vtrn2q_f64(r26, r27);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r26 = vtrn1q_f64(sm, df);
+            r27 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r28 = vld1q_f64(p + 56);
+        float64x2_t r29 = vld1q_f64(p + 58);
+        {
+            float64x2_t ev = vtrn1q_f64(r28, r29), od = vtrn2q_f64(r28, r29);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r28 = vtrn1q_f64(sm, df);
+            r29 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r30 = vld1q_f64(p + 60);
+        float64x2_t r31 = vld1q_f64(p + 62);
+        {
+            float64x2_t ev = vtrn1q_f64(r30, r31), od = vtrn2q_f64(r30, r31);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r30 = vtrn1q_f64(sm, df);
+            r31 = vtrn2q_f64(sm, df);
+        }
+        { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r5); r5 = vsubq_f64(r4, r5); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r7); r7 = vsubq_f64(r6, r7); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r9); r9 = vsubq_f64(r8, r9); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r11); r11 = vsubq_f64(r10, r11); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r13); r13 = vsubq_f64(r12, r13); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r14, r15); r15 = vsubq_f64(r14, r15); r14 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r17); r17 = vsubq_f64(r16, r17); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r19); r19 = vsubq_f64(r18, r19); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r21); r21 = vsubq_f64(r20, r21); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r22, r23); r23 = vsubq_f64(r22, r23); r22 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r25); r25 = vsubq_f64(r24, r25); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r26, r27); r27 = vsubq_f64(r26, r27); r26 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r28, r29); r29 = vsubq_f64(r28, r29); r28 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r30, r31); r31 = vsubq_f64(r30, r31); r30 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r6); r6 = vsubq_f64(r4, r6); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r7); r7 = vsubq_f64(r5, r7); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r10); r10 = vsubq_f64(r8, r10); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r11); r11 = vsubq_f64(r9, r11); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r14); r14 = vsubq_f64(r12, r14); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r13, r15); r15 = vsubq_f64(r13, r15); r13 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r18); r18 = vsubq_f64(r16, r18); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r19); r19 = vsubq_f64(r17, r19); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r22); r22 = vsubq_f64(r20, r22); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r21, r23); r23 = vsubq_f64(r21, r23); r21 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r26); r26 = vsubq_f64(r24, r26); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r25, r27); r27 = vsubq_f64(r25, r27); r25 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r28, r30); r30 = vsubq_f64(r28, r30); r28 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r29, r31); r31 = vsubq_f64(r29, r31); r29 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r4); r4 = vsubq_f64(r0, r4); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r5); r5 = vsubq_f64(r1, r5); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r6); r6 = vsubq_f64(r2, r6); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r7); r7 = vsubq_f64(r3, r7); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r12); r12 = vsubq_f64(r8, r12); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r13); r13 = vsubq_f64(r9, r13); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r14); r14 = vsubq_f64(r10, r14); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r11, r15); r15 = vsubq_f64(r11, r15); r11 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r20); r20 = vsubq_f64(r16, r20); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r21); r21 = vsubq_f64(r17, r21); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r22); r22 = vsubq_f64(r18, r22); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r19, r23); r23 = vsubq_f64(r19, r23); r19 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r28); r28 = vsubq_f64(r24, r28); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r25, r29); r29 = vsubq_f64(r25, r29); r25 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r26, r30); r30 = vsubq_f64(r26, r30); r26 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r27, r31); r31 = vsubq_f64(r27, r31); r27 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r8); r8 = vsubq_f64(r0, r8); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r9); r9 = vsubq_f64(r1, r9); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r10); r10 = vsubq_f64(r2, r10); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r11); r11 = vsubq_f64(r3, r11); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r12); r12 = vsubq_f64(r4, r12); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r13); r13 = vsubq_f64(r5, r13); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r14); r14 = vsubq_f64(r6, r14); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r7, r15); r15 = vsubq_f64(r7, r15); r7 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r24); r24 = vsubq_f64(r16, r24); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r25); r25 = vsubq_f64(r17, r25); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r26); r26 = vsubq_f64(r18, r26); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r19, r27); r27 = vsubq_f64(r19, r27); r19 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r28); r28 = vsubq_f64(r20, r28); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r21, r29); r29 = vsubq_f64(r21, r29); r21 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r22, r30); r30 = vsubq_f64(r22, r30); r22 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r23, r31); r31 = vsubq_f64(r23, r31); r23 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r16); r16 = vsubq_f64(r0, r16); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r17); r17 = vsubq_f64(r1, r17); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r18); r18 = vsubq_f64(r2, r18); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r19); r19 = vsubq_f64(r3, r19); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r20); r20 = vsubq_f64(r4, r20); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r21); r21 = vsubq_f64(r5, r21); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r22); r22 = vsubq_f64(r6, r22); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r7, r23); r23 = vsubq_f64(r7, r23); r7 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r24); r24 = vsubq_f64(r8, r24); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r25); r25 = vsubq_f64(r9, r25); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r26); r26 = vsubq_f64(r10, r26); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r11, r27); r27 = vsubq_f64(r11, r27); r11 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r28); r28 = vsubq_f64(r12, r28); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r13, r29); r29 = vsubq_f64(r13, r29); r13 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r14, r30); r30 = vsubq_f64(r14, r30); r14 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r15, r31); r31 = vsubq_f64(r15, r31); r15 = tmp; }
+        vst1q_f64(p + 0, r0);
+        vst1q_f64(p + 2, r1);
+        vst1q_f64(p + 4, r2);
+        vst1q_f64(p + 6, r3);
+        vst1q_f64(p + 8, r4);
+        vst1q_f64(p + 10, r5);
+        vst1q_f64(p + 12, r6);
+        vst1q_f64(p + 14, r7);
+        vst1q_f64(p + 16, r8);
+        vst1q_f64(p + 18, r9);
+        vst1q_f64(p + 20, r10);
+        vst1q_f64(p + 22, r11);
+        vst1q_f64(p + 24, r12);
+        vst1q_f64(p + 26, r13);
+        vst1q_f64(p + 28, r14);
+        vst1q_f64(p + 30, r15);
+        vst1q_f64(p + 32, r16);
+        vst1q_f64(p + 34, r17);
+        vst1q_f64(p + 36, r18);
+        vst1q_f64(p + 38, r19);
+        vst1q_f64(p + 40, r20);
+        vst1q_f64(p + 42, r21);
+        vst1q_f64(p + 44, r22);
+        vst1q_f64(p + 46, r23);
+        vst1q_f64(p + 48, r24);
+        vst1q_f64(p + 50, r25);
+        vst1q_f64(p + 52, r26);
+        vst1q_f64(p + 54, r27);
+        vst1q_f64(p + 56, r28);
+        vst1q_f64(p + 58, r29);
+        vst1q_f64(p + 60, r30);
+        vst1q_f64(p + 62, r31);
+    }
+    for (size_t i = 0; i < 512; i += 512) {
+        for (size_t j = i; j < i + 64; j += 2) {
+            double *p = buf + j;
+            float64x2_t r0 = vld1q_f64(p + 0);
+            float64x2_t r1 = vld1q_f64(p + 64);
+            float64x2_t r2 = vld1q_f64(p + 128);
+            float64x2_t r3 = vld1q_f64(p + 192);
+            float64x2_t r4 = vld1q_f64(p + 256);
+            float64x2_t r5 = vld1q_f64(p + 320);
+            float64x2_t r6 = vld1q_f64(p + 384);
+            float64x2_t r7 = vld1q_f64(p + 448);
+            { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r4, r5); r5 = vsubq_f64(r4, r5); r4 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r6, r7); r7 = vsubq_f64(r6, r7); r6 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r4, r6); r6 = vsubq_f64(r4, r6); r4 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r5, r7); r7 = vsubq_f64(r5, r7); r5 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r0, r4); r4 = vsubq_f64(r0, r4); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r1, r5); r5 = vsubq_f64(r1, r5); r1 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r2, r6); r6 = vsubq_f64(r2, r6); r2 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r3, r7); r7 = vsubq_f64(r3, r7); r3 = tmp; }
+            vst1q_f64(p + 0, r0);
+            vst1q_f64(p + 64, r1);
+            vst1q_f64(p + 128, r2);
+            vst1q_f64(p + 192, r3);
+            vst1q_f64(p + 256, r4);
+            vst1q_f64(p + 320, r5);
+            vst1q_f64(p + 384, r6);
+            vst1q_f64(p + 448, r7);
+        }
+    }
+}
+
+static void fht_neon_gen_double_10(double *buf) {
+    for (size_t i = 0; i < 1024; i += 64) {
+        double *p = buf + i;
+        float64x2_t r0 = vld1q_f64(p + 0);
+        float64x2_t r1 = vld1q_f64(p + 2);
+        {
+            float64x2_t ev = vtrn1q_f64(r0, r1), od = vtrn2q_f64(r0, r1);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r0 = vtrn1q_f64(sm, df);
+            r1 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r2 = vld1q_f64(p + 4);
+        float64x2_t r3 = vld1q_f64(p + 6);
+        {
+            float64x2_t ev = vtrn1q_f64(r2, r3), od = vtrn2q_f64(r2, r3);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r2 = vtrn1q_f64(sm, df);
+            r3 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r4 = vld1q_f64(p + 8);
+        float64x2_t r5 = vld1q_f64(p + 10);
+        {
+            float64x2_t ev = vtrn1q_f64(r4, r5), od = vtrn2q_f64(r4, r5);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r4 = vtrn1q_f64(sm, df);
+            r5 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r6 = vld1q_f64(p + 12);
+        float64x2_t r7 = vld1q_f64(p + 14);
+        {
+            float64x2_t ev = vtrn1q_f64(r6, r7), od = vtrn2q_f64(r6, r7);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r6 = vtrn1q_f64(sm, df);
+            r7 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r8 = vld1q_f64(p + 16);
+        float64x2_t r9 = vld1q_f64(p + 18);
+        {
+            float64x2_t ev = vtrn1q_f64(r8, r9), od = vtrn2q_f64(r8, r9);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r8 = vtrn1q_f64(sm, df);
+            r9 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r10 = vld1q_f64(p + 20);
+        float64x2_t r11 = vld1q_f64(p + 22);
+        {
+            float64x2_t ev = vtrn1q_f64(r10, r11), od = vtrn2q_f64(r10, r11);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r10 = vtrn1q_f64(sm, df);
+            r11 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r12 = vld1q_f64(p + 24);
+        float64x2_t r13 = vld1q_f64(p + 26);
+        {
+            float64x2_t ev = vtrn1q_f64(r12, r13), od = vtrn2q_f64(r12, r13);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r12 = vtrn1q_f64(sm, df);
+            r13 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r14 = vld1q_f64(p + 28);
+        float64x2_t r15 = vld1q_f64(p + 30);
+        {
+            float64x2_t ev = vtrn1q_f64(r14, r15), od = vtrn2q_f64(r14, r15);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r14 = vtrn1q_f64(sm, df);
+            r15 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r16 = vld1q_f64(p + 32);
+        float64x2_t r17 = vld1q_f64(p + 34);
+        {
+            float64x2_t ev = vtrn1q_f64(r16, r17), od = vtrn2q_f64(r16, r17);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r16 = vtrn1q_f64(sm, df);
+            r17 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r18 = vld1q_f64(p + 36);
+        float64x2_t r19 = vld1q_f64(p + 38);
+        {
+            float64x2_t ev = vtrn1q_f64(r18, r19), od = vtrn2q_f64(r18, r19);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r18 = vtrn1q_f64(sm, df);
+            r19 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r20 = vld1q_f64(p + 40);
+        float64x2_t r21 = vld1q_f64(p + 42);
+        {
+            float64x2_t ev = vtrn1q_f64(r20, r21), od = vtrn2q_f64(r20, r21);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r20 = vtrn1q_f64(sm, df);
+            r21 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r22 = vld1q_f64(p + 44);
+        float64x2_t r23 = vld1q_f64(p + 46);
+        {
+            float64x2_t ev = vtrn1q_f64(r22, r23), od = vtrn2q_f64(r22, r23);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r22 = vtrn1q_f64(sm, df);
+            r23 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r24 = vld1q_f64(p + 48);
+        float64x2_t r25 = vld1q_f64(p + 50);
+        {
+            float64x2_t ev = vtrn1q_f64(r24, r25), od = vtrn2q_f64(r24, r25);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r24 = vtrn1q_f64(sm, df);
+            r25 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r26 = vld1q_f64(p + 52);
+        float64x2_t r27 = vld1q_f64(p + 54);
+        {
+            float64x2_t ev = vtrn1q_f64(r26, r27), od = vtrn2q_f64(r26, r27);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r26 = vtrn1q_f64(sm, df);
+            r27 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r28 = vld1q_f64(p + 56);
+        float64x2_t r29 = vld1q_f64(p + 58);
+        {
+            float64x2_t ev = vtrn1q_f64(r28, r29), od = vtrn2q_f64(r28, r29);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r28 = vtrn1q_f64(sm, df);
+            r29 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r30 = vld1q_f64(p + 60);
+        float64x2_t r31 = vld1q_f64(p + 62);
+        {
+            float64x2_t ev = vtrn1q_f64(r30, r31), od = vtrn2q_f64(r30, r31);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r30 = vtrn1q_f64(sm, df);
+            r31 = vtrn2q_f64(sm, df);
+        }
+        { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r5); r5 = vsubq_f64(r4, r5); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r7); r7 = vsubq_f64(r6, r7); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r9); r9 = vsubq_f64(r8, r9); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r11); r11 = vsubq_f64(r10, r11); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r13); r13 = vsubq_f64(r12, r13); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r14, r15); r15 = vsubq_f64(r14, r15); r14 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r17); r17 = vsubq_f64(r16, r17); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r19); r19 = vsubq_f64(r18, r19); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r21); r21 = vsubq_f64(r20, r21); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r22, r23); r23 = vsubq_f64(r22, r23); r22 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r25); r25 = vsubq_f64(r24, r25); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r26, r27); r27 = vsubq_f64(r26, r27); r26 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r28, r29); r29 = vsubq_f64(r28, r29); r28 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r30, r31); r31 = vsubq_f64(r30, r31); r30 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r6); r6 = vsubq_f64(r4, r6); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r7); r7 = vsubq_f64(r5, r7); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r10); r10 = vsubq_f64(r8, r10); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r11); r11 = vsubq_f64(r9, r11); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r14); r14 = vsubq_f64(r12, r14); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r13, r15); r15 = vsubq_f64(r13, r15); r13 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r18); r18 = vsubq_f64(r16, r18); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r19); r19 = vsubq_f64(r17, r19); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r22); r22 = vsubq_f64(r20, r22); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r21, r23); r23 = vsubq_f64(r21, r23); r21 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r26); r26 = vsubq_f64(r24, r26); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r25, r27); r27 = vsubq_f64(r25, r27); r25 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r28, r30); r30 = vsubq_f64(r28, r30); r28 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r29, r31); r31 = vsubq_f64(r29, r31); r29 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r4); r4 = vsubq_f64(r0, r4); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r5); r5 = vsubq_f64(r1, r5); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r6); r6 = vsubq_f64(r2, r6); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r7); r7 = vsubq_f64(r3, r7); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r12); r12 = vsubq_f64(r8, r12); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r13); r13 = vsubq_f64(r9, r13); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r14); r14 = vsubq_f64(r10, r14); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r11, r15); r15 = vsubq_f64(r11, r15); r11 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r20); r20 = vsubq_f64(r16, r20); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r21); r21 = vsubq_f64(r17, r21); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r22); r22 = vsubq_f64(r18, r22); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r19, r23); r23 = vsubq_f64(r19, r23); r19 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r28); r28 = vsubq_f64(r24, r28); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r25, r29); r29 = vsubq_f64(r25, r29); r25 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r26, r30); r30 = vsubq_f64(r26, r30); r26 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r27, r31); r31 = vsubq_f64(r27, r31); r27 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r8); r8 = vsubq_f64(r0, r8); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r9); r9 = vsubq_f64(r1, r9); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r10); r10 = vsubq_f64(r2, r10); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r11); r11 = vsubq_f64(r3, r11); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r12); r12 = vsubq_f64(r4, r12); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r13); r13 = vsubq_f64(r5, r13); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r14); r14 = vsubq_f64(r6, r14); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r7, r15); r15 = vsubq_f64(r7, r15); r7 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r24); r24 = vsubq_f64(r16, r24); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r25); r25 = vsubq_f64(r17, r25); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r26); r26 = vsubq_f64(r18, r26); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r19, r27); r27 = vsubq_f64(r19, r27); r19 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r28); r28 = vsubq_f64(r20, r28); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r21, r29); r29 = vsubq_f64(r21, r29); r21 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r22, r30); r30 = vsubq_f64(r22, r30); r22 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r23, r31); r31 = vsubq_f64(r23, r31); r23 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r16); r16 = vsubq_f64(r0, r16); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r17); r17 = vsubq_f64(r1, r17); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r18); r18 = vsubq_f64(r2, r18); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r19); r19 = vsubq_f64(r3, r19); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r20); r20 = vsubq_f64(r4, r20); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r21); r21 = vsubq_f64(r5, r21); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r22); r22 = vsubq_f64(r6, r22); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r7, r23); r23 = vsubq_f64(r7, r23); r7 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r24); r24 = vsubq_f64(r8, r24); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r25); r25 = vsubq_f64(r9, r25); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r26); r26 = vsubq_f64(r10, r26); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r11, r27); r27 = vsubq_f64(r11, r27); r11 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r28); r28 = vsubq_f64(r12, r28); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r13, r29); r29 = vsubq_f64(r13, r29); r13 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r14, r30); r30 = vsubq_f64(r14, r30); r14 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r15, r31); r31 = vsubq_f64(r15, r31); r15 = tmp; }
+        vst1q_f64(p + 0, r0);
+        vst1q_f64(p + 2, r1);
+        vst1q_f64(p + 4, r2);
+        vst1q_f64(p + 6, r3);
+        vst1q_f64(p + 8, r4);
+        vst1q_f64(p + 10, r5);
+        vst1q_f64(p + 12, r6);
+        vst1q_f64(p + 14, r7);
+        vst1q_f64(p + 16, r8);
+        vst1q_f64(p + 18, r9);
+        vst1q_f64(p + 20, r10);
+        vst1q_f64(p + 22, r11);
+        vst1q_f64(p + 24, r12);
+        vst1q_f64(p + 26, r13);
+        vst1q_f64(p + 28, r14);
+        vst1q_f64(p + 30, r15);
+        vst1q_f64(p + 32, r16);
+        vst1q_f64(p + 34, r17);
+        vst1q_f64(p + 36, r18);
+        vst1q_f64(p + 38, r19);
+        vst1q_f64(p + 40, r20);
+        vst1q_f64(p + 42, r21);
+        vst1q_f64(p + 44, r22);
+        vst1q_f64(p + 46, r23);
+        vst1q_f64(p + 48, r24);
+        vst1q_f64(p + 50, r25);
+        vst1q_f64(p + 52, r26);
+        vst1q_f64(p + 54, r27);
+        vst1q_f64(p + 56, r28);
+        vst1q_f64(p + 58, r29);
+        vst1q_f64(p + 60, r30);
+        vst1q_f64(p + 62, r31);
+    }
+    for (size_t i = 0; i < 1024; i += 1024) {
+        for (size_t j = i; j < i + 64; j += 2) {
+            double *p = buf + j;
+            float64x2_t r0 = vld1q_f64(p + 0);
+            float64x2_t r1 = vld1q_f64(p + 64);
+            float64x2_t r2 = vld1q_f64(p + 128);
+            float64x2_t r3 = vld1q_f64(p + 192);
+            float64x2_t r4 = vld1q_f64(p + 256);
+            float64x2_t r5 = vld1q_f64(p + 320);
+            float64x2_t r6 = vld1q_f64(p + 384);
+            float64x2_t r7 = vld1q_f64(p + 448);
+            float64x2_t r8 = vld1q_f64(p + 512);
+            float64x2_t r9 = vld1q_f64(p + 576);
+            float64x2_t r10 = vld1q_f64(p + 640);
+            float64x2_t r11 = vld1q_f64(p + 704);
+            float64x2_t r12 = vld1q_f64(p + 768);
+            float64x2_t r13 = vld1q_f64(p + 832);
+            float64x2_t r14 = vld1q_f64(p + 896);
+            float64x2_t r15 = vld1q_f64(p + 960);
+            { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r4, r5); r5 = vsubq_f64(r4, r5); r4 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r6, r7); r7 = vsubq_f64(r6, r7); r6 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r8, r9); r9 = vsubq_f64(r8, r9); r8 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r10, r11); r11 = vsubq_f64(r10, r11); r10 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r12, r13); r13 = vsubq_f64(r12, r13); r12 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r14, r15); r15 = vsubq_f64(r14, r15); r14 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r4, r6); r6 = vsubq_f64(r4, r6); r4 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r5, r7); r7 = vsubq_f64(r5, r7); r5 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r8, r10); r10 = vsubq_f64(r8, r10); r8 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r9, r11); r11 = vsubq_f64(r9, r11); r9 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r12, r14); r14 = vsubq_f64(r12, r14); r12 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r13, r15); r15 = vsubq_f64(r13, r15); r13 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r0, r4); r4 = vsubq_f64(r0, r4); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r1, r5); r5 = vsubq_f64(r1, r5); r1 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r2, r6); r6 = vsubq_f64(r2, r6); r2 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r3, r7); r7 = vsubq_f64(r3, r7); r3 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r8, r12); r12 = vsubq_f64(r8, r12); r8 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r9, r13); r13 = vsubq_f64(r9, r13); r9 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r10, r14); r14 = vsubq_f64(r10, r14); r10 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r11, r15); r15 = vsubq_f64(r11, r15); r11 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r0, r8); r8 = vsubq_f64(r0, r8); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r1, r9); r9 = vsubq_f64(r1, r9); r1 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r2, r10); r10 = vsubq_f64(r2, r10); r2 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r3, r11); r11 = vsubq_f64(r3, r11); r3 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r4, r12); r12 = vsubq_f64(r4, r12); r4 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r5, r13); r13 = vsubq_f64(r5, r13); r5 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r6, r14); r14 = vsubq_f64(r6, r14); r6 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r7, r15); r15 = vsubq_f64(r7, r15); r7 = tmp; }
+            vst1q_f64(p + 0, r0);
+            vst1q_f64(p + 64, r1);
+            vst1q_f64(p + 128, r2);
+            vst1q_f64(p + 192, r3);
+            vst1q_f64(p + 256, r4);
+            vst1q_f64(p + 320, r5);
+            vst1q_f64(p + 384, r6);
+            vst1q_f64(p + 448, r7);
+            vst1q_f64(p + 512, r8);
+            vst1q_f64(p + 576, r9);
+            vst1q_f64(p + 640, r10);
+            vst1q_f64(p + 704, r11);
+            vst1q_f64(p + 768, r12);
+            vst1q_f64(p + 832, r13);
+            vst1q_f64(p + 896, r14);
+            vst1q_f64(p + 960, r15);
+        }
+    }
+}
+
+static void fht_neon_gen_double_11(double *buf) {
+    for (size_t i = 0; i < 2048; i += 64) {
+        double *p = buf + i;
+        float64x2_t r0 = vld1q_f64(p + 0);
+        float64x2_t r1 = vld1q_f64(p + 2);
+        {
+            float64x2_t ev = vtrn1q_f64(r0, r1), od = vtrn2q_f64(r0, r1);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r0 = vtrn1q_f64(sm, df);
+            r1 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r2 = vld1q_f64(p + 4);
+        float64x2_t r3 = vld1q_f64(p + 6);
+        {
+            float64x2_t ev = vtrn1q_f64(r2, r3), od = vtrn2q_f64(r2, r3);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r2 = vtrn1q_f64(sm, df);
+            r3 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r4 = vld1q_f64(p + 8);
+        float64x2_t r5 = vld1q_f64(p + 10);
+        {
+            float64x2_t ev = vtrn1q_f64(r4, r5), od = vtrn2q_f64(r4, r5);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r4 = vtrn1q_f64(sm, df);
+            r5 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r6 = vld1q_f64(p + 12);
+        float64x2_t r7 = vld1q_f64(p + 14);
+        {
+            float64x2_t ev = vtrn1q_f64(r6, r7), od = vtrn2q_f64(r6, r7);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r6 = vtrn1q_f64(sm, df);
+            r7 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r8 = vld1q_f64(p + 16);
+        float64x2_t r9 = vld1q_f64(p + 18);
+        {
+            float64x2_t ev = vtrn1q_f64(r8, r9), od = vtrn2q_f64(r8, r9);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r8 = vtrn1q_f64(sm, df);
+            r9 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r10 = vld1q_f64(p + 20);
+        float64x2_t r11 = vld1q_f64(p + 22);
+        {
+            float64x2_t ev = vtrn1q_f64(r10, r11), od = vtrn2q_f64(r10, r11);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r10 = vtrn1q_f64(sm, df);
+            r11 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r12 = vld1q_f64(p + 24);
+        float64x2_t r13 = vld1q_f64(p + 26);
+        {
+            float64x2_t ev = vtrn1q_f64(r12, r13), od = vtrn2q_f64(r12, r13);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r12 = vtrn1q_f64(sm, df);
+            r13 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r14 = vld1q_f64(p + 28);
+        float64x2_t r15 = vld1q_f64(p + 30);
+        {
+            float64x2_t ev = vtrn1q_f64(r14, r15), od = vtrn2q_f64(r14, r15);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r14 = vtrn1q_f64(sm, df);
+            r15 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r16 = vld1q_f64(p + 32);
+        float64x2_t r17 = vld1q_f64(p + 34);
+        {
+            float64x2_t ev = vtrn1q_f64(r16, r17), od = vtrn2q_f64(r16, r17);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r16 = vtrn1q_f64(sm, df);
+            r17 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r18 = vld1q_f64(p + 36);
+        float64x2_t r19 = vld1q_f64(p + 38);
+        {
+            float64x2_t ev = vtrn1q_f64(r18, r19), od = vtrn2q_f64(r18, r19);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r18 = vtrn1q_f64(sm, df);
+            r19 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r20 = vld1q_f64(p + 40);
+        float64x2_t r21 = vld1q_f64(p + 42);
+        {
+            float64x2_t ev = vtrn1q_f64(r20, r21), od = vtrn2q_f64(r20, r21);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r20 = vtrn1q_f64(sm, df);
+            r21 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r22 = vld1q_f64(p + 44);
+        float64x2_t r23 = vld1q_f64(p + 46);
+        {
+            float64x2_t ev = vtrn1q_f64(r22, r23), od = vtrn2q_f64(r22, r23);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r22 = vtrn1q_f64(sm, df);
+            r23 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r24 = vld1q_f64(p + 48);
+        float64x2_t r25 = vld1q_f64(p + 50);
+        {
+            float64x2_t ev = vtrn1q_f64(r24, r25), od = vtrn2q_f64(r24, r25);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r24 = vtrn1q_f64(sm, df);
+            r25 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r26 = vld1q_f64(p + 52);
+        float64x2_t r27 = vld1q_f64(p + 54);
+        {
+            float64x2_t ev = vtrn1q_f64(r26, r27), od = vtrn2q_f64(r26, r27);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r26 = vtrn1q_f64(sm, df);
+            r27 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r28 = vld1q_f64(p + 56);
+        float64x2_t r29 = vld1q_f64(p + 58);
+        {
+            float64x2_t ev = vtrn1q_f64(r28, r29), od = vtrn2q_f64(r28, r29);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r28 = vtrn1q_f64(sm, df);
+            r29 = vtrn2q_f64(sm, df);
+        }
+        float64x2_t r30 = vld1q_f64(p + 60);
+        float64x2_t r31 = vld1q_f64(p + 62);
+        {
+            float64x2_t ev = vtrn1q_f64(r30, r31), od = vtrn2q_f64(r30, r31);
+            float64x2_t sm = vaddq_f64(ev, od), df = vsubq_f64(ev, od);
+            r30 = vtrn1q_f64(sm, df);
+            r31 = vtrn2q_f64(sm, df);
+        }
+        { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r5); r5 = vsubq_f64(r4, r5); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r7); r7 = vsubq_f64(r6, r7); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r9); r9 = vsubq_f64(r8, r9); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r11); r11 = vsubq_f64(r10, r11); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r13); r13 = vsubq_f64(r12, r13); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r14, r15); r15 = vsubq_f64(r14, r15); r14 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r17); r17 = vsubq_f64(r16, r17); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r19); r19 = vsubq_f64(r18, r19); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r21); r21 = vsubq_f64(r20, r21); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r22, r23); r23 = vsubq_f64(r22, r23); r22 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r25); r25 = vsubq_f64(r24, r25); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r26, r27); r27 = vsubq_f64(r26, r27); r26 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r28, r29); r29 = vsubq_f64(r28, r29); r28 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r30, r31); r31 = vsubq_f64(r30, r31); r30 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r6); r6 = vsubq_f64(r4, r6); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r7); r7 = vsubq_f64(r5, r7); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r10); r10 = vsubq_f64(r8, r10); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r11); r11 = vsubq_f64(r9, r11); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r14); r14 = vsubq_f64(r12, r14); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r13, r15); r15 = vsubq_f64(r13, r15); r13 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r18); r18 = vsubq_f64(r16, r18); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r19); r19 = vsubq_f64(r17, r19); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r22); r22 = vsubq_f64(r20, r22); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r21, r23); r23 = vsubq_f64(r21, r23); r21 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r26); r26 = vsubq_f64(r24, r26); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r25, r27); r27 = vsubq_f64(r25, r27); r25 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r28, r30); r30 = vsubq_f64(r28, r30); r28 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r29, r31); r31 = vsubq_f64(r29, r31); r29 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r4); r4 = vsubq_f64(r0, r4); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r5); r5 = vsubq_f64(r1, r5); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r6); r6 = vsubq_f64(r2, r6); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r7); r7 = vsubq_f64(r3, r7); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r12); r12 = vsubq_f64(r8, r12); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r13); r13 = vsubq_f64(r9, r13); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r14); r14 = vsubq_f64(r10, r14); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r11, r15); r15 = vsubq_f64(r11, r15); r11 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r20); r20 = vsubq_f64(r16, r20); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r21); r21 = vsubq_f64(r17, r21); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r22); r22 = vsubq_f64(r18, r22); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r19, r23); r23 = vsubq_f64(r19, r23); r19 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r24, r28); r28 = vsubq_f64(r24, r28); r24 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r25, r29); r29 = vsubq_f64(r25, r29); r25 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r26, r30); r30 = vsubq_f64(r26, r30); r26 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r27, r31); r31 = vsubq_f64(r27, r31); r27 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r8); r8 = vsubq_f64(r0, r8); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r9); r9 = vsubq_f64(r1, r9); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r10); r10 = vsubq_f64(r2, r10); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r11); r11 = vsubq_f64(r3, r11); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r12); r12 = vsubq_f64(r4, r12); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r13); r13 = vsubq_f64(r5, r13); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r14); r14 = vsubq_f64(r6, r14); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r7, r15); r15 = vsubq_f64(r7, r15); r7 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r16, r24); r24 = vsubq_f64(r16, r24); r16 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r17, r25); r25 = vsubq_f64(r17, r25); r17 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r18, r26); r26 = vsubq_f64(r18, r26); r18 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r19, r27); r27 = vsubq_f64(r19, r27); r19 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r20, r28); r28 = vsubq_f64(r20, r28); r20 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r21, r29); r29 = vsubq_f64(r21, r29); r21 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r22, r30); r30 = vsubq_f64(r22, r30); r22 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r23, r31); r31 = vsubq_f64(r23, r31); r23 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r0, r16); r16 = vsubq_f64(r0, r16); r0 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r1, r17); r17 = vsubq_f64(r1, r17); r1 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r2, r18); r18 = vsubq_f64(r2, r18); r2 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r3, r19); r19 = vsubq_f64(r3, r19); r3 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r4, r20); r20 = vsubq_f64(r4, r20); r4 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r5, r21); r21 = vsubq_f64(r5, r21); r5 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r6, r22); r22 = vsubq_f64(r6, r22); r6 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r7, r23); r23 = vsubq_f64(r7, r23); r7 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r8, r24); r24 = vsubq_f64(r8, r24); r8 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r9, r25); r25 = vsubq_f64(r9, r25); r9 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r10, r26); r26 = vsubq_f64(r10, r26); r10 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r11, r27); r27 = vsubq_f64(r11, r27); r11 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r12, r28); r28 = vsubq_f64(r12, r28); r12 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r13, r29); r29 = vsubq_f64(r13, r29); r13 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r14, r30); r30 = vsubq_f64(r14, r30); r14 = tmp; }
+        { float64x2_t tmp = vaddq_f64(r15, r31); r31 = vsubq_f64(r15, r31); r15 = tmp; }
+        vst1q_f64(p + 0, r0);
+        vst1q_f64(p + 2, r1);
+        vst1q_f64(p + 4, r2);
+        vst1q_f64(p + 6, r3);
+        vst1q_f64(p + 8, r4);
+        vst1q_f64(p + 10, r5);
+        vst1q_f64(p + 12, r6);
+        vst1q_f64(p + 14, r7);
+        vst1q_f64(p + 16, r8);
+        vst1q_f64(p + 18, r9);
+        vst1q_f64(p + 20, r10);
+        vst1q_f64(p + 22, r11);
+        vst1q_f64(p + 24, r12);
+        vst1q_f64(p + 26, r13);
+        vst1q_f64(p + 28, r14);
+        vst1q_f64(p + 30, r15);
+        vst1q_f64(p + 32, r16);
+        vst1q_f64(p + 34, r17);
+        vst1q_f64(p + 36, r18);
+        vst1q_f64(p + 38, r19);
+        vst1q_f64(p + 40, r20);
+        vst1q_f64(p + 42, r21);
+        vst1q_f64(p + 44, r22);
+        vst1q_f64(p + 46, r23);
+        vst1q_f64(p + 48, r24);
+        vst1q_f64(p + 50, r25);
+        vst1q_f64(p + 52, r26);
+        vst1q_f64(p + 54, r27);
+        vst1q_f64(p + 56, r28);
+        vst1q_f64(p + 58, r29);
+        vst1q_f64(p + 60, r30);
+        vst1q_f64(p + 62, r31);
+    }
+    for (size_t i = 0; i < 2048; i += 2048) {
+        for (size_t j = i; j < i + 64; j += 2) {
+            double *p = buf + j;
+            float64x2_t r0 = vld1q_f64(p + 0);
+            float64x2_t r1 = vld1q_f64(p + 64);
+            float64x2_t r2 = vld1q_f64(p + 128);
+            float64x2_t r3 = vld1q_f64(p + 192);
+            float64x2_t r4 = vld1q_f64(p + 256);
+            float64x2_t r5 = vld1q_f64(p + 320);
+            float64x2_t r6 = vld1q_f64(p + 384);
+            float64x2_t r7 = vld1q_f64(p + 448);
+            float64x2_t r8 = vld1q_f64(p + 512);
+            float64x2_t r9 = vld1q_f64(p + 576);
+            float64x2_t r10 = vld1q_f64(p + 640);
+            float64x2_t r11 = vld1q_f64(p + 704);
+            float64x2_t r12 = vld1q_f64(p + 768);
+            float64x2_t r13 = vld1q_f64(p + 832);
+            float64x2_t r14 = vld1q_f64(p + 896);
+            float64x2_t r15 = vld1q_f64(p + 960);
+            float64x2_t r16 = vld1q_f64(p + 1024);
+            float64x2_t r17 = vld1q_f64(p + 1088);
+            float64x2_t r18 = vld1q_f64(p + 1152);
+            float64x2_t r19 = vld1q_f64(p + 1216);
+            float64x2_t r20 = vld1q_f64(p + 1280);
+            float64x2_t r21 = vld1q_f64(p + 1344);
+            float64x2_t r22 = vld1q_f64(p + 1408);
+            float64x2_t r23 = vld1q_f64(p + 1472);
+            float64x2_t r24 = vld1q_f64(p + 1536);
+            float64x2_t r25 = vld1q_f64(p + 1600);
+            float64x2_t r26 = vld1q_f64(p + 1664);
+            float64x2_t r27 = vld1q_f64(p + 1728);
+            float64x2_t r28 = vld1q_f64(p + 1792);
+            float64x2_t r29 = vld1q_f64(p + 1856);
+            float64x2_t r30 = vld1q_f64(p + 1920);
+            float64x2_t r31 = vld1q_f64(p + 1984);
+            { float64x2_t tmp = vaddq_f64(r0, r1); r1 = vsubq_f64(r0, r1); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r2, r3); r3 = vsubq_f64(r2, r3); r2 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r4, r5); r5 = vsubq_f64(r4, r5); r4 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r6, r7); r7 = vsubq_f64(r6, r7); r6 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r8, r9); r9 = vsubq_f64(r8, r9); r8 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r10, r11); r11 = vsubq_f64(r10, r11); r10 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r12, r13); r13 = vsubq_f64(r12, r13); r12 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r14, r15); r15 = vsubq_f64(r14, r15); r14 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r16, r17); r17 = vsubq_f64(r16, r17); r16 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r18, r19); r19 = vsubq_f64(r18, r19); r18 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r20, r21); r21 = vsubq_f64(r20, r21); r20 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r22, r23); r23 = vsubq_f64(r22, r23); r22 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r24, r25); r25 = vsubq_f64(r24, r25); r24 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r26, r27); r27 = vsubq_f64(r26, r27); r26 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r28, r29); r29 = vsubq_f64(r28, r29); r28 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r30, r31); r31 = vsubq_f64(r30, r31); r30 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r0, r2); r2 = vsubq_f64(r0, r2); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r1, r3); r3 = vsubq_f64(r1, r3); r1 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r4, r6); r6 = vsubq_f64(r4, r6); r4 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r5, r7); r7 = vsubq_f64(r5, r7); r5 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r8, r10); r10 = vsubq_f64(r8, r10); r8 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r9, r11); r11 = vsubq_f64(r9, r11); r9 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r12, r14); r14 = vsubq_f64(r12, r14); r12 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r13, r15); r15 = vsubq_f64(r13, r15); r13 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r16, r18); r18 = vsubq_f64(r16, r18); r16 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r17, r19); r19 = vsubq_f64(r17, r19); r17 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r20, r22); r22 = vsubq_f64(r20, r22); r20 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r21, r23); r23 = vsubq_f64(r21, r23); r21 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r24, r26); r26 = vsubq_f64(r24, r26); r24 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r25, r27); r27 = vsubq_f64(r25, r27); r25 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r28, r30); r30 = vsubq_f64(r28, r30); r28 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r29, r31); r31 = vsubq_f64(r29, r31); r29 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r0, r4); r4 = vsubq_f64(r0, r4); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r1, r5); r5 = vsubq_f64(r1, r5); r1 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r2, r6); r6 = vsubq_f64(r2, r6); r2 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r3, r7); r7 = vsubq_f64(r3, r7); r3 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r8, r12); r12 = vsubq_f64(r8, r12); r8 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r9, r13); r13 = vsubq_f64(r9, r13); r9 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r10, r14); r14 = vsubq_f64(r10, r14); r10 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r11, r15); r15 = vsubq_f64(r11, r15); r11 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r16, r20); r20 = vsubq_f64(r16, r20); r16 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r17, r21); r21 = vsubq_f64(r17, r21); r17 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r18, r22); r22 = vsubq_f64(r18, r22); r18 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r19, r23); r23 = vsubq_f64(r19, r23); r19 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r24, r28); r28 = vsubq_f64(r24, r28); r24 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r25, r29); r29 = vsubq_f64(r25, r29); r25 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r26, r30); r30 = vsubq_f64(r26, r30); r26 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r27, r31); r31 = vsubq_f64(r27, r31); r27 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r0, r8); r8 = vsubq_f64(r0, r8); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r1, r9); r9 = vsubq_f64(r1, r9); r1 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r2, r10); r10 = vsubq_f64(r2, r10); r2 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r3, r11); r11 = vsubq_f64(r3, r11); r3 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r4, r12); r12 = vsubq_f64(r4, r12); r4 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r5, r13); r13 = vsubq_f64(r5, r13); r5 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r6, r14); r14 = vsubq_f64(r6, r14); r6 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r7, r15); r15 = vsubq_f64(r7, r15); r7 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r16, r24); r24 = vsubq_f64(r16, r24); r16 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r17, r25); r25 = vsubq_f64(r17, r25); r17 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r18, r26); r26 = vsubq_f64(r18, r26); r18 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r19, r27); r27 = vsubq_f64(r19, r27); r19 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r20, r28); r28 = vsubq_f64(r20, r28); r20 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r21, r29); r29 = vsubq_f64(r21, r29); r21 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r22, r30); r30 = vsubq_f64(r22, r30); r22 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r23, r31); r31 = vsubq_f64(r23, r31); r23 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r0, r16); r16 = vsubq_f64(r0, r16); r0 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r1, r17); r17 = vsubq_f64(r1, r17); r1 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r2, r18); r18 = vsubq_f64(r2, r18); r2 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r3, r19); r19 = vsubq_f64(r3, r19); r3 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r4, r20); r20 = vsubq_f64(r4, r20); r4 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r5, r21); r21 = vsubq_f64(r5, r21); r5 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r6, r22); r22 = vsubq_f64(r6, r22); r6 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r7, r23); r23 = vsubq_f64(r7, r23); r7 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r8, r24); r24 = vsubq_f64(r8, r24); r8 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r9, r25); r25 = vsubq_f64(r9, r25); r9 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r10, r26); r26 = vsubq_f64(r10, r26); r10 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r11, r27); r27 = vsubq_f64(r11, r27); r11 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r12, r28); r28 = vsubq_f64(r12, r28); r12 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r13, r29); r29 = vsubq_f64(r13, r29); r13 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r14, r30); r30 = vsubq_f64(r14, r30); r14 = tmp; }
+            { float64x2_t tmp = vaddq_f64(r15, r31); r31 = vsubq_f64(r15, r31); r15 = tmp; }
+            vst1q_f64(p + 0, r0);
+            vst1q_f64(p + 64, r1);
+            vst1q_f64(p + 128, r2);
+            vst1q_f64(p + 192, r3);
+            vst1q_f64(p + 256, r4);
+            vst1q_f64(p + 320, r5);
+            vst1q_f64(p + 384, r6);
+            vst1q_f64(p + 448, r7);
+            vst1q_f64(p + 512, r8);
+            vst1q_f64(p + 576, r9);
+            vst1q_f64(p + 640, r10);
+            vst1q_f64(p + 704, r11);
+            vst1q_f64(p + 768, r12);
+            vst1q_f64(p + 832, r13);
+            vst1q_f64(p + 896, r14);
+            vst1q_f64(p + 960, r15);
+            vst1q_f64(p + 1024, r16);
+            vst1q_f64(p + 1088, r17);
+            vst1q_f64(p + 1152, r18);
+            vst1q_f64(p + 1216, r19);
+            vst1q_f64(p + 1280, r20);
+            vst1q_f64(p + 1344, r21);
+            vst1q_f64(p + 1408, r22);
+            vst1q_f64(p + 1472, r23);
+            vst1q_f64(p + 1536, r24);
+            vst1q_f64(p + 1600, r25);
+            vst1q_f64(p + 1664, r26);
+            vst1q_f64(p + 1728, r27);
+            vst1q_f64(p + 1792, r28);
+            vst1q_f64(p + 1856, r29);
+            vst1q_f64(p + 1920, r30);
+            vst1q_f64(p + 1984, r31);
+        }
+    }
+}
+
+/* Transform 2^log_n elements, 1 <= log_n <= FHT_NEON_GEN_MAX_LOG_DOUBLE */
+static void fht_neon_gen_double(double *buf, int log_n) {
+    switch (log_n) {
+    case 1: fht_neon_gen_double_1(buf); break;
+    case 2: fht_neon_gen_double_2(buf); break;
+    case 3: fht_neon_gen_double_3(buf); break;
+    case 4: fht_neon_gen_double_4(buf); break;
+    case 5: fht_neon_gen_double_5(buf); break;
+    case 6: fht_neon_gen_double_6(buf); break;
+    case 7: fht_neon_gen_double_7(buf); break;
+    case 8: fht_neon_gen_double_8(buf); break;
+    case 9: fht_neon_gen_double_9(buf); break;
+    case 10: fht_neon_gen_double_10(buf); break;
+    case 11: fht_neon_gen_double_11(buf); break;
+    default: break;
+    }
+}
+
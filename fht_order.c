@@ -0,0 +1,193 @@
+// Ordered spectra: sequency (Walsh) and Paley (dyadic) order without a
+// permutation pass over the output.
+//
+// Paley order is the natural order at bit-reversed indices, and sequency
+// order (coefficient k has k sign changes) at bit-reversed Gray codes,
+// out[k] = natural[rev(gray(k))]. Both index maps are linear over GF(2),
+// and H is symmetric under any such map applied to both sides, so the
+// permutation moves to the input as another linear map: the ordered
+// spectrum is the natural transform of y[j] = x[src(j)], with src(j) =
+// rev(j) for Paley and rev(prefix_xor(j)) for sequency, where bit k of
+// prefix_xor(j) is the parity of bits 0..k of j (the inverse transpose of
+// the Gray code).
+//
+// The gather into y takes the place of the copy an out-of-place transform
+// makes anyway. Being linear, src(j) = src(high bits) ^ src(middle bits) ^
+// src(low bits), and both maps send the top ORDER_LOG_TILE bits of j to the
+// low ones of src(j). So a tile of 2^ORDER_LOG_TILE x 2^ORDER_LOG_TILE
+// elements, one per middle value, reads whole cache lines of `in`,
+// transposes in L1 and writes whole cache lines of `out`, where a gather
+// element by element would miss on every read for large n.
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht.h"
+#include "fht_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Tile side: a cache line of elements
+#define ORDER_LOG_TILE_FLOAT 4
+#define ORDER_LOG_TILE_DOUBLE 3
+
+static size_t bit_reverse(size_t j, int log_n) {
+    size_t r = 0;
+    for (int k = 0; k < log_n; k++) {
+        r = (r << 1) | ((j >> k) & 1);
+    }
+    return r;
+}
+
+// Input index of element j of y
+static size_t source_index(size_t j, int log_n, int order) {
+    if (order == FHT_ORDER_SEQUENCY) {
+        for (int s = 1; s < log_n; s *= 2) {
+            j ^= j << s;
+        }
+        j &= ((size_t)1 << log_n) - 1;
+    }
+    return bit_reverse(j, log_n);
+}
+
+static void gather_float(const float *in, float *out, int log_n, int order) {
+    size_t n = (size_t)1 << log_n;
+    if (log_n < 2 * ORDER_LOG_TILE_FLOAT) {
+        for (size_t j = 0; j < n; j++) {
+            out[j] = in[source_index(j, log_n, order)];
+        }
+        return;
+    }
+    const int lt = ORDER_LOG_TILE_FLOAT, high = log_n - ORDER_LOG_TILE_FLOAT;
+    const size_t m = (size_t)1 << ORDER_LOG_TILE_FLOAT;
+    size_t src_high[1 << ORDER_LOG_TILE_FLOAT], src_low[1 << ORDER_LOG_TILE_FLOAT];
+    for (size_t a = 0; a < m; a++) {
+        src_high[a] = source_index(a << high, log_n, order);
+        src_low[a] = source_index(a, log_n, order);
+    }
+    float tile[1 << ORDER_LOG_TILE_FLOAT][1 << ORDER_LOG_TILE_FLOAT];
+    for (size_t mid = 0; mid < n >> (2 * lt); mid++) {
+        size_t base = source_index(mid << lt, log_n, order);
+        // Row b of the tile comes from one cache line of `in`, read in
+        // order but for an xor of its position (sequency), and src_high[a]
+        // < m picks the row of the transposed tile that output row a takes
+        const float *lines[1 << ORDER_LOG_TILE_FLOAT];
+        size_t flip[1 << ORDER_LOG_TILE_FLOAT];
+        for (size_t b = 0; b < m; b++) {
+            size_t row = base ^ src_low[b];
+            lines[b] = in + (row & ~(m - 1));
+            flip[b] = row & (m - 1);
+        }
+        for (size_t p = 0; p < m; p++) {
+            for (size_t b = 0; b < m; b++) {
+                tile[p][b] = lines[b][p ^ flip[b]];
+            }
+        }
+        for (size_t a = 0; a < m; a++) {
+            memcpy(out + (a << high) + (mid << lt), tile[src_high[a]], sizeof(tile[0]));
+        }
+    }
+}
+
+static void gather_double(const double *in, double *out, int log_n, int order) {
+    size_t n = (size_t)1 << log_n;
+    if (log_n < 2 * ORDER_LOG_TILE_DOUBLE) {
+        for (size_t j = 0; j < n; j++) {
+            out[j] = in[source_index(j, log_n, order)];
+        }
+        return;
+    }
+    const int lt = ORDER_LOG_TILE_DOUBLE, high = log_n - ORDER_LOG_TILE_DOUBLE;
+    const size_t m = (size_t)1 << ORDER_LOG_TILE_DOUBLE;
+    size_t src_high[1 << ORDER_LOG_TILE_DOUBLE], src_low[1 << ORDER_LOG_TILE_DOUBLE];
+    for (size_t a = 0; a < m; a++) {
+        src_high[a] = source_index(a << high, log_n, order);
+        src_low[a] = source_index(a, log_n, order);
+    }
+    double tile[1 << ORDER_LOG_TILE_DOUBLE][1 << ORDER_LOG_TILE_DOUBLE];
+    for (size_t mid = 0; mid < n >> (2 * lt); mid++) {
+        size_t base = source_index(mid << lt, log_n, order);
+        // Row b of the tile comes from one cache line of `in`, read in
+        // order but for an xor of its position (sequency), and src_high[a]
+        // < m picks the row of the transposed tile that output row a takes
+        const double *lines[1 << ORDER_LOG_TILE_DOUBLE];
+        size_t flip[1 << ORDER_LOG_TILE_DOUBLE];
+        for (size_t b = 0; b < m; b++) {
+            size_t row = base ^ src_low[b];
+            lines[b] = in + (row & ~(m - 1));
+            flip[b] = row & (m - 1);
+        }
+        for (size_t p = 0; p < m; p++) {
+            for (size_t b = 0; b < m; b++) {
+                tile[p][b] = lines[b][p ^ flip[b]];
+            }
+        }
+        for (size_t a = 0; a < m; a++) {
+            memcpy(out + (a << high) + (mid << lt), tile[src_high[a]], sizeof(tile[0]));
+        }
+    }
+}
+
+static int float_ordered(float *in, float *out, int log_n, int order) {
+    if (order == FHT_ORDER_NATURAL) {
+        return fht_float_oop(in, out, log_n);
+    }
+    if ((order != FHT_ORDER_SEQUENCY && order != FHT_ORDER_PALEY) || log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (in != out) {
+        gather_float(in, out, log_n, order);
+        return fht_float(out, log_n);
+    }
+    // In place: gather into a copy, whose fused out-of-place transform
+    // writes the buffer back
+    float *y = (float *)malloc(((size_t)1 << log_n) * sizeof(float));
+    if (y == NULL) {
+        return -1;
+    }
+    gather_float(in, y, log_n, order);
+    int res = fht_float_oop(y, out, log_n);
+    free(y);
+    return res;
+}
+
+static int double_ordered(double *in, double *out, int log_n, int order) {
+    if (order == FHT_ORDER_NATURAL) {
+        return fht_double_oop(in, out, log_n);
+    }
+    if ((order != FHT_ORDER_SEQUENCY && order != FHT_ORDER_PALEY) || log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (in != out) {
+        gather_double(in, out, log_n, order);
+        return fht_double(out, log_n);
+    }
+    double *y = (double *)malloc(((size_t)1 << log_n) * sizeof(double));
+    if (y == NULL) {
+        return -1;
+    }
+    gather_double(in, y, log_n, order);
+    int res = fht_double_oop(y, out, log_n);
+    free(y);
+    return res;
+}
+
+int fht_float_ordered(float *in, float *out, int log_n, int order) {
+    uint64_t t0 = fht_stats_begin();
+    int res = float_ordered(in, out, log_n, order);
+    fht_stats_end(t0, 0, FHT_STATS_ORDERED, log_n, in == out ? 1 : 2);
+    return res;
+}
+
+int fht_double_ordered(double *in, double *out, int log_n, int order) {
+    uint64_t t0 = fht_stats_begin();
+    int res = double_ordered(in, out, log_n, order);
+    fht_stats_end(t0, 1, FHT_STATS_ORDERED, log_n, in == out ? 1 : 2);
+    return res;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
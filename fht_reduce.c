@@ -0,0 +1,459 @@
+// Fused spectrum reductions: the coefficients of largest magnitude (argmax,
+// top-k) or all those at or above a threshold, picked out while the last
+// butterfly stage writes them instead of in a second pass over the spectrum.
+//
+// As in fht_xor.c the two halves are transformed first. The last stage then
+// compares |a + b| and |a - b| with the current bound a vector at a time and
+// hands the few lanes that pass to a scalar sink. For top-k the bound is the
+// smallest magnitude kept so far, so once the heap is full nearly every
+// vector is rejected by one compare. Each half is visited in increasing
+// index order, so each keeps its own heap and a strict compare keeps the
+// lower index among equal magnitudes (the flat spectrum of a bent function
+// costs no more than any other); the heaps are merged at the end. The
+// spectrum is left in the buffer.
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht.h"
+#include "fht_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Below this size the vectors are transformed whole and scanned in L1; see
+// FHT_SPLIT_MIN_LOG_N in fht.c
+#define REDUCE_MIN_SPLIT_LOG_N 5
+// Small vectors go through the batch kernel in groups of this many bytes
+#define REDUCE_LOG_GROUP_BYTES 17
+// Top-k heaps up to this many entries live on the stack
+#define REDUCE_STACK_ENTRIES 32
+
+typedef struct {
+    double mag;
+    size_t index;
+} reduce_entry;
+
+// What one call collects, per vector: k entries, or up to `capacity`
+// threshold hits and their count
+typedef struct {
+    size_t k;  // 0: threshold
+    double threshold;
+    size_t *indices;
+    size_t capacity;
+    size_t *counts;
+    reduce_entry *scratch;  // 2k entries
+} reduce_job;
+
+// State for one vector. Top-k keeps a min-heap per half; threshold hits of
+// the lower half fill `out` from the front and those of the upper half from
+// the back, and a lower hit evicts the largest upper one when it is full,
+// so the lowest `capacity` indices survive.
+typedef struct {
+    size_t k;
+    reduce_entry *heaps[2];
+    size_t heap_len[2];
+    double bound[2];  // a coefficient of half h is taken if |x| > bound[h]
+    size_t *out;
+    size_t capacity;
+    size_t front;
+    size_t back;
+    size_t count;
+} reduce_sink;
+
+// Smaller magnitude, or the same one at a higher index
+static int entry_worse(const reduce_entry *a, const reduce_entry *b) {
+    return a->mag < b->mag || (a->mag == b->mag && a->index > b->index);
+}
+
+static int entry_order(const void *a, const void *b) {
+    const reduce_entry *x = (const reduce_entry *)a, *y = (const reduce_entry *)b;
+    return entry_worse(y, x) ? -1 : entry_worse(x, y);
+}
+
+static void reduce_hit(reduce_sink *s, int h, size_t index, double mag) {
+    if (s->k == 0) {
+        s->count++;
+        if (h == 1 && s->front < s->back) {
+            s->out[--s->back] = index;
+        } else if (h == 0 && s->front < s->capacity) {
+            s->out[s->front++] = index;
+            if (s->back < s->front) {
+                s->back = s->front;
+            }
+        }
+        return;
+    }
+    reduce_entry *heap = s->heaps[h];
+    reduce_entry e = {mag, index};
+    size_t len = s->heap_len[h];
+    size_t i;
+    if (len < s->k) {
+        for (i = len++; i > 0 && entry_worse(&e, &heap[(i - 1) / 2]); i = (i - 1) / 2) {
+            heap[i] = heap[(i - 1) / 2];
+        }
+        s->heap_len[h] = len;
+    } else if (entry_worse(&heap[0], &e)) {
+        for (i = 0; 2 * i + 1 < len;) {
+            size_t c = 2 * i + 1;
+            if (c + 1 < len && entry_worse(&heap[c + 1], &heap[c])) {
+                c++;
+            }
+            if (!entry_worse(&heap[c], &e)) {
+                break;
+            }
+            heap[i] = heap[c];
+            i = c;
+        }
+    } else {
+        return;
+    }
+    heap[i] = e;
+    s->bound[h] = len < s->k ? -1.0 : heap[0].mag;
+}
+
+static void sink_begin(reduce_sink *s, const reduce_job *job, size_t v) {
+    s->k = job->k;
+    s->heaps[0] = job->scratch;
+    s->heaps[1] = job->scratch + job->k;
+    s->heap_len[0] = s->heap_len[1] = 0;
+    s->bound[0] = s->bound[1] = job->k ? -1.0 : job->threshold;
+    s->out = job->indices + v * (job->k ? job->k : job->capacity);
+    s->capacity = job->capacity;
+    s->front = 0;
+    s->back = job->capacity;
+    s->count = 0;
+}
+
+static void sink_end(reduce_sink *s, const reduce_job *job, size_t v) {
+    if (s->k == 0) {
+        // The upper hits sit at the back, largest index first
+        size_t upper = s->capacity - s->back;
+        for (size_t j = 0; j < upper / 2; j++) {
+            size_t t = s->out[s->back + j];
+            s->out[s->back + j] = s->out[s->capacity - 1 - j];
+            s->out[s->capacity - 1 - j] = t;
+        }
+        if (upper > 0) {
+            memmove(s->out + s->front, s->out + s->back, upper * sizeof(size_t));
+        }
+        job->counts[v] = s->count;
+        return;
+    }
+    size_t len = s->heap_len[0];
+    memmove(s->heaps[0] + len, s->heaps[1], s->heap_len[1] * sizeof(reduce_entry));
+    len += s->heap_len[1];
+    qsort(s->heaps[0], len, sizeof(reduce_entry), entry_order);
+    for (size_t j = 0; j < s->k; j++) {
+        s->out[j] = j < len ? s->heaps[0][j].index : SIZE_MAX;
+    }
+}
+
+static void scan_float(reduce_sink *s, int h, const float *x, size_t base, size_t len) {
+    for (size_t j = 0; j < len; j++) {
+        double mag = x[j] < 0.0f ? -(double)x[j] : (double)x[j];
+        if (mag > s->bound[h]) {
+            reduce_hit(s, h, base + j, mag);
+        }
+    }
+}
+
+static void scan_double(reduce_sink *s, int h, const double *x, size_t base, size_t len) {
+    for (size_t j = 0; j < len; j++) {
+        double mag = x[j] < 0.0 ? -x[j] : x[j];
+        if (mag > s->bound[h]) {
+            reduce_hit(s, h, base + j, mag);
+        }
+    }
+}
+
+// Last butterfly stage fused with the filter; the sink updates the bounds
+static void last_stage_reduce_float(float *restrict lo, float *restrict hi, size_t half, reduce_sink *s) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 b0 = _mm_set1_ps((float)s->bound[0]), b1 = _mm_set1_ps((float)s->bound[1]);
+    for (; i + 4 <= half; i += 4) {
+        __m128 u = _mm_loadu_ps(lo + i);
+        __m128 v = _mm_loadu_ps(hi + i);
+        __m128 a = _mm_add_ps(u, v);
+        __m128 d = _mm_sub_ps(u, v);
+        _mm_storeu_ps(lo + i, a);
+        _mm_storeu_ps(hi + i, d);
+        __m128 hit = _mm_or_ps(_mm_cmpgt_ps(_mm_and_ps(a, abs_mask), b0), _mm_cmpgt_ps(_mm_and_ps(d, abs_mask), b1));
+        if (_mm_movemask_ps(hit)) {
+            scan_float(s, 0, lo + i, i, 4);
+            scan_float(s, 1, hi + i, half + i, 4);
+            b0 = _mm_set1_ps((float)s->bound[0]);
+            b1 = _mm_set1_ps((float)s->bound[1]);
+        }
+    }
+#elif defined(__aarch64__)
+    float32x4_t b0 = vdupq_n_f32((float)s->bound[0]), b1 = vdupq_n_f32((float)s->bound[1]);
+    for (; i + 4 <= half; i += 4) {
+        float32x4_t u = vld1q_f32(lo + i);
+        float32x4_t v = vld1q_f32(hi + i);
+        float32x4_t a = vaddq_f32(u, v);
+        float32x4_t d = vsubq_f32(u, v);
+        vst1q_f32(lo + i, a);
+        vst1q_f32(hi + i, d);
+        uint32x4_t hit = vorrq_u32(vcgtq_f32(vabsq_f32(a), b0), vcgtq_f32(vabsq_f32(d), b1));
+        if (vmaxvq_u32(hit)) {
+            scan_float(s, 0, lo + i, i, 4);
+            scan_float(s, 1, hi + i, half + i, 4);
+            b0 = vdupq_n_f32((float)s->bound[0]);
+            b1 = vdupq_n_f32((float)s->bound[1]);
+        }
+    }
+#endif
+    for (size_t j = i; j < half; j++) {
+        float u = lo[j];
+        float v = hi[j];
+        lo[j] = u + v;
+        hi[j] = u - v;
+    }
+    scan_float(s, 0, lo + i, i, half - i);
+    scan_float(s, 1, hi + i, half + i, half - i);
+}
+
+static void last_stage_reduce_double(double *restrict lo, double *restrict hi, size_t half, reduce_sink *s) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    __m128d b0 = _mm_set1_pd(s->bound[0]), b1 = _mm_set1_pd(s->bound[1]);
+    for (; i + 2 <= half; i += 2) {
+        __m128d u = _mm_loadu_pd(lo + i);
+        __m128d v = _mm_loadu_pd(hi + i);
+        __m128d a = _mm_add_pd(u, v);
+        __m128d d = _mm_sub_pd(u, v);
+        _mm_storeu_pd(lo + i, a);
+        _mm_storeu_pd(hi + i, d);
+        __m128d hit = _mm_or_pd(_mm_cmpgt_pd(_mm_and_pd(a, abs_mask), b0), _mm_cmpgt_pd(_mm_and_pd(d, abs_mask), b1));
+        if (_mm_movemask_pd(hit)) {
+            scan_double(s, 0, lo + i, i, 2);
+            scan_double(s, 1, hi + i, half + i, 2);
+            b0 = _mm_set1_pd(s->bound[0]);
+            b1 = _mm_set1_pd(s->bound[1]);
+        }
+    }
+#elif defined(__aarch64__)
+    float64x2_t b0 = vdupq_n_f64(s->bound[0]), b1 = vdupq_n_f64(s->bound[1]);
+    for (; i + 2 <= half; i += 2) {
+        float64x2_t u = vld1q_f64(lo + i);
+        float64x2_t v = vld1q_f64(hi + i);
+        float64x2_t a = vaddq_f64(u, v);
+        float64x2_t d = vsubq_f64(u, v);
+        vst1q_f64(lo + i, a);
+        vst1q_f64(hi + i, d);
+        uint64x2_t hit = vorrq_u64(vcgtq_f64(vabsq_f64(a), b0), vcgtq_f64(vabsq_f64(d), b1));
+        if (vmaxvq_u32(vreinterpretq_u32_u64(hit))) {
+            scan_double(s, 0, lo + i, i, 2);
+            scan_double(s, 1, hi + i, half + i, 2);
+            b0 = vdupq_n_f64(s->bound[0]);
+            b1 = vdupq_n_f64(s->bound[1]);
+        }
+    }
+#endif
+    for (size_t j = i; j < half; j++) {
+        double u = lo[j];
+        double v = hi[j];
+        lo[j] = u + v;
+        hi[j] = u - v;
+    }
+    scan_double(s, 0, lo + i, i, half - i);
+    scan_double(s, 1, hi + i, half + i, half - i);
+}
+
+// Transform a group of vectors (whole if small, else their halves) through
+// the batch path, then run the fused last stage of each
+static int reduce_float(float *buf, int log_n, size_t count, size_t stride, const reduce_job *job) {
+    size_t n = (size_t)1 << log_n;
+    size_t group = ((size_t)1 << REDUCE_LOG_GROUP_BYTES) / sizeof(float) >> log_n;
+    if (group == 0) {
+        group = 1;
+    }
+    for (size_t v = 0; v < count; v += group) {
+        size_t m = count - v < group ? count - v : group;
+        float *first = buf + v * stride;
+        int res;
+        if (log_n < REDUCE_MIN_SPLIT_LOG_N) {
+            res = fht_float_batch(first, log_n, m, stride);
+        } else {
+            res = fht_float_batch(first, log_n - 1, m, stride);
+            if (res == 0) {
+                res = fht_float_batch(first + n / 2, log_n - 1, m, stride);
+            }
+        }
+        if (res) {
+            return res;
+        }
+        for (size_t i = v; i < v + m; i++) {
+            reduce_sink s;
+            sink_begin(&s, job, i);
+            if (log_n < REDUCE_MIN_SPLIT_LOG_N) {
+                scan_float(&s, 0, buf + i * stride, 0, n);
+            } else {
+                last_stage_reduce_float(buf + i * stride, buf + i * stride + n / 2, n / 2, &s);
+            }
+            sink_end(&s, job, i);
+        }
+    }
+    return 0;
+}
+
+static int reduce_double(double *buf, int log_n, size_t count, size_t stride, const reduce_job *job) {
+    size_t n = (size_t)1 << log_n;
+    size_t group = ((size_t)1 << REDUCE_LOG_GROUP_BYTES) / sizeof(double) >> log_n;
+    if (group == 0) {
+        group = 1;
+    }
+    for (size_t v = 0; v < count; v += group) {
+        size_t m = count - v < group ? count - v : group;
+        double *first = buf + v * stride;
+        int res;
+        if (log_n < REDUCE_MIN_SPLIT_LOG_N) {
+            res = fht_double_batch(first, log_n, m, stride);
+        } else {
+            res = fht_double_batch(first, log_n - 1, m, stride);
+            if (res == 0) {
+                res = fht_double_batch(first + n / 2, log_n - 1, m, stride);
+            }
+        }
+        if (res) {
+            return res;
+        }
+        for (size_t i = v; i < v + m; i++) {
+            reduce_sink s;
+            sink_begin(&s, job, i);
+            if (log_n < REDUCE_MIN_SPLIT_LOG_N) {
+                scan_double(&s, 0, buf + i * stride, 0, n);
+            } else {
+                last_stage_reduce_double(buf + i * stride, buf + i * stride + n / 2, n / 2, &s);
+            }
+            sink_end(&s, job, i);
+        }
+    }
+    return 0;
+}
+
+static int check_reduce(const void *buf, int log_n, size_t count, size_t stride) {
+    if (log_n < 0 || log_n > 30 || (buf == NULL && count > 0)) {
+        return -1;
+    }
+    return count > 1 && stride < ((size_t)1 << log_n) ? -1 : 0;
+}
+
+// Top-k with its two heaps on the stack or, for large k, the heap
+static int topk(void *buf, int log_n, size_t count, size_t stride, size_t k, size_t *indices, int is_double) {
+    if (check_reduce(buf, log_n, count, stride) || k == 0 || k > ((size_t)1 << log_n) ||
+        (indices == NULL && count > 0)) {
+        return -1;
+    }
+    reduce_entry stack[REDUCE_STACK_ENTRIES];
+    reduce_entry *scratch = 2 * k <= REDUCE_STACK_ENTRIES ? stack : (reduce_entry *)malloc(2 * k * sizeof(reduce_entry));
+    if (scratch == NULL) {
+        return -1;
+    }
+    reduce_job job = {k, 0.0, indices, 0, NULL, scratch};
+    uint64_t t0 = fht_stats_begin();
+    int res = is_double ? reduce_double((double *)buf, log_n, count, stride, &job)
+                        : reduce_float((float *)buf, log_n, count, stride, &job);
+    fht_stats_end(t0, is_double, FHT_STATS_REDUCE, log_n, count);
+    if (scratch != stack) {
+        free(scratch);
+    }
+    return res;
+}
+
+// |x| >= t as the strict |x| > bound of the sink: bound is the next value
+// below t, -1 if every magnitude passes, and NaN (nothing passes) for NaN
+static double threshold_bound_float(float t) {
+    if (!(t > 0.0f)) {
+        return t != t ? (double)t : -1.0;
+    }
+    uint32_t bits;
+    memcpy(&bits, &t, sizeof(bits));
+    bits--;
+    memcpy(&t, &bits, sizeof(bits));
+    return (double)t;
+}
+
+static double threshold_bound_double(double t) {
+    if (!(t > 0.0)) {
+        return t != t ? t : -1.0;
+    }
+    uint64_t bits;
+    memcpy(&bits, &t, sizeof(bits));
+    bits--;
+    memcpy(&t, &bits, sizeof(bits));
+    return t;
+}
+
+static int threshold(void *buf, int log_n, size_t count, size_t stride, double bound, size_t *indices,
+                     size_t capacity, size_t *counts, int is_double) {
+    if (check_reduce(buf, log_n, count, stride) || (counts == NULL && count > 0) ||
+        (indices == NULL && capacity > 0 && count > 0)) {
+        return -1;
+    }
+    reduce_job job = {0, bound, indices, capacity, counts, NULL};
+    uint64_t t0 = fht_stats_begin();
+    int res = is_double ? reduce_double((double *)buf, log_n, count, stride, &job)
+                        : reduce_float((float *)buf, log_n, count, stride, &job);
+    fht_stats_end(t0, is_double, FHT_STATS_REDUCE, log_n, count);
+    return res;
+}
+
+int fht_float_argmax(float *buf, int log_n, size_t *index) {
+    return topk(buf, log_n, 1, 0, 1, index, 0);
+}
+
+int fht_double_argmax(double *buf, int log_n, size_t *index) {
+    return topk(buf, log_n, 1, 0, 1, index, 1);
+}
+
+int fht_float_argmax_batch(float *buf, int log_n, size_t count, size_t stride, size_t *indices) {
+    return topk(buf, log_n, count, stride, 1, indices, 0);
+}
+
+int fht_double_argmax_batch(double *buf, int log_n, size_t count, size_t stride, size_t *indices) {
+    return topk(buf, log_n, count, stride, 1, indices, 1);
+}
+
+int fht_float_topk(float *buf, int log_n, size_t k, size_t *indices) {
+    return topk(buf, log_n, 1, 0, k, indices, 0);
+}
+
+int fht_double_topk(double *buf, int log_n, size_t k, size_t *indices) {
+    return topk(buf, log_n, 1, 0, k, indices, 1);
+}
+
+int fht_float_topk_batch(float *buf, int log_n, size_t count, size_t stride, size_t k, size_t *indices) {
+    return topk(buf, log_n, count, stride, k, indices, 0);
+}
+
+int fht_double_topk_batch(double *buf, int log_n, size_t count, size_t stride, size_t k, size_t *indices) {
+    return topk(buf, log_n, count, stride, k, indices, 1);
+}
+
+int fht_float_threshold(float *buf, int log_n, float t, size_t *indices, size_t capacity, size_t *count) {
+    return threshold(buf, log_n, 1, 0, threshold_bound_float(t), indices, capacity, count, 0);
+}
+
+int fht_double_threshold(double *buf, int log_n, double t, size_t *indices, size_t capacity, size_t *count) {
+    return threshold(buf, log_n, 1, 0, threshold_bound_double(t), indices, capacity, count, 1);
+}
+
+int fht_float_threshold_batch(float *buf, int log_n, size_t count, size_t stride, float t, size_t *indices,
+                              size_t capacity, size_t *counts) {
+    return threshold(buf, log_n, count, stride, threshold_bound_float(t), indices, capacity, counts, 0);
+}
+
+int fht_double_threshold_batch(double *buf, int log_n, size_t count, size_t stride, double t, size_t *indices,
+                               size_t capacity, size_t *counts) {
+    return threshold(buf, log_n, count, stride, threshold_bound_double(t), indices, capacity, counts, 1);
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,653 @@
+// Pruned transforms: sparse input to dense spectrum, and dense input to a few
+// requested coefficients.
+//
+// With k nonzero inputs (or k requested outputs) there are two ways to get
+// the result:
+//
+//   * direct: each entry is a signed sum, out[y] = sum of (-1)^popcount(i & y)
+//     x[i], which is k operations per element of the dense side. The sign
+//     splits into a 64-entry table for the low bits and one sign per 64-block,
+//     so these are vectorized multiply-adds in a single pass;
+//   * pruned butterflies: the stages that only ever see zeros (sparse input)
+//     or feed no requested output (selected outputs) are skipped. Once a
+//     butterfly group holds k nonzeros it is dense, so the total is about
+//     log2(k) + 2 passes over n elements instead of log_n.
+//
+// The direct form reads or writes the dense side once and never copies it, so
+// it wins for a handful of entries (SPARSE_DIRECT_MAX).
+//
+// Updates of a spectrum after a few input changes, spectrum += H delta, take
+// the direct form with UPDATE_GROUP deltas per pass, so the spectrum crosses
+// the bus once per group. Past update_direct_max() deltas (more for larger
+// sizes, where a transform costs more passes) the deltas go through the
+// sparse-input transform in scratch, which is then added.
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht.h"
+#include "fht_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Granularity of the nonzero map of the sparse-input path (64 elements,
+// transformed whole with the regular kernel)
+#define SPARSE_LOG_BLOCK 6
+// Output selection runs a dense transform once a group is this small
+#define SELECT_MIN_LOG_N 6
+// Most entries evaluated directly, and the sign table tile (2^6 elements)
+#define SPARSE_DIRECT_MAX 4
+#define DIRECT_LOG_TILE 6
+// Deltas per pass of a direct update, the most updated directly up to 2^16,
+// and the outputs kept in registers across a group
+#define UPDATE_GROUP 8
+#define UPDATE_DIRECT_MAX 4
+#define UPDATE_LANES 16
+
+static int parity(size_t x) {
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    return (0x6996 >> (x & 0xF)) & 1;
+}
+
+static int ceil_log2(size_t k) {
+    int l = 0;
+    while (((size_t)1 << l) < k) {
+        l++;
+    }
+    return l;
+}
+
+/* Direct evaluation: sign(i & y) = sign(low bits) * sign(high bits) */
+
+static void direct_sparse_float(const size_t *indices, const float *values, size_t nnz, float *out, int log_n) {
+    int lt = log_n < DIRECT_LOG_TILE ? log_n : DIRECT_LOG_TILE;
+    size_t m = (size_t)1 << lt, n = (size_t)1 << log_n;
+    float tab[SPARSE_DIRECT_MAX][1 << DIRECT_LOG_TILE];
+    for (size_t j = 0; j < nnz; j++) {
+        for (size_t lo = 0; lo < m; lo++) {
+            tab[j][lo] = parity(indices[j] & lo) ? -values[j] : values[j];
+        }
+    }
+    for (size_t b = 0; b < n; b += m) {
+        float *restrict o = out + b;
+        float c = parity(indices[0] & b) ? -1.0f : 1.0f;
+        for (size_t lo = 0; lo < m; lo++) {
+            o[lo] = c * tab[0][lo];
+        }
+        for (size_t j = 1; j < nnz; j++) {
+            c = parity(indices[j] & b) ? -1.0f : 1.0f;
+            for (size_t lo = 0; lo < m; lo++) {
+                o[lo] += c * tab[j][lo];
+            }
+        }
+    }
+}
+
+static void direct_sparse_double(const size_t *indices, const double *values, size_t nnz, double *out, int log_n) {
+    int lt = log_n < DIRECT_LOG_TILE ? log_n : DIRECT_LOG_TILE;
+    size_t m = (size_t)1 << lt, n = (size_t)1 << log_n;
+    double tab[SPARSE_DIRECT_MAX][1 << DIRECT_LOG_TILE];
+    for (size_t j = 0; j < nnz; j++) {
+        for (size_t lo = 0; lo < m; lo++) {
+            tab[j][lo] = parity(indices[j] & lo) ? -values[j] : values[j];
+        }
+    }
+    for (size_t b = 0; b < n; b += m) {
+        double *restrict o = out + b;
+        double c = parity(indices[0] & b) ? -1.0 : 1.0;
+        for (size_t lo = 0; lo < m; lo++) {
+            o[lo] = c * tab[0][lo];
+        }
+        for (size_t j = 1; j < nnz; j++) {
+            c = parity(indices[j] & b) ? -1.0 : 1.0;
+            for (size_t lo = 0; lo < m; lo++) {
+                o[lo] += c * tab[j][lo];
+            }
+        }
+    }
+}
+
+// Eight partial sums per tile, so that the dot product vectorizes without
+// reassociating a single accumulator
+static float direct_coefficient_float(const float *in, size_t y, int log_n) {
+    int lt = log_n < DIRECT_LOG_TILE ? log_n : DIRECT_LOG_TILE;
+    size_t m = (size_t)1 << lt, n = (size_t)1 << log_n;
+    float tab[1 << DIRECT_LOG_TILE];
+    for (size_t lo = 0; lo < m; lo++) {
+        tab[lo] = parity(y & lo) ? -1.0f : 1.0f;
+    }
+    if (m < 8) {
+        float acc = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            acc += tab[i] * in[i];
+        }
+        return acc;
+    }
+    float total = 0.0f;
+    for (size_t b = 0; b < n; b += m) {
+        float part[8] = {0.0f};
+        for (size_t lo = 0; lo < m; lo += 8) {
+            for (int q = 0; q < 8; q++) {
+                part[q] += tab[lo + q] * in[b + lo + q];
+            }
+        }
+        float dot = ((part[0] + part[1]) + (part[2] + part[3])) + ((part[4] + part[5]) + (part[6] + part[7]));
+        total += parity(y & b) ? -dot : dot;
+    }
+    return total;
+}
+
+static double direct_coefficient_double(const double *in, size_t y, int log_n) {
+    int lt = log_n < DIRECT_LOG_TILE ? log_n : DIRECT_LOG_TILE;
+    size_t m = (size_t)1 << lt, n = (size_t)1 << log_n;
+    double tab[1 << DIRECT_LOG_TILE];
+    for (size_t lo = 0; lo < m; lo++) {
+        tab[lo] = parity(y & lo) ? -1.0 : 1.0;
+    }
+    if (m < 8) {
+        double acc = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            acc += tab[i] * in[i];
+        }
+        return acc;
+    }
+    double total = 0.0;
+    for (size_t b = 0; b < n; b += m) {
+        double part[8] = {0.0};
+        for (size_t lo = 0; lo < m; lo += 8) {
+            for (int q = 0; q < 8; q++) {
+                part[q] += tab[lo + q] * in[b + lo + q];
+            }
+        }
+        double dot = ((part[0] + part[1]) + (part[2] + part[3])) + ((part[4] + part[5]) + (part[6] + part[7]));
+        total += parity(y & b) ? -dot : dot;
+    }
+    return total;
+}
+
+static int check_indices(const size_t *indices, size_t count, int log_n) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    for (size_t j = 0; j < count; j++) {
+        if (indices[j] >> log_n) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Sparse input */
+
+static int float_sparse(const size_t *indices, const float *values, size_t nnz, float *out, int log_n) {
+    if (check_indices(indices, nnz, log_n)) {
+        return -1;
+    }
+    size_t n = (size_t)1 << log_n;
+
+    if (nnz == 0) {
+        memset(out, 0, n * sizeof(float));
+        return 0;
+    }
+    if (nnz <= SPARSE_DIRECT_MAX) {
+        direct_sparse_float(indices, values, nnz, out, log_n);
+        return 0;
+    }
+
+    memset(out, 0, n * sizeof(float));
+    for (size_t j = 0; j < nnz; j++) {
+        out[indices[j]] += values[j];
+    }
+    if (log_n <= SPARSE_LOG_BLOCK) {
+        return fht_float(out, log_n);
+    }
+
+    // Transform the blocks that hold a nonzero, then the cross-block stages
+    // on the pairs where either side is nonzero
+    size_t nblocks = n >> SPARSE_LOG_BLOCK, blk = (size_t)1 << SPARSE_LOG_BLOCK;
+    unsigned char *nonzero = (unsigned char *)calloc(nblocks, 1);
+    if (nonzero == NULL) {
+        return -1;
+    }
+    int res = 0;
+    for (size_t j = 0; res == 0 && j < nnz; j++) {
+        size_t b = indices[j] >> SPARSE_LOG_BLOCK;
+        if (!nonzero[b]) {
+            nonzero[b] = 1;
+            res = fht_float(out + b * blk, SPARSE_LOG_BLOCK);
+        }
+    }
+    for (size_t half = 1; res == 0 && half < nblocks; half *= 2) {
+        for (size_t g = 0; g < nblocks; g += 2 * half) {
+            for (size_t a = g; a < g + half; a++) {
+                if (!nonzero[a] && !nonzero[a + half]) {
+                    continue;
+                }
+                nonzero[a] = nonzero[a + half] = 1;
+                float *restrict x = out + a * blk;
+                float *restrict z = x + half * blk;
+                for (size_t i = 0; i < blk; i++) {
+                    float u = x[i], v = z[i];
+                    x[i] = u + v;
+                    z[i] = u - v;
+                }
+            }
+        }
+    }
+    free(nonzero);
+    return res;
+}
+
+static int double_sparse(const size_t *indices, const double *values, size_t nnz, double *out, int log_n) {
+    if (check_indices(indices, nnz, log_n)) {
+        return -1;
+    }
+    size_t n = (size_t)1 << log_n;
+
+    if (nnz == 0) {
+        memset(out, 0, n * sizeof(double));
+        return 0;
+    }
+    if (nnz <= SPARSE_DIRECT_MAX) {
+        direct_sparse_double(indices, values, nnz, out, log_n);
+        return 0;
+    }
+
+    memset(out, 0, n * sizeof(double));
+    for (size_t j = 0; j < nnz; j++) {
+        out[indices[j]] += values[j];
+    }
+    if (log_n <= SPARSE_LOG_BLOCK) {
+        return fht_double(out, log_n);
+    }
+
+    // Transform the blocks that hold a nonzero, then the cross-block stages
+    // on the pairs where either side is nonzero
+    size_t nblocks = n >> SPARSE_LOG_BLOCK, blk = (size_t)1 << SPARSE_LOG_BLOCK;
+    unsigned char *nonzero = (unsigned char *)calloc(nblocks, 1);
+    if (nonzero == NULL) {
+        return -1;
+    }
+    int res = 0;
+    for (size_t j = 0; res == 0 && j < nnz; j++) {
+        size_t b = indices[j] >> SPARSE_LOG_BLOCK;
+        if (!nonzero[b]) {
+            nonzero[b] = 1;
+            res = fht_double(out + b * blk, SPARSE_LOG_BLOCK);
+        }
+    }
+    for (size_t half = 1; res == 0 && half < nblocks; half *= 2) {
+        for (size_t g = 0; g < nblocks; g += 2 * half) {
+            for (size_t a = g; a < g + half; a++) {
+                if (!nonzero[a] && !nonzero[a + half]) {
+                    continue;
+                }
+                nonzero[a] = nonzero[a + half] = 1;
+                double *restrict x = out + a * blk;
+                double *restrict z = x + half * blk;
+                for (size_t i = 0; i < blk; i++) {
+                    double u = x[i], v = z[i];
+                    x[i] = u + v;
+                    z[i] = u - v;
+                }
+            }
+        }
+    }
+    free(nonzero);
+    return res;
+}
+
+/* Spectrum updates */
+
+// Direct update: per group, sign table rows of +-delta_j * (-1)^popcount(i_j
+// & lo) for the low bits, built by doubling; each tile picks a row per delta
+// and adds the group into its outputs without a pass per delta
+static void direct_update_float(float *spectrum, int log_n, const size_t *indices, const float *deltas,
+                                size_t count) {
+    size_t m = (size_t)1 << DIRECT_LOG_TILE, n = (size_t)1 << log_n;
+    float tab[2][UPDATE_GROUP][1 << DIRECT_LOG_TILE];
+    for (size_t first = 0; first < count; first += UPDATE_GROUP) {
+        size_t g = count - first < UPDATE_GROUP ? count - first : UPDATE_GROUP;
+        for (size_t j = 0; j < g; j++) {
+            size_t i = indices[first + j];
+            tab[0][j][0] = deltas[first + j];
+            for (size_t w = 1; w < m; w *= 2) {
+                float s = (i & w) ? -1.0f : 1.0f;
+                for (size_t lo = 0; lo < w; lo++) {
+                    tab[0][j][w + lo] = s * tab[0][j][lo];
+                }
+            }
+            for (size_t lo = 0; lo < m; lo++) {
+                tab[1][j][lo] = -tab[0][j][lo];
+            }
+        }
+        for (size_t b = 0; b < n; b += m) {
+            const float *rows[UPDATE_GROUP];
+            for (size_t j = 0; j < g; j++) {
+                rows[j] = tab[parity(indices[first + j] & b)][j];
+            }
+            // UPDATE_LANES outputs stay in registers across the group
+            for (size_t lo = 0; lo < m; lo += UPDATE_LANES) {
+                float acc[UPDATE_LANES];
+                for (size_t l = 0; l < UPDATE_LANES; l++) {
+                    acc[l] = spectrum[b + lo + l];
+                }
+                for (size_t j = 0; j < g; j++) {
+                    for (size_t l = 0; l < UPDATE_LANES; l++) {
+                        acc[l] += rows[j][lo + l];
+                    }
+                }
+                for (size_t l = 0; l < UPDATE_LANES; l++) {
+                    spectrum[b + lo + l] = acc[l];
+                }
+            }
+        }
+    }
+}
+
+static void direct_update_double(double *spectrum, int log_n, const size_t *indices, const double *deltas,
+                                 size_t count) {
+    size_t m = (size_t)1 << DIRECT_LOG_TILE, n = (size_t)1 << log_n;
+    double tab[2][UPDATE_GROUP][1 << DIRECT_LOG_TILE];
+    for (size_t first = 0; first < count; first += UPDATE_GROUP) {
+        size_t g = count - first < UPDATE_GROUP ? count - first : UPDATE_GROUP;
+        for (size_t j = 0; j < g; j++) {
+            size_t i = indices[first + j];
+            tab[0][j][0] = deltas[first + j];
+            for (size_t w = 1; w < m; w *= 2) {
+                double s = (i & w) ? -1.0 : 1.0;
+                for (size_t lo = 0; lo < w; lo++) {
+                    tab[0][j][w + lo] = s * tab[0][j][lo];
+                }
+            }
+            for (size_t lo = 0; lo < m; lo++) {
+                tab[1][j][lo] = -tab[0][j][lo];
+            }
+        }
+        for (size_t b = 0; b < n; b += m) {
+            const double *rows[UPDATE_GROUP];
+            for (size_t j = 0; j < g; j++) {
+                rows[j] = tab[parity(indices[first + j] & b)][j];
+            }
+            // UPDATE_LANES outputs stay in registers across the group
+            for (size_t lo = 0; lo < m; lo += UPDATE_LANES) {
+                double acc[UPDATE_LANES];
+                for (size_t l = 0; l < UPDATE_LANES; l++) {
+                    acc[l] = spectrum[b + lo + l];
+                }
+                for (size_t j = 0; j < g; j++) {
+                    for (size_t l = 0; l < UPDATE_LANES; l++) {
+                        acc[l] += rows[j][lo + l];
+                    }
+                }
+                for (size_t l = 0; l < UPDATE_LANES; l++) {
+                    spectrum[b + lo + l] = acc[l];
+                }
+            }
+        }
+    }
+}
+
+// Largest count updated directly. A direct delta costs a pass over the
+// spectrum, while the sparse transform's cost per element grows once it
+// spills out of L2, so past 2^16 each doubling allows one more (break-even
+// measured at about 4, 8, 10, 12 and 20+ deltas for 2^16, 2^18, 2^20, 2^22
+// and 2^24). Below one tile the transform is always cheaper.
+static size_t update_direct_max(int log_n) {
+    if (log_n < DIRECT_LOG_TILE) {
+        return 0;
+    }
+    return log_n <= 16 ? UPDATE_DIRECT_MAX : UPDATE_DIRECT_MAX + (size_t)(log_n - 16);
+}
+
+static int float_update(float *spectrum, int log_n, const size_t *indices, const float *deltas, size_t count,
+                        float *scratch) {
+    if (check_indices(indices, count, log_n)) {
+        return -1;
+    }
+    if (count <= update_direct_max(log_n)) {
+        direct_update_float(spectrum, log_n, indices, deltas, count);
+        return 0;
+    }
+
+    size_t n = (size_t)1 << log_n;
+    float *owned = NULL;
+    if (scratch == NULL) {
+        owned = scratch = (float *)malloc(n * sizeof(float));
+        if (scratch == NULL) {
+            return -1;
+        }
+    }
+    int res = float_sparse(indices, deltas, count, scratch, log_n);
+    for (size_t i = 0; res == 0 && i < n; i++) {
+        spectrum[i] += scratch[i];
+    }
+    free(owned);
+    return res;
+}
+
+static int double_update(double *spectrum, int log_n, const size_t *indices, const double *deltas, size_t count,
+                         double *scratch) {
+    if (check_indices(indices, count, log_n)) {
+        return -1;
+    }
+    if (count <= update_direct_max(log_n)) {
+        direct_update_double(spectrum, log_n, indices, deltas, count);
+        return 0;
+    }
+
+    size_t n = (size_t)1 << log_n;
+    double *owned = NULL;
+    if (scratch == NULL) {
+        owned = scratch = (double *)malloc(n * sizeof(double));
+        if (scratch == NULL) {
+            return -1;
+        }
+    }
+    int res = double_sparse(indices, deltas, count, scratch, log_n);
+    for (size_t i = 0; res == 0 && i < n; i++) {
+        spectrum[i] += scratch[i];
+    }
+    free(owned);
+    return res;
+}
+
+/* Selected outputs */
+
+// Reorder order[0..count) so that the outputs with `bit` clear come first;
+// returns how many that is
+static size_t partition_bit(size_t *order, size_t count, const size_t *indices, size_t bit) {
+    size_t split = 0;
+    for (size_t j = 0; j < count; j++) {
+        if (!(indices[order[j]] & bit)) {
+            size_t t = order[split];
+            order[split++] = order[j];
+            order[j] = t;
+        }
+    }
+    return split;
+}
+
+// Outputs order[0..count) of the transform of buf (2^l elements), indexed by
+// the low l bits of their indices. The top stage only computes the half (sum
+// or difference) that a requested output depends on.
+static int select_float(float *buf, int l, const size_t *indices, size_t *order, size_t count, float *out) {
+    if (l <= SELECT_MIN_LOG_N || l <= ceil_log2(count) + 2) {
+        int res = fht_float(buf, l);
+        size_t mask = ((size_t)1 << l) - 1;
+        for (size_t j = 0; j < count; j++) {
+            out[order[j]] = buf[indices[order[j]] & mask];
+        }
+        return res;
+    }
+    size_t half = (size_t)1 << (l - 1);
+    float *restrict lo = buf;
+    float *restrict hi = buf + half;
+    size_t split = partition_bit(order, count, indices, half);
+    if (split == count) {
+        for (size_t i = 0; i < half; i++) lo[i] += hi[i];
+        return select_float(lo, l - 1, indices, order, count, out);
+    }
+    if (split == 0) {
+        for (size_t i = 0; i < half; i++) hi[i] = lo[i] - hi[i];
+        return select_float(hi, l - 1, indices, order, count, out);
+    }
+    for (size_t i = 0; i < half; i++) {
+        float u = lo[i], v = hi[i];
+        lo[i] = u + v;
+        hi[i] = u - v;
+    }
+    int res = select_float(lo, l - 1, indices, order, split, out);
+    return res ? res : select_float(hi, l - 1, indices, order + split, count - split, out);
+}
+
+static int select_double(double *buf, int l, const size_t *indices, size_t *order, size_t count, double *out) {
+    if (l <= SELECT_MIN_LOG_N || l <= ceil_log2(count) + 2) {
+        int res = fht_double(buf, l);
+        size_t mask = ((size_t)1 << l) - 1;
+        for (size_t j = 0; j < count; j++) {
+            out[order[j]] = buf[indices[order[j]] & mask];
+        }
+        return res;
+    }
+    size_t half = (size_t)1 << (l - 1);
+    double *restrict lo = buf;
+    double *restrict hi = buf + half;
+    size_t split = partition_bit(order, count, indices, half);
+    if (split == count) {
+        for (size_t i = 0; i < half; i++) lo[i] += hi[i];
+        return select_double(lo, l - 1, indices, order, count, out);
+    }
+    if (split == 0) {
+        for (size_t i = 0; i < half; i++) hi[i] = lo[i] - hi[i];
+        return select_double(hi, l - 1, indices, order, count, out);
+    }
+    for (size_t i = 0; i < half; i++) {
+        double u = lo[i], v = hi[i];
+        lo[i] = u + v;
+        hi[i] = u - v;
+    }
+    int res = select_double(lo, l - 1, indices, order, split, out);
+    return res ? res : select_double(hi, l - 1, indices, order + split, count - split, out);
+}
+
+static int float_select(const float *in, const size_t *indices, size_t count, float *out, int log_n, float *scratch) {
+    if (check_indices(indices, count, log_n)) {
+        return -1;
+    }
+    size_t n = (size_t)1 << log_n;
+
+    if (count <= SPARSE_DIRECT_MAX) {
+        for (size_t j = 0; j < count; j++) {
+            out[j] = direct_coefficient_float(in, indices[j], log_n);
+        }
+        return 0;
+    }
+
+    size_t *order = (size_t *)malloc(count * sizeof(size_t));
+    float *owned = NULL;
+    if (scratch == NULL) {
+        owned = scratch = (float *)malloc(n * sizeof(float));
+    }
+    if (order == NULL || scratch == NULL) {
+        free(order);
+        free(owned);
+        return -1;
+    }
+    for (size_t j = 0; j < count; j++) {
+        order[j] = j;
+    }
+    memcpy(scratch, in, n * sizeof(float));
+    int res = select_float(scratch, log_n, indices, order, count, out);
+    free(order);
+    free(owned);
+    return res;
+}
+
+static int double_select(const double *in, const size_t *indices, size_t count, double *out, int log_n,
+                         double *scratch) {
+    if (check_indices(indices, count, log_n)) {
+        return -1;
+    }
+    size_t n = (size_t)1 << log_n;
+
+    if (count <= SPARSE_DIRECT_MAX) {
+        for (size_t j = 0; j < count; j++) {
+            out[j] = direct_coefficient_double(in, indices[j], log_n);
+        }
+        return 0;
+    }
+
+    size_t *order = (size_t *)malloc(count * sizeof(size_t));
+    double *owned = NULL;
+    if (scratch == NULL) {
+        owned = scratch = (double *)malloc(n * sizeof(double));
+    }
+    if (order == NULL || scratch == NULL) {
+        free(order);
+        free(owned);
+        return -1;
+    }
+    for (size_t j = 0; j < count; j++) {
+        order[j] = j;
+    }
+    memcpy(scratch, in, n * sizeof(double));
+    int res = select_double(scratch, log_n, indices, order, count, out);
+    free(order);
+    free(owned);
+    return res;
+}
+
+/* Entry points */
+
+int fht_float_sparse(const size_t *indices, const float *values, size_t nnz, float *out, int log_n) {
+    uint64_t t0 = fht_stats_begin();
+    int res = float_sparse(indices, values, nnz, out, log_n);
+    fht_stats_end(t0, 0, FHT_STATS_SPARSE, log_n, 1);
+    return res;
+}
+
+int fht_double_sparse(const size_t *indices, const double *values, size_t nnz, double *out, int log_n) {
+    uint64_t t0 = fht_stats_begin();
+    int res = double_sparse(indices, values, nnz, out, log_n);
+    fht_stats_end(t0, 1, FHT_STATS_SPARSE, log_n, 1);
+    return res;
+}
+
+int fht_float_update(float *spectrum, int log_n, const size_t *indices, const float *deltas, size_t count,
+                     float *scratch) {
+    uint64_t t0 = fht_stats_begin();
+    int res = float_update(spectrum, log_n, indices, deltas, count, scratch);
+    fht_stats_end(t0, 0, FHT_STATS_SPARSE, log_n, 1);
+    return res;
+}
+
+int fht_double_update(double *spectrum, int log_n, const size_t *indices, const double *deltas, size_t count,
+                      double *scratch) {
+    uint64_t t0 = fht_stats_begin();
+    int res = double_update(spectrum, log_n, indices, deltas, count, scratch);
+    fht_stats_end(t0, 1, FHT_STATS_SPARSE, log_n, 1);
+    return res;
+}
+
+int fht_float_select(const float *in, const size_t *indices, size_t count, float *out, int log_n, float *scratch) {
+    uint64_t t0 = fht_stats_begin();
+    int res = float_select(in, indices, count, out, log_n, scratch);
+    fht_stats_end(t0, 0, FHT_STATS_SPARSE, log_n, 1);
+    return res;
+}
+
+int fht_double_select(const double *in, const size_t *indices, size_t count, double *out, int log_n, double *scratch) {
+    uint64_t t0 = fht_stats_begin();
+    int res = double_select(in, indices, count, out, log_n, scratch);
+    fht_stats_end(t0, 1, FHT_STATS_SPARSE, log_n, 1);
+    return res;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,274 @@
+// Instrumentation: call counts, bytes and time per (dtype, entry point, log_n).
+//
+// Every thread counts into its own table, so recording takes no lock and
+// touches no shared cache line. Tables are allocated on a thread's first
+// recorded call and linked into a registry, which fht_stats_snapshot and
+// fht_stats_reset walk for all_threads; a thread's counts are folded into
+// the `retired` table when it exits, so they survive it.
+//
+// Only the outermost entry point of a call is recorded (fht_float_mt does
+// not also count the fht_float calls it makes, nor fht_float_argmax its
+// fht_float_batch calls), and the fht_mt.c workers record nothing: their
+// work is part of the _mt call that spawned them.
+//
+// Off until fht_stats_enable(1) or FFHT_STATS=1 in the environment, and the
+// disabled cost is one load and branch per call (fht_kernel.h). Building with
+// -DFFHT_NO_STATS drops the hooks altogether and leaves these functions as
+// stubs that return -1.
+
+#define _GNU_SOURCE  // clock_gettime
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht.h"
+#include "fht_kernel.h"
+#include <pthread.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static const char *const entry_names[FHT_STATS_NUM_ENTRIES] = {
+    "inplace", "oop", "batch", "scaled", "stream", "mt", "hd",
+    "xor", "reduce", "sparse", "ordered", "strided", "file",
+};
+
+
+const char *fht_stats_entry_name(int entry) {
+    return (entry >= 0 && entry < FHT_STATS_NUM_ENTRIES) ? entry_names[entry] : "unknown";
+}
+
+static void fill_kernels(fht_stats *out) {
+    for (int log_n = 0; log_n <= 30; log_n++) {
+        out->kernel[FHT_STATS_F32][log_n] = fht_tuned_kernel_name(log_n, 0);
+        out->kernel[FHT_STATS_F64][log_n] = fht_tuned_kernel_name(log_n, 1);
+        out->kernel[FHT_STATS_F16][log_n] = out->kernel[FHT_STATS_F32][log_n];
+        out->kernel[FHT_STATS_BF16][log_n] = out->kernel[FHT_STATS_F32][log_n];
+        for (int dtype = FHT_STATS_I16; dtype <= FHT_STATS_I64; dtype++) {
+            out->kernel[dtype][log_n] = "int";
+        }
+    }
+}
+
+#ifndef FFHT_NO_STATS
+
+typedef struct stats_thread {
+    fht_stats_counter counters[FHT_STATS_NUM_DTYPES][FHT_STATS_NUM_ENTRIES][31];
+    int depth;  // entry points currently running on this thread
+    struct stats_thread *prev;
+    struct stats_thread *next;
+} stats_thread;
+
+int fht_stats_active = 0;
+
+// Element size of each FHT_STATS_<DTYPE>
+static const unsigned char dtype_bytes[FHT_STATS_NUM_DTYPES] = {4, 8, 2, 2, 2, 4, 8};
+
+static pthread_once_t stats_once = PTHREAD_ONCE_INIT;
+static pthread_key_t stats_key;
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static stats_thread *stats_threads = NULL;    // live threads, under stats_lock
+static stats_thread stats_retired;            // exited threads, under stats_lock
+// Recorded nothing, never will: fht_mt.c workers point their key here
+static stats_thread stats_ignored = {.depth = 1};
+
+// Add a thread's table to `dst`, laid out as fht_stats.counters
+static void add_counters(fht_stats_counter *d, const stats_thread *src) {
+    const fht_stats_counter *s = &src->counters[0][0][0];
+    for (size_t i = 0; i < FHT_STATS_NUM_DTYPES * FHT_STATS_NUM_ENTRIES * 31; i++) {
+        d[i].calls += s[i].calls;
+        d[i].bytes += s[i].bytes;
+        d[i].ns += s[i].ns;
+        for (int b = 0; b < FHT_STATS_HIST_BINS; b++) {
+            d[i].hist[b] += s[i].hist[b];
+        }
+    }
+}
+
+static void thread_exit(void *arg) {
+    stats_thread *t = (stats_thread *)arg;
+    if (t == &stats_ignored) {
+        return;
+    }
+    pthread_mutex_lock(&stats_lock);
+    add_counters(&stats_retired.counters[0][0][0], t);
+    if (t->prev != NULL) {
+        t->prev->next = t->next;
+    } else {
+        stats_threads = t->next;
+    }
+    if (t->next != NULL) {
+        t->next->prev = t->prev;
+    }
+    pthread_mutex_unlock(&stats_lock);
+    free(t);
+}
+
+static void make_key(void) {
+    pthread_key_create(&stats_key, thread_exit);
+}
+
+// This thread's table, allocated and registered on first use
+static stats_thread *this_thread(int create) {
+    pthread_once(&stats_once, make_key);
+    stats_thread *t = (stats_thread *)pthread_getspecific(stats_key);
+    if (t != NULL || !create) {
+        return t;
+    }
+    t = (stats_thread *)calloc(1, sizeof(stats_thread));
+    if (t == NULL || pthread_setspecific(stats_key, t) != 0) {
+        free(t);
+        return NULL;
+    }
+    pthread_mutex_lock(&stats_lock);
+    t->next = stats_threads;
+    if (stats_threads != NULL) {
+        stats_threads->prev = t;
+    }
+    stats_threads = t;
+    pthread_mutex_unlock(&stats_lock);
+    return t;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t fht_stats_start(void) {
+    stats_thread *t = this_thread(1);
+    if (t == NULL || t->depth > 0) {
+        return 0;  // nested in a recorded call, or an _mt worker
+    }
+    t->depth = 1;
+    uint64_t t0 = now_ns();
+    return t0 != 0 ? t0 : 1;
+}
+
+void fht_stats_stop(uint64_t t0, int dtype, int entry, int log_n, size_t count) {
+    uint64_t ns = now_ns() - t0;
+    stats_thread *t = this_thread(0);
+    if (t == NULL) {
+        return;
+    }
+    t->depth = 0;
+    if (log_n < 0 || log_n > 30 || dtype < 0 || dtype >= FHT_STATS_NUM_DTYPES || entry < 0 ||
+        entry >= FHT_STATS_NUM_ENTRIES) {
+        return;
+    }
+    fht_stats_counter *c = &t->counters[dtype][entry][log_n];
+    c->calls++;
+    c->bytes += (uint64_t)count * ((uint64_t)dtype_bytes[dtype] << log_n);
+    c->ns += ns;
+    int bin = 0;
+    while (bin + 1 < FHT_STATS_HIST_BINS && (ns >> (bin + 1)) != 0) {
+        bin++;
+    }
+    c->hist[bin]++;
+}
+
+void fht_stats_ignore_thread(void) {
+    pthread_once(&stats_once, make_key);
+    pthread_setspecific(stats_key, &stats_ignored);
+}
+
+void fht_stats_suspend_thread(void) {
+    stats_thread *t = this_thread(1);
+    if (t != NULL && t != &stats_ignored) {
+        t->depth++;
+    }
+}
+
+void fht_stats_resume_thread(void) {
+    stats_thread *t = this_thread(0);
+    if (t != NULL && t != &stats_ignored && t->depth > 0) {
+        t->depth--;
+    }
+}
+
+int fht_stats_enable(int on) {
+    int was = fht_stats_active;
+    fht_stats_active = (on != 0);
+    return was;
+}
+
+int fht_stats_snapshot(fht_stats *out, int all_threads) {
+    if (out == NULL) {
+        return -1;
+    }
+    memset(out, 0, sizeof(*out));
+    fht_stats_counter *sum = &out->counters[0][0][0];
+    if (all_threads) {
+        // Other threads keep counting meanwhile, so a total can be a few
+        // calls behind; each thread's own snapshot is exact
+        pthread_mutex_lock(&stats_lock);
+        add_counters(sum, &stats_retired);
+        for (const stats_thread *t = stats_threads; t != NULL; t = t->next) {
+            add_counters(sum, t);
+        }
+        pthread_mutex_unlock(&stats_lock);
+    } else {
+        const stats_thread *t = this_thread(0);
+        if (t != NULL && t != &stats_ignored) {
+            add_counters(sum, t);
+        }
+    }
+    fill_kernels(out);
+    return 0;
+}
+
+int fht_stats_reset(int all_threads) {
+    if (all_threads) {
+        pthread_mutex_lock(&stats_lock);
+        memset(stats_retired.counters, 0, sizeof(stats_retired.counters));
+        for (stats_thread *t = stats_threads; t != NULL; t = t->next) {
+            memset(t->counters, 0, sizeof(t->counters));
+        }
+        pthread_mutex_unlock(&stats_lock);
+    } else {
+        stats_thread *t = this_thread(0);
+        if (t != NULL && t != &stats_ignored) {
+            memset(t->counters, 0, sizeof(t->counters));
+        }
+    }
+    return 0;
+}
+
+#if defined(__GNUC__)
+__attribute__((constructor)) static void fht_stats_init(void) {
+    const char *env = getenv("FFHT_STATS");
+    if (env != NULL && *env != '\0' && strcmp(env, "0") != 0) {
+        fht_stats_active = 1;
+    }
+}
+#endif
+
+#else  // FFHT_NO_STATS
+
+int fht_stats_enable(int on) {
+    (void)on;
+    return -1;
+}
+
+// Zero counts, so that callers ignoring the -1 still read sane data
+int fht_stats_snapshot(fht_stats *out, int all_threads) {
+    (void)all_threads;
+    if (out != NULL) {
+        memset(out, 0, sizeof(*out));
+        fill_kernels(out);
+    }
+    return -1;
+}
+
+int fht_stats_reset(int all_threads) {
+    (void)all_threads;
+    return -1;
+}
+
+#endif  // FFHT_NO_STATS
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,360 @@
+// Strided transforms: vector j holds the 2^log_n elements
+// buf[j * batch_stride + i * stride], i < 2^log_n.
+//
+// The common non-contiguous case is a transform along the columns of a
+// row-major matrix: stride is the row length and batch_stride is 1. Then
+// element i of all vectors sits in one contiguous row, and every butterfly is
+// a row operation over the columns, which the compiler vectorizes. Columns are
+// taken a tile at a time so that the tile stays in cache through the stages,
+// and tiles too tall for that are split in halves recursively, as in fht.c.
+//
+// Contiguous vectors (stride 1) go to fht_*_batch; other layouts are gathered
+// into a contiguous 2^log_n buffer, transformed and scattered back.
+//
+// fht_*_dims builds on this: the butterfly stages of a run of consecutive bit
+// positions [a, b) form a transform of length 2^(b - a) along a strided axis,
+// and stages on different bits commute, so each run of selected bits is one
+// batched or strided call.
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht.h"
+#include "fht_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Column tile that runs all of its stages in cache (128 KiB, half of a
+// typical L2)
+#define STRIDED_LOG_TILE_BYTES 17
+// Narrowest tile: one 64-byte cache line of floats
+#define STRIDED_MIN_TILE_COLS 16
+// Fewer columns than one vector: gathering is faster than row operations
+#define STRIDED_MIN_COLS 4
+
+/* Column transforms: rows `stride` apart, `cols` contiguous elements each */
+
+static void column_stages_float(float *buf, int log_n, size_t stride, size_t cols) {
+    size_t n = (size_t)1 << log_n;
+    int s = 0;
+    // Two stages per pass (j, j + h, j + 2h, j + 3h), then a radix-2 tail
+    for (; s + 2 <= log_n; s += 2) {
+        size_t h = (size_t)1 << s;
+        for (size_t i = 0; i < n; i += 4 * h) {
+            for (size_t j = i; j < i + h; j++) {
+                float *restrict r0 = buf + j * stride;
+                float *restrict r1 = r0 + h * stride;
+                float *restrict r2 = r1 + h * stride;
+                float *restrict r3 = r2 + h * stride;
+                for (size_t c = 0; c < cols; c++) {
+                    float a0 = r0[c] + r1[c], a1 = r0[c] - r1[c];
+                    float a2 = r2[c] + r3[c], a3 = r2[c] - r3[c];
+                    r0[c] = a0 + a2;
+                    r1[c] = a1 + a3;
+                    r2[c] = a0 - a2;
+                    r3[c] = a1 - a3;
+                }
+            }
+        }
+    }
+    if (s < log_n) {
+        size_t h = (size_t)1 << s;
+        for (size_t j = 0; j < h; j++) {
+            float *restrict r0 = buf + j * stride;
+            float *restrict r1 = r0 + h * stride;
+            for (size_t c = 0; c < cols; c++) {
+                float a0 = r0[c], a1 = r1[c];
+                r0[c] = a0 + a1;
+                r1[c] = a0 - a1;
+            }
+        }
+    }
+}
+
+static void column_stages_double(double *buf, int log_n, size_t stride, size_t cols) {
+    size_t n = (size_t)1 << log_n;
+    int s = 0;
+    // Two stages per pass (j, j + h, j + 2h, j + 3h), then a radix-2 tail
+    for (; s + 2 <= log_n; s += 2) {
+        size_t h = (size_t)1 << s;
+        for (size_t i = 0; i < n; i += 4 * h) {
+            for (size_t j = i; j < i + h; j++) {
+                double *restrict r0 = buf + j * stride;
+                double *restrict r1 = r0 + h * stride;
+                double *restrict r2 = r1 + h * stride;
+                double *restrict r3 = r2 + h * stride;
+                for (size_t c = 0; c < cols; c++) {
+                    double a0 = r0[c] + r1[c], a1 = r0[c] - r1[c];
+                    double a2 = r2[c] + r3[c], a3 = r2[c] - r3[c];
+                    r0[c] = a0 + a2;
+                    r1[c] = a1 + a3;
+                    r2[c] = a0 - a2;
+                    r3[c] = a1 - a3;
+                }
+            }
+        }
+    }
+    if (s < log_n) {
+        size_t h = (size_t)1 << s;
+        for (size_t j = 0; j < h; j++) {
+            double *restrict r0 = buf + j * stride;
+            double *restrict r1 = r0 + h * stride;
+            for (size_t c = 0; c < cols; c++) {
+                double a0 = r0[c], a1 = r1[c];
+                r0[c] = a0 + a1;
+                r1[c] = a0 - a1;
+            }
+        }
+    }
+}
+
+// Tiles taller than the cache budget: transform both halves of the rows,
+// then the stage that joins them
+static void column_transform_float(float *buf, int log_n, size_t stride, size_t cols) {
+    if (((cols * sizeof(float)) << log_n) <= ((size_t)1 << STRIDED_LOG_TILE_BYTES) || log_n <= 2) {
+        column_stages_float(buf, log_n, stride, cols);
+        return;
+    }
+    size_t half = (size_t)1 << (log_n - 1);
+    column_transform_float(buf, log_n - 1, stride, cols);
+    column_transform_float(buf + half * stride, log_n - 1, stride, cols);
+    for (size_t j = 0; j < half; j++) {
+        float *restrict r0 = buf + j * stride;
+        float *restrict r1 = r0 + half * stride;
+        for (size_t c = 0; c < cols; c++) {
+            float a0 = r0[c], a1 = r1[c];
+            r0[c] = a0 + a1;
+            r1[c] = a0 - a1;
+        }
+    }
+}
+
+static void column_transform_double(double *buf, int log_n, size_t stride, size_t cols) {
+    if (((cols * sizeof(double)) << log_n) <= ((size_t)1 << STRIDED_LOG_TILE_BYTES) || log_n <= 2) {
+        column_stages_double(buf, log_n, stride, cols);
+        return;
+    }
+    size_t half = (size_t)1 << (log_n - 1);
+    column_transform_double(buf, log_n - 1, stride, cols);
+    column_transform_double(buf + half * stride, log_n - 1, stride, cols);
+    for (size_t j = 0; j < half; j++) {
+        double *restrict r0 = buf + j * stride;
+        double *restrict r1 = r0 + half * stride;
+        for (size_t c = 0; c < cols; c++) {
+            double a0 = r0[c], a1 = r1[c];
+            r0[c] = a0 + a1;
+            r1[c] = a0 - a1;
+        }
+    }
+}
+
+static size_t tile_cols(int log_n, size_t elem, size_t count) {
+    size_t cols = ((size_t)1 << STRIDED_LOG_TILE_BYTES) / (elem << log_n);
+    if (cols < STRIDED_MIN_TILE_COLS) {
+        cols = STRIDED_MIN_TILE_COLS;
+    }
+    return cols < count ? cols : count;
+}
+
+static void columns_float(float *buf, int log_n, size_t stride, size_t count) {
+    size_t cols = tile_cols(log_n, sizeof(float), count);
+    for (size_t c = 0; c < count; c += cols) {
+        column_transform_float(buf + c, log_n, stride, count - c < cols ? count - c : cols);
+    }
+}
+
+static void columns_double(double *buf, int log_n, size_t stride, size_t count) {
+    size_t cols = tile_cols(log_n, sizeof(double), count);
+    for (size_t c = 0; c < count; c += cols) {
+        column_transform_double(buf + c, log_n, stride, count - c < cols ? count - c : cols);
+    }
+}
+
+static int check_strided(int log_n, size_t stride, size_t count, size_t batch_stride) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if ((log_n > 0 && stride == 0) || (count > 1 && batch_stride == 0)) {
+        return -1;
+    }
+    // Interleaved columns must not run into the next row
+    if (batch_stride == 1 && stride != 1 && count > stride) {
+        return -1;
+    }
+    return 0;
+}
+
+static int float_strided(float *buf, int log_n, size_t stride, size_t count, size_t batch_stride) {
+    if (check_strided(log_n, stride, count, batch_stride)) {
+        return -1;
+    }
+    if (log_n == 0 || count == 0) {
+        return 0;
+    }
+    if (stride == 1) {
+        return fht_float_batch(buf, log_n, count, batch_stride);
+    }
+    if (batch_stride == 1 && count >= STRIDED_MIN_COLS) {
+        columns_float(buf, log_n, stride, count);
+        return 0;
+    }
+
+    size_t n = (size_t)1 << log_n;
+    float *tmp = (float *)malloc(n * sizeof(float));
+    if (tmp == NULL) {
+        return -1;
+    }
+    int res = 0;
+    for (size_t j = 0; res == 0 && j < count; j++) {
+        float *v = buf + j * batch_stride;
+        for (size_t i = 0; i < n; i++) {
+            tmp[i] = v[i * stride];
+        }
+        res = fht_float(tmp, log_n);
+        for (size_t i = 0; i < n; i++) {
+            v[i * stride] = tmp[i];
+        }
+    }
+    free(tmp);
+    return res;
+}
+
+static int double_strided(double *buf, int log_n, size_t stride, size_t count, size_t batch_stride) {
+    if (check_strided(log_n, stride, count, batch_stride)) {
+        return -1;
+    }
+    if (log_n == 0 || count == 0) {
+        return 0;
+    }
+    if (stride == 1) {
+        return fht_double_batch(buf, log_n, count, batch_stride);
+    }
+    if (batch_stride == 1 && count >= STRIDED_MIN_COLS) {
+        columns_double(buf, log_n, stride, count);
+        return 0;
+    }
+
+    size_t n = (size_t)1 << log_n;
+    double *tmp = (double *)malloc(n * sizeof(double));
+    if (tmp == NULL) {
+        return -1;
+    }
+    int res = 0;
+    for (size_t j = 0; res == 0 && j < count; j++) {
+        double *v = buf + j * batch_stride;
+        for (size_t i = 0; i < n; i++) {
+            tmp[i] = v[i * stride];
+        }
+        res = fht_double(tmp, log_n);
+        for (size_t i = 0; i < n; i++) {
+            v[i * stride] = tmp[i];
+        }
+    }
+    free(tmp);
+    return res;
+}
+
+static int check_dims(int log_n, uint32_t dim_mask) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    return (dim_mask >> log_n) != 0 ? -1 : 0;
+}
+
+static int float_dims(float *buf, int log_n, uint32_t dim_mask) {
+    if (check_dims(log_n, dim_mask)) {
+        return -1;
+    }
+    size_t n = (size_t)1 << log_n;
+    int res = 0;
+    for (int a = 0; res == 0 && a < log_n;) {
+        if (!(dim_mask >> a & 1)) {
+            a++;
+            continue;
+        }
+        int b = a;
+        while (b < log_n && (dim_mask >> b & 1)) {
+            b++;
+        }
+        size_t block = (size_t)1 << b;
+        if (a == 0) {
+            // Low bits: contiguous blocks, the regular kernel
+            res = fht_float_batch(buf, b, n >> b, block);
+        } else {
+            // High bits: 2^a interleaved columns per block (row operations
+            // also when narrow; gathering would copy every block)
+            size_t lo = (size_t)1 << a;
+            for (size_t hi = 0; hi < n; hi += block) {
+                columns_float(buf + hi, b - a, lo, lo);
+            }
+        }
+        a = b;
+    }
+    return res;
+}
+
+static int double_dims(double *buf, int log_n, uint32_t dim_mask) {
+    if (check_dims(log_n, dim_mask)) {
+        return -1;
+    }
+    size_t n = (size_t)1 << log_n;
+    int res = 0;
+    for (int a = 0; res == 0 && a < log_n;) {
+        if (!(dim_mask >> a & 1)) {
+            a++;
+            continue;
+        }
+        int b = a;
+        while (b < log_n && (dim_mask >> b & 1)) {
+            b++;
+        }
+        size_t block = (size_t)1 << b;
+        if (a == 0) {
+            // Low bits: contiguous blocks, the regular kernel
+            res = fht_double_batch(buf, b, n >> b, block);
+        } else {
+            // High bits: 2^a interleaved columns per block (row operations
+            // also when narrow; gathering would copy every block)
+            size_t lo = (size_t)1 << a;
+            for (size_t hi = 0; hi < n; hi += block) {
+                columns_double(buf + hi, b - a, lo, lo);
+            }
+        }
+        a = b;
+    }
+    return res;
+}
+
+int fht_float_strided(float *buf, int log_n, size_t stride, size_t count, size_t batch_stride) {
+    uint64_t t0 = fht_stats_begin();
+    int res = float_strided(buf, log_n, stride, count, batch_stride);
+    fht_stats_end(t0, 0, FHT_STATS_STRIDED, log_n, count);
+    return res;
+}
+
+int fht_double_strided(double *buf, int log_n, size_t stride, size_t count, size_t batch_stride) {
+    uint64_t t0 = fht_stats_begin();
+    int res = double_strided(buf, log_n, stride, count, batch_stride);
+    fht_stats_end(t0, 1, FHT_STATS_STRIDED, log_n, count);
+    return res;
+}
+
+int fht_float_dims(float *buf, int log_n, uint32_t dim_mask) {
+    uint64_t t0 = fht_stats_begin();
+    int res = float_dims(buf, log_n, dim_mask);
+    fht_stats_end(t0, 0, FHT_STATS_STRIDED, log_n, 1);
+    return res;
+}
+
+int fht_double_dims(double *buf, int log_n, uint32_t dim_mask) {
+    uint64_t t0 = fht_stats_begin();
+    int res = double_dims(buf, log_n, dim_mask);
+    fht_stats_end(t0, 1, FHT_STATS_STRIDED, log_n, 1);
+    return res;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
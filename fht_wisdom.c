@@ -0,0 +1,230 @@
+// Wisdom: per-machine tuning of the dispatcher, in the spirit of FFTW.
+//
+// fht_tune() times every kernel the CPU supports for each (dtype, log_n) and
+// keeps the fastest; from 2^WISDOM_MIN_MT_LOG_N it also times the _mt
+// transform over thread counts and cross-block splits. The results live in
+// fht_wisdom[][] (fht_kernel.h), which fht.c consults for the kernel and
+// fht_mt.c for calls with nthreads <= 0. Nothing is compiled differently:
+// the FFHT kernels have their recursion cutoff baked into the generated
+// code, and the NEON chunk is a compile-time constant, so the runtime
+// tunables are the kernel, the thread count and the block split.
+//
+// The text format is an "ffht-wisdom 1" header, then one line per tuned size,
+//
+//   <float|double> <log_n> <kernel> <threads> <log_blocks>
+//
+// where threads 0 leaves the _mt defaults. Lines naming a kernel this CPU lacks
+// (wisdom from another machine) are skipped. FFHT_WISDOM=<path> loads a
+// file when the library is loaded, so C, Rust and Python callers all pick
+// it up without code changes.
+
+#define _GNU_SOURCE  // clock_gettime
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht.h"
+#include "fht_kernel.h"
+#include <stdio.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Thread counts and block splits are tuned from this size on
+#define WISDOM_MIN_MT_LOG_N 16
+// Each timing repeats the call for at least this long (best of three)
+#define WISDOM_MIN_TIME_NS 2e6
+
+static const char *const wisdom_kernel_names[] = {"avx512", "avx", "sse", "sve", "neon"};
+#define WISDOM_NUM_NAMES (sizeof(wisdom_kernel_names) / sizeof(wisdom_kernel_names[0]))
+
+fht_wisdom_entry fht_wisdom[2][31];
+
+void fht_wisdom_forget(void) {
+    memset(fht_wisdom, 0, sizeof(fht_wisdom));
+}
+
+static double wisdom_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Best of three, ns per call of the public entry point: fht_* with mt 0,
+// so the out-of-cache passes are timed too, fht_*_mt(buf, log_n, 0) with 1
+static double time_call(int is_double, void *buf, int log_n, int mt) {
+    double best = -1.0;
+    for (int rep = 0; rep < 3; rep++) {
+        long iters = 0;
+        double start = wisdom_now_ns(), elapsed;
+        do {
+            if (mt && is_double) {
+                fht_double_mt((double *)buf, log_n, 0);
+            } else if (mt) {
+                fht_float_mt((float *)buf, log_n, 0);
+            } else if (is_double) {
+                fht_double((double *)buf, log_n);
+            } else {
+                fht_float((float *)buf, log_n);
+            }
+            iters++;
+            elapsed = wisdom_now_ns() - start;
+        } while (elapsed < WISDOM_MIN_TIME_NS);
+        double per_call = elapsed / (double)iters;
+        if (best < 0.0 || per_call < best) best = per_call;
+    }
+    return best;
+}
+
+// `forced` is the caller's forced kernel (NULL: none), which each candidate
+// displaces while it is timed
+static void tune_size(int is_double, int log_n, int max_threads, void *buf, const fht_kernel *forced) {
+    fht_wisdom_entry *e = &fht_wisdom[is_double][log_n];
+    size_t n = (size_t)1 << log_n;
+    // Growth to inf/NaN over the repetitions does not slow the kernels down
+    for (size_t i = 0; i < n; i++) {
+        if (is_double) {
+            ((double *)buf)[i] = (double)(i % 7) - 3.0;
+        } else {
+            ((float *)buf)[i] = (float)(i % 7) - 3.0f;
+        }
+    }
+
+    double best = -1.0;
+    for (size_t i = 0; i < WISDOM_NUM_NAMES; i++) {
+        // Forced the way FFHT_KERNEL forces it, every block of the
+        // dispatcher runs on this kernel
+        if (fht_select_kernel(wisdom_kernel_names[i]) != 0) {
+            continue;
+        }
+        double t = time_call(is_double, buf, log_n, 0);
+        if (best < 0.0 || t < best) {
+            best = t;
+            e->kernel = fht_find_kernel(wisdom_kernel_names[i]);
+        }
+    }
+    fht_select_kernel(forced != NULL ? forced->name : NULL);
+    e->threads = 0;  // untuned: the _mt defaults
+    e->log_blocks = 0;
+    if (log_n < WISDOM_MIN_MT_LOG_N) {
+        return;
+    }
+    e->threads = 1;
+
+    // Thread counts in powers of two, each with the default split and one
+    // block level either side of it (fht_mt.c clamps invalid splits)
+    fht_wisdom_entry winner = *e;
+    for (int t = 2; t <= max_threads; t *= 2) {
+        for (int delta = -1; delta <= 1; delta++) {
+            e->threads = t;
+            e->log_blocks = fht_mt_default_log_blocks(log_n, t) + delta;
+            if (e->log_blocks <= 0) {
+                continue;
+            }
+            double time = time_call(is_double, buf, log_n, 1);
+            if (time < best) {
+                best = time;
+                winner = *e;
+            }
+        }
+    }
+    *e = winner;
+}
+
+int fht_tune(int max_log_n, int max_threads) {
+    if (max_log_n < 1 || max_log_n > 30) {
+        return -1;
+    }
+    if (max_threads <= 0) {
+        max_threads = fht_get_num_threads();
+    }
+    fht_wisdom_entry saved[2][31];
+    memcpy(saved, fht_wisdom, sizeof(saved));
+
+    void *buf = malloc(sizeof(double) << max_log_n);
+    if (buf == NULL) {
+        return -1;
+    }
+    // The timing calls go through the public entry points; keep them out
+    // of this thread's counters, without muting other threads
+    const fht_kernel *forced = fht_forced_kernel();
+    fht_stats_suspend_thread();
+    for (int is_double = 0; is_double <= 1; is_double++) {
+        for (int log_n = 1; log_n <= max_log_n; log_n++) {
+            tune_size(is_double, log_n, max_threads, buf, forced);
+        }
+    }
+    fht_stats_resume_thread();
+    free(buf);
+    // Sizes outside the tuned range keep what they had
+    for (int is_double = 0; is_double <= 1; is_double++) {
+        for (int log_n = max_log_n + 1; log_n <= 30; log_n++) {
+            fht_wisdom[is_double][log_n] = saved[is_double][log_n];
+        }
+    }
+    return 0;
+}
+
+int fht_wisdom_save(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        return -1;
+    }
+    fprintf(f, "ffht-wisdom 1\n");
+    for (int is_double = 0; is_double <= 1; is_double++) {
+        for (int log_n = 0; log_n <= 30; log_n++) {
+            const fht_wisdom_entry *e = &fht_wisdom[is_double][log_n];
+            if (e->kernel != NULL) {
+                fprintf(f, "%s %d %s %d %d\n", is_double ? "double" : "float", log_n, e->kernel->name,
+                        e->threads, e->log_blocks);
+            }
+        }
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+int fht_wisdom_load(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return -1;
+    }
+    char line[128];
+    int version;
+    if (fgets(line, sizeof(line), f) == NULL || sscanf(line, "ffht-wisdom %d", &version) != 1 ||
+        version != 1) {
+        fclose(f);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char dtype[8], name[16];
+        int log_n, threads, log_blocks;
+        if (sscanf(line, "%7s %d %15s %d %d", dtype, &log_n, name, &threads, &log_blocks) != 5 ||
+            log_n < 0 || log_n > 30 || threads < 0 || log_blocks < 0) {
+            continue;
+        }
+        int is_double = strcmp(dtype, "double") == 0;
+        const fht_kernel *k = fht_find_kernel(name);
+        if ((!is_double && strcmp(dtype, "float") != 0) || k == NULL) {
+            continue;
+        }
+        fht_wisdom[is_double][log_n].kernel = k;
+        fht_wisdom[is_double][log_n].threads = threads;
+        fht_wisdom[is_double][log_n].log_blocks = log_blocks;
+    }
+    fclose(f);
+    return 0;
+}
+
+#if defined(__GNUC__)
+__attribute__((constructor)) static void fht_wisdom_init(void) {
+    const char *path = getenv("FFHT_WISDOM");
+    if (path != NULL && *path != '\0') {
+        fht_wisdom_load(path);  // a missing file just means no wisdom yet
+    }
+}
+#endif
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,201 @@
+// XOR (dyadic) convolution: out[k] = sum over i ^ j == k of a[i] * b[j].
+//
+// The Hadamard transform diagonalizes it, out = H(Ha * Hb) / n. Done naively
+// that is three transforms, a product pass and a scaling pass. Here the last
+// butterfly stage of both forward transforms runs as one pass that also
+// multiplies the spectra, and the 1/n scale rides in the last stage of the
+// inverse (fht_*_inverse).
+
+#ifndef FHT_HEADER_ONLY
+#  define FHT_HEADER_ONLY  // keep fast_copy local to fht.c
+#endif
+#include "fht.h"
+#include "fht_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Below this size the forward transforms run whole and the product is a
+// separate pass over L1; see FHT_SPLIT_MIN_LOG_N in fht.c
+#define XOR_MIN_SPLIT_LOG_N 5
+
+// Last stage of both forward transforms fused with the pointwise product
+static void last_stage_product_float(float *restrict x, const float *restrict y, size_t half) {
+    float *x_hi = x + half;
+    const float *y_hi = y + half;
+    for (size_t i = 0; i < half; i++) {
+        float a0 = x[i] + x_hi[i];
+        float a1 = x[i] - x_hi[i];
+        float b0 = y[i] + y_hi[i];
+        float b1 = y[i] - y_hi[i];
+        x[i] = a0 * b0;
+        x_hi[i] = a1 * b1;
+    }
+}
+
+static void last_stage_product_double(double *restrict x, const double *restrict y, size_t half) {
+    double *x_hi = x + half;
+    const double *y_hi = y + half;
+    for (size_t i = 0; i < half; i++) {
+        double a0 = x[i] + x_hi[i];
+        double a1 = x[i] - x_hi[i];
+        double b0 = y[i] + y_hi[i];
+        double b1 = y[i] - y_hi[i];
+        x[i] = a0 * b0;
+        x_hi[i] = a1 * b1;
+    }
+}
+
+static int xor_convolve_float(const float *a, const float *b, float *out, int log_n, float *scratch) {
+    size_t n = (size_t)1 << log_n;
+    int res;
+
+    // b first, so that out may alias b
+    memcpy(scratch, b, n * sizeof(float));
+    if (out != a) {
+        memcpy(out, a, n * sizeof(float));
+    }
+
+    if (log_n < XOR_MIN_SPLIT_LOG_N) {
+        res = fht_float(out, log_n);
+        if (res == 0) {
+            res = fht_float(scratch, log_n);
+        }
+        for (size_t i = 0; res == 0 && i < n; i++) {
+            out[i] *= scratch[i];
+        }
+    } else {
+        size_t half = n / 2;
+        res = fht_float(out, log_n - 1);
+        if (res == 0) res = fht_float(out + half, log_n - 1);
+        if (res == 0) res = fht_float(scratch, log_n - 1);
+        if (res == 0) res = fht_float(scratch + half, log_n - 1);
+        if (res == 0) {
+            last_stage_product_float(out, scratch, half);
+        }
+    }
+    return res ? res : fht_float_inverse(out, log_n);
+}
+
+static int xor_convolve_double(const double *a, const double *b, double *out, int log_n, double *scratch) {
+    size_t n = (size_t)1 << log_n;
+    int res;
+
+    // b first, so that out may alias b
+    memcpy(scratch, b, n * sizeof(double));
+    if (out != a) {
+        memcpy(out, a, n * sizeof(double));
+    }
+
+    if (log_n < XOR_MIN_SPLIT_LOG_N) {
+        res = fht_double(out, log_n);
+        if (res == 0) {
+            res = fht_double(scratch, log_n);
+        }
+        for (size_t i = 0; res == 0 && i < n; i++) {
+            out[i] *= scratch[i];
+        }
+    } else {
+        size_t half = n / 2;
+        res = fht_double(out, log_n - 1);
+        if (res == 0) res = fht_double(out + half, log_n - 1);
+        if (res == 0) res = fht_double(scratch, log_n - 1);
+        if (res == 0) res = fht_double(scratch + half, log_n - 1);
+        if (res == 0) {
+            last_stage_product_double(out, scratch, half);
+        }
+    }
+    return res ? res : fht_double_inverse(out, log_n);
+}
+
+static int check_xor(int log_n, size_t count, size_t stride) {
+    if (log_n < 0 || log_n > 30) {
+        return -1;
+    }
+    if (count > 1 && stride < ((size_t)1 << log_n)) {
+        return -1;
+    }
+    return 0;
+}
+
+static int xor_float_batch(const float *a, const float *b, float *out, int log_n, size_t count, size_t stride,
+                           float *scratch) {
+    if (check_xor(log_n, count, stride)) {
+        return -1;
+    }
+    float *owned = NULL;
+    if (scratch == NULL) {
+        owned = (float *)malloc(sizeof(float) << log_n);
+        if (owned == NULL) {
+            return -1;
+        }
+        scratch = owned;
+    }
+    int res = 0;
+    for (size_t i = 0; res == 0 && i < count; i++) {
+        res = xor_convolve_float(a + i * stride, b + i * stride, out + i * stride, log_n, scratch);
+    }
+    free(owned);
+    return res;
+}
+
+static int xor_double_batch(const double *a, const double *b, double *out, int log_n, size_t count, size_t stride,
+                            double *scratch) {
+    if (check_xor(log_n, count, stride)) {
+        return -1;
+    }
+    double *owned = NULL;
+    if (scratch == NULL) {
+        owned = (double *)malloc(sizeof(double) << log_n);
+        if (owned == NULL) {
+            return -1;
+        }
+        scratch = owned;
+    }
+    int res = 0;
+    for (size_t i = 0; res == 0 && i < count; i++) {
+        res = xor_convolve_double(a + i * stride, b + i * stride, out + i * stride, log_n, scratch);
+    }
+    free(owned);
+    return res;
+}
+
+// Each convolution transforms two vectors, out and scratch
+int fht_xor_convolve_float_batch(const float *a, const float *b, float *out, int log_n,
+                                 size_t count, size_t stride, float *scratch) {
+    uint64_t t0 = fht_stats_begin();
+    int res = xor_float_batch(a, b, out, log_n, count, stride, scratch);
+    fht_stats_end(t0, 0, FHT_STATS_XOR, log_n, 2 * count);
+    return res;
+}
+
+int fht_xor_convolve_double_batch(const double *a, const double *b, double *out, int log_n,
+                                  size_t count, size_t stride, double *scratch) {
+    uint64_t t0 = fht_stats_begin();
+    int res = xor_double_batch(a, b, out, log_n, count, stride, scratch);
+    fht_stats_end(t0, 1, FHT_STATS_XOR, log_n, 2 * count);
+    return res;
+}
+
+int fht_xor_convolve_float(const float *a, const float *b, float *out, int log_n, float *scratch) {
+    return fht_xor_convolve_float_batch(a, b, out, log_n, 1, 0, scratch);
+}
+
+int fht_xor_convolve_double(const double *a, const double *b, double *out, int log_n, double *scratch) {
+    return fht_xor_convolve_double_batch(a, b, out, log_n, 1, 0, scratch);
+}
+
+// Over XOR, j = i ^ k is the same as i ^ j = k, so correlation and
+// convolution coincide; the separate names keep call sites self-describing.
+int fht_xor_correlate_float(const float *a, const float *b, float *out, int log_n, float *scratch) {
+    return fht_xor_convolve_float(a, b, out, log_n, scratch);
+}
+
+int fht_xor_correlate_double(const double *a, const double *b, double *out, int log_n, double *scratch) {
+    return fht_xor_convolve_double(a, b, out, log_n, scratch);
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""Generate fht_neon_gen.c: fully unrolled NEON kernels, one per log_n.
+
+This works like FFHT's x86 generator. Every size up to the L1 chunk gets its own
+register-blocked routine:
+
+  * Stages inside a register are done two registers at a time with
+    trn1/trn2/uzp1/uzp2 transposes; no sign constants and no lane moves.
+  * Up to 32 registers are live at once (all of the AArch64 vector file), so
+    one load/store of a register block covers up to 5 more stages.
+  * Sizes that fit in 32 registers are straight-line code. Larger sizes are a
+    short sequence of loops whose bodies are unrolled register blocks.
+
+Usage: python3 gen_neon.py [--max-log-float N] [--max-log-double N] > fht_neon_gen.c
+"""
+
+import argparse
+
+LOG_REGS = 5
+
+
+class Emitter:
+    def __init__(self):
+        self.lines = []
+        self.indent = 0
+
+    def __call__(self, line=""):
+        self.lines.append(("    " * self.indent + line) if line else "")
+
+    def text(self):
+        return "\n".join(self.lines) + "\n"
+
+
+class Type:
+    def __init__(self, name, lanes, log_lanes, vec, sfx):
+        self.name = name
+        self.lanes = lanes
+        self.log_lanes = log_lanes
+        self.vec = vec
+        self.sfx = sfx
+
+
+FLOAT = Type("float", 4, 2, "float32x4_t", "f32")
+DOUBLE = Type("double", 2, 1, "float64x2_t", "f64")
+
+
+def emit_in_register(out, t, a, b):
+    """In-register stages (stride < lanes) on registers a and b, in place."""
+    v, s = t.vec, t.sfx
+    if t.lanes == 4:
+        # trn splits even/odd lanes: stage 1 is a plain butterfly on them.
+        # trn on 64-bit lanes then lines up lanes 0/2 and 1/3 for stage 2,
+        # and uzp puts every element back where it belongs.
+        out("{")
+        out("    %s ev = vtrn1q_f32(%s, %s), od = vtrn2q_f32(%s, %s);" % (v, a, b, a, b))
+        out("    %s sm = vaddq_f32(ev, od), df = vsubq_f32(ev, od);" % v)
+        out("    float64x2_t sd = vreinterpretq_f64_f32(sm), dd = vreinterpretq_f64_f32(df);")
+        out("    %s u = vreinterpretq_f32_f64(vtrn1q_f64(sd, dd));" % v)
+        out("    %s w = vreinterpretq_f32_f64(vtrn2q_f64(sd, dd));" % v)
+        out("    %s x = vaddq_f32(u, w), y = vsubq_f32(u, w);" % v)
+        out("    %s = vuzp1q_f32(x, y);" % a)
+        out("    %s = vuzp2q_f32(x, y);" % b)
+        out("}")
+    else:
+        out("{")
+        out("    %s ev = vtrn1q_%s(%s, %s), od = vtrn2q_%s(%s, %s);" % (v, s, a, b, s, a, b))
+        out("    %s sm = vaddq_%s(ev, od), df = vsubq_%s(ev, od);" % (v, s, s))
+        out("    %s = vtrn1q_%s(sm, df);" % (a, s))
+        out("    %s = vtrn2q_%s(sm, df);" % (b, s))
+        out("}")
+
+
+def emit_cross(out, t, regs, stages):
+    """Butterflies across registers: register i pairs with i ^ (1 << k)."""
+    s = t.sfx
+    for k in range(stages):
+        h = 1 << k
+        for i in range(len(regs)):
+            if i & h:
+                continue
+            a, b = regs[i], regs[i | h]
+            out("{ %s tmp = vaddq_%s(%s, %s); %s = vsubq_%s(%s, %s); %s = tmp; }"
+                % (t.vec, s, a, b, b, s, a, b, a))
+
+
+def emit_block(out, t, ptr, offsets, in_register):
+    """Load registers at ptr + offsets, transform, store them back."""
+    regs = ["r%d" % i for i in range(len(offsets))]
+    for i in range(0, len(regs), 2):
+        for j in (i, i + 1):
+            if j < len(regs):
+                out("%s %s = vld1q_%s(%s + %s);" % (t.vec, regs[j], t.sfx, ptr, offsets[j]))
+        if in_register:
+            emit_in_register(out, t, regs[i], regs[i + 1])
+    stages = len(regs).bit_length() - 1
+    emit_cross(out, t, regs, stages)
+    for r, off in zip(regs, offsets):
+        out("vst1q_%s(%s + %s, %s);" % (t.sfx, ptr, off, r))
+
+
+def split_passes(stages):
+    """Split cross-register stages into passes of at most LOG_REGS, balanced."""
+    if stages <= 0:
+        return []
+    npasses = -(-stages // LOG_REGS)
+    base, extra = divmod(stages, npasses)
+    return [base + 1 if i < extra else base for i in range(npasses)]
+
+
+def emit_kernel(out, t, log_n):
+    n = 1 << log_n
+    out("static void fht_neon_gen_%s_%d(%s *buf) {" % (t.name, log_n, t.name))
+    out.indent += 1
+    if log_n == 1:
+        out("%s u = buf[0], v = buf[1];" % t.name)
+        out("buf[0] = u + v;")
+        out("buf[1] = u - v;")
+    elif t.lanes == 4 and log_n == 2:
+        # Single register: uzp/zip for stage 1, halves for stage 2
+        out("float32x4_t v = vld1q_f32(buf);")
+        out("float32x4_t x = vuzp1q_f32(v, v), y = vuzp2q_f32(v, v);")
+        out("float32x4_t z = vzip1q_f32(vaddq_f32(x, y), vsubq_f32(x, y));")
+        out("float32x2_t lo = vget_low_f32(z), hi = vget_high_f32(z);")
+        out("vst1q_f32(buf, vcombine_f32(vadd_f32(lo, hi), vsub_f32(lo, hi)));")
+    else:
+        log_block = min(log_n, t.log_lanes + LOG_REGS)
+        block = 1 << log_block
+        offsets = [str(i * t.lanes) for i in range(block // t.lanes)]
+        if block == n:
+            emit_block(out, t, "buf", offsets, True)
+        else:
+            out("for (size_t i = 0; i < %d; i += %d) {" % (n, block))
+            out.indent += 1
+            out("%s *p = buf + i;" % t.name)
+            emit_block(out, t, "p", offsets, True)
+            out.indent -= 1
+            out("}")
+            stage = log_block
+            for k in split_passes(log_n - log_block):
+                h = 1 << stage
+                offsets = [str(i * h) for i in range(1 << k)]
+                out("for (size_t i = 0; i < %d; i += %d) {" % (n, h << k))
+                out.indent += 1
+                out("for (size_t j = i; j < i + %d; j += %d) {" % (h, t.lanes))
+                out.indent += 1
+                out("%s *p = buf + j;" % t.name)
+                emit_block(out, t, "p", offsets, False)
+                out.indent -= 1
+                out("}")
+                out.indent -= 1
+                out("}")
+                stage += k
+    out.indent -= 1
+    out("}")
+    out()
+
+
+def emit_dispatch(out, t, max_log):
+    out("/* Transform 2^log_n elements, 1 <= log_n <= FHT_NEON_GEN_MAX_LOG_%s */" % t.name.upper())
+    out("static void fht_neon_gen_%s(%s *buf, int log_n) {" % (t.name, t.name))
+    out("    switch (log_n) {")
+    for log_n in range(1, max_log + 1):
+        out("    case %d: fht_neon_gen_%s_%d(buf); break;" % (log_n, t.name, log_n))
+    out("    default: break;")
+    out("    }")
+    out("}")
+    out()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--max-log-float", type=int, default=12)
+    ap.add_argument("--max-log-double", type=int, default=11)
+    args = ap.parse_args()
+
+    out = Emitter()
+    out("/* Generated by gen_neon.py -- do not edit by hand. */")
+    out("/* Included by fht_neon.c after <arm_neon.h>. */")
+    out()
+    out("#define FHT_NEON_GEN_MAX_LOG_FLOAT %d" % args.max_log_float)
+    out("#define FHT_NEON_GEN_MAX_LOG_DOUBLE %d" % args.max_log_double)
+    out()
+    for t, max_log in ((FLOAT, args.max_log_float), (DOUBLE, args.max_log_double)):
+        for log_n in range(1, max_log + 1):
+            emit_kernel(out, t, log_n)
+        emit_dispatch(out, t, max_log)
+    print(out.text(), end="")
+
+
+if __name__ == "__main__":
+    main()
@@ -41,15 +41,19 @@ except ImportError:
 
 # Use Python 3 version (fixed for modern Python 3.9+)
 # Original FFHT's _ffht_3.c only worked with Python 3.8 and below
-arr_sources = ['_ffht_3.c', 'fht.c']
+# All SIMD backends are built in and selected at runtime (see fht.c), so the
+# wheel runs on any CPU of the target architecture: no -march=native.
+arr_sources = ['_ffht_3.c', 'fht.c', 'fht_mt.c', 'fht_xor.c', 'fht_int.c', 'fht_half.c', 'fht_strided.c', 'fht_sparse.c', 'fht_reduce.c', 'fht_order.c', 'fht_file.c', 'fht_wisdom.c', 'fht_stats.c', 'fht_kernel_avx512.c', 'fht_kernel_avx.c', 'fht_kernel_sse.c', 'fht_neon.c', 'fht_sve.c']
 
 module = Extension('ffht',
                    sources=arr_sources,
-                   extra_compile_args=['-march=native', '-O3', '-Wall', '-Wextra', '-pedantic',
+                   extra_compile_args=['-O3', '-Wall', '-Wextra', '-pedantic',
                                        '-Wshadow', '-Wpointer-arith', '-Wcast-qual',
                                        '-Wstrict-prototypes', '-Wmissing-prototypes',
                                        '-std=c99', '-DFHT_HEADER_ONLY'],
-                   include_dirs=[np.get_include()])
+                   extra_link_args=['-pthread'],
+                   depends=['fht.h', 'fht_kernel.h', 'fht_neon_gen.c'],
+                   include_dirs=[np.get_include(), 'FFHT'])
 
 setup(name='FFHT',
       version='1.1',
@@ -6,8 +6,11 @@
 //! ## Features
 //!
 //! - **SIMD optimized**: Uses AVX on x86_64, NEON on ARM64
-//! - **In-place and out-of-place** transforms
-//! - **f32 and f64** support
+//! - **Runtime dispatch**: The fastest kernel the CPU supports is picked at load time
+//! - **In-place, out-of-place and batched** transforms
+//! - **Multithreaded** transforms for large sizes (C worker threads, or rayon with feature `rayon`)
+//! - **f32 and f64** support, plus exact **i16/i32/i64** transforms
+//!   and fp16/bf16 storage with fp32 arithmetic (feature `half`)
 //! - **ndarray integration** for convenient array operations
 //! - **Safe API** wrapping unsafe C FFI
 //!
@@ -26,18 +29,35 @@
 //! println!("Transformed: {:?}", data);
 //! ```
 
-use ndarray::{Array1, ArrayViewMut1};
+use ndarray::{Array1, Array2, ArrayViewMut1, ArrayViewMut2, ArrayViewMutD, Axis};
+use std::ffi::{CStr, CString};
+#[cfg(unix)]
+use std::fs::File;
 use std::os::raw::c_int;
+#[cfg(unix)]
+use std::os::unix::io::AsRawFd;
+use std::path::Path;
 
 /// Error types for FFHT operations
 #[derive(Debug, Clone, PartialEq, Eq)]
 pub enum FhtError {
     /// Input size is not a power of 2
     InvalidSize(usize),
-    /// Input size is too large (log_n > 30)
+    /// Input size (in elements) is too large: past 2^30, or past
+    /// 2^MAX_LARGE_LOG_N for the `fht_large_inplace`/`fht_file` transforms
     SizeTooLarge(usize),
     /// Internal FFT error
     InternalError(i32),
+    /// An int16 transform saturated; the output is clipped
+    Overflow,
+    /// The operation is not available for this element type (e.g. no exact
+    /// integer counterpart) or this container (e.g. an owned result from a
+    /// view)
+    Unsupported(&'static str),
+    /// Reading or writing the file of an out-of-core transform failed
+    Io(std::io::ErrorKind),
+    /// The array is not in standard (contiguous, row-major) layout
+    NonContiguous,
 }
 
 impl std::fmt::Display for FhtError {
@@ -47,22 +67,73 @@ impl std::fmt::Display for FhtError {
                 write!(f, "Input size {} is not a power of 2", size)
             }
             FhtError::SizeTooLarge(size) => {
-                write!(f, "Input size {} is too large (max 2^30)", size)
+                write!(
+                    f,
+                    "Input size {} is too large (max 2^30, 2^{} for fht_large_inplace and fht_file)",
+                    size, MAX_LARGE_LOG_N
+                )
             }
             FhtError::InternalError(code) => {
                 write!(f, "FFHT internal error: {}", code)
             }
+            FhtError::Overflow => {
+                write!(f, "Integer transform saturated")
+            }
+            FhtError::Unsupported(what) => {
+                write!(f, "{} is not supported", what)
+            }
+            FhtError::Io(kind) => {
+                write!(f, "Out-of-core transform failed: {}", kind)
+            }
+            FhtError::NonContiguous => {
+                write!(f, "Array is not in standard (contiguous, row-major) layout")
+            }
         }
     }
 }
 
+/// Coefficient order of `Fht::fht_ordered` (`FHT_ORDER_*` in fht.h)
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum FhtOrder {
+    /// Hadamard order, as `Fht::fht`
+    Natural = 0,
+    /// Walsh order: coefficient k has k sign changes
+    Sequency = 1,
+    /// Dyadic order: the natural one at bit-reversed indices
+    Paley = 2,
+}
+
 impl std::error::Error for FhtError {}
 
 pub type FhtResult<T> = Result<T, FhtError>;
 
 /// Raw FFI bindings to FFHT C library
 mod ffi {
-    use std::os::raw::c_int;
+    use std::os::raw::{c_char, c_int};
+
+    /// Histogram bins of `fht_stats_counter` (FHT_STATS_HIST_BINS)
+    pub const STATS_HIST_BINS: usize = 24;
+    /// Entry points counted (FHT_STATS_NUM_ENTRIES)
+    pub const STATS_NUM_ENTRIES: usize = 13;
+    /// Element types counted (FHT_STATS_NUM_DTYPES)
+    pub const STATS_NUM_DTYPES: usize = 7;
+
+    /// `fht_stats_counter` from fht.h
+    #[repr(C)]
+    #[derive(Clone, Copy)]
+    pub struct FhtStatsCounter {
+        pub calls: u64,
+        pub bytes: u64,
+        pub ns: u64,
+        pub hist: [u64; STATS_HIST_BINS],
+    }
+
+    /// `fht_stats` from fht.h
+    #[repr(C)]
+    pub struct FhtStats {
+        pub counters: [[[FhtStatsCounter; 31]; STATS_NUM_ENTRIES]; STATS_NUM_DTYPES],
+        pub kernel: [[*const c_char; 31]; STATS_NUM_DTYPES],
+    }
 
     extern "C" {
         /// In-place FHT for f32
@@ -76,6 +147,540 @@ mod ffi {
 
         /// Out-of-place FHT for f64
         pub fn fht_double_oop(input: *const f64, output: *mut f64, log_n: c_int) -> c_int;
+
+        /// Out-of-place FHT for f32 in an FHT_ORDER_* order (in place if input == output)
+        pub fn fht_float_ordered(input: *const f32, output: *mut f32, log_n: c_int, order: c_int) -> c_int;
+
+        /// Out-of-place FHT for f64 in an FHT_ORDER_* order (in place if input == output)
+        pub fn fht_double_ordered(input: *const f64, output: *mut f64, log_n: c_int, order: c_int) -> c_int;
+
+        /// Batched in-place FHT for f32: `count` vectors, `stride` elements apart
+        pub fn fht_float_batch(buf: *mut f32, log_n: c_int, count: usize, stride: usize) -> c_int;
+
+        /// Batched in-place FHT for f64: `count` vectors, `stride` elements apart
+        pub fn fht_double_batch(buf: *mut f64, log_n: c_int, count: usize, stride: usize) -> c_int;
+
+        /// In-place FHT for f32, scaled by `scale` in the last butterfly stage
+        pub fn fht_float_scaled(buf: *mut f32, log_n: c_int, scale: f32) -> c_int;
+
+        /// In-place FHT for f64, scaled by `scale` in the last butterfly stage
+        pub fn fht_double_scaled(buf: *mut f64, log_n: c_int, scale: f64) -> c_int;
+
+        /// In-place FHT for f32 scaled by 1/sqrt(n)
+        pub fn fht_float_orthonormal(buf: *mut f32, log_n: c_int) -> c_int;
+
+        /// In-place FHT for f64 scaled by 1/sqrt(n)
+        pub fn fht_double_orthonormal(buf: *mut f64, log_n: c_int) -> c_int;
+
+        /// In-place FHT for f32 scaled by 1/n
+        pub fn fht_float_inverse(buf: *mut f32, log_n: c_int) -> c_int;
+
+        /// In-place FHT for f64 scaled by 1/n
+        pub fn fht_double_inverse(buf: *mut f64, log_n: c_int) -> c_int;
+
+        /// Batched `fht_float_scaled`: `count` vectors, `stride` elements apart
+        pub fn fht_float_scaled_batch(buf: *mut f32, log_n: c_int, count: usize, stride: usize, scale: f32) -> c_int;
+
+        /// Batched `fht_double_scaled`: `count` vectors, `stride` elements apart
+        pub fn fht_double_scaled_batch(
+            buf: *mut f64,
+            log_n: c_int,
+            count: usize,
+            stride: usize,
+            scale: f64,
+        ) -> c_int;
+
+        /// In-place FHT for f32, last stage written with non-temporal stores
+        pub fn fht_float_stream(buf: *mut f32, log_n: c_int) -> c_int;
+
+        /// In-place FHT for f64, last stage written with non-temporal stores
+        pub fn fht_double_stream(buf: *mut f64, log_n: c_int) -> c_int;
+
+        /// Exact in-place FHT for i16; returns 1 if a value saturated
+        pub fn fht_int16(buf: *mut i16, log_n: c_int) -> c_int;
+
+        /// Exact in-place FHT for i32 (wraps modulo 2^32)
+        pub fn fht_int32(buf: *mut i32, log_n: c_int) -> c_int;
+
+        /// Exact in-place FHT for i64 (wraps modulo 2^64)
+        pub fn fht_int64(buf: *mut i64, log_n: c_int) -> c_int;
+
+        /// In-place FHT of IEEE fp16 bit patterns, fp32 arithmetic
+        #[cfg_attr(not(feature = "half"), allow(dead_code))]
+        pub fn fht_half(buf: *mut u16, log_n: c_int) -> c_int;
+
+        /// In-place FHT of bfloat16 bit patterns, fp32 arithmetic
+        #[cfg_attr(not(feature = "half"), allow(dead_code))]
+        pub fn fht_bf16(buf: *mut u16, log_n: c_int) -> c_int;
+
+        /// Strided FHT for f32: `count` vectors `batch_stride` apart, elements `stride` apart
+        pub fn fht_float_strided(
+            buf: *mut f32,
+            log_n: c_int,
+            stride: usize,
+            count: usize,
+            batch_stride: usize,
+        ) -> c_int;
+
+        /// Strided FHT for f64: `count` vectors `batch_stride` apart, elements `stride` apart
+        pub fn fht_double_strided(
+            buf: *mut f64,
+            log_n: c_int,
+            stride: usize,
+            count: usize,
+            batch_stride: usize,
+        ) -> c_int;
+
+        /// FHT for f32 over the bit positions set in dim_mask only
+        pub fn fht_float_dims(buf: *mut f32, log_n: c_int, dim_mask: u32) -> c_int;
+
+        /// FHT for f64 over the bit positions set in dim_mask only
+        pub fn fht_double_dims(buf: *mut f64, log_n: c_int, dim_mask: u32) -> c_int;
+
+        /// Dense spectrum of a sparse f32 vector
+        pub fn fht_float_sparse(
+            indices: *const usize,
+            values: *const f32,
+            nnz: usize,
+            out: *mut f32,
+            log_n: c_int,
+        ) -> c_int;
+
+        /// Dense spectrum of a sparse f64 vector
+        pub fn fht_double_sparse(
+            indices: *const usize,
+            values: *const f64,
+            nnz: usize,
+            out: *mut f64,
+            log_n: c_int,
+        ) -> c_int;
+
+        /// Selected coefficients of the f32 transform (scratch: 2^log_n elements or null)
+        pub fn fht_float_select(
+            input: *const f32,
+            indices: *const usize,
+            count: usize,
+            out: *mut f32,
+            log_n: c_int,
+            scratch: *mut f32,
+        ) -> c_int;
+
+        /// Selected coefficients of the f64 transform (scratch: 2^log_n elements or null)
+        pub fn fht_double_select(
+            input: *const f64,
+            indices: *const usize,
+            count: usize,
+            out: *mut f64,
+            log_n: c_int,
+            scratch: *mut f64,
+        ) -> c_int;
+
+        /// Update an f32 spectrum after input changes (scratch: 2^log_n elements or null)
+        pub fn fht_float_update(
+            spectrum: *mut f32,
+            log_n: c_int,
+            indices: *const usize,
+            deltas: *const f32,
+            count: usize,
+            scratch: *mut f32,
+        ) -> c_int;
+
+        /// Update an f64 spectrum after input changes (scratch: 2^log_n elements or null)
+        pub fn fht_double_update(
+            spectrum: *mut f64,
+            log_n: c_int,
+            indices: *const usize,
+            deltas: *const f64,
+            count: usize,
+            scratch: *mut f64,
+        ) -> c_int;
+
+        /// XOR convolution for f32 (scratch: 2^log_n elements or null)
+        pub fn fht_xor_convolve_float(
+            a: *const f32,
+            b: *const f32,
+            out: *mut f32,
+            log_n: c_int,
+            scratch: *mut f32,
+        ) -> c_int;
+
+        /// XOR convolution for f64 (scratch: 2^log_n elements or null)
+        pub fn fht_xor_convolve_double(
+            a: *const f64,
+            b: *const f64,
+            out: *mut f64,
+            log_n: c_int,
+            scratch: *mut f64,
+        ) -> c_int;
+
+        /// Batched XOR convolution for f32: `count` vectors `stride` apart
+        pub fn fht_xor_convolve_float_batch(
+            a: *const f32,
+            b: *const f32,
+            out: *mut f32,
+            log_n: c_int,
+            count: usize,
+            stride: usize,
+            scratch: *mut f32,
+        ) -> c_int;
+
+        /// Batched XOR convolution for f64: `count` vectors `stride` apart
+        pub fn fht_xor_convolve_double_batch(
+            a: *const f64,
+            b: *const f64,
+            out: *mut f64,
+            log_n: c_int,
+            count: usize,
+            stride: usize,
+            scratch: *mut f64,
+        ) -> c_int;
+
+        /// Multithreaded in-place FHT for f32 (nthreads <= 0: global default)
+        pub fn fht_float_mt(buf: *mut f32, log_n: c_int, nthreads: c_int) -> c_int;
+
+        /// Multithreaded in-place FHT for f64 (nthreads <= 0: global default)
+        pub fn fht_double_mt(buf: *mut f64, log_n: c_int, nthreads: c_int) -> c_int;
+
+        /// Batched in-place FHT for f32 on C worker threads (nthreads <= 0: global default)
+        pub fn fht_float_batch_mt(buf: *mut f32, log_n: c_int, count: usize, stride: usize, nthreads: c_int) -> c_int;
+
+        /// Batched in-place FHT for f64 on C worker threads (nthreads <= 0: global default)
+        pub fn fht_double_batch_mt(buf: *mut f64, log_n: c_int, count: usize, stride: usize, nthreads: c_int) -> c_int;
+
+        /// Randomized Hadamard rounds (H D_r) on `count` vectors, times `scale`
+        pub fn fht_float_hd_batch(
+            buf: *mut f32,
+            log_n: c_int,
+            count: usize,
+            stride: usize,
+            sign_bits: *const u64,
+            rounds: c_int,
+            scale: f32,
+        ) -> c_int;
+
+        /// Randomized Hadamard rounds (H D_r) on `count` vectors, times `scale`
+        pub fn fht_double_hd_batch(
+            buf: *mut f64,
+            log_n: c_int,
+            count: usize,
+            stride: usize,
+            sign_bits: *const u64,
+            rounds: c_int,
+            scale: f64,
+        ) -> c_int;
+
+        /// In-place FHT for f32 returning the index of the largest |coefficient|
+        pub fn fht_float_argmax(buf: *mut f32, log_n: c_int, index: *mut usize) -> c_int;
+
+        /// In-place FHT for f64 returning the index of the largest |coefficient|
+        pub fn fht_double_argmax(buf: *mut f64, log_n: c_int, index: *mut usize) -> c_int;
+
+        /// `fht_float_argmax` of `count` vectors, one index each
+        pub fn fht_float_argmax_batch(
+            buf: *mut f32,
+            log_n: c_int,
+            count: usize,
+            stride: usize,
+            indices: *mut usize,
+        ) -> c_int;
+
+        /// `fht_double_argmax` of `count` vectors, one index each
+        pub fn fht_double_argmax_batch(
+            buf: *mut f64,
+            log_n: c_int,
+            count: usize,
+            stride: usize,
+            indices: *mut usize,
+        ) -> c_int;
+
+        /// In-place FHT for f32 of `count` vectors and the k largest |coefficients| of each
+        pub fn fht_float_topk_batch(
+            buf: *mut f32,
+            log_n: c_int,
+            count: usize,
+            stride: usize,
+            k: usize,
+            indices: *mut usize,
+        ) -> c_int;
+
+        /// In-place FHT for f64 of `count` vectors and the k largest |coefficients| of each
+        pub fn fht_double_topk_batch(
+            buf: *mut f64,
+            log_n: c_int,
+            count: usize,
+            stride: usize,
+            k: usize,
+            indices: *mut usize,
+        ) -> c_int;
+
+        /// In-place FHT for f32 of `count` vectors and the indices with |coefficient| >= t
+        pub fn fht_float_threshold_batch(
+            buf: *mut f32,
+            log_n: c_int,
+            count: usize,
+            stride: usize,
+            t: f32,
+            indices: *mut usize,
+            capacity: usize,
+            counts: *mut usize,
+        ) -> c_int;
+
+        /// In-place FHT for f64 of `count` vectors and the indices with |coefficient| >= t
+        pub fn fht_double_threshold_batch(
+            buf: *mut f64,
+            log_n: c_int,
+            count: usize,
+            stride: usize,
+            t: f64,
+            indices: *mut usize,
+            capacity: usize,
+            counts: *mut usize,
+        ) -> c_int;
+
+        /// In-place FHT for f32 of up to 2^FHT_LARGE_MAX_LOG_N elements
+        pub fn fht_float_large(buf: *mut f32, log_n: c_int) -> c_int;
+
+        /// In-place FHT for f64 of up to 2^FHT_LARGE_MAX_LOG_N elements
+        pub fn fht_double_large(buf: *mut f64, log_n: c_int) -> c_int;
+
+        /// Out-of-core FHT of 2^log_n f32 at byte `offset` of `fd`; -1 with errno set
+        #[cfg(unix)]
+        pub fn fht_float_file(fd: c_int, offset: u64, log_n: c_int, mem_bytes: usize, nthreads: c_int) -> c_int;
+
+        /// Out-of-core FHT of 2^log_n f64 at byte `offset` of `fd`; -1 with errno set
+        #[cfg(unix)]
+        pub fn fht_double_file(fd: c_int, offset: u64, log_n: c_int, mem_bytes: usize, nthreads: c_int) -> c_int;
+
+        /// Default thread count of the _mt calls (0: all online CPUs)
+        pub fn fht_set_num_threads(nthreads: c_int) -> c_int;
+
+        /// Effective default thread count of the _mt calls
+        pub fn fht_get_num_threads() -> c_int;
+
+        /// Cross-block butterfly stages for offsets [begin, end) (f32)
+        #[cfg_attr(not(feature = "rayon"), allow(dead_code))]
+        pub fn fht_float_combine_blocks(
+            buf: *mut f32,
+            log_n: c_int,
+            log_blocks: c_int,
+            begin: usize,
+            end: usize,
+        ) -> c_int;
+
+        /// Cross-block butterfly stages for offsets [begin, end) (f64)
+        #[cfg_attr(not(feature = "rayon"), allow(dead_code))]
+        pub fn fht_double_combine_blocks(
+            buf: *mut f64,
+            log_n: c_int,
+            log_blocks: c_int,
+            begin: usize,
+            end: usize,
+        ) -> c_int;
+
+        /// Name of the kernel selected by the runtime dispatcher
+        pub fn fht_kernel_name() -> *const c_char;
+
+        /// Time the kernels, thread counts and block splits up to 2^max_log_n
+        pub fn fht_tune(max_log_n: c_int, max_threads: c_int) -> c_int;
+
+        /// Write the tuning results to a text file
+        pub fn fht_wisdom_save(path: *const c_char) -> c_int;
+
+        /// Read tuning results written by fht_wisdom_save
+        pub fn fht_wisdom_load(path: *const c_char) -> c_int;
+
+        /// Drop all tuning results
+        pub fn fht_wisdom_forget();
+
+        /// Kernel used for 2^log_n (is_double 0: f32), tuned or not
+        pub fn fht_tuned_kernel_name(log_n: c_int, is_double: c_int) -> *const c_char;
+
+        /// Turn instrumentation on or off; returns the previous state, -1 if
+        /// compiled out
+        pub fn fht_stats_enable(on: c_int) -> c_int;
+
+        /// Counters of the calling thread, or summed over all threads
+        pub fn fht_stats_snapshot(out: *mut FhtStats, all_threads: c_int) -> c_int;
+
+        /// Zero the calling thread's counters, or everyone's
+        pub fn fht_stats_reset(all_threads: c_int) -> c_int;
+
+        /// Name of an FHT_STATS_* entry point
+        pub fn fht_stats_entry_name(entry: c_int) -> *const c_char;
+    }
+}
+
+/// Set the default thread count of `Fht::fht_inplace_mt` (0: all online CPUs)
+pub fn set_num_threads(nthreads: usize) {
+    unsafe {
+        ffi::fht_set_num_threads(nthreads.min(c_int::MAX as usize) as c_int);
+    }
+}
+
+/// Default thread count of `Fht::fht_inplace_mt`
+pub fn num_threads() -> usize {
+    unsafe { ffi::fht_get_num_threads() as usize }
+}
+
+/// Name of the SIMD kernel the C library selected for this CPU
+/// (e.g. `"avx"`, `"sse"`, `"neon"` or `"sve"`)
+pub fn kernel_name() -> &'static str {
+    // The C side returns a pointer to a static string literal
+    unsafe { CStr::from_ptr(ffi::fht_kernel_name()) }
+        .to_str()
+        .unwrap_or("unknown")
+}
+
+/// Tune the C library for this machine: time every supported kernel for
+/// each size up to 2^`max_log_n`, and from 2^16 the thread count (up to
+/// `max_threads`, 0: all CPUs) of `Fht::fht_inplace_mt` with `nthreads` 0.
+/// Later transforms, and plans built afterwards, use the fastest choices.
+pub fn tune(max_log_n: usize, max_threads: usize) -> FhtResult<()> {
+    if max_log_n == 0 {
+        return Err(FhtError::Unsupported("tune with max_log_n 0"));
+    }
+    if max_log_n > 30 {
+        return Err(FhtError::SizeTooLarge(1usize.checked_shl(max_log_n as u32).unwrap_or(usize::MAX)));
+    }
+    let result = unsafe { ffi::fht_tune(max_log_n as c_int, max_threads.min(c_int::MAX as usize) as c_int) };
+    if result != 0 {
+        return Err(FhtError::InternalError(result));
+    }
+    Ok(())
+}
+
+fn wisdom_path(path: &Path) -> FhtResult<CString> {
+    path.to_str()
+        .and_then(|p| CString::new(p).ok())
+        .ok_or(FhtError::InternalError(-1))
+}
+
+/// Save the `tune` results to `path` (plain text)
+pub fn wisdom_save(path: &Path) -> FhtResult<()> {
+    let path = wisdom_path(path)?;
+    let result = unsafe { ffi::fht_wisdom_save(path.as_ptr()) };
+    if result != 0 {
+        return Err(FhtError::InternalError(result));
+    }
+    Ok(())
+}
+
+/// Load tuning results saved by `wisdom_save`; entries for kernels this CPU
+/// does not support are skipped. Setting `FFHT_WISDOM=<path>` does the same
+/// when the library is loaded.
+pub fn wisdom_load(path: &Path) -> FhtResult<()> {
+    let path = wisdom_path(path)?;
+    let result = unsafe { ffi::fht_wisdom_load(path.as_ptr()) };
+    if result != 0 {
+        return Err(FhtError::InternalError(result));
+    }
+    Ok(())
+}
+
+/// Drop all tuning results, going back to the load-time kernel
+pub fn wisdom_forget() {
+    unsafe { ffi::fht_wisdom_forget() }
+}
+
+fn tuned_kernel_name(log_n: usize, is_double: bool) -> &'static str {
+    // Static string literals, like fht_kernel_name
+    unsafe { CStr::from_ptr(ffi::fht_tuned_kernel_name(log_n as c_int, is_double as c_int)) }
+        .to_str()
+        .unwrap_or("unknown")
+}
+
+/// Histogram bins of `StatsEntry::histogram`: bin `b` counts calls that took
+/// [2^b, 2^(b+1)) ns, the last bin everything longer
+pub const STATS_HIST_BINS: usize = ffi::STATS_HIST_BINS;
+
+/// Instrumentation counters of one element type, entry point and size
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct StatsEntry {
+    /// `"f32"`, `"f64"`, `"f16"`, `"bf16"`, `"i16"`, `"i32"` or `"i64"`
+    pub dtype: &'static str,
+    /// C entry point family: `"inplace"`, `"oop"`, `"batch"`, `"scaled"`,
+    /// `"stream"`, `"mt"`, `"hd"`, `"xor"`, `"reduce"`, `"sparse"`,
+    /// `"ordered"`, `"strided"` or `"file"`
+    pub entry: &'static str,
+    pub log_n: usize,
+    pub calls: u64,
+    /// Size of the buffers transformed (both buffers for out-of-place, both
+    /// spectra of an XOR convolution)
+    pub bytes: u64,
+    pub nanos: u64,
+    pub histogram: [u64; STATS_HIST_BINS],
+    /// Kernel this size runs on now (`"int"` for the integer types)
+    pub kernel: &'static str,
+}
+
+/// Turn the C library's call counters on or off (off by default, or on with
+/// `FFHT_STATS=1`); returns the previous state. `Unsupported` if the library
+/// was built with `FFHT_NO_STATS`.
+pub fn stats_enable(on: bool) -> FhtResult<bool> {
+    match unsafe { ffi::fht_stats_enable(on as c_int) } {
+        -1 => Err(FhtError::Unsupported("stats")),
+        was => Ok(was != 0),
+    }
+}
+
+fn stats_snapshot(all_threads: bool) -> FhtResult<Vec<StatsEntry>> {
+    // About 600 KiB: keep it off the stack. All-zero is a valid FhtStats
+    // (null kernel pointers are overwritten by the snapshot)
+    let mut raw: Box<ffi::FhtStats> = Box::new(unsafe { std::mem::zeroed() });
+    if unsafe { ffi::fht_stats_snapshot(&mut *raw, all_threads as c_int) } != 0 {
+        return Err(FhtError::Unsupported("stats"));
+    }
+    let static_str = |p: *const std::os::raw::c_char| {
+        // Static string literals on the C side
+        unsafe { CStr::from_ptr(p) }.to_str().unwrap_or("unknown")
+    };
+    let mut entries = Vec::new();
+    const DTYPES: [&str; ffi::STATS_NUM_DTYPES] = ["f32", "f64", "f16", "bf16", "i16", "i32", "i64"];
+    for (d, dtype) in DTYPES.iter().enumerate() {
+        for entry in 0..ffi::STATS_NUM_ENTRIES {
+            for log_n in 0..31 {
+                let c = &raw.counters[d][entry][log_n];
+                if c.calls == 0 {
+                    continue;
+                }
+                entries.push(StatsEntry {
+                    dtype: *dtype,
+                    entry: static_str(unsafe { ffi::fht_stats_entry_name(entry as c_int) }),
+                    log_n,
+                    calls: c.calls,
+                    bytes: c.bytes,
+                    nanos: c.ns,
+                    histogram: c.hist,
+                    kernel: static_str(raw.kernel[d][log_n]),
+                });
+            }
+        }
+    }
+    Ok(entries)
+}
+
+/// Counters of every size and entry point that was called, summed over all
+/// threads (including exited ones) since the last `stats_reset`
+pub fn stats() -> FhtResult<Vec<StatsEntry>> {
+    stats_snapshot(true)
+}
+
+/// Like `stats`, for the calling thread only
+pub fn thread_stats() -> FhtResult<Vec<StatsEntry>> {
+    stats_snapshot(false)
+}
+
+/// Zero the counters of all threads
+pub fn stats_reset() {
+    unsafe {
+        ffi::fht_stats_reset(1);
+    }
+}
+
+/// Zero the counters of the calling thread
+pub fn thread_stats_reset() {
+    unsafe {
+        ffi::fht_stats_reset(0);
     }
 }
 
@@ -86,6 +691,171 @@ pub trait Fht: Sized {
 
     /// Perform out-of-place FHT
     fn fht(input: &[Self], output: &mut [Self]) -> FhtResult<()>;
+
+    /// Perform in-place FHT on every consecutive length-`n` chunk of `data`
+    /// with a single FFI call (`data.len()` must be a multiple of `n`)
+    fn fht_batch_inplace(data: &mut [Self], n: usize) -> FhtResult<()>;
+
+    /// Perform in-place FHT on `nthreads` threads of the C worker pool
+    /// (0: the `set_num_threads` default). Pays off from about 2^20 elements.
+    fn fht_inplace_mt(data: &mut [Self], nthreads: usize) -> FhtResult<()>;
+
+    /// Perform in-place FHT and multiply by `scale`; the scale is folded into
+    /// the last butterfly stage, so it costs no extra pass over `data`
+    fn fht_scaled_inplace(data: &mut [Self], scale: Self) -> FhtResult<()>;
+
+    /// Perform in-place FHT scaled by 1/sqrt(n), which is its own inverse
+    fn fht_orthonormal_inplace(data: &mut [Self]) -> FhtResult<()>;
+
+    /// Perform in-place FHT scaled by 1/n, the inverse of `fht_inplace`
+    fn fht_inverse_inplace(data: &mut [Self]) -> FhtResult<()>;
+
+    /// Perform in-place FHT whose last pass uses non-temporal (streaming)
+    /// stores; for large results that will not be read again soon
+    fn fht_stream_inplace(data: &mut [Self]) -> FhtResult<()>;
+
+    /// FHT of `input` into `output` with the coefficients in sequency or
+    /// Paley order (f32, f64). The permutation is applied to the input by a
+    /// cache-blocked gather in place of the out-of-place copy, so it costs
+    /// about as much as `fht`.
+    fn fht_ordered(_input: &[Self], _output: &mut [Self], _order: FhtOrder) -> FhtResult<()> {
+        Err(FhtError::Unsupported("fht_ordered"))
+    }
+
+    /// In-place `fht_ordered`; orders other than natural allocate a
+    /// temporary copy
+    fn fht_ordered_inplace(_data: &mut [Self], _order: FhtOrder) -> FhtResult<()> {
+        Err(FhtError::Unsupported("fht_ordered_inplace"))
+    }
+
+    /// Randomized Hadamard transform (H D_rounds) ... (H D_1) of `data`, the
+    /// rotation of cross-polytope LSH and SRHT (f32, f64). D_r negates the
+    /// elements whose bits are set in round r: `sign_bits` holds `rounds`
+    /// blocks of max(1, n / 64) words, element i at bit i % 64 of word i / 64.
+    /// The flips ride in the transform passes, so a round costs one FHT.
+    fn fht_hd_inplace(_data: &mut [Self], _sign_bits: &[u64], _rounds: usize) -> FhtResult<()> {
+        Err(FhtError::Unsupported("fht_hd_inplace"))
+    }
+
+    /// `fht_hd_inplace` with the same signs on every length-`n` chunk of
+    /// `data`, times `scale` at no extra cost (f32, f64)
+    fn fht_hd_batch_inplace(
+        _data: &mut [Self],
+        _n: usize,
+        _sign_bits: &[u64],
+        _rounds: usize,
+        _scale: Self,
+    ) -> FhtResult<()> {
+        Err(FhtError::Unsupported("fht_hd_batch_inplace"))
+    }
+
+    /// Perform in-place FHT and return the index of the coefficient of
+    /// largest magnitude, picked out while the last butterfly stage writes it
+    /// (f32, f64). Ties go to the lower index, NaNs are never picked, and the
+    /// spectrum stays in `data`; `data[index]` gives the sign of an LSH hash.
+    fn fht_argmax(_data: &mut [Self]) -> FhtResult<usize> {
+        Err(FhtError::Unsupported("fht_argmax"))
+    }
+
+    /// `fht_argmax` of every length-`n` chunk of `data`, one index per chunk
+    fn fht_argmax_batch(_data: &mut [Self], _n: usize) -> FhtResult<Vec<usize>> {
+        Err(FhtError::Unsupported("fht_argmax_batch"))
+    }
+
+    /// Perform in-place FHT and return the indices of the `k` coefficients of
+    /// largest magnitude, largest first (f32, f64); fewer if the spectrum has
+    /// NaNs. `k` is between 1 and `data.len()`.
+    fn fht_topk(_data: &mut [Self], _k: usize) -> FhtResult<Vec<usize>> {
+        Err(FhtError::Unsupported("fht_topk"))
+    }
+
+    /// `fht_topk` of every length-`n` chunk of `data`: `k` indices per chunk,
+    /// chunk by chunk, with `usize::MAX` in the places NaNs leave empty
+    fn fht_topk_batch(_data: &mut [Self], _n: usize, _k: usize) -> FhtResult<Vec<usize>> {
+        Err(FhtError::Unsupported("fht_topk_batch"))
+    }
+
+    /// Perform in-place FHT and write the indices of the coefficients with
+    /// magnitude at least `threshold` to `indices`, in increasing order (the
+    /// lowest ones if there are more than fit); returns how many there are
+    /// (f32, f64)
+    fn fht_threshold(_data: &mut [Self], _threshold: Self, _indices: &mut [usize]) -> FhtResult<usize> {
+        Err(FhtError::Unsupported("fht_threshold"))
+    }
+
+    /// `fht_threshold` of every length-`n` chunk of `data`: chunk v gets an
+    /// equal share of `indices` and its full count in `counts[v]`
+    fn fht_threshold_batch(
+        _data: &mut [Self],
+        _n: usize,
+        _threshold: Self,
+        _indices: &mut [usize],
+        _counts: &mut [usize],
+    ) -> FhtResult<()> {
+        Err(FhtError::Unsupported("fht_threshold_batch"))
+    }
+
+    /// Perform in-place FHT of up to 2^`MAX_LARGE_LOG_N` elements, past the
+    /// 2^30 of `fht_inplace` (f32, f64). Works on any slice, e.g. one over a
+    /// memory-mapped file; `fht_file` needs far fewer passes over the disk.
+    fn fht_large_inplace(_data: &mut [Self]) -> FhtResult<()> {
+        Err(FhtError::Unsupported("fht_large_inplace"))
+    }
+
+    /// Out-of-core FHT of the `len` native-endian elements at byte `offset`
+    /// of `file` (opened for reading and writing), through two tiles that fit
+    /// in `mem_bytes` of RAM (f32, f64). The file is read and written once
+    /// per pass, and I/O overlaps the transform of each tile on `nthreads`
+    /// threads (0: the `set_num_threads` default). On error the file is
+    /// partly transformed.
+    #[cfg(unix)]
+    fn fht_file(_file: &File, _offset: u64, _len: u64, _mem_bytes: usize, _nthreads: usize) -> FhtResult<()> {
+        Err(FhtError::Unsupported("fht_file"))
+    }
+
+    /// Perform in-place FHT along the bit dimensions set in `dim_mask` only
+    /// (bit `s` pairs elements `2^s` apart), in O(n k) for k selected bits.
+    /// Bits at or above log2(n) are an error.
+    fn fht_dims_inplace(_data: &mut [Self], _dim_mask: u32) -> FhtResult<()> {
+        Err(FhtError::Unsupported("fht_dims_inplace"))
+    }
+
+    /// Spectrum of a sparse vector, `values[j]` at `indices[j]` (repeats add
+    /// up), written to all of `out`. Few nonzeros are evaluated directly,
+    /// more skip the butterflies that only see zeros.
+    fn fht_sparse(_indices: &[usize], _values: &[Self], _out: &mut [Self]) -> FhtResult<()> {
+        Err(FhtError::Unsupported("fht_sparse"))
+    }
+
+    /// Only the coefficients `indices[j]` of the transform of `input`, into
+    /// `out[j]`; the butterflies that feed no requested output are skipped.
+    fn fht_select(_input: &[Self], _indices: &[usize], _out: &mut [Self]) -> FhtResult<()> {
+        Err(FhtError::Unsupported("fht_select"))
+    }
+
+    /// XOR (dyadic) convolution: `out[k]` = sum of `a[i] * b[j]` over `i ^ j == k`.
+    /// All slices have the same power-of-2 length; `scratch` is working
+    /// memory that callers in a loop can reuse to avoid allocating.
+    fn xor_convolve(a: &[Self], b: &[Self], out: &mut [Self], scratch: &mut [Self]) -> FhtResult<()>;
+
+    /// XOR convolution that overwrites `a` with the result
+    fn xor_convolve_inplace(a: &mut [Self], b: &[Self], scratch: &mut [Self]) -> FhtResult<()>;
+
+    /// XOR correlation, `out[k]` = sum of `a[i] * b[i ^ k]`; over XOR this is
+    /// the same operation as `xor_convolve`
+    fn xor_correlate(a: &[Self], b: &[Self], out: &mut [Self], scratch: &mut [Self]) -> FhtResult<()> {
+        Self::xor_convolve(a, b, out, scratch)
+    }
+
+    /// XOR convolution of every consecutive length-`n` chunk of `a` and `b`
+    /// in one FFI call; `scratch` needs `n` elements
+    fn xor_convolve_batch(
+        a: &[Self],
+        b: &[Self],
+        out: &mut [Self],
+        scratch: &mut [Self],
+        n: usize,
+    ) -> FhtResult<()>;
 }
 
 impl Fht for f32 {
@@ -120,14 +890,248 @@ impl Fht for f32 {
             Ok(())
         }
     }
-}
 
-impl Fht for f64 {
-    fn fht_inplace(data: &mut [Self]) -> FhtResult<()> {
+    fn fht_batch_inplace(data: &mut [Self], n: usize) -> FhtResult<()> {
+        let log_n = validate_size(n)?;
+        if data.len() % n != 0 {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+
+        let count = data.len() / n;
+        let result = unsafe {
+            ffi::fht_float_batch(data.as_mut_ptr(), log_n as c_int, count, n)
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_inplace_mt(data: &mut [Self], nthreads: usize) -> FhtResult<()> {
         let n = data.len();
         let log_n = validate_size(n)?;
+        let nthreads = nthreads.min(c_int::MAX as usize) as c_int;
 
-        let result = unsafe { ffi::fht_double(data.as_mut_ptr(), log_n as c_int) };
+        let result = unsafe { ffi::fht_float_mt(data.as_mut_ptr(), log_n as c_int, nthreads) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_scaled_inplace(data: &mut [Self], scale: Self) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe { ffi::fht_float_scaled(data.as_mut_ptr(), log_n as c_int, scale) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_orthonormal_inplace(data: &mut [Self]) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe { ffi::fht_float_orthonormal(data.as_mut_ptr(), log_n as c_int) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_inverse_inplace(data: &mut [Self]) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe { ffi::fht_float_inverse(data.as_mut_ptr(), log_n as c_int) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_stream_inplace(data: &mut [Self]) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe { ffi::fht_float_stream(data.as_mut_ptr(), log_n as c_int) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_ordered(input: &[Self], output: &mut [Self], order: FhtOrder) -> FhtResult<()> {
+        if input.len() != output.len() {
+            return Err(FhtError::InvalidSize(output.len()));
+        }
+        let log_n = validate_size(input.len())?;
+
+        let result = unsafe {
+            ffi::fht_float_ordered(input.as_ptr(), output.as_mut_ptr(), log_n as c_int, order as c_int)
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_ordered_inplace(data: &mut [Self], order: FhtOrder) -> FhtResult<()> {
+        let log_n = validate_size(data.len())?;
+
+        let buf = data.as_mut_ptr();
+        let result = unsafe { ffi::fht_float_ordered(buf, buf, log_n as c_int, order as c_int) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_hd_inplace(data: &mut [Self], sign_bits: &[u64], rounds: usize) -> FhtResult<()> {
+        let n = data.len();
+        Self::fht_hd_batch_inplace(data, n, sign_bits, rounds, 1.0)
+    }
+
+    fn fht_hd_batch_inplace(
+        data: &mut [Self],
+        n: usize,
+        sign_bits: &[u64],
+        rounds: usize,
+        scale: Self,
+    ) -> FhtResult<()> {
+        let log_n = validate_size(n)?;
+        if data.len() % n != 0 {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+        let rounds = validate_signs(n, sign_bits, rounds)?;
+
+        let count = data.len() / n;
+        let result = unsafe {
+            ffi::fht_float_hd_batch(data.as_mut_ptr(), log_n as c_int, count, n, sign_bits.as_ptr(), rounds, scale)
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_argmax(data: &mut [Self]) -> FhtResult<usize> {
+        let log_n = validate_size(data.len())?;
+        let mut index = 0usize;
+
+        let result = unsafe { ffi::fht_float_argmax(data.as_mut_ptr(), log_n as c_int, &mut index) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(index)
+        }
+    }
+
+    fn fht_argmax_batch(data: &mut [Self], n: usize) -> FhtResult<Vec<usize>> {
+        let log_n = validate_size(n)?;
+        if data.len() % n != 0 {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+
+        let count = data.len() / n;
+        let mut indices = vec![0usize; count];
+        let result = unsafe {
+            ffi::fht_float_argmax_batch(data.as_mut_ptr(), log_n as c_int, count, n, indices.as_mut_ptr())
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(indices)
+        }
+    }
+
+    fn fht_topk(data: &mut [Self], k: usize) -> FhtResult<Vec<usize>> {
+        let n = data.len();
+        let mut indices = Self::fht_topk_batch(data, n, k)?;
+        indices.retain(|&i| i != usize::MAX);
+        Ok(indices)
+    }
+
+    fn fht_topk_batch(data: &mut [Self], n: usize, k: usize) -> FhtResult<Vec<usize>> {
+        let log_n = validate_size(n)?;
+        if data.len() % n != 0 {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+        if k == 0 || k > n {
+            return Err(FhtError::InvalidSize(k));
+        }
+
+        let count = data.len() / n;
+        let mut indices = vec![0usize; count * k];
+        let result = unsafe {
+            ffi::fht_float_topk_batch(data.as_mut_ptr(), log_n as c_int, count, n, k, indices.as_mut_ptr())
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(indices)
+        }
+    }
+
+    fn fht_threshold(data: &mut [Self], threshold: Self, indices: &mut [usize]) -> FhtResult<usize> {
+        let n = data.len();
+        let mut count = [0usize];
+        Self::fht_threshold_batch(data, n, threshold, indices, &mut count)?;
+        Ok(count[0])
+    }
+
+    fn fht_threshold_batch(
+        data: &mut [Self],
+        n: usize,
+        threshold: Self,
+        indices: &mut [usize],
+        counts: &mut [usize],
+    ) -> FhtResult<()> {
+        let log_n = validate_size(n)?;
+        if data.len() % n != 0 {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+        let count = data.len() / n;
+        if counts.len() != count {
+            return Err(FhtError::InvalidSize(counts.len()));
+        }
+
+        let capacity = if count == 0 { 0 } else { indices.len() / count };
+        let result = unsafe {
+            ffi::fht_float_threshold_batch(
+                data.as_mut_ptr(),
+                log_n as c_int,
+                count,
+                n,
+                threshold,
+                indices.as_mut_ptr(),
+                capacity,
+                counts.as_mut_ptr(),
+            )
+        };
 
         if result != 0 {
             Err(FhtError::InternalError(result))
@@ -136,23 +1140,1397 @@ impl Fht for f64 {
         }
     }
 
-    fn fht(input: &[Self], output: &mut [Self]) -> FhtResult<()> {
-        if input.len() != output.len() {
-            return Err(FhtError::InvalidSize(output.len()));
-        }
+    fn fht_large_inplace(data: &mut [Self]) -> FhtResult<()> {
+        let log_n = validate_large_size(data.len() as u64)?;
+
+        let result = unsafe { ffi::fht_float_large(data.as_mut_ptr(), log_n as c_int) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    #[cfg(unix)]
+    fn fht_file(file: &File, offset: u64, len: u64, mem_bytes: usize, nthreads: usize) -> FhtResult<()> {
+        let log_n = validate_large_size(len)?;
+        let nthreads = nthreads.min(c_int::MAX as usize) as c_int;
+
+        let result =
+            unsafe { ffi::fht_float_file(file.as_raw_fd(), offset, log_n as c_int, mem_bytes, nthreads) };
+
+        file_result(result)
+    }
+
+    fn fht_dims_inplace(data: &mut [Self], dim_mask: u32) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe { ffi::fht_float_dims(data.as_mut_ptr(), log_n as c_int, dim_mask) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_sparse(indices: &[usize], values: &[Self], out: &mut [Self]) -> FhtResult<()> {
+        let log_n = validate_size(out.len())?;
+        if values.len() != indices.len() {
+            return Err(FhtError::InvalidSize(values.len()));
+        }
+
+        let result = unsafe {
+            ffi::fht_float_sparse(indices.as_ptr(), values.as_ptr(), indices.len(), out.as_mut_ptr(), log_n as c_int)
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_select(input: &[Self], indices: &[usize], out: &mut [Self]) -> FhtResult<()> {
+        let log_n = validate_size(input.len())?;
+        if out.len() != indices.len() {
+            return Err(FhtError::InvalidSize(out.len()));
+        }
+
+        let result = unsafe {
+            ffi::fht_float_select(
+                input.as_ptr(),
+                indices.as_ptr(),
+                indices.len(),
+                out.as_mut_ptr(),
+                log_n as c_int,
+                std::ptr::null_mut(),
+            )
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn xor_convolve(a: &[Self], b: &[Self], out: &mut [Self], scratch: &mut [Self]) -> FhtResult<()> {
+        let n = a.len();
+        let log_n = validate_size(n)?;
+        if b.len() != n || out.len() != n || scratch.len() != n {
+            return Err(FhtError::InvalidSize(n));
+        }
+
+        let result = unsafe {
+            ffi::fht_xor_convolve_float(
+                a.as_ptr(),
+                b.as_ptr(),
+                out.as_mut_ptr(),
+                log_n as c_int,
+                scratch.as_mut_ptr(),
+            )
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn xor_convolve_inplace(a: &mut [Self], b: &[Self], scratch: &mut [Self]) -> FhtResult<()> {
+        let n = a.len();
+        let log_n = validate_size(n)?;
+        if b.len() != n || scratch.len() != n {
+            return Err(FhtError::InvalidSize(n));
+        }
+
+        // The C side allows out == a; one pointer serves both, since
+        // as_mut_ptr would invalidate an earlier as_ptr of the same slice
+        let p = a.as_mut_ptr();
+        let result = unsafe {
+            ffi::fht_xor_convolve_float(p as *const _, b.as_ptr(), p, log_n as c_int, scratch.as_mut_ptr())
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn xor_convolve_batch(
+        a: &[Self],
+        b: &[Self],
+        out: &mut [Self],
+        scratch: &mut [Self],
+        n: usize,
+    ) -> FhtResult<()> {
+        let log_n = validate_size(n)?;
+        if a.len() % n != 0 || b.len() != a.len() || out.len() != a.len() {
+            return Err(FhtError::InvalidSize(a.len()));
+        }
+        if scratch.len() < n {
+            return Err(FhtError::InvalidSize(scratch.len()));
+        }
+
+        let count = a.len() / n;
+        let result = unsafe {
+            ffi::fht_xor_convolve_float_batch(
+                a.as_ptr(),
+                b.as_ptr(),
+                out.as_mut_ptr(),
+                log_n as c_int,
+                count,
+                n,
+                scratch.as_mut_ptr(),
+            )
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+}
+
+impl Fht for f64 {
+    fn fht_inplace(data: &mut [Self]) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe { ffi::fht_double(data.as_mut_ptr(), log_n as c_int) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht(input: &[Self], output: &mut [Self]) -> FhtResult<()> {
+        if input.len() != output.len() {
+            return Err(FhtError::InvalidSize(output.len()));
+        }
+
+        let n = input.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe {
+            ffi::fht_double_oop(input.as_ptr(), output.as_mut_ptr(), log_n as c_int)
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_batch_inplace(data: &mut [Self], n: usize) -> FhtResult<()> {
+        let log_n = validate_size(n)?;
+        if data.len() % n != 0 {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+
+        let count = data.len() / n;
+        let result = unsafe {
+            ffi::fht_double_batch(data.as_mut_ptr(), log_n as c_int, count, n)
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_inplace_mt(data: &mut [Self], nthreads: usize) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+        let nthreads = nthreads.min(c_int::MAX as usize) as c_int;
+
+        let result = unsafe { ffi::fht_double_mt(data.as_mut_ptr(), log_n as c_int, nthreads) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_scaled_inplace(data: &mut [Self], scale: Self) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe { ffi::fht_double_scaled(data.as_mut_ptr(), log_n as c_int, scale) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_orthonormal_inplace(data: &mut [Self]) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe { ffi::fht_double_orthonormal(data.as_mut_ptr(), log_n as c_int) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_inverse_inplace(data: &mut [Self]) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe { ffi::fht_double_inverse(data.as_mut_ptr(), log_n as c_int) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_stream_inplace(data: &mut [Self]) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe { ffi::fht_double_stream(data.as_mut_ptr(), log_n as c_int) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_ordered(input: &[Self], output: &mut [Self], order: FhtOrder) -> FhtResult<()> {
+        if input.len() != output.len() {
+            return Err(FhtError::InvalidSize(output.len()));
+        }
+        let log_n = validate_size(input.len())?;
+
+        let result = unsafe {
+            ffi::fht_double_ordered(input.as_ptr(), output.as_mut_ptr(), log_n as c_int, order as c_int)
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_ordered_inplace(data: &mut [Self], order: FhtOrder) -> FhtResult<()> {
+        let log_n = validate_size(data.len())?;
+
+        let buf = data.as_mut_ptr();
+        let result = unsafe { ffi::fht_double_ordered(buf, buf, log_n as c_int, order as c_int) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_hd_inplace(data: &mut [Self], sign_bits: &[u64], rounds: usize) -> FhtResult<()> {
+        let n = data.len();
+        Self::fht_hd_batch_inplace(data, n, sign_bits, rounds, 1.0)
+    }
+
+    fn fht_hd_batch_inplace(
+        data: &mut [Self],
+        n: usize,
+        sign_bits: &[u64],
+        rounds: usize,
+        scale: Self,
+    ) -> FhtResult<()> {
+        let log_n = validate_size(n)?;
+        if data.len() % n != 0 {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+        let rounds = validate_signs(n, sign_bits, rounds)?;
+
+        let count = data.len() / n;
+        let result = unsafe {
+            ffi::fht_double_hd_batch(data.as_mut_ptr(), log_n as c_int, count, n, sign_bits.as_ptr(), rounds, scale)
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_argmax(data: &mut [Self]) -> FhtResult<usize> {
+        let log_n = validate_size(data.len())?;
+        let mut index = 0usize;
+
+        let result = unsafe { ffi::fht_double_argmax(data.as_mut_ptr(), log_n as c_int, &mut index) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(index)
+        }
+    }
+
+    fn fht_argmax_batch(data: &mut [Self], n: usize) -> FhtResult<Vec<usize>> {
+        let log_n = validate_size(n)?;
+        if data.len() % n != 0 {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+
+        let count = data.len() / n;
+        let mut indices = vec![0usize; count];
+        let result = unsafe {
+            ffi::fht_double_argmax_batch(data.as_mut_ptr(), log_n as c_int, count, n, indices.as_mut_ptr())
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(indices)
+        }
+    }
+
+    fn fht_topk(data: &mut [Self], k: usize) -> FhtResult<Vec<usize>> {
+        let n = data.len();
+        let mut indices = Self::fht_topk_batch(data, n, k)?;
+        indices.retain(|&i| i != usize::MAX);
+        Ok(indices)
+    }
+
+    fn fht_topk_batch(data: &mut [Self], n: usize, k: usize) -> FhtResult<Vec<usize>> {
+        let log_n = validate_size(n)?;
+        if data.len() % n != 0 {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+        if k == 0 || k > n {
+            return Err(FhtError::InvalidSize(k));
+        }
+
+        let count = data.len() / n;
+        let mut indices = vec![0usize; count * k];
+        let result = unsafe {
+            ffi::fht_double_topk_batch(data.as_mut_ptr(), log_n as c_int, count, n, k, indices.as_mut_ptr())
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(indices)
+        }
+    }
+
+    fn fht_threshold(data: &mut [Self], threshold: Self, indices: &mut [usize]) -> FhtResult<usize> {
+        let n = data.len();
+        let mut count = [0usize];
+        Self::fht_threshold_batch(data, n, threshold, indices, &mut count)?;
+        Ok(count[0])
+    }
+
+    fn fht_threshold_batch(
+        data: &mut [Self],
+        n: usize,
+        threshold: Self,
+        indices: &mut [usize],
+        counts: &mut [usize],
+    ) -> FhtResult<()> {
+        let log_n = validate_size(n)?;
+        if data.len() % n != 0 {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+        let count = data.len() / n;
+        if counts.len() != count {
+            return Err(FhtError::InvalidSize(counts.len()));
+        }
+
+        let capacity = if count == 0 { 0 } else { indices.len() / count };
+        let result = unsafe {
+            ffi::fht_double_threshold_batch(
+                data.as_mut_ptr(),
+                log_n as c_int,
+                count,
+                n,
+                threshold,
+                indices.as_mut_ptr(),
+                capacity,
+                counts.as_mut_ptr(),
+            )
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_large_inplace(data: &mut [Self]) -> FhtResult<()> {
+        let log_n = validate_large_size(data.len() as u64)?;
+
+        let result = unsafe { ffi::fht_double_large(data.as_mut_ptr(), log_n as c_int) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    #[cfg(unix)]
+    fn fht_file(file: &File, offset: u64, len: u64, mem_bytes: usize, nthreads: usize) -> FhtResult<()> {
+        let log_n = validate_large_size(len)?;
+        let nthreads = nthreads.min(c_int::MAX as usize) as c_int;
+
+        let result =
+            unsafe { ffi::fht_double_file(file.as_raw_fd(), offset, log_n as c_int, mem_bytes, nthreads) };
+
+        file_result(result)
+    }
+
+    fn fht_dims_inplace(data: &mut [Self], dim_mask: u32) -> FhtResult<()> {
+        let n = data.len();
+        let log_n = validate_size(n)?;
+
+        let result = unsafe { ffi::fht_double_dims(data.as_mut_ptr(), log_n as c_int, dim_mask) };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_sparse(indices: &[usize], values: &[Self], out: &mut [Self]) -> FhtResult<()> {
+        let log_n = validate_size(out.len())?;
+        if values.len() != indices.len() {
+            return Err(FhtError::InvalidSize(values.len()));
+        }
+
+        let result = unsafe {
+            ffi::fht_double_sparse(indices.as_ptr(), values.as_ptr(), indices.len(), out.as_mut_ptr(), log_n as c_int)
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn fht_select(input: &[Self], indices: &[usize], out: &mut [Self]) -> FhtResult<()> {
+        let log_n = validate_size(input.len())?;
+        if out.len() != indices.len() {
+            return Err(FhtError::InvalidSize(out.len()));
+        }
+
+        let result = unsafe {
+            ffi::fht_double_select(
+                input.as_ptr(),
+                indices.as_ptr(),
+                indices.len(),
+                out.as_mut_ptr(),
+                log_n as c_int,
+                std::ptr::null_mut(),
+            )
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn xor_convolve(a: &[Self], b: &[Self], out: &mut [Self], scratch: &mut [Self]) -> FhtResult<()> {
+        let n = a.len();
+        let log_n = validate_size(n)?;
+        if b.len() != n || out.len() != n || scratch.len() != n {
+            return Err(FhtError::InvalidSize(n));
+        }
+
+        let result = unsafe {
+            ffi::fht_xor_convolve_double(
+                a.as_ptr(),
+                b.as_ptr(),
+                out.as_mut_ptr(),
+                log_n as c_int,
+                scratch.as_mut_ptr(),
+            )
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn xor_convolve_inplace(a: &mut [Self], b: &[Self], scratch: &mut [Self]) -> FhtResult<()> {
+        let n = a.len();
+        let log_n = validate_size(n)?;
+        if b.len() != n || scratch.len() != n {
+            return Err(FhtError::InvalidSize(n));
+        }
+
+        // The C side allows out == a; one pointer serves both, since
+        // as_mut_ptr would invalidate an earlier as_ptr of the same slice
+        let p = a.as_mut_ptr();
+        let result = unsafe {
+            ffi::fht_xor_convolve_double(p as *const _, b.as_ptr(), p, log_n as c_int, scratch.as_mut_ptr())
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    fn xor_convolve_batch(
+        a: &[Self],
+        b: &[Self],
+        out: &mut [Self],
+        scratch: &mut [Self],
+        n: usize,
+    ) -> FhtResult<()> {
+        let log_n = validate_size(n)?;
+        if a.len() % n != 0 || b.len() != a.len() || out.len() != a.len() {
+            return Err(FhtError::InvalidSize(a.len()));
+        }
+        if scratch.len() < n {
+            return Err(FhtError::InvalidSize(scratch.len()));
+        }
+
+        let count = a.len() / n;
+        let result = unsafe {
+            ffi::fht_xor_convolve_double_batch(
+                a.as_ptr(),
+                b.as_ptr(),
+                out.as_mut_ptr(),
+                log_n as c_int,
+                count,
+                n,
+                scratch.as_mut_ptr(),
+            )
+        };
+
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+}
+
+/// Exact integer transforms. These run the C integer kernels on the calling
+/// thread; the scaled, inverse and XOR convolution methods are built from
+/// them with wrapping integer arithmetic (the inverse divides exactly, since
+/// every entry of a transformed vector is a multiple of n). An orthonormal
+/// transform has no integer form and returns `FhtError::Unsupported`, as does
+/// the partial `fht_dims_inplace`.
+macro_rules! impl_fht_int {
+    ($t:ty, $fht:ident) => {
+        impl Fht for $t {
+            fn fht_inplace(data: &mut [Self]) -> FhtResult<()> {
+                let n = data.len();
+                let log_n = validate_size(n)?;
+
+                let result = unsafe { ffi::$fht(data.as_mut_ptr(), log_n as c_int) };
+
+                match result {
+                    0 => Ok(()),
+                    1 => Err(FhtError::Overflow),
+                    code => Err(FhtError::InternalError(code)),
+                }
+            }
+
+            fn fht(input: &[Self], output: &mut [Self]) -> FhtResult<()> {
+                if input.len() != output.len() {
+                    return Err(FhtError::InvalidSize(output.len()));
+                }
+                output.copy_from_slice(input);
+                Self::fht_inplace(output)
+            }
+
+            fn fht_batch_inplace(data: &mut [Self], n: usize) -> FhtResult<()> {
+                validate_size(n)?;
+                if data.len() % n != 0 {
+                    return Err(FhtError::InvalidSize(data.len()));
+                }
+                data.chunks_exact_mut(n).try_for_each(Self::fht_inplace)
+            }
+
+            fn fht_inplace_mt(data: &mut [Self], _nthreads: usize) -> FhtResult<()> {
+                Self::fht_inplace(data)
+            }
+
+            fn fht_scaled_inplace(data: &mut [Self], scale: Self) -> FhtResult<()> {
+                Self::fht_inplace(data)?;
+                data.iter_mut().for_each(|x| *x = x.wrapping_mul(scale));
+                Ok(())
+            }
+
+            fn fht_orthonormal_inplace(_data: &mut [Self]) -> FhtResult<()> {
+                Err(FhtError::Unsupported("fht_orthonormal_inplace"))
+            }
+
+            fn fht_inverse_inplace(data: &mut [Self]) -> FhtResult<()> {
+                let n = data.len() as i64;
+                Self::fht_inplace(data)?;
+                data.iter_mut().for_each(|x| *x = (*x as i64 / n) as $t);
+                Ok(())
+            }
+
+            fn fht_stream_inplace(data: &mut [Self]) -> FhtResult<()> {
+                Self::fht_inplace(data)
+            }
+
+            fn xor_convolve(a: &[Self], b: &[Self], out: &mut [Self], scratch: &mut [Self]) -> FhtResult<()> {
+                if out.len() != a.len() {
+                    return Err(FhtError::InvalidSize(out.len()));
+                }
+                out.copy_from_slice(a);
+                Self::xor_convolve_inplace(out, b, scratch)
+            }
+
+            fn xor_convolve_inplace(a: &mut [Self], b: &[Self], scratch: &mut [Self]) -> FhtResult<()> {
+                let n = a.len();
+                validate_size(n)?;
+                if b.len() != n || scratch.len() != n {
+                    return Err(FhtError::InvalidSize(n));
+                }
+
+                scratch.copy_from_slice(b);
+                Self::fht_inplace(a)?;
+                Self::fht_inplace(scratch)?;
+                a.iter_mut().zip(scratch.iter()).for_each(|(x, &y)| *x = x.wrapping_mul(y));
+                Self::fht_inverse_inplace(a)
+            }
+
+            fn xor_convolve_batch(
+                a: &[Self],
+                b: &[Self],
+                out: &mut [Self],
+                scratch: &mut [Self],
+                n: usize,
+            ) -> FhtResult<()> {
+                validate_size(n)?;
+                if a.len() % n != 0 || b.len() != a.len() || out.len() != a.len() {
+                    return Err(FhtError::InvalidSize(a.len()));
+                }
+                if scratch.len() < n {
+                    return Err(FhtError::InvalidSize(scratch.len()));
+                }
+
+                let scratch = &mut scratch[..n];
+                for ((x, y), z) in a.chunks_exact(n).zip(b.chunks_exact(n)).zip(out.chunks_exact_mut(n)) {
+                    Self::xor_convolve(x, y, z, scratch)?;
+                }
+                Ok(())
+            }
+        }
+    };
+}
+
+impl_fht_int!(i16, fht_int16);
+impl_fht_int!(i32, fht_int32);
+impl_fht_int!(i64, fht_int64);
+
+/// `Fht` for the 16-bit float types of the `half` crate (feature `half`)
+///
+/// The plain transforms run in C on the 16-bit data, with fp32 arithmetic and
+/// one rounding per cache-sized pass. The scaled, orthonormal, inverse, partial
+/// (`fht_dims_inplace`) and XOR convolution methods widen to an `f32` copy, run the `f32` method on it and
+/// round once on the way back; `scratch` is only checked for its length.
+#[cfg(feature = "half")]
+macro_rules! impl_fht_half {
+    ($t:ty, $fht:ident) => {
+        impl Fht for $t {
+            fn fht_inplace(data: &mut [Self]) -> FhtResult<()> {
+                let n = data.len();
+                let log_n = validate_size(n)?;
+
+                // Both types are repr(transparent) over their u16 bits
+                let result = unsafe { ffi::$fht(data.as_mut_ptr() as *mut u16, log_n as c_int) };
+
+                if result == 0 {
+                    Ok(())
+                } else {
+                    Err(FhtError::InternalError(result))
+                }
+            }
+
+            fn fht(input: &[Self], output: &mut [Self]) -> FhtResult<()> {
+                if input.len() != output.len() {
+                    return Err(FhtError::InvalidSize(output.len()));
+                }
+                output.copy_from_slice(input);
+                Self::fht_inplace(output)
+            }
+
+            fn fht_batch_inplace(data: &mut [Self], n: usize) -> FhtResult<()> {
+                validate_size(n)?;
+                if data.len() % n != 0 {
+                    return Err(FhtError::InvalidSize(data.len()));
+                }
+                data.chunks_exact_mut(n).try_for_each(Self::fht_inplace)
+            }
+
+            fn fht_inplace_mt(data: &mut [Self], _nthreads: usize) -> FhtResult<()> {
+                Self::fht_inplace(data)
+            }
+
+            fn fht_scaled_inplace(data: &mut [Self], scale: Self) -> FhtResult<()> {
+                let scale = scale.to_f32();
+                Self::via_f32(data, |x| f32::fht_scaled_inplace(x, scale))
+            }
+
+            fn fht_orthonormal_inplace(data: &mut [Self]) -> FhtResult<()> {
+                Self::via_f32(data, f32::fht_orthonormal_inplace)
+            }
+
+            fn fht_inverse_inplace(data: &mut [Self]) -> FhtResult<()> {
+                Self::via_f32(data, f32::fht_inverse_inplace)
+            }
+
+            fn fht_stream_inplace(data: &mut [Self]) -> FhtResult<()> {
+                Self::fht_inplace(data)
+            }
+
+            fn fht_dims_inplace(data: &mut [Self], dim_mask: u32) -> FhtResult<()> {
+                Self::via_f32(data, |x| f32::fht_dims_inplace(x, dim_mask))
+            }
+
+            fn xor_convolve(a: &[Self], b: &[Self], out: &mut [Self], scratch: &mut [Self]) -> FhtResult<()> {
+                if out.len() != a.len() {
+                    return Err(FhtError::InvalidSize(out.len()));
+                }
+                out.copy_from_slice(a);
+                Self::xor_convolve_inplace(out, b, scratch)
+            }
+
+            fn xor_convolve_inplace(a: &mut [Self], b: &[Self], scratch: &mut [Self]) -> FhtResult<()> {
+                let n = a.len();
+                if b.len() != n || scratch.len() != n {
+                    return Err(FhtError::InvalidSize(n));
+                }
+                let b: Vec<f32> = b.iter().map(|x| x.to_f32()).collect();
+                let mut tmp = vec![0.0f32; n];
+                Self::via_f32(a, |x| f32::xor_convolve_inplace(x, &b, &mut tmp))
+            }
+
+            fn xor_convolve_batch(
+                a: &[Self],
+                b: &[Self],
+                out: &mut [Self],
+                scratch: &mut [Self],
+                n: usize,
+            ) -> FhtResult<()> {
+                validate_size(n)?;
+                if a.len() % n != 0 || b.len() != a.len() || out.len() != a.len() {
+                    return Err(FhtError::InvalidSize(a.len()));
+                }
+                if scratch.len() < n {
+                    return Err(FhtError::InvalidSize(scratch.len()));
+                }
+
+                let scratch = &mut scratch[..n];
+                for ((x, y), z) in a.chunks_exact(n).zip(b.chunks_exact(n)).zip(out.chunks_exact_mut(n)) {
+                    Self::xor_convolve(x, y, z, scratch)?;
+                }
+                Ok(())
+            }
+        }
+
+        impl HalfFloat for $t {
+            fn via_f32<F>(data: &mut [Self], f: F) -> FhtResult<()>
+            where
+                F: FnOnce(&mut [f32]) -> FhtResult<()>,
+            {
+                let mut wide: Vec<f32> = data.iter().map(|x| x.to_f32()).collect();
+                f(&mut wide)?;
+                data.iter_mut().zip(wide.iter()).for_each(|(x, &y)| *x = <$t>::from_f32(y));
+                Ok(())
+            }
+        }
+    };
+}
+
+/// Round trip of a 16-bit float slice through fp32
+#[cfg(feature = "half")]
+trait HalfFloat: Sized {
+    fn via_f32<F>(data: &mut [Self], f: F) -> FhtResult<()>
+    where
+        F: FnOnce(&mut [f32]) -> FhtResult<()>;
+}
+
+#[cfg(feature = "half")]
+impl_fht_half!(half::f16, fht_half);
+#[cfg(feature = "half")]
+impl_fht_half!(half::bf16, fht_bf16);
+
+/// Parallel transforms on the current rayon thread pool (feature `rayon`)
+///
+/// The contiguous blocks are transformed as independent rayon tasks, then the
+/// cross-block butterfly stages run as tasks over disjoint offset ranges
+/// (`fht_*_combine_blocks` in the C library).
+#[cfg(feature = "rayon")]
+pub trait FhtPar: Fht + Send + Sync {
+    /// Perform in-place FHT using the rayon pool the caller runs in
+    fn fht_inplace_par(data: &mut [Self]) -> FhtResult<()>;
+}
+
+#[cfg(feature = "rayon")]
+impl FhtPar for f32 {
+    fn fht_inplace_par(data: &mut [Self]) -> FhtResult<()> {
+        fht_inplace_par_impl(data, ffi::fht_float_combine_blocks)
+    }
+}
+
+#[cfg(feature = "rayon")]
+impl FhtPar for f64 {
+    fn fht_inplace_par(data: &mut [Self]) -> FhtResult<()> {
+        fht_inplace_par_impl(data, ffi::fht_double_combine_blocks)
+    }
+}
+
+/// Raw pointer that may be shared with rayon tasks touching disjoint elements
+#[cfg(feature = "rayon")]
+struct SendPtr<T>(*mut T);
+
+#[cfg(feature = "rayon")]
+unsafe impl<T> Send for SendPtr<T> {}
+
+#[cfg(feature = "rayon")]
+unsafe impl<T> Sync for SendPtr<T> {}
+
+#[cfg(feature = "rayon")]
+impl<T> SendPtr<T> {
+    fn get(&self) -> *mut T {
+        self.0
+    }
+}
+
+#[cfg(feature = "rayon")]
+type CombineFn<T> = unsafe extern "C" fn(*mut T, c_int, c_int, usize, usize) -> c_int;
+
+#[cfg(feature = "rayon")]
+fn fht_inplace_par_impl<T: Fht + Send + Sync>(
+    data: &mut [T],
+    combine: CombineFn<T>,
+) -> FhtResult<()> {
+    use rayon::prelude::*;
+
+    // Same policy as fht_mt.c: about four blocks per thread, 2^12 or larger
+    const MIN_LOG_BLOCK: usize = 12;
+
+    let n = data.len();
+    let log_n = validate_size(n)?;
+    let threads = rayon::current_num_threads();
+    let mut log_blocks = (threads * 4).next_power_of_two().trailing_zeros() as usize;
+    log_blocks = log_blocks.min(log_n.saturating_sub(MIN_LOG_BLOCK));
+    if threads <= 1 || log_blocks == 0 {
+        return T::fht_inplace(data);
+    }
+
+    let blk = n >> log_blocks;
+    data.par_chunks_mut(blk).try_for_each(|block| T::fht_inplace(block))?;
+
+    // Offset ranges rounded to whole cache lines
+    let ranges = threads * 4;
+    let ptr = SendPtr(data.as_mut_ptr());
+    (0..ranges).into_par_iter().try_for_each(|r| {
+        let begin = (blk * r / ranges) & !15;
+        let end = if r + 1 == ranges { blk } else { (blk * (r + 1) / ranges) & !15 };
+        let result = unsafe { combine(ptr.get(), log_n as c_int, log_blocks as c_int, begin, end) };
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    })
+}
+
+type OopFn<T> = unsafe extern "C" fn(*const T, *mut T, c_int) -> c_int;
+
+/// Out-of-place transform of every length-`n` chunk of `input` into a new
+/// vector. The C side writes every output element, so the output is never
+/// zero-filled or copied first.
+fn fht_oop_new<T: Copy>(input: &[T], n: usize, oop: OopFn<T>) -> FhtResult<Vec<T>> {
+    let log_n = validate_size(n)?;
+    if input.len() % n != 0 {
+        return Err(FhtError::InvalidSize(input.len()));
+    }
+
+    let mut output: Vec<T> = Vec::with_capacity(input.len());
+    for (row, chunk) in input.chunks_exact(n).enumerate() {
+        let result = unsafe { oop(chunk.as_ptr(), output.as_mut_ptr().add(row * n), log_n as c_int) };
+        if result != 0 {
+            return Err(FhtError::InternalError(result));
+        }
+    }
+    unsafe { output.set_len(input.len()) };
+    Ok(output)
+}
+
+/// Out-of-place transform of every length-`n` chunk of `input` into the
+/// matching chunk of `output`
+fn fht_oop_into<T>(input: &[T], output: &mut [T], n: usize, oop: OopFn<T>) -> FhtResult<()> {
+    let log_n = validate_size(n)?;
+    if input.len() % n != 0 || output.len() != input.len() {
+        return Err(FhtError::InvalidSize(output.len()));
+    }
+
+    for (x, y) in input.chunks_exact(n).zip(output.chunks_exact_mut(n)) {
+        let result = unsafe { oop(x.as_ptr(), y.as_mut_ptr(), log_n as c_int) };
+        if result != 0 {
+            return Err(FhtError::InternalError(result));
+        }
+    }
+    Ok(())
+}
+
+type ScaledBatchFn<T> = unsafe extern "C" fn(*mut T, c_int, usize, usize, T) -> c_int;
+
+/// Transform every length-`n` chunk of `data`, multiplied by `scale`, in one
+/// batched call
+fn fht_scaled_batch<T>(data: &mut [T], n: usize, scale: T, batch: ScaledBatchFn<T>) -> FhtResult<()> {
+    let log_n = validate_size(n)?;
+    if data.len() % n != 0 {
+        return Err(FhtError::InvalidSize(data.len()));
+    }
+
+    let result = unsafe { batch(data.as_mut_ptr(), log_n as c_int, data.len() / n, n, scale) };
+    if result != 0 {
+        Err(FhtError::InternalError(result))
+    } else {
+        Ok(())
+    }
+}
+
+/// The elements of an array in standard layout (`as_slice`/`as_slice_mut`)
+fn contiguous<S>(slice: Option<S>) -> FhtResult<S> {
+    slice.ok_or(FhtError::NonContiguous)
+}
+
+type StridedFn<T> = unsafe extern "C" fn(*mut T, c_int, usize, usize, usize) -> c_int;
+
+/// Transform every lane along `axis` of the elements at `ptr` with the given
+/// shape and strides (in elements, as ndarray reports them).
+///
+/// The other axis with the smallest stride is handed to the C side as the
+/// batch, so lanes interleaved in memory are transformed together; the
+/// remaining axes are looped over here. Batch axes with negative strides are
+/// walked from their last element. A reversed `axis` itself is gathered
+/// lane by lane, since reversing a vector does not commute with the
+/// transform.
+///
+/// Safety: `ptr`, `shape` and `strides` must describe elements that are valid
+/// for writes and distinct, as in a mutable ndarray view.
+unsafe fn fht_axis_raw<T: Fht + Copy>(
+    ptr: *mut T,
+    shape: &[usize],
+    strides: &[isize],
+    axis: usize,
+    strided: StridedFn<T>,
+) -> FhtResult<()> {
+    assert!(axis < shape.len(), "axis {} out of bounds for {} dimensions", axis, shape.len());
+    let n = shape[axis];
+    let log_n = validate_size(n)?;
+    if shape.contains(&0) {
+        return Ok(());
+    }
+
+    // Other axes as (len, positive stride); sorted by decreasing stride, so
+    // the smallest one is popped as the batch
+    let mut base = ptr;
+    let mut others: Vec<(usize, usize)> = Vec::with_capacity(shape.len());
+    for (k, (&len, &stride)) in shape.iter().zip(strides.iter()).enumerate() {
+        if k == axis || len == 1 {
+            continue;
+        }
+        if stride < 0 {
+            base = base.offset(stride * (len as isize - 1));
+        }
+        others.push((len, stride.unsigned_abs()));
+    }
+    others.sort_by(|a, b| b.1.cmp(&a.1));
+    let (count, batch_stride) = others.pop().unwrap_or((1, 0));
+
+    let axis_stride = strides[axis];
+    let mut index = vec![0usize; others.len()];
+    loop {
+        let offset: usize = index.iter().zip(others.iter()).map(|(&i, &(_, stride))| i * stride).sum();
+        let first = base.add(offset);
+        if axis_stride >= 0 || n == 1 {
+            let result = strided(first, log_n as c_int, axis_stride as usize, count, batch_stride);
+            if result != 0 {
+                return Err(FhtError::InternalError(result));
+            }
+        } else {
+            let mut lane: Vec<T> = Vec::with_capacity(n);
+            for j in 0..count {
+                let start = first.add(j * batch_stride);
+                lane.clear();
+                lane.extend((0..n).map(|i| *start.offset(i as isize * axis_stride)));
+                T::fht_inplace(&mut lane)?;
+                for (i, &x) in lane.iter().enumerate() {
+                    *start.offset(i as isize * axis_stride) = x;
+                }
+            }
+        }
+
+        // Odometer over the remaining axes
+        let mut k = 0;
+        while k < index.len() {
+            index[k] += 1;
+            if index[k] < others[k].0 {
+                break;
+            }
+            index[k] = 0;
+            k += 1;
+        }
+        if k == index.len() {
+            return Ok(());
+        }
+    }
+}
+
+macro_rules! impl_fht_axis {
+    ($view:ident, $t:ty, $strided:ident) => {
+        impl<'a> FhtAxis for $view<'a, $t> {
+            fn fht_axis_inplace(&mut self, axis: Axis) -> FhtResult<()> {
+                let ptr = self.as_mut_ptr();
+                // A mutable view owns its elements exclusively, none alias
+                unsafe { fht_axis_raw(ptr, self.shape(), self.strides(), axis.index(), ffi::$strided) }
+            }
+        }
+    };
+}
+
+impl_fht_axis!(ArrayViewMut2, f32, fht_float_strided);
+impl_fht_axis!(ArrayViewMut2, f64, fht_double_strided);
+impl_fht_axis!(ArrayViewMutD, f32, fht_float_strided);
+impl_fht_axis!(ArrayViewMutD, f64, fht_double_strided);
+
+type InplaceFn<T> = unsafe extern "C" fn(*mut T, c_int) -> c_int;
+type MtFn<T> = unsafe extern "C" fn(*mut T, c_int, c_int) -> c_int;
+type BatchFn<T> = unsafe extern "C" fn(*mut T, c_int, usize, usize) -> c_int;
+type BatchMtFn<T> = unsafe extern "C" fn(*mut T, c_int, usize, usize, c_int) -> c_int;
+type XorFn<T> = unsafe extern "C" fn(*const T, *const T, *mut T, c_int, *mut T) -> c_int;
+type UpdateFn<T> = unsafe extern "C" fn(*mut T, c_int, *const usize, *const T, usize, *mut T) -> c_int;
+
+/// The C entry points a plan calls, resolved once in `FhtPlan::new`
+struct PlanFns<T> {
+    inplace: InplaceFn<T>,
+    mt: MtFn<T>,
+    oop: OopFn<T>,
+    batch: BatchFn<T>,
+    batch_mt: BatchMtFn<T>,
+    xor: XorFn<T>,
+    update: UpdateFn<T>,
+}
+
+/// Alignment of the plan's scratch buffer (one cache line)
+const PLAN_ALIGN: usize = 64;
+
+/// A transform of one size, set up once and executed many times
+///
+/// The size is validated and the C entry points picked when the plan is
+/// built, so the `execute*` calls only check slice lengths before going
+/// straight to the kernel. Only `execute_xor_convolve` and `execute_update`
+/// need a scratch buffer of `len()` elements; it is allocated on the first
+/// such call and reused after that. A plan can also fix a batch
+/// count, a thread count for the C worker threads, and (feature `rayon`) a
+/// rayon pool that `execute_batch` spreads the batch over.
+///
+/// ```rust
+/// use ffht::FhtPlan;
+///
+/// let plan = FhtPlan::<f32>::new(8).unwrap().with_batch(2);
+/// let mut data = vec![1.0f32; 16];
+/// plan.execute_batch(&mut data).unwrap();
+/// assert_eq!(data[0], 8.0);
+/// ```
+pub struct FhtPlan<T> {
+    n: usize,
+    log_n: c_int,
+    batch: usize,
+    threads: c_int,
+    kernel: &'static str,
+    scratch: Vec<T>,
+    scratch_offset: usize,
+    #[cfg(feature = "rayon")]
+    pool: Option<rayon::ThreadPool>,
+    fns: PlanFns<T>,
+}
+
+impl<T: Copy + Default + Send + Sync> FhtPlan<T> {
+    fn with_fns(n: usize, is_double: bool, fns: PlanFns<T>) -> FhtResult<Self> {
+        let log_n = validate_size(n)?;
+        Ok(FhtPlan {
+            n,
+            log_n: log_n as c_int,
+            batch: 1,
+            threads: 1,
+            kernel: tuned_kernel_name(log_n, is_double),
+            scratch: Vec::new(),
+            scratch_offset: 0,
+            #[cfg(feature = "rayon")]
+            pool: None,
+            fns,
+        })
+    }
+
+    /// Set the number of vectors `execute_batch` transforms
+    pub fn with_batch(mut self, count: usize) -> Self {
+        self.batch = count;
+        self
+    }
+
+    /// Run `execute` and `execute_batch` on `nthreads` C worker threads
+    /// (0: the `set_num_threads` default; 1, the default, is the calling
+    /// thread only)
+    pub fn with_threads(mut self, nthreads: usize) -> Self {
+        self.threads = if nthreads == 0 { 0 } else { nthreads.min(c_int::MAX as usize) as c_int };
+        self
+    }
+
+    /// Spread `execute_batch` over a rayon pool of `nthreads` threads owned
+    /// by the plan, instead of the C worker threads
+    #[cfg(feature = "rayon")]
+    pub fn with_rayon_threads(mut self, nthreads: usize) -> FhtResult<Self> {
+        let pool = rayon::ThreadPoolBuilder::new()
+            .num_threads(nthreads)
+            .build()
+            .map_err(|_| FhtError::InternalError(-1))?;
+        self.pool = Some(pool);
+        Ok(self)
+    }
+
+    /// Transform length
+    pub fn len(&self) -> usize {
+        self.n
+    }
+
+    /// Always false: plans are at least one element long
+    pub fn is_empty(&self) -> bool {
+        false
+    }
+
+    /// Number of vectors `execute_batch` expects
+    pub fn batch(&self) -> usize {
+        self.batch
+    }
+
+    /// SIMD kernel that ran this size when the plan was built (the tuned
+    /// one after `tune` or `wisdom_load`)
+    pub fn kernel_name(&self) -> &'static str {
+        self.kernel
+    }
+
+    /// The cache-line aligned scratch slice of `len()` elements, allocated
+    /// on the first call that needs it
+    fn scratch(&mut self) -> &mut [T] {
+        if self.scratch.is_empty() {
+            // Over-allocate by a cache line so that the slice can start on
+            // one; the Vec is never resized again, so the offset stays valid
+            let extra = PLAN_ALIGN / std::mem::size_of::<T>();
+            self.scratch = vec![T::default(); self.n + extra];
+            let misalign = self.scratch.as_ptr() as usize % PLAN_ALIGN;
+            self.scratch_offset = ((PLAN_ALIGN - misalign) % PLAN_ALIGN) / std::mem::size_of::<T>();
+        }
+        &mut self.scratch[self.scratch_offset..self.scratch_offset + self.n]
+    }
+
+    fn check(result: c_int) -> FhtResult<()> {
+        if result != 0 {
+            Err(FhtError::InternalError(result))
+        } else {
+            Ok(())
+        }
+    }
+
+    /// In-place transform of `data` (`len()` elements)
+    pub fn execute(&self, data: &mut [T]) -> FhtResult<()> {
+        if data.len() != self.n {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+        let result = unsafe {
+            if self.threads == 1 {
+                (self.fns.inplace)(data.as_mut_ptr(), self.log_n)
+            } else {
+                (self.fns.mt)(data.as_mut_ptr(), self.log_n, self.threads)
+            }
+        };
+        Self::check(result)
+    }
+
+    /// Out-of-place transform of `input` into `output`, which may hold
+    /// anything: every element is written
+    pub fn execute_oop(&self, input: &[T], output: &mut [T]) -> FhtResult<()> {
+        if input.len() != self.n || output.len() != self.n {
+            return Err(FhtError::InvalidSize(output.len()));
+        }
+        Self::check(unsafe { (self.fns.oop)(input.as_ptr(), output.as_mut_ptr(), self.log_n) })
+    }
+
+    /// In-place transform of `batch()` consecutive vectors of `len()`
+    pub fn execute_batch(&self, data: &mut [T]) -> FhtResult<()> {
+        if data.len() != self.n * self.batch {
+            return Err(FhtError::InvalidSize(data.len()));
+        }
+        #[cfg(feature = "rayon")]
+        if let Some(pool) = &self.pool {
+            use rayon::prelude::*;
+
+            // About four chunks of whole vectors per thread
+            let per_chunk = (self.batch / (pool.current_num_threads() * 4)).max(1);
+            let (batch, log_n, n) = (self.fns.batch, self.log_n, self.n);
+            return pool.install(|| {
+                data.par_chunks_mut(per_chunk * n).try_for_each(|chunk| {
+                    Self::check(unsafe { batch(chunk.as_mut_ptr(), log_n, chunk.len() / n, n) })
+                })
+            });
+        }
+        let result = unsafe {
+            if self.threads == 1 {
+                (self.fns.batch)(data.as_mut_ptr(), self.log_n, self.batch, self.n)
+            } else {
+                (self.fns.batch_mt)(data.as_mut_ptr(), self.log_n, self.batch, self.n, self.threads)
+            }
+        };
+        Self::check(result)
+    }
+
+    /// XOR convolution of `a` and `b` into `out`, using the plan's scratch
+    /// buffer for the transform of `b`
+    pub fn execute_xor_convolve(&mut self, a: &[T], b: &[T], out: &mut [T]) -> FhtResult<()> {
+        if a.len() != self.n || b.len() != self.n || out.len() != self.n {
+            return Err(FhtError::InvalidSize(a.len()));
+        }
+        let (xor, log_n) = (self.fns.xor, self.log_n);
+        let scratch = self.scratch();
+        Self::check(unsafe { xor(a.as_ptr(), b.as_ptr(), out.as_mut_ptr(), log_n, scratch.as_mut_ptr()) })
+    }
+
+    /// Update `spectrum`, the transform of some input, after the changes
+    /// `input[indices[j]] += deltas[j]` (repeats add up), without
+    /// transforming the input again. A few changes cost a pass over the
+    /// spectrum per 8; many go through the sparse transform in the plan's
+    /// scratch buffer. Indices past `len()` are an error and leave
+    /// `spectrum` as it was.
+    pub fn execute_update(&mut self, spectrum: &mut [T], indices: &[usize], deltas: &[T]) -> FhtResult<()> {
+        if spectrum.len() != self.n {
+            return Err(FhtError::InvalidSize(spectrum.len()));
+        }
+        if deltas.len() != indices.len() {
+            return Err(FhtError::InvalidSize(deltas.len()));
+        }
+        let (update, log_n) = (self.fns.update, self.log_n);
+        let scratch = self.scratch();
+        Self::check(unsafe {
+            update(
+                spectrum.as_mut_ptr(),
+                log_n,
+                indices.as_ptr(),
+                deltas.as_ptr(),
+                indices.len(),
+                scratch.as_mut_ptr(),
+            )
+        })
+    }
+}
+
+impl FhtPlan<f32> {
+    /// Plan an f32 transform of length `n` (a power of 2)
+    pub fn new(n: usize) -> FhtResult<Self> {
+        Self::with_fns(
+            n,
+            false,
+            PlanFns {
+                inplace: ffi::fht_float,
+                mt: ffi::fht_float_mt,
+                oop: ffi::fht_float_oop,
+                batch: ffi::fht_float_batch,
+                batch_mt: ffi::fht_float_batch_mt,
+                xor: ffi::fht_xor_convolve_float,
+                update: ffi::fht_float_update,
+            },
+        )
+    }
+}
+
+impl FhtPlan<f64> {
+    /// Plan an f64 transform of length `n` (a power of 2)
+    pub fn new(n: usize) -> FhtResult<Self> {
+        Self::with_fns(
+            n,
+            true,
+            PlanFns {
+                inplace: ffi::fht_double,
+                mt: ffi::fht_double_mt,
+                oop: ffi::fht_double_oop,
+                batch: ffi::fht_double_batch,
+                batch_mt: ffi::fht_double_batch_mt,
+                xor: ffi::fht_xor_convolve_double,
+                update: ffi::fht_double_update,
+            },
+        )
+    }
+}
+
+/// Check that `sign_bits` holds `rounds` (at least one) blocks of sign words
+/// for vectors of length `n`
+fn validate_signs(n: usize, sign_bits: &[u64], rounds: usize) -> FhtResult<c_int> {
+    let words = (n / 64).max(1);
+    if rounds == 0 || rounds > c_int::MAX as usize || sign_bits.len() / words < rounds {
+        return Err(FhtError::InvalidSize(sign_bits.len()));
+    }
+    Ok(rounds as c_int)
+}
+
+/// Largest log2 size of `fht_large_inplace` and `fht_file` (FHT_LARGE_MAX_LOG_N)
+pub const MAX_LARGE_LOG_N: usize = 48;
+
+/// Validate a size for the transforms past 2^30
+fn validate_large_size(size: u64) -> FhtResult<usize> {
+    if size == 0 || !size.is_power_of_two() {
+        return Err(FhtError::InvalidSize(size as usize));
+    }
+
+    let log_n = size.trailing_zeros() as usize;
 
-        let n = input.len();
-        let log_n = validate_size(n)?;
+    if log_n > MAX_LARGE_LOG_N {
+        return Err(FhtError::SizeTooLarge(usize::try_from(size).unwrap_or(usize::MAX)));
+    }
 
-        let result = unsafe {
-            ffi::fht_double_oop(input.as_ptr(), output.as_mut_ptr(), log_n as c_int)
-        };
+    Ok(log_n)
+}
 
-        if result != 0 {
-            Err(FhtError::InternalError(result))
-        } else {
-            Ok(())
-        }
+/// Map the result of `fht_*_file`: -1 leaves the cause in errno
+#[cfg(unix)]
+fn file_result(result: c_int) -> FhtResult<()> {
+    if result != 0 {
+        Err(FhtError::Io(std::io::Error::last_os_error().kind()))
+    } else {
+        Ok(())
     }
 }
 
@@ -180,30 +2558,230 @@ pub trait FhtArray {
     fn fht(&self) -> FhtResult<Self>
     where
         Self: Sized;
+
+    /// Perform FHT into `output` (same shape), which is fully overwritten;
+    /// the only out-of-place form for views
+    fn fht_into(&self, output: &mut Self) -> FhtResult<()>;
+
+    /// Perform in-place FHT multiplied by `scale` (fused, no extra pass;
+    /// converted to the element type)
+    fn fht_scaled_inplace(&mut self, scale: f64) -> FhtResult<()>;
+
+    /// Perform in-place FHT scaled by 1/sqrt(n)
+    fn fht_orthonormal_inplace(&mut self) -> FhtResult<()>;
+
+    /// Perform in-place FHT scaled by 1/n (inverse of `fht_inplace`)
+    fn fht_inverse_inplace(&mut self) -> FhtResult<()>;
+
+    /// XOR convolution with `other` (same shape), returned as a new array
+    fn xor_convolve(&self, other: &Self) -> FhtResult<Self>
+    where
+        Self: Sized;
+}
+
+/// Transform along one axis of a 2-D or N-D view
+///
+/// Every lane along `axis` is transformed in place, the axis need not be
+/// contiguous. Along a non-contiguous axis (e.g. the columns of a row-major
+/// matrix) the C library runs the butterflies across the contiguous
+/// dimension, so no transpose copy is made. Owned arrays use
+/// `array.view_mut().fht_axis_inplace(axis)`.
+pub trait FhtAxis {
+    /// Perform in-place FHT on every lane along `axis` (panics if `axis` is
+    /// out of bounds, like ndarray's own axis methods)
+    fn fht_axis_inplace(&mut self, axis: Axis) -> FhtResult<()>;
 }
 
 impl FhtArray for Array1<f32> {
     fn fht_inplace(&mut self) -> FhtResult<()> {
-        let slice = self.as_slice_mut().unwrap();
+        let slice = contiguous(self.as_slice_mut())?;
         f32::fht_inplace(slice)
     }
 
     fn fht(&self) -> FhtResult<Self> {
+        let output = fht_oop_new(contiguous(self.as_slice())?, self.len(), ffi::fht_float_oop)?;
+        Ok(Array1::from_vec(output))
+    }
+
+    fn fht_into(&self, output: &mut Self) -> FhtResult<()> {
+        f32::fht(contiguous(self.as_slice())?, contiguous(output.as_slice_mut())?)
+    }
+
+    fn fht_scaled_inplace(&mut self, scale: f64) -> FhtResult<()> {
+        f32::fht_scaled_inplace(contiguous(self.as_slice_mut())?, scale as f32)
+    }
+
+    fn fht_orthonormal_inplace(&mut self) -> FhtResult<()> {
+        f32::fht_orthonormal_inplace(contiguous(self.as_slice_mut())?)
+    }
+
+    fn fht_inverse_inplace(&mut self) -> FhtResult<()> {
+        f32::fht_inverse_inplace(contiguous(self.as_slice_mut())?)
+    }
+
+    fn xor_convolve(&self, other: &Self) -> FhtResult<Self> {
         let mut output = Array1::zeros(self.len());
-        f32::fht(self.as_slice().unwrap(), output.as_slice_mut().unwrap())?;
+        let mut scratch = vec![0.0; self.len()];
+        f32::xor_convolve(
+            contiguous(self.as_slice())?,
+            contiguous(other.as_slice())?,
+            output.as_slice_mut().unwrap(),
+            &mut scratch,
+        )?;
         Ok(output)
     }
 }
 
 impl FhtArray for Array1<f64> {
     fn fht_inplace(&mut self) -> FhtResult<()> {
-        let slice = self.as_slice_mut().unwrap();
+        let slice = contiguous(self.as_slice_mut())?;
         f64::fht_inplace(slice)
     }
 
     fn fht(&self) -> FhtResult<Self> {
+        let output = fht_oop_new(contiguous(self.as_slice())?, self.len(), ffi::fht_double_oop)?;
+        Ok(Array1::from_vec(output))
+    }
+
+    fn fht_into(&self, output: &mut Self) -> FhtResult<()> {
+        f64::fht(contiguous(self.as_slice())?, contiguous(output.as_slice_mut())?)
+    }
+
+    fn fht_scaled_inplace(&mut self, scale: f64) -> FhtResult<()> {
+        f64::fht_scaled_inplace(contiguous(self.as_slice_mut())?, scale)
+    }
+
+    fn fht_orthonormal_inplace(&mut self) -> FhtResult<()> {
+        f64::fht_orthonormal_inplace(contiguous(self.as_slice_mut())?)
+    }
+
+    fn fht_inverse_inplace(&mut self) -> FhtResult<()> {
+        f64::fht_inverse_inplace(contiguous(self.as_slice_mut())?)
+    }
+
+    fn xor_convolve(&self, other: &Self) -> FhtResult<Self> {
         let mut output = Array1::zeros(self.len());
-        f64::fht(self.as_slice().unwrap(), output.as_slice_mut().unwrap())?;
+        let mut scratch = vec![0.0; self.len()];
+        f64::xor_convolve(
+            contiguous(self.as_slice())?,
+            contiguous(other.as_slice())?,
+            output.as_slice_mut().unwrap(),
+            &mut scratch,
+        )?;
+        Ok(output)
+    }
+}
+
+/// Row-wise transform: every row of the matrix is transformed independently
+/// in one batched call (the row length must be a power of 2). The matrix
+/// must be in standard layout, otherwise the methods return
+/// `FhtError::NonContiguous`
+impl FhtArray for Array2<f32> {
+    fn fht_inplace(&mut self) -> FhtResult<()> {
+        let n = self.ncols();
+        f32::fht_batch_inplace(contiguous(self.as_slice_mut())?, n)
+    }
+
+    fn fht(&self) -> FhtResult<Self> {
+        let output = fht_oop_new(contiguous(self.as_slice())?, self.ncols(), ffi::fht_float_oop)?;
+        Ok(Array2::from_shape_vec(self.dim(), output).unwrap())
+    }
+
+    fn fht_into(&self, output: &mut Self) -> FhtResult<()> {
+        if output.dim() != self.dim() {
+            return Err(FhtError::InvalidSize(output.len()));
+        }
+        let input = contiguous(self.as_slice())?;
+        fht_oop_into(input, contiguous(output.as_slice_mut())?, self.ncols(), ffi::fht_float_oop)
+    }
+
+    fn fht_scaled_inplace(&mut self, scale: f64) -> FhtResult<()> {
+        let n = self.ncols();
+        fht_scaled_batch(contiguous(self.as_slice_mut())?, n, scale as f32, ffi::fht_float_scaled_batch)
+    }
+
+    fn fht_orthonormal_inplace(&mut self) -> FhtResult<()> {
+        let n = self.ncols();
+        let scale = 1.0 / (n as f64).sqrt();
+        fht_scaled_batch(contiguous(self.as_slice_mut())?, n, scale as f32, ffi::fht_float_scaled_batch)
+    }
+
+    fn fht_inverse_inplace(&mut self) -> FhtResult<()> {
+        let n = self.ncols();
+        let scale = 1.0 / n as f64;
+        fht_scaled_batch(contiguous(self.as_slice_mut())?, n, scale as f32, ffi::fht_float_scaled_batch)
+    }
+
+    fn xor_convolve(&self, other: &Self) -> FhtResult<Self> {
+        let n = self.ncols();
+        validate_size(n)?;
+        if other.dim() != self.dim() {
+            return Err(FhtError::InvalidSize(other.len()));
+        }
+        let mut output = Array2::zeros(self.dim());
+        let mut scratch = vec![0.0; n];
+        f32::xor_convolve_batch(
+            contiguous(self.as_slice())?,
+            contiguous(other.as_slice())?,
+            output.as_slice_mut().unwrap(),
+            &mut scratch,
+            n,
+        )?;
+        Ok(output)
+    }
+}
+
+impl FhtArray for Array2<f64> {
+    fn fht_inplace(&mut self) -> FhtResult<()> {
+        let n = self.ncols();
+        f64::fht_batch_inplace(contiguous(self.as_slice_mut())?, n)
+    }
+
+    fn fht(&self) -> FhtResult<Self> {
+        let output = fht_oop_new(contiguous(self.as_slice())?, self.ncols(), ffi::fht_double_oop)?;
+        Ok(Array2::from_shape_vec(self.dim(), output).unwrap())
+    }
+
+    fn fht_into(&self, output: &mut Self) -> FhtResult<()> {
+        if output.dim() != self.dim() {
+            return Err(FhtError::InvalidSize(output.len()));
+        }
+        let input = contiguous(self.as_slice())?;
+        fht_oop_into(input, contiguous(output.as_slice_mut())?, self.ncols(), ffi::fht_double_oop)
+    }
+
+    fn fht_scaled_inplace(&mut self, scale: f64) -> FhtResult<()> {
+        let n = self.ncols();
+        fht_scaled_batch(contiguous(self.as_slice_mut())?, n, scale, ffi::fht_double_scaled_batch)
+    }
+
+    fn fht_orthonormal_inplace(&mut self) -> FhtResult<()> {
+        let n = self.ncols();
+        let scale = 1.0 / (n as f64).sqrt();
+        fht_scaled_batch(contiguous(self.as_slice_mut())?, n, scale, ffi::fht_double_scaled_batch)
+    }
+
+    fn fht_inverse_inplace(&mut self) -> FhtResult<()> {
+        let n = self.ncols();
+        let scale = 1.0 / n as f64;
+        fht_scaled_batch(contiguous(self.as_slice_mut())?, n, scale, ffi::fht_double_scaled_batch)
+    }
+
+    fn xor_convolve(&self, other: &Self) -> FhtResult<Self> {
+        let n = self.ncols();
+        validate_size(n)?;
+        if other.dim() != self.dim() {
+            return Err(FhtError::InvalidSize(other.len()));
+        }
+        let mut output = Array2::zeros(self.dim());
+        let mut scratch = vec![0.0; n];
+        f64::xor_convolve_batch(
+            contiguous(self.as_slice())?,
+            contiguous(other.as_slice())?,
+            output.as_slice_mut().unwrap(),
+            &mut scratch,
+            n,
+        )?;
         Ok(output)
     }
 }
@@ -211,25 +2789,67 @@ impl FhtArray for Array1<f64> {
 /// Extension for mutable array views (only in-place operations)
 impl<'a> FhtArray for ArrayViewMut1<'a, f32> {
     fn fht_inplace(&mut self) -> FhtResult<()> {
-        let slice = self.as_slice_mut().unwrap();
+        let slice = contiguous(self.as_slice_mut())?;
         f32::fht_inplace(slice)
     }
 
     fn fht(&self) -> FhtResult<Self> {
-        // Views cannot create owned arrays, use Array1::fht() instead
-        unimplemented!("Use fht_inplace() for views, or convert to Array1 first")
+        // A view cannot own the result
+        Err(FhtError::Unsupported("fht on a view (use fht_into or fht_inplace)"))
+    }
+
+    fn fht_into(&self, output: &mut Self) -> FhtResult<()> {
+        f32::fht(contiguous(self.as_slice())?, contiguous(output.as_slice_mut())?)
+    }
+
+    fn fht_scaled_inplace(&mut self, scale: f64) -> FhtResult<()> {
+        f32::fht_scaled_inplace(contiguous(self.as_slice_mut())?, scale as f32)
+    }
+
+    fn fht_orthonormal_inplace(&mut self) -> FhtResult<()> {
+        f32::fht_orthonormal_inplace(contiguous(self.as_slice_mut())?)
+    }
+
+    fn fht_inverse_inplace(&mut self) -> FhtResult<()> {
+        f32::fht_inverse_inplace(contiguous(self.as_slice_mut())?)
+    }
+
+    fn xor_convolve(&self, _other: &Self) -> FhtResult<Self> {
+        // A view cannot own the result
+        Err(FhtError::Unsupported("xor_convolve on a view (use Fht::xor_convolve_inplace)"))
     }
 }
 
 impl<'a> FhtArray for ArrayViewMut1<'a, f64> {
     fn fht_inplace(&mut self) -> FhtResult<()> {
-        let slice = self.as_slice_mut().unwrap();
+        let slice = contiguous(self.as_slice_mut())?;
         f64::fht_inplace(slice)
     }
 
     fn fht(&self) -> FhtResult<Self> {
-        // Views cannot create owned arrays, use Array1::fht() instead
-        unimplemented!("Use fht_inplace() for views, or convert to Array1 first")
+        // A view cannot own the result
+        Err(FhtError::Unsupported("fht on a view (use fht_into or fht_inplace)"))
+    }
+
+    fn fht_into(&self, output: &mut Self) -> FhtResult<()> {
+        f64::fht(contiguous(self.as_slice())?, contiguous(output.as_slice_mut())?)
+    }
+
+    fn fht_scaled_inplace(&mut self, scale: f64) -> FhtResult<()> {
+        f64::fht_scaled_inplace(contiguous(self.as_slice_mut())?, scale)
+    }
+
+    fn fht_orthonormal_inplace(&mut self) -> FhtResult<()> {
+        f64::fht_orthonormal_inplace(contiguous(self.as_slice_mut())?)
+    }
+
+    fn fht_inverse_inplace(&mut self) -> FhtResult<()> {
+        f64::fht_inverse_inplace(contiguous(self.as_slice_mut())?)
+    }
+
+    fn xor_convolve(&self, _other: &Self) -> FhtResult<Self> {
+        // A view cannot own the result
+        Err(FhtError::Unsupported("xor_convolve on a view (use Fht::xor_convolve_inplace)"))
     }
 }
 
@@ -247,6 +2867,14 @@ mod tests {
         assert!(validate_size(0).is_err());
     }
 
+    #[test]
+    fn test_kernel_name() {
+        let name = kernel_name();
+        println!("Selected kernel: {}", name);
+        assert!(!name.is_empty());
+        assert_ne!(name, "none");
+    }
+
     #[test]
     fn test_fht_f32_inplace() {
         let mut data = vec![1.0f32, -1.0, 1.0, -1.0];
@@ -304,6 +2932,660 @@ mod tests {
         assert_abs_diff_eq!(result[1], 4.0, epsilon = 1e-6);
     }
 
+    #[test]
+    fn test_fht_batch_inplace() {
+        let mut data = vec![
+            1.0f64, -1.0, 1.0, -1.0, // -> [0, 4, 0, 0]
+            1.0, 1.0, 1.0, 1.0, // -> [4, 0, 0, 0]
+            1.0, 0.0, 0.0, 0.0, // -> [1, 1, 1, 1]
+        ];
+        f64::fht_batch_inplace(&mut data, 4).unwrap();
+
+        let expected = [0.0, 4.0, 0.0, 0.0, 4.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0];
+        for (&result, &expected) in data.iter().zip(expected.iter()) {
+            assert_abs_diff_eq!(result, expected, epsilon = 1e-12);
+        }
+
+        // Length must be a multiple of the transform size
+        let mut data = vec![0.0f32; 12];
+        assert_eq!(
+            f32::fht_batch_inplace(&mut data, 8).unwrap_err(),
+            FhtError::InvalidSize(12)
+        );
+    }
+
+    #[test]
+    fn test_ndarray_batch() {
+        // Array2 rows are transformed independently; compare with Array1
+        let rows = 5;
+        let n = 256;
+        let data = Array2::from_shape_fn((rows, n), |(i, j)| ((i * 31 + j * 7) % 13) as f32);
+        let result = data.fht().unwrap();
+
+        for i in 0..rows {
+            let mut row = Array1::from((0..n).map(|j| data[[i, j]]).collect::<Vec<f32>>());
+            row.fht_inplace().unwrap();
+            for j in 0..n {
+                assert_abs_diff_eq!(result[[i, j]], row[j], epsilon = 1e-3);
+            }
+        }
+    }
+
+    #[test]
+    fn test_fht_axis() {
+        use ndarray::{ArrayD, IxDyn};
+
+        // Columns of a row-major matrix, without a transpose
+        let (rows, cols) = (64, 12);
+        let data = Array2::from_shape_fn((rows, cols), |(i, j)| ((i * 5 + j * 11) % 7) as f64 - 3.0);
+        let mut by_cols = data.clone();
+        by_cols.view_mut().fht_axis_inplace(Axis(0)).unwrap();
+        for j in 0..cols {
+            let mut col: Vec<f64> = (0..rows).map(|i| data[[i, j]]).collect();
+            f64::fht_inplace(&mut col).unwrap();
+            for i in 0..rows {
+                assert_abs_diff_eq!(by_cols[[i, j]], col[i], epsilon = 1e-9);
+            }
+        }
+
+        // The same lanes through a transposed view; 12 columns are no power of 2
+        let mut transposed = data.clone();
+        transposed.view_mut().reversed_axes().fht_axis_inplace(Axis(1)).unwrap();
+        assert_eq!(transposed, by_cols);
+        assert!(transposed.view_mut().fht_axis_inplace(Axis(1)).is_err());
+
+        // Middle axis of a 3-D tensor, also with reversed axes
+        let shape = [3, 16, 8];
+        let values: Vec<f32> = (0..3 * 16 * 8).map(|i| ((i * 13) % 17) as f32 - 8.0).collect();
+        let mut tensor = ArrayD::from_shape_vec(IxDyn(&shape), values.clone()).unwrap();
+        tensor.view_mut().fht_axis_inplace(Axis(1)).unwrap();
+        let mut flipped = ArrayD::from_shape_vec(IxDyn(&shape), values.clone()).unwrap();
+        let mut view = flipped.view_mut();
+        view.invert_axis(Axis(0));
+        view.invert_axis(Axis(2));
+        view.fht_axis_inplace(Axis(1)).unwrap();
+        let result = tensor.as_slice().unwrap();
+        for a in 0..3 {
+            for c in 0..8 {
+                let mut lane: Vec<f32> = (0..16).map(|b| values[(a * 16 + b) * 8 + c]).collect();
+                f32::fht_inplace(&mut lane).unwrap();
+                for b in 0..16 {
+                    let k = (a * 16 + b) * 8 + c;
+                    assert_abs_diff_eq!(result[k], lane[b], epsilon = 1e-4);
+                    assert_abs_diff_eq!(flipped.as_slice().unwrap()[k], lane[b], epsilon = 1e-4);
+                }
+            }
+        }
+
+        // A reversed transform axis falls back to a per-lane gather
+        let mut reversed = data.clone();
+        let mut view = reversed.view_mut();
+        view.invert_axis(Axis(0));
+        view.fht_axis_inplace(Axis(0)).unwrap();
+        for j in 0..cols {
+            let mut col: Vec<f64> = (0..rows).map(|i| data[[rows - 1 - i, j]]).collect();
+            f64::fht_inplace(&mut col).unwrap();
+            for i in 0..rows {
+                assert_abs_diff_eq!(reversed[[rows - 1 - i, j]], col[i], epsilon = 1e-9);
+            }
+        }
+    }
+
+    #[test]
+    fn test_fht_dims() {
+        // Bits 0 and 2 of 8 elements: H2 (x) I2 (x) H2 on the index bits
+        let original: Vec<f32> = (0..8).map(|i| ((i * 3) % 5) as f32).collect();
+        let mut data = original.clone();
+        f32::fht_dims_inplace(&mut data, 0b101).unwrap();
+        for k in 0..8usize {
+            let expected: f32 = (0..8usize)
+                .filter(|&i| i & 0b010 == k & 0b010)
+                .map(|i| if (i & k & 0b101).count_ones() % 2 == 0 { original[i] } else { -original[i] })
+                .sum();
+            assert_abs_diff_eq!(data[k], expected, epsilon = 1e-5);
+        }
+
+        // The full mask is the plain transform; bits past log2(n) are refused
+        let original: Vec<f64> = (0..1024).map(|i| ((i * 7) % 11) as f64).collect();
+        let mut full = original.clone();
+        f64::fht_dims_inplace(&mut full, 0x3ff).unwrap();
+        let mut plain = original.clone();
+        f64::fht_inplace(&mut plain).unwrap();
+        for (&a, &b) in full.iter().zip(plain.iter()) {
+            assert_abs_diff_eq!(a, b, epsilon = 1e-9);
+        }
+        assert!(f64::fht_dims_inplace(&mut full, 0x400).is_err());
+        assert!(i32::fht_dims_inplace(&mut [1, 2], 1).is_err());
+    }
+
+    #[test]
+    fn test_fht_sparse_select() {
+        let n = 1 << 12;
+        // Indicator vectors and a few spikes, on both sides of the direct/pruned switch
+        for &nnz in &[1usize, 4, 17] {
+            let indices: Vec<usize> = (0..nnz).map(|j| (j * 2719 + 5) % n).collect();
+            let values: Vec<f64> = (0..nnz).map(|j| j as f64 - 2.5).collect();
+            let mut spectrum = vec![0.0; n];
+            f64::fht_sparse(&indices, &values, &mut spectrum).unwrap();
+
+            let mut dense = vec![0.0; n];
+            for (&i, &v) in indices.iter().zip(values.iter()) {
+                dense[i] += v;
+            }
+            f64::fht_inplace(&mut dense).unwrap();
+            for (&a, &b) in spectrum.iter().zip(dense.iter()) {
+                assert_abs_diff_eq!(a, b, epsilon = 1e-9);
+            }
+
+            // The same coefficients picked out of a dense input
+            let input: Vec<f32> = (0..n).map(|i| ((i * 7) % 13) as f32 - 6.0).collect();
+            let mut full = input.clone();
+            f32::fht_inplace(&mut full).unwrap();
+            let mut picked = vec![0.0f32; nnz];
+            f32::fht_select(&input, &indices, &mut picked).unwrap();
+            for (&p, &i) in picked.iter().zip(indices.iter()) {
+                assert_abs_diff_eq!(p, full[i], epsilon = 1e-2);
+            }
+        }
+
+        // Out-of-range indices are refused
+        let mut out = vec![0.0f32; 8];
+        assert!(f32::fht_sparse(&[8], &[1.0], &mut out).is_err());
+    }
+
+    #[test]
+    fn test_fht_inplace_mt() {
+        let n = 1 << 16;
+        let mut data: Vec<f64> = (0..n).map(|i| ((i * 7) % 11) as f64 - 5.0).collect();
+        let mut expected = data.clone();
+
+        f64::fht_inplace_mt(&mut data, 3).unwrap();
+        f64::fht_inplace(&mut expected).unwrap();
+
+        for (&result, &expected) in data.iter().zip(expected.iter()) {
+            assert_abs_diff_eq!(result, expected, epsilon = 1e-6);
+        }
+        assert!(num_threads() >= 1);
+    }
+
+    #[cfg(feature = "rayon")]
+    #[test]
+    fn test_fht_inplace_par() {
+        let n = 1 << 18;
+        let mut data: Vec<f32> = (0..n).map(|i| ((i * 7) % 11) as f32 - 5.0).collect();
+        let mut expected = data.clone();
+
+        let pool = rayon::ThreadPoolBuilder::new().num_threads(4).build().unwrap();
+        pool.install(|| f32::fht_inplace_par(&mut data)).unwrap();
+        f32::fht_inplace(&mut expected).unwrap();
+
+        for (&result, &expected) in data.iter().zip(expected.iter()) {
+            assert_abs_diff_eq!(result, expected, epsilon = 1e-1);
+        }
+    }
+
+    #[test]
+    fn test_fht_int() {
+        // Walsh spectrum of a Boolean function in {-1, 1} form is exact
+        let signs: Vec<i32> = (0..256).map(|i: i32| if (i * 37 + i / 5) % 3 == 0 { -1 } else { 1 }).collect();
+        let mut spectrum = signs.clone();
+        i32::fht_inplace(&mut spectrum).unwrap();
+        let mut reference: Vec<f64> = signs.iter().map(|&x| x as f64).collect();
+        f64::fht_inplace(&mut reference).unwrap();
+        for (&exact, &approx) in spectrum.iter().zip(reference.iter()) {
+            assert_eq!(exact as f64, approx);
+        }
+
+        // The inverse divides exactly; i16 agrees while nothing saturates
+        let mut wide: Vec<i64> = spectrum.iter().map(|&x| x as i64).collect();
+        i64::fht_inverse_inplace(&mut wide).unwrap();
+        let mut narrow: Vec<i16> = signs.iter().map(|&x| x as i16).collect();
+        i16::fht_inplace(&mut narrow).unwrap();
+        for i in 0..256 {
+            assert_eq!(wide[i], signs[i] as i64);
+            assert_eq!(narrow[i] as i32, spectrum[i]);
+        }
+
+        // int16 reports saturation instead of wrapping
+        let mut ones = vec![1i16; 1 << 16];
+        assert_eq!(i16::fht_inplace(&mut ones), Err(FhtError::Overflow));
+        assert!(i32::fht_orthonormal_inplace(&mut spectrum).is_err());
+    }
+
+    #[cfg(feature = "half")]
+    #[test]
+    fn test_fht_half() {
+        use half::{bf16, f16};
+
+        // {-1, 0, 1} inputs keep every fp16 value an exact integer below 2048
+        let signs: Vec<i32> = (0..1 << 13).map(|i: i32| (i * 37 + i / 5) % 3 - 1).collect();
+        let mut spectrum = signs.clone();
+        i32::fht_inplace(&mut spectrum).unwrap();
+
+        let mut data: Vec<f16> = signs.iter().map(|&x| f16::from_f32(x as f32)).collect();
+        f16::fht_inplace(&mut data).unwrap();
+        for (&h, &exact) in data.iter().zip(spectrum.iter()) {
+            assert_eq!(h.to_f32(), exact as f32);
+        }
+
+        // bf16 keeps 8 bits; plain + inverse gets back to the input
+        let mut data: Vec<bf16> = signs.iter().map(|&x| bf16::from_f32(x as f32)).collect();
+        bf16::fht_inplace(&mut data).unwrap();
+        for (&h, &exact) in data.iter().zip(spectrum.iter()) {
+            assert_abs_diff_eq!(h.to_f32(), exact as f32, epsilon = 512.0 / 128.0);
+        }
+        let mut data: Vec<bf16> = signs.iter().map(|&x| bf16::from_f32(x as f32)).collect();
+        bf16::fht_inplace(&mut data).unwrap();
+        bf16::fht_inverse_inplace(&mut data).unwrap();
+        for (&h, &x) in data.iter().zip(signs.iter()) {
+            assert_abs_diff_eq!(h.to_f32(), x as f32, epsilon = 0.1);
+        }
+    }
+
+    #[test]
+    fn test_fht_scaled() {
+        let original: Vec<f64> = (0..64).map(|i| ((i * 5) % 9) as f64 - 4.0).collect();
+
+        let mut plain = original.clone();
+        f64::fht_inplace(&mut plain).unwrap();
+        let mut scaled = original.clone();
+        f64::fht_scaled_inplace(&mut scaled, 0.25).unwrap();
+        for (&result, &expected) in scaled.iter().zip(plain.iter()) {
+            assert_abs_diff_eq!(result, expected * 0.25, epsilon = 1e-12);
+        }
+
+        // Orthonormal twice and plain + inverse are both the identity
+        let mut data = original.clone();
+        f64::fht_orthonormal_inplace(&mut data).unwrap();
+        f64::fht_orthonormal_inplace(&mut data).unwrap();
+        f64::fht_inverse_inplace(&mut plain).unwrap();
+        for i in 0..original.len() {
+            assert_abs_diff_eq!(data[i], original[i], epsilon = 1e-10);
+            assert_abs_diff_eq!(plain[i], original[i], epsilon = 1e-10);
+        }
+
+        // The streaming variant only changes how the last stage is stored
+        let mut streamed = original.clone();
+        f64::fht_stream_inplace(&mut streamed).unwrap();
+        f64::fht_inplace(&mut data).unwrap();
+        for i in 0..original.len() {
+            assert_abs_diff_eq!(streamed[i], data[i], epsilon = 1e-10);
+        }
+
+        // ndarray: every row of an Array2 is scaled by 1/sqrt(ncols)
+        let mut rows = Array2::from_shape_fn((3, 8), |(i, j)| (i + j) as f32);
+        let mut expected = rows.clone();
+        rows.fht_orthonormal_inplace().unwrap();
+        expected.fht_inplace().unwrap();
+        for i in 0..3 {
+            for j in 0..8 {
+                assert_abs_diff_eq!(rows[[i, j]], expected[[i, j]] / 8f32.sqrt(), epsilon = 1e-5);
+            }
+        }
+
+        // Scaled and inverse rows of small vectors (the batch kernel path)
+        let original = Array2::from_shape_fn((4, 2), |(i, j)| (i * 3 + j) as f64);
+        let mut scaled = original.clone();
+        scaled.fht_scaled_inplace(0.5).unwrap();
+        let mut plain = original.clone();
+        plain.fht_inplace().unwrap();
+        let mut restored = plain.clone();
+        restored.fht_inverse_inplace().unwrap();
+        for i in 0..4 {
+            for j in 0..2 {
+                assert_abs_diff_eq!(scaled[[i, j]], plain[[i, j]] * 0.5, epsilon = 1e-12);
+                assert_abs_diff_eq!(restored[[i, j]], original[[i, j]], epsilon = 1e-12);
+            }
+        }
+
+        // A matrix outside standard layout is an error, not a panic
+        let mut transposed = original.reversed_axes();
+        assert_eq!(transposed.fht_inplace(), Err(FhtError::NonContiguous));
+        assert_eq!(transposed.fht_inverse_inplace(), Err(FhtError::NonContiguous));
+        assert!(matches!(transposed.fht(), Err(FhtError::NonContiguous)));
+    }
+
+    #[test]
+    fn test_stats() {
+        let was = stats_enable(true).unwrap();
+        thread_stats_reset();
+        let mut data = vec![1.0f32; 512];
+        f32::fht_inplace(&mut data).unwrap();
+        f32::fht_inplace(&mut data).unwrap();
+        f64::fht_batch_inplace(&mut vec![1.0f64; 64], 16).unwrap();
+
+        // Other tests run on other threads, so this thread's counts are exact
+        let mine = thread_stats().unwrap();
+        let inplace = mine.iter().find(|e| e.dtype == "f32" && e.entry == "inplace" && e.log_n == 9).unwrap();
+        assert_eq!(inplace.calls, 2);
+        assert_eq!(inplace.bytes, 2 * 512 * 4);
+        assert_eq!(inplace.histogram.iter().sum::<u64>(), 2);
+        assert_ne!(inplace.kernel, "unknown");
+        let batch = mine.iter().find(|e| e.dtype == "f64" && e.entry == "batch").unwrap();
+        assert_eq!((batch.log_n, batch.calls, batch.bytes), (4, 1, 64 * 8));
+        assert!(stats().unwrap().iter().any(|e| e.entry == "inplace" && e.calls >= 2));
+
+        // A convolution is one "xor" call, not the transforms it runs
+        thread_stats_reset();
+        let (a, b) = (vec![1.0f64; 1024], vec![0.5f64; 1024]);
+        let (mut out, mut scratch) = (vec![0.0f64; 1024], vec![0.0f64; 1024]);
+        f64::xor_convolve(&a, &b, &mut out, &mut scratch).unwrap();
+        let mine = thread_stats().unwrap();
+        assert_eq!(mine.len(), 1);
+        assert_eq!((mine[0].entry, mine[0].log_n, mine[0].calls, mine[0].bytes), ("xor", 10, 1, 2 * 8192));
+
+        thread_stats_reset();
+        assert!(thread_stats().unwrap().is_empty());
+        stats_enable(was).unwrap();
+    }
+
+    #[test]
+    fn test_wisdom() {
+        let path = std::env::temp_dir().join(format!("ffht_wisdom_{}.txt", std::process::id()));
+        tune(8, 1).unwrap();
+        let tuned = tuned_kernel_name(8, false);
+        wisdom_save(&path).unwrap();
+        wisdom_forget();
+        wisdom_load(&path).unwrap();
+        assert_eq!(tuned_kernel_name(8, false), tuned);
+        assert_eq!(tune(31, 1), Err(FhtError::SizeTooLarge(1 << 31)));
+        assert!(wisdom_load(Path::new("does/not/exist")).is_err());
+
+        // Tuning only changes speed
+        let mut data: Vec<f32> = (0..256).map(|i| (i as f32 * 0.3).cos()).collect();
+        let mut expected = data.clone();
+        wisdom_forget();
+        f32::fht_inplace(&mut expected).unwrap();
+        wisdom_load(&path).unwrap();
+        f32::fht_inplace(&mut data).unwrap();
+        for (a, b) in data.iter().zip(&expected) {
+            assert_abs_diff_eq!(a, b, epsilon = 1e-3);
+        }
+
+        std::fs::remove_file(&path).unwrap();
+        wisdom_forget();
+    }
+
+    #[test]
+    fn test_hd() {
+        // Three rounds on two vectors against flip-then-transform
+        let n = 256;
+        let signs: Vec<u64> = (0..3 * n as u64 / 64).map(|w| w.wrapping_mul(0x9e37_79b9_7f4a_7c15)).collect();
+        let mut data: Vec<f64> = (0..2 * n).map(|i| (i as f64 * 0.37).sin()).collect();
+        let mut expected = data.clone();
+        for chunk in expected.chunks_mut(n) {
+            for r in 0..3 {
+                for (i, x) in chunk.iter_mut().enumerate() {
+                    if (signs[r * n / 64 + i / 64] >> (i % 64)) & 1 == 1 {
+                        *x = -*x;
+                    }
+                }
+                f64::fht_inplace(chunk).unwrap();
+            }
+        }
+        f64::fht_hd_batch_inplace(&mut data, n, &signs, 3, 0.5).unwrap();
+        for (a, b) in data.iter().zip(&expected) {
+            assert_abs_diff_eq!(*a, b * 0.5, epsilon = 1e-9);
+        }
+
+        let mut single: Vec<f32> = vec![1.0; 16];
+        f32::fht_hd_inplace(&mut single, &[0], 1).unwrap();
+        assert_eq!(single[0], 16.0);
+        assert_eq!(f32::fht_hd_inplace(&mut single, &[0], 2), Err(FhtError::InvalidSize(1)));
+        assert_eq!(f32::fht_hd_inplace(&mut single, &[], 0), Err(FhtError::InvalidSize(0)));
+    }
+
+    #[test]
+    fn test_ordered() {
+        let n = 64usize;
+        let input: Vec<f64> = (0..n).map(|i| ((i * 37) % 11) as f64 - 5.0).collect();
+        let mut natural = vec![0.0; n];
+        f64::fht(&input, &mut natural).unwrap();
+        let rev = |k: usize| k.reverse_bits() >> (usize::BITS - 6);
+
+        let (mut paley, mut sequency) = (vec![0.0; n], vec![0.0; n]);
+        f64::fht_ordered(&input, &mut paley, FhtOrder::Paley).unwrap();
+        f64::fht_ordered(&input, &mut sequency, FhtOrder::Sequency).unwrap();
+        for k in 0..n {
+            assert_eq!(paley[k], natural[rev(k)]);
+            assert_eq!(sequency[k], natural[rev(k ^ (k >> 1))]);
+        }
+
+        // In place gives the same, also for f32
+        let mut data: Vec<f32> = input.iter().map(|&x| x as f32).collect();
+        f32::fht_ordered_inplace(&mut data, FhtOrder::Sequency).unwrap();
+        assert!(data.iter().zip(&sequency).all(|(&a, &b)| a as f64 == b));
+
+        // Sequency row k changes sign k times
+        let mut rows = vec![vec![0.0f64; 8]; 8];
+        for i in 0..8 {
+            let mut unit = vec![0.0f64; 8];
+            unit[i] = 1.0;
+            f64::fht_ordered_inplace(&mut unit, FhtOrder::Sequency).unwrap();
+            for k in 0..8 {
+                rows[k][i] = unit[k];
+            }
+        }
+        for (k, row) in rows.iter().enumerate() {
+            assert_eq!(row.windows(2).filter(|w| w[0] != w[1]).count(), k);
+        }
+        assert!(f32::fht_ordered(&[0.0; 4], &mut [0.0; 8], FhtOrder::Paley).is_err());
+    }
+
+    #[test]
+    fn test_reductions() {
+        // Against a sort of the spectrum: larger magnitude first, then lower
+        // index; the integer input has plenty of ties
+        let n = 64;
+        let input: Vec<f64> = (0..2 * n).map(|i| ((i * 37 + i / 5) % 11) as f64 - 5.0).collect();
+        let mut spectrum = input.clone();
+        f64::fht_batch_inplace(&mut spectrum, n).unwrap();
+
+        let mut data = input.clone();
+        let top = f64::fht_topk_batch(&mut data, n, 3).unwrap();
+        assert_eq!(data, spectrum);
+        for (v, chunk) in spectrum.chunks(n).enumerate() {
+            let mut order: Vec<usize> = (0..n).collect();
+            order.sort_by(|&i, &j| chunk[j].abs().partial_cmp(&chunk[i].abs()).unwrap().then(i.cmp(&j)));
+            assert_eq!(&top[3 * v..3 * v + 3], &order[..3]);
+        }
+
+        let mut single: Vec<f32> = input.iter().map(|&x| x as f32).collect();
+        assert_eq!(f32::fht_argmax_batch(&mut single, n).unwrap(), vec![top[0], top[3]]);
+        let mut single: Vec<f32> = input[..n].iter().map(|&x| x as f32).collect();
+        assert_eq!(f32::fht_argmax(&mut single).unwrap(), top[0]);
+        assert_eq!(f32::fht_topk(&mut single, 0), Err(FhtError::InvalidSize(0)));
+
+        let t = spectrum[top[2]].abs();
+        let expected: Vec<usize> = (0..n).filter(|&i| spectrum[i].abs() >= t).collect();
+        let mut hits = vec![0; 2];
+        let mut data = input[..n].to_vec();
+        assert_eq!(f64::fht_threshold(&mut data, t, &mut hits).unwrap(), expected.len());
+        assert_eq!(hits, expected[..2]);
+    }
+
+    #[test]
+    fn test_large_inplace() {
+        let mut data: Vec<f64> = (0..1024).map(|i| (i as f64 * 0.7).sin()).collect();
+        let mut expected = data.clone();
+        f64::fht_large_inplace(&mut data).unwrap();
+        f64::fht_inplace(&mut expected).unwrap();
+        assert_eq!(data, expected);
+        assert_eq!(validate_large_size(1 << 40), Ok(40));
+        assert_eq!(validate_large_size(1 << 49), Err(FhtError::SizeTooLarge(1 << 49)));
+    }
+
+    #[cfg(unix)]
+    #[test]
+    fn test_file() {
+        use std::io::{Read, Seek, SeekFrom, Write};
+
+        let path = std::env::temp_dir().join(format!("ffht_file_{}.bin", std::process::id()));
+        let header = [7u8; 12];
+        let mut expected: Vec<f32> = (0..1 << 14).map(|i| (i as f32 * 0.3).cos()).collect();
+        let mut file = std::fs::OpenOptions::new()
+            .read(true)
+            .write(true)
+            .create(true)
+            .truncate(true)
+            .open(&path)
+            .unwrap();
+        file.write_all(&header).unwrap();
+        for x in &expected {
+            file.write_all(&x.to_ne_bytes()).unwrap();
+        }
+
+        // 16 KiB tiles: one contiguous pass and one cross-tile pass
+        f32::fht_file(&file, header.len() as u64, expected.len() as u64, 32 << 10, 1).unwrap();
+        f32::fht_inplace(&mut expected).unwrap();
+
+        let mut bytes = Vec::new();
+        file.seek(SeekFrom::Start(0)).unwrap();
+        file.read_to_end(&mut bytes).unwrap();
+        assert_eq!(&bytes[..12], &header);
+        for (chunk, b) in bytes[12..].chunks_exact(4).zip(&expected) {
+            let a = f32::from_ne_bytes(chunk.try_into().unwrap());
+            assert_abs_diff_eq!(a, *b, epsilon = 1e-2);
+        }
+
+        // Past the end of the file
+        assert!(matches!(f32::fht_file(&file, 0, 1 << 16, 32 << 10, 1), Err(FhtError::Io(_))));
+        assert_eq!(f32::fht_file(&file, 0, 3, 32 << 10, 1), Err(FhtError::InvalidSize(3)));
+        std::fs::remove_file(&path).unwrap();
+    }
+
+    #[test]
+    fn test_fht_plan() {
+        let plan = FhtPlan::<f32>::new(16).unwrap().with_batch(3);
+        assert_eq!(plan.len(), 16);
+        // test_wisdom may retune in parallel, so any known kernel will do
+        assert_ne!(plan.kernel_name(), "unknown");
+        assert_eq!(FhtPlan::<f32>::new(12).err(), Some(FhtError::InvalidSize(12)));
+
+        let input: Vec<f32> = (0..48).map(|i| (i as f32 * 0.7).sin()).collect();
+        let mut expected = input.clone();
+        f32::fht_batch_inplace(&mut expected, 16).unwrap();
+
+        let mut data = input.clone();
+        plan.execute_batch(&mut data).unwrap();
+        assert_eq!(data, expected);
+        assert_eq!(plan.execute_batch(&mut data[..32]), Err(FhtError::InvalidSize(32)));
+
+        let mut single = input[..16].to_vec();
+        plan.execute(&mut single).unwrap();
+        let mut out = vec![f32::NAN; 16];
+        plan.execute_oop(&input[..16], &mut out).unwrap();
+        assert_eq!(single, expected[..16]);
+        assert_eq!(out, expected[..16]);
+
+        // Thread counts only change who runs the batch, not the result
+        let threaded = FhtPlan::<f32>::new(16).unwrap().with_batch(3).with_threads(4);
+        let mut data = input.clone();
+        threaded.execute_batch(&mut data).unwrap();
+        assert_eq!(data, expected);
+        #[cfg(feature = "rayon")]
+        {
+            let pooled = FhtPlan::<f32>::new(16).unwrap().with_batch(3).with_rayon_threads(2).unwrap();
+            let mut data = input.clone();
+            pooled.execute_batch(&mut data).unwrap();
+            assert_eq!(data, expected);
+        }
+
+        // XOR convolution through the plan's scratch matches the Fht call
+        // Only the scratch users allocate the scratch, once
+        let mut plan = FhtPlan::<f64>::new(8).unwrap();
+        assert!(plan.scratch.is_empty());
+        let a: Vec<f64> = (0..8).map(|i| i as f64).collect();
+        let b: Vec<f64> = (0..8).map(|i| (8 - i) as f64).collect();
+        let (mut out, mut reference, mut scratch) = (vec![0.0; 8], vec![0.0; 8], vec![0.0; 8]);
+        plan.execute_xor_convolve(&a, &b, &mut out).unwrap();
+        f64::xor_convolve(&a, &b, &mut reference, &mut scratch).unwrap();
+        assert_eq!(out, reference);
+        let kept = plan.scratch.as_ptr();
+        plan.execute_xor_convolve(&a, &b, &mut out).unwrap();
+        assert_eq!(plan.scratch.as_ptr(), kept);
+        assert_eq!(plan.scratch()[..].as_ptr() as usize % PLAN_ALIGN, 0);
+
+        // Spectrum updates match a retransform, directly and past the switch
+        let mut plan = FhtPlan::<f64>::new(256).unwrap();
+        let mut input: Vec<f64> = (0..256).map(|i| ((i * 37) % 11) as f64 - 5.0).collect();
+        let mut spectrum = input.clone();
+        plan.execute(&mut spectrum).unwrap();
+        for count in [3usize, 40] {
+            let indices: Vec<usize> = (0..count).map(|j| (j * 97) % 256).collect();
+            let deltas: Vec<f64> = (0..count).map(|j| j as f64 - 2.0).collect();
+            for (&i, &d) in indices.iter().zip(&deltas) {
+                input[i] += d;
+            }
+            plan.execute_update(&mut spectrum, &indices, &deltas).unwrap();
+            let mut reference = input.clone();
+            plan.execute(&mut reference).unwrap();
+            assert_eq!(spectrum, reference);
+        }
+        assert!(plan.execute_update(&mut spectrum, &[256], &[1.0]).is_err());
+        assert!(plan.execute_update(&mut spectrum, &[1, 2], &[1.0]).is_err());
+        assert!(plan.execute_update(&mut spectrum[..128], &[1], &[1.0]).is_err());
+
+        // Views transform into a caller-supplied output
+        let mut src = Array1::from(vec![1.0f32, -1.0, 1.0, -1.0]);
+        let mut dst = Array1::from(vec![0.0f32; 4]);
+        src.view_mut().fht_into(&mut dst.view_mut()).unwrap();
+        assert_eq!(dst.as_slice().unwrap(), &[0.0, 4.0, 0.0, 0.0]);
+        assert_eq!(src.as_slice().unwrap(), &[1.0, -1.0, 1.0, -1.0]);
+
+        // An owned XOR convolution from a view is an error, not a panic
+        let mut other = Array1::from(vec![1.0f64, 0.0, 0.0, 0.0]);
+        let mut a = Array1::from(vec![1.0f64, 2.0, 3.0, 4.0]);
+        let (va, vb) = (a.view_mut(), other.view_mut());
+        assert!(matches!(FhtArray::xor_convolve(&va, &vb), Err(FhtError::Unsupported(_))));
+
+        // So is an owned transform; the view and its data are left alone
+        assert!(matches!(FhtArray::fht(&src.view_mut()), Err(FhtError::Unsupported(_))));
+        assert!(matches!(FhtArray::fht(&a.view_mut()), Err(FhtError::Unsupported(_))));
+        assert_eq!(a.as_slice().unwrap(), &[1.0, 2.0, 3.0, 4.0]);
+    }
+
+    #[test]
+    fn test_xor_convolve() {
+        let n = 32;
+        let a: Vec<f64> = (0..n).map(|i| ((i * 3) % 7) as f64 - 3.0).collect();
+        let b: Vec<f64> = (0..n).map(|i| ((i * 5) % 11) as f64 - 5.0).collect();
+        let mut out = vec![0.0; n];
+        let mut scratch = vec![0.0; n];
+        f64::xor_convolve(&a, &b, &mut out, &mut scratch).unwrap();
+
+        for k in 0..n {
+            let expected: f64 = (0..n).map(|i| a[i] * b[i ^ k]).sum();
+            assert_abs_diff_eq!(out[k], expected, epsilon = 1e-9);
+        }
+
+        // In place gives the same result
+        let mut a_inplace = a.clone();
+        f64::xor_convolve_inplace(&mut a_inplace, &b, &mut scratch).unwrap();
+        for k in 0..n {
+            assert_abs_diff_eq!(a_inplace[k], out[k], epsilon = 1e-9);
+        }
+
+        // Batched over Array2 rows matches the single-vector call
+        let rows_a = Array2::from_shape_fn((3, 16), |(i, j)| ((i * 7 + j) % 5) as f32);
+        let rows_b = Array2::from_shape_fn((3, 16), |(i, j)| ((i + j * 3) % 4) as f32);
+        let result = rows_a.xor_convolve(&rows_b).unwrap();
+        let mut row_out = vec![0.0f32; 16];
+        let mut row_scratch = vec![0.0f32; 16];
+        for i in 0..3 {
+            let ra: Vec<f32> = (0..16).map(|j| rows_a[[i, j]]).collect();
+            let rb: Vec<f32> = (0..16).map(|j| rows_b[[i, j]]).collect();
+            f32::xor_convolve(&ra, &rb, &mut row_out, &mut row_scratch).unwrap();
+            for j in 0..16 {
+                assert_abs_diff_eq!(result[[i, j]], row_out[j], epsilon = 1e-3);
+            }
+        }
+
+        // Scratch must match the transform size
+        let mut short = vec![0.0; n / 2];
+        assert!(f64::xor_convolve(&a, &b, &mut out, &mut short).is_err());
+    }
+
     #[test]
     fn test_invalid_size() {
         let mut data = vec![1.0f32, 2.0, 3.0]; // Not power of 2
@@ -0,0 +1,85 @@
+/* Compile-time-size C++ transforms against the runtime ones (C++17; C++20 adds std::span) */
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+#include "fht.h"
+
+/* fht<LogN> against fht(buf, LogN); the unrolled network does the runtime
+ * kernels' additions in another order, so floats get a tolerance */
+template <int LogN, class T>
+static bool test_fixed(const char *name) {
+    const std::size_t n = std::size_t(1) << LogN;
+    std::vector<T> fixed(n), runtime(n);
+    for (std::size_t i = 0; i < n; i++) {
+        fixed[i] = runtime[i] = T((i * 37) % 11) - T(5);
+    }
+    int res = fht<LogN>(fixed.data());
+    res |= fht(runtime.data(), LogN);
+
+    double max_error = 0.0;
+    for (std::size_t i = 0; i < n; i++) {
+        double error = std::fabs(double(fixed[i]) - double(runtime[i]));
+        if (error > max_error) max_error = error;
+    }
+    bool passed = res == 0 && max_error <= (std::is_integral_v<T> ? 0.0 : 1e-6 * n * 5.0);
+    if (!passed) {
+        std::printf("fht<%2d> %-7s: max_error=%.2e ... FAIL\n", LogN, name, max_error);
+    }
+    return passed;
+}
+
+template <class T, int... LogN>
+static bool test_sizes(const char *name, std::integer_sequence<int, LogN...>) {
+    bool passed = (test_fixed<LogN, T>(name) & ...);
+    std::printf("fht<0..%d> %-7s ... %s\n", int(sizeof...(LogN)) - 1, name, passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+/* Past the unrolled sizes: the runtime call by default, and with
+ * FHT_CXX_INLINE_MAX_BYTES=32768 (make test_cxx_inline) the blocked inline
+ * kernel, which then covers 2^12 for every dtype and 2^14 for none */
+template <class T>
+static bool test_blocked(const char *name) {
+    bool passed = test_fixed<8, T>(name) & test_fixed<12, T>(name) & test_fixed<13, T>(name) &
+                  test_fixed<14, T>(name);
+    std::printf("fht<8, 12..14> %-7s ... %s\n", name, passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+static bool test_containers() {
+    std::array<float, 8> a = {1, 0, 0, 0, 0, 0, 0, 0};
+    bool passed = fht(a) == 0 && a[7] == 1.0f;
+    std::array<int64_t, 4> b = {1, 2, 3, 4};
+    passed = passed && fht(b) == 0 && b[0] == 10 && b[3] == 0;
+#if defined(__cpp_lib_span)
+    std::vector<double> v(16, 1.0);
+    passed = passed && fht(std::span<double, 16>(v.data(), 16)) == 0 && v[0] == 16.0 && v[1] == 0.0;
+    passed = passed && fht(std::span<double>(v)) == 0 && v[0] == 16.0 && v[5] == 16.0;
+    passed = passed && fht(std::span<double>(v.data(), 12)) == -1;
+#endif
+    std::printf("std::array/std::span ... %s\n", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+int main() {
+    std::printf("C++ Compile-Time FHT Test\n");
+    std::printf("=========================\n\n");
+
+    /* Two sizes past FHT_CXX_UNROLL_MAX_LOG_N the runtime path takes over */
+    auto sizes = std::make_integer_sequence<int, FHT_CXX_UNROLL_MAX_LOG_N + 3>();
+    bool all_passed = test_sizes<float>("float", sizes);
+    all_passed &= test_sizes<double>("double", sizes);
+    all_passed &= test_sizes<int16_t>("int16", sizes);
+    all_passed &= test_sizes<int32_t>("int32", sizes);
+    all_passed &= test_sizes<int64_t>("int64", sizes);
+    all_passed &= test_blocked<float>("float");
+    all_passed &= test_blocked<double>("double");
+    all_passed &= test_blocked<int16_t>("int16");
+    all_passed &= test_blocked<int32_t>("int32");
+    all_passed &= test_blocked<int64_t>("int64");
+    all_passed &= test_containers();
+
+    std::printf("\n%s\n", all_passed ? "All C++ tests PASSED!" : "Some C++ tests FAILED!");
+    return all_passed ? 0 : 1;
+}
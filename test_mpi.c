@@ -0,0 +1,117 @@
+/* Distributed transform test, e.g. mpirun -np 4 ./test_mpi (any power of two ranks) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fht_mpi.h"
+
+/*
+ * The global input is the outer product x[r * n + i] = a[r] * c[i] of a
+ * length-P rank vector and a length-n block vector, so its transform is
+ * (H a)[r] * (H c)[i] and every rank can check its block without the rest.
+ */
+static double rank_coeff(int r) {
+    return (double)((r * 5) % 7) - 3.0;
+}
+
+static double block_coeff(size_t i) {
+    return (double)((i * 37) % 11) - 5.0;
+}
+
+/* (H a)[r] for the rank vector */
+static double rank_spectrum(int r, int nranks) {
+    double sum = 0.0;
+    for (int s = 0; s < nranks; s++) {
+        sum += __builtin_parity((unsigned)(r & s)) ? -rank_coeff(s) : rank_coeff(s);
+    }
+    return sum;
+}
+
+static int test_mpi_correctness(int is_double, int log_local, MPI_Comm comm) {
+    int rank, nranks;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nranks);
+    size_t n = (size_t)1 << log_local;
+    double *ref = (double *)malloc(n * sizeof(double));
+    void *buf = malloc(n * (is_double ? sizeof(double) : sizeof(float)));
+    int passed = ref != NULL && buf != NULL;
+
+    for (size_t i = 0; passed && i < n; i++) {
+        ref[i] = block_coeff(i);
+        if (is_double) {
+            ((double *)buf)[i] = rank_coeff(rank) * ref[i];
+        } else {
+            ((float *)buf)[i] = (float)(rank_coeff(rank) * ref[i]);
+        }
+    }
+    if (passed) {
+        fht_double(ref, log_local);
+    }
+    int res = is_double ? fht_double_mpi((double *)buf, log_local, comm, 0)
+                        : fht_float_mpi((float *)buf, log_local, comm, 0);
+    passed = passed && res == 0;
+
+    /* Exact for double; float rounds, relative to the largest possible value */
+    double scale = rank_spectrum(rank, nranks);
+    double tol = is_double ? 0.0 : 1e-6 * 5.0 * 3.0 * (double)n * (double)nranks;
+    for (size_t i = 0; passed && i < n; i++) {
+        double got = is_double ? ((double *)buf)[i] : (double)((float *)buf)[i];
+        passed = fabs(got - scale * ref[i]) <= tol;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &passed, 1, MPI_INT, MPI_MIN, comm);
+    if (rank == 0) {
+        printf("%s log_local=%2d x %d ranks ... %s\n", is_double ? "double" : "float ", log_local, nranks,
+               passed ? "PASS" : "FAIL");
+    }
+    free(ref);
+    free(buf);
+    return passed;
+}
+
+/* Ranks that disagree on the size all get -1, without exchanging anything */
+static int test_mpi_errors(MPI_Comm comm) {
+    int rank, nranks;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nranks);
+    float buf[64] = {0};
+    int passed = fht_float_mpi(buf, -1, comm, 0) == -1;
+    if (nranks > 1) {
+        passed = passed && fht_float_mpi(buf, rank == 0 ? 5 : 6, comm, 0) == -1;
+    }
+    passed = passed && fht_float_mpi(buf, FHT_LARGE_MAX_LOG_N + 1, comm, 0) == -1;
+    MPI_Allreduce(MPI_IN_PLACE, &passed, 1, MPI_INT, MPI_MIN, comm);
+    if (rank == 0) {
+        printf("invalid arguments ... %s\n", passed ? "PASS" : "FAIL");
+    }
+    return passed;
+}
+
+int main(int argc, char **argv) {
+    MPI_Init(&argc, &argv);
+    int rank, nranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+    if (rank == 0) {
+        printf("Distributed FHT Test (%d ranks)\n", nranks);
+        printf("===============================\n\n");
+    }
+    if (nranks & (nranks - 1)) {
+        if (rank == 0) {
+            printf("Rank count must be a power of two\n");
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    /* One chunk per stage, a few, and more than FHT_MPI_DEPTH in flight */
+    int all_passed = test_mpi_correctness(0, 0, MPI_COMM_WORLD);
+    all_passed &= test_mpi_correctness(0, 10, MPI_COMM_WORLD);
+    all_passed &= test_mpi_correctness(1, 20, MPI_COMM_WORLD);
+    all_passed &= test_mpi_correctness(0, 23, MPI_COMM_WORLD);
+    all_passed &= test_mpi_errors(MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        printf("\n%s\n", all_passed ? "All MPI tests PASSED!" : "Some MPI tests FAILED!");
+    }
+    MPI_Finalize();
+    return all_passed ? 0 : 1;
+}
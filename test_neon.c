@@ -1,8 +1,15 @@
 /* Simple test program for ARM NEON FHT implementation */
+#define _POSIX_C_SOURCE 200809L  /* open, pread, pwrite for the file tests */
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include <time.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "fht.h"
 
 #define MAX_LOG_N 10
@@ -65,6 +72,1266 @@ static int test_correctness(int log_n) {
     return passed;
 }
 
+static int test_oop_correctness(int log_n) {
+    int n = 1 << log_n;
+    float *in = (float *)malloc(n * sizeof(float));
+    float *orig = (float *)malloc(n * sizeof(float));
+    float *out = (float *)malloc(n * sizeof(float));
+
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        in[i] = orig[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+
+    fht_float_oop(in, out, log_n);
+    fht_naive_float(orig, n);
+
+    /* The input must stay untouched */
+    float max_error = 0.0f;
+    int input_kept = 1;
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        float error = fabsf(out[i] - orig[i]);
+        if (error > max_error) max_error = error;
+        if (in[i] != (float)rand() / RAND_MAX * 2.0f - 1.0f) input_kept = 0;
+    }
+
+    int passed = (max_error < 1e-4f) && input_kept;
+    printf("oop log_n=%2d: max_error=%.2e input %s ... %s\n",
+           log_n, max_error, input_kept ? "kept" : "MODIFIED", passed ? "PASS" : "FAIL");
+
+    free(in);
+    free(orig);
+    free(out);
+
+    return passed;
+}
+
+/* in == out past the out-of-cache block must take the blocked path of
+ * fht_*, so the results match bit for bit (small integers are exact) */
+static int test_oop_inplace_large(void) {
+    int log_f = 18, log_d = 17;
+    size_t nf = (size_t)1 << log_f, nd = (size_t)1 << log_d;
+    float *f1 = (float *)malloc(nf * sizeof(float));
+    float *f2 = (float *)malloc(nf * sizeof(float));
+    double *d1 = (double *)malloc(nd * sizeof(double));
+    double *d2 = (double *)malloc(nd * sizeof(double));
+    for (size_t i = 0; i < nf; i++) {
+        f1[i] = f2[i] = (float)((int)(i * 5 % 3) - 1);
+    }
+    for (size_t i = 0; i < nd; i++) {
+        d1[i] = d2[i] = (double)((int)(i * 3 % 5) - 2);
+    }
+    int passed = fht_float_oop(f1, f1, log_f) == 0 && fht_float(f2, log_f) == 0 &&
+                 memcmp(f1, f2, nf * sizeof(float)) == 0;
+    passed = passed && fht_double_oop(d1, d1, log_d) == 0 && fht_double(d2, log_d) == 0 &&
+             memcmp(d1, d2, nd * sizeof(double)) == 0;
+    printf("oop in == out float log_n=%d, double log_n=%d: ... %s\n", log_f, log_d, passed ? "PASS" : "FAIL");
+    free(f1);
+    free(f2);
+    free(d1);
+    free(d2);
+    return passed;
+}
+
+static int test_batch_correctness(int log_n, int count) {
+    int n = 1 << log_n;
+    int stride = n + 3;  /* padded rows exercise the stride argument */
+    float *buf1 = (float *)malloc(count * stride * sizeof(float));
+    float *buf2 = (float *)malloc(count * stride * sizeof(float));
+
+    srand(42);
+    for (int i = 0; i < count * stride; i++) {
+        buf1[i] = buf2[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+
+    fht_float_batch(buf1, log_n, count, stride);
+    for (int c = 0; c < count; c++) {
+        fht_naive_float(buf2 + c * stride, n);
+    }
+
+    /* Padding must be left untouched, so compare the whole buffer */
+    float max_error = 0.0f;
+    for (int i = 0; i < count * stride; i++) {
+        float error = fabsf(buf1[i] - buf2[i]);
+        if (error > max_error) max_error = error;
+    }
+
+    int passed = (max_error < 1e-4f);
+    printf("batch log_n=%2d x %3d: max_error=%.2e ... %s\n",
+           log_n, count, max_error, passed ? "PASS" : "FAIL");
+
+    free(buf1);
+    free(buf2);
+
+    return passed;
+}
+
+/* Columns of a row-major matrix (batch_stride 1), with padding columns that
+ * must stay untouched; `batch_stride` > 1 exercises the gather path */
+static int test_strided_correctness(int log_n, int cols, int batch_stride) {
+    int n = 1 << log_n;
+    int stride = cols * batch_stride + 5;
+    float *buf1 = (float *)malloc((size_t)n * stride * sizeof(float));
+    float *buf2 = (float *)malloc((size_t)n * stride * sizeof(float));
+    float *col = (float *)malloc(n * sizeof(float));
+
+    srand(42);
+    for (int i = 0; i < n * stride; i++) {
+        buf1[i] = buf2[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+
+    int res = fht_float_strided(buf1, log_n, stride, cols, batch_stride);
+    for (int c = 0; c < cols; c++) {
+        for (int i = 0; i < n; i++) col[i] = buf2[i * stride + c * batch_stride];
+        fht_naive_float(col, n);
+        for (int i = 0; i < n; i++) buf2[i * stride + c * batch_stride] = col[i];
+    }
+
+    float max_error = 0.0f;
+    for (int i = 0; i < n * stride; i++) {
+        float error = fabsf(buf1[i] - buf2[i]);
+        if (error > max_error) max_error = error;
+    }
+
+    int passed = (res == 0) && (max_error < 1e-4f * (log_n > 10 ? 8 : 1));
+    printf("strided log_n=%2d x %3d (batch_stride %d): max_error=%.2e ... %s\n",
+           log_n, cols, batch_stride, max_error, passed ? "PASS" : "FAIL");
+
+    free(buf1);
+    free(buf2);
+    free(col);
+
+    return passed;
+}
+
+/* Only the butterfly stages of the bits in dim_mask, against a stage-by-stage
+ * reference; double also checks the full mask against fht_double */
+static int test_dims_correctness(int log_n, uint32_t dim_mask) {
+    int n = 1 << log_n;
+    float *buf1 = (float *)malloc(n * sizeof(float));
+    float *buf2 = (float *)malloc(n * sizeof(float));
+    double *dbuf1 = (double *)malloc(n * sizeof(double));
+    double *dbuf2 = (double *)malloc(n * sizeof(double));
+
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        buf1[i] = buf2[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+        dbuf1[i] = dbuf2[i] = buf1[i];
+    }
+
+    int res = fht_float_dims(buf1, log_n, dim_mask);
+    for (int s = 0; s < log_n; s++) {
+        if (!(dim_mask >> s & 1)) continue;
+        int h = 1 << s;
+        for (int i = 0; i < n; i++) {
+            if (i & h) continue;
+            float a = buf2[i], b = buf2[i + h];
+            buf2[i] = a + b;
+            buf2[i + h] = a - b;
+        }
+    }
+    uint32_t full = log_n ? ((uint32_t)-1 >> (32 - log_n)) : 0;
+    res |= fht_double_dims(dbuf1, log_n, full);
+    res |= fht_double(dbuf2, log_n);
+
+    float max_error = 0.0f;
+    for (int i = 0; i < n; i++) {
+        float error = fabsf(buf1[i] - buf2[i]);
+        if (error > max_error) max_error = error;
+        error = (float)fabs(dbuf1[i] - dbuf2[i]);
+        if (error > max_error) max_error = error;
+    }
+
+    int passed = (res == 0) && (max_error < 1e-4f);
+    printf("dims log_n=%2d mask=0x%05x: max_error=%.2e ... %s\n",
+           log_n, (unsigned)dim_mask, max_error, passed ? "PASS" : "FAIL");
+
+    free(buf1);
+    free(buf2);
+    free(dbuf1);
+    free(dbuf2);
+
+    return passed;
+}
+
+/* Sparse input and selected outputs against the dense transform, for nnz /
+ * count on both sides of the direct/pruned switch */
+static int test_sparse_correctness(int log_n, int k) {
+    int n = 1 << log_n;
+    float *dense = (float *)calloc(n, sizeof(float));
+    float *spectrum = (float *)malloc(n * sizeof(float));
+    float *input = (float *)malloc(n * sizeof(float));
+    float *reference = (float *)malloc(n * sizeof(float));
+    float *picked = (float *)malloc(k * sizeof(float));
+    float *values = (float *)malloc(k * sizeof(float));
+    size_t *indices = (size_t *)malloc(k * sizeof(size_t));
+
+    srand(42);
+    for (int j = 0; j < k; j++) {
+        indices[j] = (size_t)rand() % n;  /* repeats must add up */
+        values[j] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+        dense[indices[j]] += values[j];
+    }
+    for (int i = 0; i < n; i++) {
+        input[i] = reference[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+
+    int res = fht_float_sparse(indices, values, k, spectrum, log_n);
+    res |= fht_float_select(input, indices, k, picked, log_n, NULL);
+    fht_naive_float(dense, n);
+    fht_naive_float(reference, n);
+
+    float max_error = 0.0f;
+    for (int i = 0; i < n; i++) {
+        float error = fabsf(spectrum[i] - dense[i]);
+        if (error > max_error) max_error = error;
+    }
+    int input_kept = 1;
+    srand(42);
+    for (int j = 0; j < 2 * k; j++) rand();
+    for (int i = 0; i < n; i++) {
+        if (input[i] != (float)rand() / RAND_MAX * 2.0f - 1.0f) input_kept = 0;
+    }
+    for (int j = 0; j < k; j++) {
+        float error = fabsf(picked[j] - reference[indices[j]]);
+        if (error > max_error) max_error = error;
+    }
+
+    int passed = (res == 0) && input_kept && (max_error < 1e-4f * (log_n > 10 ? 8 : 1));
+    printf("sparse log_n=%2d k=%3d: max_error=%.2e ... %s\n",
+           log_n, k, max_error, passed ? "PASS" : "FAIL");
+
+    free(dense);
+    free(spectrum);
+    free(input);
+    free(reference);
+    free(picked);
+    free(values);
+    free(indices);
+
+    return passed;
+}
+
+static size_t reverse_bits(size_t k, int log_n) {
+    size_t r = 0;
+    for (int b = 0; b < log_n; b++) {
+        r = (r << 1) | ((k >> b) & 1);
+    }
+    return r;
+}
+
+/* Paley and sequency output against the natural spectrum at bit-reversed
+ * (Gray-coded) indices, out of place and in place; float and double */
+static int test_ordered_correctness(int log_n) {
+    size_t n = (size_t)1 << log_n;
+    double *natural = (double *)malloc(n * sizeof(double));
+    double *in = (double *)malloc(n * sizeof(double));
+    double *out = (double *)malloc(n * sizeof(double));
+    float *in_f = (float *)malloc(n * sizeof(float));
+    float *out_f = (float *)malloc(n * sizeof(float));
+
+    for (size_t i = 0; i < n; i++) {
+        natural[i] = (double)((i * 37) % 11) - 5.0;
+    }
+    fht_double(natural, log_n);
+    int passed = 1;
+    int orders[] = {FHT_ORDER_NATURAL, FHT_ORDER_SEQUENCY, FHT_ORDER_PALEY};
+    for (int o = 0; o < 3; o++) {
+        for (int inplace = 0; inplace < 2; inplace++) {
+            for (size_t i = 0; i < n; i++) {
+                in[i] = (double)((i * 37) % 11) - 5.0;
+                in_f[i] = (float)in[i];
+            }
+            double *dst = inplace ? in : out;
+            float *dst_f = inplace ? in_f : out_f;
+            passed &= fht_double_ordered(in, dst, log_n, orders[o]) == 0;
+            passed &= fht_float_ordered(in_f, dst_f, log_n, orders[o]) == 0;
+            for (size_t k = 0; passed && k < n; k++) {
+                size_t h = orders[o] == FHT_ORDER_NATURAL ? k
+                         : reverse_bits(orders[o] == FHT_ORDER_SEQUENCY ? k ^ (k >> 1) : k, log_n);
+                /* Integer inputs: double is exact, and so is float up to 2^24 */
+                passed = dst[k] == natural[h] && dst_f[k] == (float)natural[h];
+            }
+        }
+    }
+
+    /* Sequency row k, the ordered transforms of the unit vectors at k, has
+     * k sign changes */
+    for (size_t k = 0; passed && log_n <= 6 && k < n; k++) {
+        int changes = 0;
+        double last = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            memset(in, 0, n * sizeof(double));
+            in[i] = 1.0;
+            fht_double_ordered(in, out, log_n, FHT_ORDER_SEQUENCY);
+            if (i > 0 && out[k] != last) changes++;
+            last = out[k];
+        }
+        passed = changes == (int)k;
+    }
+    passed = passed && fht_float_ordered(in_f, out_f, log_n, 3) == -1 &&
+             fht_double_ordered(in, out, log_n, -1) == -1 && fht_float_ordered(in_f, out_f, -1, 1) == -1;
+    printf("ordered log_n=%2d ... %s\n", log_n, passed ? "PASS" : "FAIL");
+
+    free(natural);
+    free(in);
+    free(out);
+    free(in_f);
+    free(out_f);
+    return passed;
+}
+
+/* Spectrum updates against the transform of the changed input, on both sides
+ * of the direct/sparse switch and over several 8-delta groups */
+static int test_update_correctness(int log_n, int k) {
+    size_t n = (size_t)1 << log_n;
+    float *spectrum = (float *)malloc(n * sizeof(float));
+    float *scratch = (float *)malloc(n * sizeof(float));
+    double *reference = (double *)malloc(n * sizeof(double));
+    float *deltas = (float *)malloc(k * sizeof(float));
+    size_t *indices = (size_t *)malloc(k * sizeof(size_t));
+
+    srand(7);
+    for (size_t i = 0; i < n; i++) {
+        spectrum[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+        reference[i] = spectrum[i];
+    }
+    fht_float(spectrum, log_n);
+    for (int j = 0; j < k; j++) {
+        indices[j] = (size_t)rand() % n;  /* repeats must add up */
+        deltas[j] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+        reference[indices[j]] += deltas[j];
+    }
+    fht_double(reference, log_n);
+
+    /* Odd counts allocate their scratch */
+    int res = fht_float_update(spectrum, log_n, indices, deltas, k, k % 2 ? NULL : scratch);
+
+    double max_error = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double error = fabs(spectrum[i] - reference[i]);
+        if (error > max_error) max_error = error;
+    }
+    int passed = (res == 0) && (max_error < 1e-6 * (double)(n + k) * 8.0);
+
+    /* Out-of-range indices leave the spectrum alone */
+    if (passed && k > 0) {
+        float before = spectrum[0];
+        indices[k - 1] = n;
+        passed = fht_float_update(spectrum, log_n, indices, deltas, k, NULL) == -1 && spectrum[0] == before &&
+                 fht_float_update(spectrum, -1, indices, deltas, 0, NULL) == -1;
+    }
+    printf("update log_n=%2d k=%4d: max_error=%.2e ... %s\n",
+           log_n, k, max_error, passed ? "PASS" : "FAIL");
+
+    free(spectrum);
+    free(scratch);
+    free(reference);
+    free(deltas);
+    free(indices);
+    return passed;
+}
+
+static int test_mt_correctness(int log_n, int nthreads) {
+    int n = 1 << log_n;
+    float *buf1 = (float *)malloc(n * sizeof(float));
+    float *buf2 = (float *)malloc(n * sizeof(float));
+
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        buf1[i] = buf2[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+
+    /* Same butterflies in a different order: compare with the 1-thread path */
+    fht_float_mt(buf1, log_n, nthreads);
+    fht_float(buf2, log_n);
+
+    float max_error = 0.0f;
+    for (int i = 0; i < n; i++) {
+        float error = fabsf(buf1[i] - buf2[i]);
+        if (error > max_error) max_error = error;
+    }
+
+    int passed = (max_error < 1e-2f);
+    printf("mt log_n=%2d x %d threads: max_error=%.2e ... %s\n",
+           log_n, nthreads, max_error, passed ? "PASS" : "FAIL");
+
+    free(buf1);
+    free(buf2);
+
+    return passed;
+}
+
+/* fht_float_mt against fht_float, quietly */
+static int mt_matches(int log_n, int nthreads) {
+    size_t n = (size_t)1 << log_n;
+    float *buf1 = (float *)malloc(n * sizeof(float));
+    float *buf2 = (float *)malloc(n * sizeof(float));
+    int passed = (buf1 != NULL && buf2 != NULL);
+    for (size_t i = 0; passed && i < n; i++) {
+        buf1[i] = buf2[i] = (float)((i * 37) % 17) - 8.0f;
+    }
+    passed = passed && fht_float_mt(buf1, log_n, nthreads) == 0 && fht_float(buf2, log_n) == 0;
+    for (size_t i = 0; passed && i < n; i++) {
+        passed = fabsf(buf1[i] - buf2[i]) <= 1e-3f * fabsf(buf2[i]);
+    }
+    free(buf1);
+    free(buf2);
+    return passed;
+}
+
+static void *mt_pool_thread_main(void *arg) {
+    int passed = 1;
+    for (int r = 0; r < 20; r++) {
+        passed = passed && mt_matches(16 + r % 2, 2 + r % 3);
+    }
+    *(int *)arg = passed;
+    return NULL;
+}
+
+static int test_mt_pool_correctness(void) {
+    /* The pool grows, follows an affinity change, and shares the work with
+     * calls from another thread that find it busy and spawn their own */
+    int passed = mt_matches(17, 2) && mt_matches(17, 5);
+#if defined(__linux__)
+    int cpu0 = 0;
+    passed = passed && fht_set_thread_affinity(&cpu0, 1) == 0 && mt_matches(17, 3);
+    fht_set_thread_affinity(NULL, 0);
+#endif
+    int other = 0;
+    pthread_t thread;
+    passed = passed && pthread_create(&thread, NULL, mt_pool_thread_main, &other) == 0;
+    for (int r = 0; passed && r < 20; r++) {
+        passed = mt_matches(17 - r % 2, 4 - r % 3);
+    }
+    passed = pthread_join(thread, NULL) == 0 && passed && other;
+    printf("mt pool: growth, affinity, concurrent callers ... %s\n", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+static int test_batch_mt_correctness(int log_n, size_t count, size_t stride, size_t batch_stride,
+                                     int nthreads) {
+    int n = 1 << log_n;
+    size_t len = (count - 1) * batch_stride + (size_t)(n - 1) * stride + 1;
+    float *buf1 = (float *)malloc(len * sizeof(float));
+    float *buf2 = (float *)malloc(len * sizeof(float));
+
+    srand(42);
+    for (size_t i = 0; i < len; i++) {
+        buf1[i] = buf2[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+
+    /* Chunks of the batch on several threads against the same call on one */
+    int res = fht_float_strided_mt(buf1, log_n, stride, count, batch_stride, nthreads);
+    fht_float_strided(buf2, log_n, stride, count, batch_stride);
+
+    float max_error = 0.0f;
+    for (size_t i = 0; i < len; i++) {
+        float error = fabsf(buf1[i] - buf2[i]);
+        if (error > max_error) max_error = error;
+    }
+
+    int passed = (res == 0 && max_error < 1e-2f);
+    printf("batch mt log_n=%2d x %zu (stride %zu) x %d threads: max_error=%.2e ... %s\n",
+           log_n, count, stride, nthreads, max_error, passed ? "PASS" : "FAIL");
+
+    free(buf1);
+    free(buf2);
+
+    return passed;
+}
+
+/* Every size a kernel handles differently (masked single registers, the
+ * first pass, radix-16/8/4/2 passes, the recursion above the chunk) and
+ * contiguous and padded batches, float and double, against a double
+ * reference */
+/* Above the L2 block fht.c joins kernel blocks with radix-8/4/2 passes:
+ * 17..22 covers every mix of them. Small integers keep float exact. */
+static int test_out_of_cache_correctness(int log_n) {
+    size_t n = (size_t)1 << log_n;
+    float *f = (float *)malloc(2 * n * sizeof(float));
+    double *d = (double *)malloc(2 * n * sizeof(double));
+    double *ref = (double *)malloc(n * sizeof(double));
+    int passed = (f != NULL && d != NULL && ref != NULL);
+
+    for (size_t i = 0; passed && i < n; i++) {
+        ref[i] = (double)((i * 37) % 11) - 5.0;
+        f[i] = f[n + i] = (float)ref[i];
+        d[i] = d[n + i] = ref[i];
+    }
+    for (size_t h = 1; passed && h < n; h <<= 1) {
+        for (size_t i = 0; i < n; i += 2 * h) {
+            for (size_t j = i; j < i + h; j++) {
+                double a = ref[j], b = ref[j + h];
+                ref[j] = a + b;
+                ref[j + h] = a - b;
+            }
+        }
+    }
+    /* In place, out of place (input in the upper half), batch of one */
+    for (int entry = 0; passed && entry < 3; entry++) {
+        int res = entry == 0   ? fht_float(f, log_n) | fht_double(d, log_n)
+                  : entry == 1 ? fht_float_oop(f + n, f, log_n) | fht_double_oop(d + n, d, log_n)
+                               : fht_float_batch(f, log_n, 1, n) | fht_double_batch(d, log_n, 1, n);
+        if (entry == 2) {
+            /* Transforming twice scales by n */
+            for (size_t i = 0; i < n; i++) {
+                f[i] /= (float)n;
+                d[i] /= (double)n;
+            }
+            res |= fht_float(f, log_n) | fht_double(d, log_n);
+        }
+        for (size_t i = 0; passed && i < n; i++) {
+            passed = res == 0 && f[i] == (float)ref[i] && d[i] == ref[i];
+        }
+        if (!passed) {
+            printf("out of cache log_n=%2d entry %d ... FAIL\n", log_n, entry);
+        }
+        if (entry == 0) {
+            for (size_t i = 0; i < n; i++) {
+                f[i] = f[n + i];
+                d[i] = d[n + i];
+            }
+        }
+    }
+    if (passed) {
+        printf("out of cache log_n=%2d: in place, oop, batch ... PASS\n", log_n);
+    }
+
+    free(f);
+    free(d);
+    free(ref);
+    return passed;
+}
+
+/* Out-of-core transform of a file region after a 12-byte header, with
+ * budgets for one in-memory tile, many one-stage passes and two-stage
+ * passes across 1 MiB segments */
+static int test_file_correctness(int is_double, int log_n, size_t mem_bytes) {
+    const char *path = "test_neon_file.bin";
+    const size_t header = 12;
+    size_t n = (size_t)1 << log_n, elem = is_double ? sizeof(double) : sizeof(float);
+    unsigned char *bytes = (unsigned char *)malloc(16 + n * elem);
+    unsigned char *back = (unsigned char *)malloc(header + n * elem);
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    int passed = (bytes != NULL && back != NULL && fd >= 0);
+
+    for (size_t i = 0; passed && i < header; i++) {
+        bytes[i] = (unsigned char)(0xA0 + i);
+    }
+    for (size_t i = 0; passed && i < n; i++) {
+        double v = (double)((i * 37) % 11) - 5.0;
+        if (is_double) {
+            memcpy(bytes + header + i * elem, &v, elem);
+        } else {
+            float f = (float)v;
+            memcpy(bytes + header + i * elem, &f, elem);
+        }
+    }
+    passed = passed && pwrite(fd, bytes, header + n * elem, 0) == (ssize_t)(header + n * elem);
+    int res = is_double ? fht_double_file(fd, header, log_n, mem_bytes, 2)
+                        : fht_float_file(fd, header, log_n, mem_bytes, 2);
+    passed = passed && res == 0 && pread(fd, back, header + n * elem, 0) == (ssize_t)(header + n * elem);
+
+    /* Same result as in memory (exact for small integers); header intact */
+    if (passed) {
+        memmove(bytes + 16, bytes + header, n * elem);  /* aligned for double */
+        res = is_double ? fht_double((double *)(void *)(bytes + 16), log_n)
+                        : fht_float((float *)(void *)(bytes + 16), log_n);
+        passed = res == 0 && memcmp(back, bytes, header) == 0 && memcmp(back + header, bytes + 16, n * elem) == 0;
+    }
+    printf("file %s log_n=%2d mem %8zu: %s\n", is_double ? "double" : "float ", log_n, mem_bytes,
+           passed ? "PASS" : "FAIL");
+
+    if (fd >= 0) {
+        close(fd);
+    }
+    remove(path);
+    free(bytes);
+    free(back);
+    return passed;
+}
+
+/* A file shorter than the vector is an I/O error; bad arguments EINVAL */
+static int test_file_errors(void) {
+    const char *path = "test_neon_file.bin";
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    float zeros[64] = {0};
+    int passed = fd >= 0 && pwrite(fd, zeros, sizeof(zeros), 0) == (ssize_t)sizeof(zeros);
+    passed = passed && fht_float_file(fd, 0, 7, 1 << 20, 1) == -1 && errno == EIO;
+    passed = passed && fht_float_file(-1, 0, 6, 1 << 20, 1) == -1 && errno == EINVAL;
+    passed = passed && fht_float_file(fd, 0, FHT_LARGE_MAX_LOG_N + 1, 1 << 20, 1) == -1;
+    passed = passed && fht_float_file(fd, 0, 6, 1 << 20, 1) == 0;
+    passed = passed && fht_float_large(zeros, 6) == 0 && fht_double_large(NULL, FHT_LARGE_MAX_LOG_N + 1) == -1;
+    printf("file errors: short file, bad fd, too large ... %s\n", passed ? "PASS" : "FAIL");
+    if (fd >= 0) {
+        close(fd);
+    }
+    remove(path);
+    return passed;
+}
+
+static int test_kernel_correctness(const char *name) {
+    if (fht_select_kernel(name) != 0) {
+        printf("kernel %-6s: not supported here, skipped\n", name);
+        return 1;
+    }
+    const int max_log_n = 16, count = 5;
+    size_t max_n = (size_t)1 << max_log_n;
+    float *f = (float *)malloc((count * max_n + 3 * count) * sizeof(float));
+    double *d = (double *)malloc((count * max_n + 3 * count) * sizeof(double));
+    double *ref = (double *)malloc((count * max_n + 3 * count) * sizeof(double));
+    int passed = (f != NULL && d != NULL && ref != NULL);
+    double worst = 0.0;
+
+    for (int log_n = 0; passed && log_n <= max_log_n; log_n++) {
+        size_t n = (size_t)1 << log_n;
+        for (int layout = 0; passed && layout < 3; layout++) {
+            /* Single vector, back-to-back batch, padded batch */
+            size_t vecs = layout == 0 ? 1 : (size_t)count, stride = layout == 2 ? n + 3 : n;
+            size_t total = vecs * stride;
+            srand(7 + log_n);
+            for (size_t i = 0; i < total; i++) {
+                ref[i] = (double)rand() / RAND_MAX * 2.0 - 1.0;
+                f[i] = (float)ref[i];
+                d[i] = ref[i];
+            }
+            int res = layout == 0 ? fht_float(f, log_n) | fht_double(d, log_n)
+                                  : fht_float_batch(f, log_n, vecs, stride) | fht_double_batch(d, log_n, vecs, stride);
+            for (size_t v = 0; v < vecs; v++) {
+                double *x = ref + v * stride;
+                for (size_t h = 1; h < n; h <<= 1) {
+                    for (size_t i = 0; i < n; i += 2 * h) {
+                        for (size_t j = i; j < i + h; j++) {
+                            double a = x[j], b = x[j + h];
+                            x[j] = a + b;
+                            x[j + h] = a - b;
+                        }
+                    }
+                }
+            }
+            /* Padding included: it must come back untouched */
+            double err_f = 0.0, err_d = 0.0;
+            for (size_t i = 0; i < total; i++) {
+                if (fabs(f[i] - ref[i]) > err_f) err_f = fabs(f[i] - ref[i]);
+                if (fabs(d[i] - ref[i]) > err_d) err_d = fabs(d[i] - ref[i]);
+            }
+            double scale = sqrt((double)n);
+            if (err_f / scale > worst) worst = err_f / scale;
+            passed = res == 0 && err_f < 1e-5 * scale * (log_n + 1) && err_d < 1e-12 * scale * (log_n + 1);
+            if (!passed) {
+                printf("kernel %-6s log_n=%2d layout %d: float error %.2e, double error %.2e\n", name, log_n,
+                       layout, err_f, err_d);
+            }
+        }
+    }
+    printf("kernel %-6s: log_n 0..%d, single/batch/padded: worst float error %.2e * sqrt(n) ... %s\n", name,
+           max_log_n, worst, passed ? "PASS" : "FAIL");
+
+    fht_select_kernel(NULL);
+    free(f);
+    free(d);
+    free(ref);
+    return passed;
+}
+
+static void *stats_thread_main(void *arg) {
+    fht_float((float *)arg, 6);
+    return NULL;
+}
+
+static int test_stats_correctness(void) {
+    static fht_stats st;  /* too big for some thread stacks */
+    float *buf = (float *)calloc((size_t)1 << 17, sizeof(float));
+    int passed = (buf != NULL);
+    int was = fht_stats_enable(1);
+    fht_stats_reset(1);
+
+    /* Three in-place calls, one batch of four and one oop */
+    for (int i = 0; passed && i < 3; i++) {
+        passed = fht_float(buf, 10) == 0;
+    }
+    passed = passed && fht_float_batch(buf, 8, 4, 256) == 0 && fht_double_oop((double *)buf, (double *)buf + 64, 6) == 0;
+    passed = passed && fht_stats_snapshot(&st, 0) == 0;
+    const fht_stats_counter *c = &st.counters[0][FHT_STATS_INPLACE][10];
+    uint64_t hist_calls = 0;
+    for (int b = 0; b < FHT_STATS_HIST_BINS; b++) {
+        hist_calls += c->hist[b];
+    }
+    passed = passed && c->calls == 3 && c->bytes == 3 * 4096 && c->ns > 0 && hist_calls == 3;
+    passed = passed && st.counters[0][FHT_STATS_BATCH][8].calls == 1 && st.counters[0][FHT_STATS_BATCH][8].bytes == 4096;
+    passed = passed && st.counters[1][FHT_STATS_OOP][6].bytes == 2 * 512;
+    passed = passed && st.kernel[0][10] != NULL && strcmp(fht_stats_entry_name(FHT_STATS_MT), "mt") == 0;
+
+    /* An _mt call counts once, not as the transforms it runs on its workers */
+    passed = passed && fht_float_mt(buf, 17, 2) == 0 && fht_stats_snapshot(&st, 0) == 0;
+    passed = passed && st.counters[0][FHT_STATS_MT][17].calls == 1 && st.counters[0][FHT_STATS_INPLACE][17].calls == 0;
+    passed = passed && st.counters[0][FHT_STATS_INPLACE][10].calls == 3;
+    fht_stats_snapshot(&st, 1);
+    passed = passed && st.counters[0][FHT_STATS_INPLACE][5].calls == 0;
+
+    /* So does a composite call: one XOR convolution and one argmax at 2^10,
+     * not the half-size batches and the inverse they run. Other dtypes
+     * count in their own rows */
+    double *d = (double *)buf;
+    size_t at;
+    passed = passed && fht_xor_convolve_double(d, d + 1024, d + 2048, 10, d + 3072) == 0 &&
+             fht_double_argmax(d, 10, &at) == 0 && fht_int16((int16_t *)buf, 4) == 0 &&
+             fht_stats_snapshot(&st, 0) == 0;
+    passed = passed && st.counters[1][FHT_STATS_XOR][10].calls == 1 && st.counters[1][FHT_STATS_XOR][10].bytes == 2 * 8192;
+    passed = passed && st.counters[1][FHT_STATS_REDUCE][10].calls == 1 && st.counters[1][FHT_STATS_INPLACE][9].calls == 0 &&
+             st.counters[1][FHT_STATS_BATCH][9].calls == 0 && st.counters[1][FHT_STATS_SCALED][10].calls == 0;
+    passed = passed && st.counters[FHT_STATS_I16][FHT_STATS_INPLACE][4].calls == 1 &&
+             st.counters[FHT_STATS_I16][FHT_STATS_INPLACE][4].bytes == 32 && st.counters[0][FHT_STATS_INPLACE][4].calls == 0;
+
+    /* Another thread counts on its own; its counts outlive it */
+    pthread_t thread;
+    passed = passed && pthread_create(&thread, NULL, stats_thread_main, buf) == 0 && pthread_join(thread, NULL) == 0;
+    passed = passed && fht_stats_snapshot(&st, 0) == 0 && st.counters[0][FHT_STATS_INPLACE][6].calls == 0;
+    passed = passed && fht_stats_snapshot(&st, 1) == 0 && st.counters[0][FHT_STATS_INPLACE][6].calls == 1 &&
+             st.counters[0][FHT_STATS_INPLACE][10].calls == 3;
+
+    /* Disabled: nothing is recorded; reset zeroes */
+    fht_stats_enable(0);
+    passed = passed && fht_float(buf, 10) == 0 && fht_stats_snapshot(&st, 0) == 0 &&
+             st.counters[0][FHT_STATS_INPLACE][10].calls == 3;
+    fht_stats_reset(1);
+    passed = passed && fht_stats_snapshot(&st, 1) == 0 && st.counters[0][FHT_STATS_INPLACE][10].calls == 0 &&
+             st.counters[0][FHT_STATS_INPLACE][6].calls == 0;
+    printf("stats: per-thread counts, histogram, _mt and composite nesting ... %s\n", passed ? "PASS" : "FAIL");
+
+    fht_stats_enable(was);
+    free(buf);
+    return passed;
+}
+
+static int test_wisdom_correctness(void) {
+    const char *path = "test_neon_wisdom.txt";
+    /* Untuned choice (the AVX-512 policy can differ from fht_kernel_name) */
+    const char *untuned = fht_tuned_kernel_name(8, 0);
+    int passed = (fht_tune(17, 2) == 0);
+
+    /* The tuned kernel is one this CPU runs, and results do not change */
+    char tuned[2][16];
+    passed = passed && test_correctness(8) && test_mt_correctness(17, 0);
+    snprintf(tuned[0], sizeof(tuned[0]), "%s", fht_tuned_kernel_name(8, 0));
+    snprintf(tuned[1], sizeof(tuned[1]), "%s", fht_tuned_kernel_name(17, 1));
+
+    /* Save, forget and load again: the same choices come back */
+    passed = passed && fht_wisdom_save(path) == 0;
+    fht_wisdom_forget();
+    passed = passed && strcmp(fht_tuned_kernel_name(8, 0), untuned) == 0;
+    passed = passed && fht_wisdom_load(path) == 0;
+    passed = passed && strcmp(fht_tuned_kernel_name(8, 0), tuned[0]) == 0 &&
+             strcmp(fht_tuned_kernel_name(17, 1), tuned[1]) == 0;
+
+    /* A kernel forced by name wins over the wisdom */
+    passed = passed && fht_select_kernel(fht_kernel_name()) == 0 &&
+             strcmp(fht_tuned_kernel_name(8, 0), fht_kernel_name()) == 0;
+    fht_select_kernel(NULL);
+
+    /* Tuning forces each candidate in turn, then restores the caller's
+     * choice: none here, so 2^8 (outside the range) keeps its wisdom */
+    passed = passed && fht_tune(4, 1) == 0 && strcmp(fht_tuned_kernel_name(8, 0), tuned[0]) == 0;
+
+    /* The timing calls stay out of this thread's counts, and counting
+     * stays on and resumes afterwards */
+    static fht_stats st;
+    int was = fht_stats_enable(1);
+    fht_stats_reset(0);
+    float one[16] = {1.0f};
+    if (was >= 0) {
+        passed = passed && fht_tune(4, 1) == 0 && fht_stats_enable(1) == 1 && fht_stats_snapshot(&st, 0) == 0 &&
+                 st.counters[0][FHT_STATS_INPLACE][4].calls == 0;
+        passed = passed && fht_float(one, 4) == 0 && fht_stats_snapshot(&st, 0) == 0 &&
+                 st.counters[0][FHT_STATS_INPLACE][4].calls == 1;
+        fht_stats_reset(0);
+        fht_stats_enable(was);
+    }
+
+    passed = passed && fht_wisdom_load("does/not/exist") == -1 && fht_tune(31, 1) == -1;
+    printf("wisdom: tuned 2^8 float: %s, 2^17 double: %s ... %s\n", tuned[0], tuned[1],
+           passed ? "PASS" : "FAIL");
+
+    remove(path);
+    fht_wisdom_forget();
+    return passed;
+}
+
+static int test_scaled_correctness(int log_n) {
+    int n = 1 << log_n;
+    float *buf1 = (float *)malloc(n * sizeof(float));
+    float *buf2 = (float *)malloc(n * sizeof(float));
+    float scale = 1.0f / sqrtf((float)n);
+
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        buf1[i] = buf2[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+
+    fht_float_orthonormal(buf1, log_n);
+    fht_naive_float(buf2, n);
+
+    float max_error = 0.0f;
+    for (int i = 0; i < n; i++) {
+        float error = fabsf(buf1[i] - buf2[i] * scale);
+        if (error > max_error) max_error = error;
+    }
+
+    /* Both the inverse of the plain transform and a second orthonormal
+     * transform give the input back */
+    fht_float_inverse(buf2, log_n);
+    fht_float_orthonormal(buf1, log_n);
+    for (int i = 0; i < n; i++) {
+        float error = fabsf(buf1[i] - buf2[i]);
+        if (error > max_error) max_error = error;
+    }
+
+    /* Batched: three vectors one element apart, each scaled as the single
+     * call scales it */
+    size_t stride = (size_t)n + 1;
+    float *batch = (float *)malloc(3 * stride * sizeof(float));
+    float *copy = (float *)malloc(3 * stride * sizeof(float));
+    for (size_t i = 0; i < 3 * stride; i++) {
+        batch[i] = copy[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+    if (fht_float_scaled_batch(batch, log_n, 3, stride, 0.5f) != 0) {
+        max_error = 1.0f;
+    }
+    for (int v = 0; v < 3; v++) {
+        fht_float_scaled(copy + v * stride, log_n, 0.5f);
+        for (int i = 0; i < n; i++) {
+            float error = fabsf(batch[v * stride + i] - copy[v * stride + i]);
+            if (error > max_error) max_error = error;
+        }
+    }
+    free(batch);
+    free(copy);
+
+    int passed = (max_error < 1e-4f);
+    printf("scaled log_n=%2d: max_error=%.2e ... %s\n",
+           log_n, max_error, passed ? "PASS" : "FAIL");
+
+    free(buf1);
+    free(buf2);
+
+    return passed;
+}
+
+/* Past the out-of-cache block the halves take the blocked path; small
+ * integers keep the results exact, so they must match fht_* bit for bit */
+static int test_stream_large(void) {
+    int log_f = 18, log_d = 17;
+    size_t nf = (size_t)1 << log_f, nd = (size_t)1 << log_d;
+    float *f1 = (float *)malloc(nf * sizeof(float));
+    float *f2 = (float *)malloc(nf * sizeof(float));
+    double *d1 = (double *)malloc(nd * sizeof(double));
+    double *d2 = (double *)malloc(nd * sizeof(double));
+    for (size_t i = 0; i < nf; i++) {
+        f1[i] = f2[i] = (float)((int)(i * 7 % 5) - 2);
+    }
+    for (size_t i = 0; i < nd; i++) {
+        d1[i] = d2[i] = (double)((int)(i * 3 % 7) - 3);
+    }
+    int passed = fht_float_stream(f1, log_f) == 0 && fht_float(f2, log_f) == 0 &&
+                 memcmp(f1, f2, nf * sizeof(float)) == 0;
+    passed = passed && fht_double_stream(d1, log_d) == 0 && fht_double(d2, log_d) == 0 &&
+             memcmp(d1, d2, nd * sizeof(double)) == 0;
+    printf("stream float log_n=%d, double log_n=%d: ... %s\n", log_f, log_d, passed ? "PASS" : "FAIL");
+    free(f1);
+    free(f2);
+    free(d1);
+    free(d2);
+    return passed;
+}
+
+static int test_stream_correctness(int log_n) {
+    int n = 1 << log_n;
+    /* One element in, so the non-temporal stores need their alignment peel */
+    float *mem = (float *)malloc((n + 1) * sizeof(float));
+    float *buf1 = mem + 1;
+    float *buf2 = (float *)malloc(n * sizeof(float));
+
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        buf1[i] = buf2[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+
+    fht_float_stream(buf1, log_n);
+    fht_naive_float(buf2, n);
+
+    float max_error = 0.0f;
+    for (int i = 0; i < n; i++) {
+        float error = fabsf(buf1[i] - buf2[i]);
+        if (error > max_error) max_error = error;
+    }
+
+    int passed = (max_error < 1e-3f * (1 << (log_n / 2)));
+    printf("stream log_n=%2d: max_error=%.2e ... %s\n",
+           log_n, max_error, passed ? "PASS" : "FAIL");
+
+    free(mem);
+    free(buf2);
+
+    return passed;
+}
+
+/* Copies above FAST_COPY_STREAM_THRESHOLD, at every destination alignment */
+static int test_fast_copy_stream(void) {
+    size_t bytes = FAST_COPY_STREAM_THRESHOLD + 100;
+    unsigned char *src = (unsigned char *)malloc(bytes + 64);
+    unsigned char *dst = (unsigned char *)malloc(bytes + 64);
+    int passed = 1;
+
+    for (size_t i = 0; i < bytes + 64; i++) {
+        src[i] = (unsigned char)(i * 131 + 7);
+    }
+    for (size_t off = 0; off < 64 && passed; off += 7) {
+        memset(dst, 0, bytes + 64);
+        fast_copy(dst + off, src + 3, bytes);
+        passed = memcmp(dst + off, src + 3, bytes) == 0 && dst[off + bytes] == 0;
+    }
+    printf("fast_copy stream: %zu bytes ... %s\n", bytes, passed ? "PASS" : "FAIL");
+
+    free(src);
+    free(dst);
+
+    return passed;
+}
+
+/* Walsh spectrum straight from the definition, exact for small n */
+static int64_t walsh_naive(const int64_t *x, int n, int k) {
+    int64_t sum = 0;
+    for (int i = 0; i < n; i++) {
+        int parity = 0;
+        for (int bits = i & k; bits; bits &= bits - 1) parity ^= 1;
+        sum += parity ? -x[i] : x[i];
+    }
+    return sum;
+}
+
+static int test_int_correctness(int log_n) {
+    int n = 1 << log_n;
+    int64_t *ref = (int64_t *)malloc(n * sizeof(int64_t));
+    int16_t *buf16 = (int16_t *)malloc(n * sizeof(int16_t));
+    int32_t *buf32 = (int32_t *)malloc(n * sizeof(int32_t));
+    int64_t *buf64 = (int64_t *)malloc(n * sizeof(int64_t));
+
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        ref[i] = rand() % 3 - 1;
+        buf16[i] = (int16_t)ref[i];
+        buf32[i] = (int32_t)ref[i];
+        buf64[i] = ref[i] * ((int64_t)1 << 32);  /* exercises the upper half of each lane */
+    }
+
+    int saturated = fht_int16(buf16, log_n);
+    fht_int32(buf32, log_n);
+    fht_int64(buf64, log_n);
+
+    int passed = !saturated;
+    for (int k = 0; k < n && passed; k++) {
+        int64_t expected = walsh_naive(ref, n, k);
+        passed = buf16[k] == expected && buf32[k] == expected && buf64[k] == expected * ((int64_t)1 << 32);
+    }
+
+    printf("int log_n=%2d: %s\n", log_n, passed ? "PASS" : "FAIL");
+
+    free(ref);
+    free(buf16);
+    free(buf32);
+    free(buf64);
+
+    return passed;
+}
+
+/* Above the iterative chunk the three widths must still agree; int16 must
+ * report saturation when the spectrum does not fit */
+static int test_int_large(int log_n) {
+    int n = 1 << log_n;
+    int16_t *buf16 = (int16_t *)malloc(n * sizeof(int16_t));
+    int32_t *buf32 = (int32_t *)malloc(n * sizeof(int32_t));
+    int64_t *buf64 = (int64_t *)malloc(n * sizeof(int64_t));
+
+    srand(7);
+    for (int i = 0; i < n; i++) {
+        buf16[i] = (int16_t)(rand() % 3 - 1);
+        buf32[i] = buf16[i];
+        buf64[i] = buf16[i];
+    }
+
+    int saturated = fht_int16(buf16, log_n);
+    fht_int32(buf32, log_n);
+    fht_int64(buf64, log_n);
+
+    int passed = !saturated;
+    for (int k = 0; k < n && passed; k++) {
+        passed = buf16[k] == buf32[k] && buf32[k] == buf64[k];
+    }
+
+    for (int i = 0; i < n; i++) {
+        buf16[i] = 1;
+    }
+    passed = passed && fht_int16(buf16, log_n) == 1 && buf16[0] == INT16_MAX;
+
+    printf("int log_n=%2d (recursive): %s\n", log_n, passed ? "PASS" : "FAIL");
+
+    free(buf16);
+    free(buf32);
+    free(buf64);
+
+    return passed;
+}
+
+/* Normal fp16 / bf16 bit patterns to float (the tests only produce those) */
+static float half_bits_value(uint16_t h) {
+    int exp = (h >> 10) & 0x1F;
+    float v = (exp == 0) ? 0.0f : ldexpf(1.0f + (h & 0x3FF) / 1024.0f, exp - 15);
+    return (h & 0x8000) ? -v : v;
+}
+
+static float bf16_bits_value(uint16_t h) {
+    uint32_t bits = (uint32_t)h << 16;
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+/* Inputs in {-1, 0, 1}: up to log_n 16 every fp16 value is an integer below
+ * 2048, so fht_half must match the int32 transform exactly, also across the
+ * gather pass above 2^12. Otherwise the check is one rounding per pass:
+ * 2^-10 relative for fp16, 2^-7 for bf16 */
+static int test_half_correctness(int log_n) {
+    int n = 1 << log_n;
+    uint16_t *half = (uint16_t *)malloc(n * sizeof(uint16_t));
+    uint16_t *bf16 = (uint16_t *)malloc(n * sizeof(uint16_t));
+    int32_t *ref = (int32_t *)malloc(n * sizeof(int32_t));
+    static const uint16_t half_of[3] = {0xBC00, 0x0000, 0x3C00};
+    static const uint16_t bf16_of[3] = {0xBF80, 0x0000, 0x3F80};
+
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        int v = rand() % 3;
+        half[i] = half_of[v];
+        bf16[i] = bf16_of[v];
+        ref[i] = v - 1;
+    }
+
+    fht_half(half, log_n);
+    fht_bf16(bf16, log_n);
+    fht_int32(ref, log_n);
+
+    int passes = (log_n <= 12) ? 1 : 1 + (log_n - 12 + 6) / 7;
+    float max_ref = 1.0f, max_error = 0.0f, max_half_error = 0.0f;
+    for (int i = 0; i < n; i++) {
+        float error = fabsf(bf16_bits_value(bf16[i]) - (float)ref[i]);
+        if (error > max_error) max_error = error;
+        error = fabsf(half_bits_value(half[i]) - (float)ref[i]);
+        if (error > max_half_error) max_half_error = error;
+        if (fabsf((float)ref[i]) > max_ref) max_ref = fabsf((float)ref[i]);
+    }
+    int passed = (max_error <= max_ref * passes / 128.0f);
+    if (log_n <= 16) {
+        passed &= (max_half_error == 0.0f);
+    } else {
+        passed &= (max_half_error <= max_ref * passes / 1024.0f);
+    }
+
+    printf("half/bf16 log_n=%2d: bf16 rel_error=%.2e ... %s\n",
+           log_n, max_error / max_ref, passed ? "PASS" : "FAIL");
+
+    free(half);
+    free(bf16);
+    free(ref);
+
+    return passed;
+}
+
+static int test_xor_convolve_correctness(int log_n) {
+    int n = 1 << log_n;
+    float *a = (float *)malloc(n * sizeof(float));
+    float *b = (float *)malloc(n * sizeof(float));
+    float *out = (float *)malloc(n * sizeof(float));
+    float *scratch = (float *)malloc(n * sizeof(float));
+
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        a[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+        b[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+
+    fht_xor_convolve_float(a, b, out, log_n, scratch);
+
+    /* Direct O(n^2) definition */
+    float max_error = 0.0f;
+    for (int k = 0; k < n; k++) {
+        double sum = 0.0;
+        for (int i = 0; i < n; i++) {
+            sum += (double)a[i] * b[i ^ k];
+        }
+        float error = fabsf(out[k] - (float)sum);
+        if (error > max_error) max_error = error;
+    }
+
+    int passed = (max_error < 1e-3f);
+    printf("xor_convolve log_n=%2d: max_error=%.2e ... %s\n",
+           log_n, max_error, passed ? "PASS" : "FAIL");
+
+    free(a);
+    free(b);
+    free(out);
+    free(scratch);
+
+    return passed;
+}
+
+/* (H D)^3 with packed signs against flip-then-transform rounds, batched and scaled */
+static int test_hd_correctness(int log_n, int count) {
+    size_t n = (size_t)1 << log_n;
+    size_t words = log_n > 6 ? n / 64 : 1;
+    const int rounds = 3;
+    uint64_t *signs = (uint64_t *)malloc(rounds * words * sizeof(uint64_t));
+    float *f = (float *)malloc(count * n * sizeof(float));
+    double *d = (double *)malloc(count * n * sizeof(double));
+    double *ref = (double *)malloc(count * n * sizeof(double));
+
+    srand(7);
+    for (size_t w = 0; w < rounds * words; w++) {
+        signs[w] = ((uint64_t)rand() << 40) ^ ((uint64_t)rand() << 20) ^ (uint64_t)rand();
+    }
+    for (size_t i = 0; i < count * n; i++) {
+        ref[i] = d[i] = (double)((i * 37) % 11) - 5.0;
+        f[i] = (float)ref[i];
+    }
+    for (int v = 0; v < count; v++) {
+        for (int r = 0; r < rounds; r++) {
+            for (size_t i = 0; i < n; i++) {
+                if ((signs[r * words + i / 64] >> (i % 64)) & 1) {
+                    ref[v * n + i] = -ref[v * n + i];
+                }
+            }
+            fht_double(ref + v * n, log_n);
+        }
+    }
+
+    /* The scale comes out exactly: a power of two */
+    float scale = 1.0f / 8.0f;
+    int res = fht_float_hd_batch(f, log_n, count, n, signs, rounds, scale);
+    res |= count == 1 ? fht_double_hd(d, log_n, signs, rounds)
+                      : fht_double_hd_batch(d, log_n, count, n, signs, rounds, 1.0);
+    double max_error = 0.0, max_ref = 1.0;
+    for (size_t i = 0; i < count * n; i++) {
+        double ef = fabs((double)f[i] / scale - ref[i]);
+        double ed = fabs(d[i] - ref[i]);
+        if (ef > max_error) max_error = ef;
+        if (ed > max_error) max_error = ed;
+        if (fabs(ref[i]) > max_ref) max_ref = fabs(ref[i]);
+    }
+
+    int passed = res == 0 && max_error <= 1e-6 * max_ref * (log_n + 1);
+    printf("hd log_n=%2d x %d: max_error=%.2e ... %s\n", log_n, count, max_error, passed ? "PASS" : "FAIL");
+
+    free(signs);
+    free(f);
+    free(d);
+    free(ref);
+
+    return passed;
+}
+
+/* Reference order for the reductions: larger magnitude first, then lower index */
+static const double *reduce_ref;
+static int reduce_ref_order(const void *a, const void *b) {
+    size_t i = *(const size_t *)a, j = *(const size_t *)b;
+    double x = fabs(reduce_ref[i]), y = fabs(reduce_ref[j]);
+    if (x != y) return x > y ? -1 : 1;
+    return i < j ? -1 : (i > j);
+}
+
+/* argmax, top-k and threshold against a sort of the reference spectrum. The
+ * integer input has many equal magnitudes, and every value is exact in
+ * float, so the indices must match exactly, ties included. */
+static int test_reduce_correctness(int log_n, int count) {
+    size_t n = (size_t)1 << log_n, stride = n + 16;
+    size_t k = n < 5 ? n : 5, capacity = n < 4 ? n : 4;
+    float *f = (float *)malloc(count * stride * sizeof(float));
+    double *d = (double *)malloc(count * stride * sizeof(double));
+    double *ref = (double *)malloc(n * sizeof(double));
+    size_t *order = (size_t *)malloc(n * sizeof(size_t));
+    size_t *got = (size_t *)malloc(count * 4 * (k + capacity + 2) * sizeof(size_t));
+    size_t *top_f = got, *top_d = top_f + count * k, *hit_f = top_d + count * k;
+    size_t *hit_d = hit_f + count * capacity, *arg_f = hit_d + count * capacity, *arg_d = arg_f + count;
+    size_t *cnt_f = arg_d + count, *cnt_d = cnt_f + count;
+
+    for (size_t i = 0; i < count * stride; i++) {
+        d[i] = (double)((i * 37 + i / 5) % 11) - 5.0;
+        f[i] = (float)d[i];
+    }
+    float *f2 = (float *)malloc(count * stride * sizeof(float));
+    double *d2 = (double *)malloc(count * stride * sizeof(double));
+    float *f3 = (float *)malloc(count * stride * sizeof(float));
+    double *d3 = (double *)malloc(count * stride * sizeof(double));
+    memcpy(f2, f, count * stride * sizeof(float));
+    memcpy(f3, f, count * stride * sizeof(float));
+    memcpy(d2, d, count * stride * sizeof(double));
+    memcpy(d3, d, count * stride * sizeof(double));
+
+    int res = fht_float_topk_batch(f, log_n, count, stride, k, top_f);
+    res |= fht_double_topk_batch(d, log_n, count, stride, k, top_d);
+    res |= fht_float_argmax_batch(f2, log_n, count, stride, arg_f);
+    res |= count == 1 ? fht_double_argmax(d2, log_n, arg_d) : fht_double_argmax_batch(d2, log_n, count, stride, arg_d);
+
+    int passed = res == 0;
+    for (int v = 0; passed && v < count; v++) {
+        for (size_t i = 0; i < n; i++) {
+            size_t g = v * stride + i;
+            ref[i] = (double)((g * 37 + g / 5) % 11) - 5.0;
+            order[i] = i;
+        }
+        fht_double(ref, log_n);
+        reduce_ref = ref;
+        qsort(order, n, sizeof(size_t), reduce_ref_order);
+
+        /* The threshold of the k-th largest magnitude, so there are ties at it */
+        double t = fabs(ref[order[k - 1]]);
+        size_t cnt = 0, low[4];
+        for (size_t i = 0; i < n; i++) {
+            if (fabs(ref[i]) >= t) {
+                if (cnt < capacity) low[cnt] = i;
+                cnt++;
+            }
+        }
+        res = fht_float_threshold_batch(f3 + v * stride, log_n, 1, 0, (float)t, hit_f + v * capacity, capacity,
+                                        cnt_f + v);
+        res |= fht_double_threshold(d3 + v * stride, log_n, t, hit_d + v * capacity, capacity, cnt_d + v);
+        passed = res == 0 && arg_f[v] == order[0] && arg_d[v] == order[0] && cnt_f[v] == cnt && cnt_d[v] == cnt;
+        for (size_t j = 0; passed && j < k; j++) {
+            passed = top_f[v * k + j] == order[j] && top_d[v * k + j] == order[j];
+        }
+        for (size_t j = 0; passed && j < (cnt < capacity ? cnt : capacity); j++) {
+            passed = hit_f[v * capacity + j] == low[j] && hit_d[v * capacity + j] == low[j];
+        }
+        /* The spectrum stays in the buffer */
+        for (size_t i = 0; passed && i < n; i++) {
+            passed = (double)f[v * stride + i] == ref[i] && d2[v * stride + i] == ref[i] &&
+                     (double)f3[v * stride + i] == ref[i];
+        }
+    }
+    printf("argmax/topk/threshold log_n=%2d x %d ... %s\n", log_n, count, passed ? "PASS" : "FAIL");
+
+    free(f);
+    free(d);
+    free(f2);
+    free(d2);
+    free(f3);
+    free(d3);
+    free(ref);
+    free(order);
+    free(got);
+    return passed;
+}
+
 static void benchmark(int log_n, int iterations) {
     int n = 1 << log_n;
     float *buf = (float *)malloc(n * sizeof(float));
@@ -106,6 +1373,200 @@ int main(int argc, char **argv) {
         }
     }
 
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        if (!test_oop_correctness(log_n)) {
+            all_passed = 0;
+        }
+    }
+    if (!test_oop_inplace_large()) {
+        all_passed = 0;
+    }
+
+    for (int log_n = 1; log_n <= MAX_LOG_N; log_n++) {
+        if (!test_batch_correctness(log_n, 7)) {
+            all_passed = 0;
+        }
+    }
+
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        if (!test_strided_correctness(log_n, 37, 1) || !test_strided_correctness(log_n, 3, 1) ||
+            !test_strided_correctness(log_n, 5, 2)) {
+            all_passed = 0;
+        }
+    }
+
+    /* Tiles taller than the cache budget take the recursive split */
+    if (!test_strided_correctness(14, 64, 1)) {
+        all_passed = 0;
+    }
+
+    /* Low runs, high runs, single bits and gaps; large masks also split tiles */
+    uint32_t dim_masks[] = {0x0, 0x1, 0x2, 0x5, 0xa, 0x36, 0x3c3, 0x2aa, 0x201};
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        for (size_t m = 0; m < sizeof(dim_masks) / sizeof(dim_masks[0]); m++) {
+            if (!test_dims_correctness(log_n, dim_masks[m] & ((1u << log_n) - 1))) {
+                all_passed = 0;
+            }
+        }
+    }
+    if (!test_dims_correctness(16, 0xf0f0) || !test_dims_correctness(18, 0x2c001)) {
+        all_passed = 0;
+    }
+
+    int sparse_counts[] = {1, 3, 4, 5, 40};
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        for (int c = 0; c < 5; c++) {
+            if (!test_sparse_correctness(log_n, sparse_counts[c])) {
+                all_passed = 0;
+            }
+        }
+    }
+    if (!test_sparse_correctness(16, 9) || !test_sparse_correctness(16, 1000)) {
+        all_passed = 0;
+    }
+
+    int update_counts[] = {0, 1, 5, 9, 17, 40, 70};
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        for (int c = 0; c < 7; c++) {
+            if (!test_update_correctness(log_n, update_counts[c])) {
+                all_passed = 0;
+            }
+        }
+    }
+    if (!test_update_correctness(22, 10) || !test_update_correctness(20, 200)) {
+        all_passed = 0;
+    }
+
+    /* Below and above the tiled gather (2^8 floats, 2^6 doubles) */
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        if (!test_ordered_correctness(log_n)) {
+            all_passed = 0;
+        }
+    }
+    if (!test_ordered_correctness(17)) {
+        all_passed = 0;
+    }
+
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        if (!test_scaled_correctness(log_n)) {
+            all_passed = 0;
+        }
+    }
+
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        if (!test_stream_correctness(log_n)) {
+            all_passed = 0;
+        }
+    }
+    if (!test_stream_large()) {
+        all_passed = 0;
+    }
+
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        if (!test_int_correctness(log_n)) {
+            all_passed = 0;
+        }
+    }
+
+    if (!test_int_large(16)) {
+        all_passed = 0;
+    }
+
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        if (!test_half_correctness(log_n)) {
+            all_passed = 0;
+        }
+    }
+
+    if (!test_half_correctness(16) || !test_half_correctness(20)) {
+        all_passed = 0;
+    }
+
+    if (!test_fast_copy_stream()) {
+        all_passed = 0;
+    }
+
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        if (!test_xor_convolve_correctness(log_n)) {
+            all_passed = 0;
+        }
+    }
+
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        if (!test_hd_correctness(log_n, log_n % 3 + 1)) {
+            all_passed = 0;
+        }
+    }
+    /* Past the cache block, where the flips ride in the blocked passes */
+    if (!test_hd_correctness(17, 1) || !test_hd_correctness(19, 2)) {
+        all_passed = 0;
+    }
+    {
+        uint64_t sign = 0;
+        float x[4] = {0};
+        if (fht_float_hd(x, 2, &sign, 0) != -1 || fht_float_hd(x, 2, NULL, 1) != -1 ||
+            fht_float_hd_batch(x, 2, 2, 3, &sign, 1, 1.0f) != -1) {
+            printf("hd invalid arguments ... FAIL\n");
+            all_passed = 0;
+        }
+    }
+
+    for (int log_n = 0; log_n <= MAX_LOG_N; log_n++) {
+        if (!test_reduce_correctness(log_n, log_n % 3 + 1)) {
+            all_passed = 0;
+        }
+    }
+    /* Halves past the cache block go out of cache; NaNs and bad k */
+    if (!test_reduce_correctness(17, 1) || !test_reduce_correctness(12, 40)) {
+        all_passed = 0;
+    }
+    {
+        float x[4] = {NAN, 0, 0, 0};
+        size_t idx[5] = {0}, cnt = 0;
+        if (fht_float_topk(x, 2, 0, idx) != -1 || fht_float_topk(x, 2, 5, idx) != -1 ||
+            fht_float_argmax_batch(x, 2, 2, 3, idx) != -1 || fht_float_threshold(x, 2, 0.0f, NULL, 0, &cnt) != 0 ||
+            cnt != 0 || fht_float_topk(x, 2, 4, idx) != 0 || idx[0] != SIZE_MAX) {
+            printf("argmax/topk/threshold invalid arguments ... FAIL\n");
+            all_passed = 0;
+        }
+    }
+
+    if (!test_mt_correctness(16, 3) || !test_mt_correctness(20, 4) || !test_mt_pool_correctness()) {
+        all_passed = 0;
+    }
+
+    for (int log_n = 17; log_n <= 22; log_n++) {
+        if (!test_out_of_cache_correctness(log_n)) {
+            all_passed = 0;
+        }
+    }
+
+    if (!test_file_correctness(0, 10, 1 << 20) || !test_file_correctness(0, 18, 1 << 16) ||
+        !test_file_correctness(1, 21, 8 << 20) || !test_file_errors()) {
+        all_passed = 0;
+    }
+
+    const char *kernel_names[] = {"avx512", "avx", "sse", "sve", "neon"};
+    for (size_t k = 0; k < sizeof(kernel_names) / sizeof(kernel_names[0]); k++) {
+        if (!test_kernel_correctness(kernel_names[k])) {
+            all_passed = 0;
+        }
+    }
+
+    if (!test_wisdom_correctness()) {
+        all_passed = 0;
+    }
+    if (!test_stats_correctness()) {
+        all_passed = 0;
+    }
+
+    /* Rows, columns (chunks of 16), gathered vectors and split long vectors */
+    if (!test_batch_mt_correctness(8, 1001, 1, 256, 4) || !test_batch_mt_correctness(10, 300, 300, 1, 3) ||
+        !test_batch_mt_correctness(6, 2000, 3, 193, 4) || !test_batch_mt_correctness(20, 2, 1, 1 << 20, 4) ||
+        !test_batch_mt_correctness(3, 5, 1, 8, 4)) {
+        all_passed = 0;
+    }
+
     if (all_passed) {
         printf("\nAll correctness tests PASSED!\n\n");
     } else {
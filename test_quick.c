@@ -26,6 +26,14 @@ static int test_defines(void) {
     return 0;
 }
 
+static int test_kernel(void) {
+    printf("\n%s\n", __func__);
+
+    printf("Selected kernel: %s\n", fht_kernel_name());
+
+    return 0;
+}
+
 static int test_fast_copy(void) {
     printf("\n%s\n", __func__);
 
@@ -74,10 +82,202 @@ static int test_oop(void) {
     return 0;
 }
 
+static int test_batch(void) {
+    printf("\n%s\n", __func__);
+
+    float data[3][4] = {
+        {1.0, -1.0, 1.0, -1.0},
+        {1.0, 1.0, 1.0, 1.0},
+        {1.0, 0.0, 0.0, 0.0},
+    };
+
+    int result = fht_float_batch(&data[0][0], 2, 3, 4);
+
+    for (int i = 0; i < 3; i++) {
+        printf("Row %d:  [%f, %f, %f, %f]\n", i, data[i][0], data[i][1], data[i][2], data[i][3]);
+    }
+    printf("Return value: %d\n", result);
+
+    return 0;
+}
+
+static int test_strided(void) {
+    printf("\n%s\n", __func__);
+
+    // The columns are {1, -1, 1, -1}, {1, 1, 1, 1}, {1, 0, 0, 0} and {0, 1, 0, 1}
+    float data[4][4] = {
+        {1.0, 1.0, 1.0, 0.0},
+        {-1.0, 1.0, 0.0, 1.0},
+        {1.0, 1.0, 0.0, 0.0},
+        {-1.0, 1.0, 0.0, 1.0},
+    };
+
+    int result = fht_float_strided(&data[0][0], 2, 4, 4, 1);
+
+    for (int i = 0; i < 4; i++) {
+        printf("Row %d:  [%f, %f, %f, %f]\n", i, data[i][0], data[i][1], data[i][2], data[i][3]);
+    }
+    printf("Return value: %d\n", result);
+
+    return 0;
+}
+
+static int test_dims(void) {
+    printf("\n%s\n", __func__);
+
+    float data[4] = {1.0, -1.0, 1.0, -1.0};
+
+    // Bit 1 only: pairs (0, 2) and (1, 3)
+    int result = fht_float_dims(data, 2, 0x2);
+
+    printf("Output: [%f, %f, %f, %f]\n", data[0], data[1], data[2], data[3]);
+    printf("Return value: %d\n", result);
+
+    return 0;
+}
+
+static int test_sparse(void) {
+    printf("\n%s\n", __func__);
+
+    // Indicator of element 1: the spectrum is row 1 of the Hadamard matrix
+    size_t indices[1] = {1};
+    float values[1] = {1.0};
+    float spectrum[4];
+
+    int result = fht_float_sparse(indices, values, 1, spectrum, 2);
+
+    printf("Output: [%f, %f, %f, %f]\n", spectrum[0], spectrum[1], spectrum[2], spectrum[3]);
+    printf("Return value: %d\n", result);
+
+    return 0;
+}
+
+static int test_scaled(void) {
+    printf("\n%s\n", __func__);
+
+    float data[4] = {1.0, -1.0, 1.0, -1.0};
+
+    int result = fht_float_orthonormal(data, 2);
+    printf("Orthonormal: [%f, %f, %f, %f]\n", data[0], data[1], data[2], data[3]);
+    printf("Return value: %d\n", result);
+
+    // Orthonormal twice is the identity; plain + inverse as well
+    result = fht_float_orthonormal(data, 2);
+    printf("Twice:       [%f, %f, %f, %f]\n", data[0], data[1], data[2], data[3]);
+    printf("Return value: %d\n", result);
+
+    fht_float(data, 2);
+    result = fht_float_inverse(data, 2);
+    printf("Inverse:     [%f, %f, %f, %f]\n", data[0], data[1], data[2], data[3]);
+    printf("Return value: %d\n", result);
+
+    return 0;
+}
+
+static int test_xor_convolve(void) {
+    printf("\n%s\n", __func__);
+
+    // Point masses at 1 and 2 convolve to a point mass at 1 ^ 2 = 3
+    float a[4] = {0.0, 1.0, 0.0, 0.0};
+    float b[4] = {0.0, 0.0, 1.0, 0.0};
+    float out[4];
+    float scratch[4];
+
+    int result = fht_xor_convolve_float(a, b, out, 2, scratch);
+
+    printf("Output: [%f, %f, %f, %f]\n", out[0], out[1], out[2], out[3]);
+    printf("Return value: %d\n", result);
+
+    return 0;
+}
+
+static int test_stream(void) {
+    printf("\n%s\n", __func__);
+
+    float data[4] = {1.0, -1.0, 1.0, -1.0};
+
+    int result = fht_float_stream(data, 2);
+
+    printf("Output: [%f, %f, %f, %f]\n", data[0], data[1], data[2], data[3]);
+    printf("Return value: %d\n", result);
+
+    return 0;
+}
+
+static int test_int(void) {
+    printf("\n%s\n", __func__);
+
+    int32_t data[4] = {1, -1, 1, -1};
+
+    int result = fht_int32(data, 2);
+
+    printf("Output: [%d, %d, %d, %d]\n", data[0], data[1], data[2], data[3]);
+    printf("Return value: %d\n", result);
+
+    return 0;
+}
+
+static int test_half(void) {
+    printf("\n%s\n", __func__);
+
+    // fp16 bit patterns of 1, -1, 1, -1
+    uint16_t data[4] = {0x3C00, 0xBC00, 0x3C00, 0xBC00};
+
+    int result = fht_half(data, 2);
+
+    printf("Output: [0x%04x, 0x%04x, 0x%04x, 0x%04x]\n", data[0], data[1], data[2], data[3]);
+    printf("Return value: %d\n", result);
+
+    return 0;
+}
+
+static int test_wisdom(void) {
+    printf("\n%s\n", __func__);
+
+    int result = fht_tune(8, 1);
+    printf("Tuned kernel for 2^8 floats: %s\n", fht_tuned_kernel_name(8, 0));
+    printf("Return value: %d\n", result);
+    fht_wisdom_forget();
+
+    return 0;
+}
+
+static int test_stats(void) {
+    printf("\n%s\n", __func__);
+
+    static fht_stats st;
+    float buf[16] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+    fht_stats_enable(1);
+    fht_float(buf, 4);
+    fht_float(buf, 4);
+    int result = fht_stats_snapshot(&st, 0);
+    fht_stats_enable(0);
+
+    const fht_stats_counter *c = &st.counters[0][FHT_STATS_INPLACE][4];
+    printf("%s float 2^4: %llu calls, %llu bytes on %s\n", fht_stats_entry_name(FHT_STATS_INPLACE),
+           (unsigned long long)c->calls, (unsigned long long)c->bytes, st.kernel[0][4]);
+    printf("Return value: %d\n", result);
+    fht_stats_reset(0);
+
+    return 0;
+}
+
 int main(void) {
     test_defines();
+    test_kernel();
     test_fast_copy();
     test_inplace();
     test_oop();
+    test_batch();
+    test_strided();
+    test_dims();
+    test_sparse();
+    test_scaled();
+    test_xor_convolve();
+    test_stream();
+    test_int();
+    test_half();
+    test_wisdom();
+    test_stats();
     return 0;
 }
@@ -4,6 +4,9 @@ Python test corresponding to test_quick.c
 Tests the FFHT Python wrapper to verify C implementation is correct
 """
 
+import os
+import tempfile
+
 import numpy as np
 import ffht
 
@@ -77,15 +80,279 @@ def test_larger_size():
 
     return data
 
+def test_scaled():
+    """Test the fused scaled variants (corresponds to test_scaled() in test_quick.c)"""
+    print("\ntest_scaled")
+
+    data = np.array([1.0, -1.0, 1.0, -1.0], dtype=np.float32)
+
+    ffht.fht_orthonormal(data)
+    print(f"Orthonormal: {data}")
+    assert np.allclose(data, [0.0, 2.0, 0.0, 0.0])
+
+    # Orthonormal twice, and plain followed by inverse, are the identity
+    ffht.fht_orthonormal(data)
+    print(f"Twice:       {data}")
+    assert np.allclose(data, [1.0, -1.0, 1.0, -1.0])
+
+    ffht.fht(data)
+    ffht.fht_inverse(data)
+    print(f"Inverse:     {data}")
+    assert np.allclose(data, [1.0, -1.0, 1.0, -1.0])
+
+    ffht.fht_scaled(data, 0.5)
+    print(f"Scaled 0.5:  {data}")
+    assert np.allclose(data, [0.0, 2.0, 0.0, 0.0])
+
+    return data
+
+def test_int():
+    """Exact integer transform (corresponds to test_int() in test_quick.c)"""
+    print("\ntest_int")
+
+    data = np.array([1, -1, 1, -1], dtype=np.int32)
+    ffht.fht(data)
+    print(f"Output: {data}")
+    assert data.tolist() == [0, 4, 0, 0]
+
+    # int16 raises instead of silently clipping
+    try:
+        ffht.fht(np.ones(1 << 16, dtype=np.int16))
+        assert False, "expected OverflowError"
+    except OverflowError:
+        pass
+
+    return data
+
+def test_half():
+    """float16 storage, float32 arithmetic (corresponds to test_half() in test_quick.c)"""
+    print("\ntest_half")
+
+    data = np.array([1, -1, 1, -1], dtype=np.float16)
+    ffht.fht(data)
+    print(f"Output: {data}")
+    assert data.tolist() == [0, 4, 0, 0]
+
+    return data
+
+def test_out():
+    """Out-of-place transform, aligned allocation and no silent copies"""
+    print("\ntest_out")
+
+    data = ffht.created_aligned(4, np.float32)
+    assert data.ctypes.data % 64 == 0
+    data[:] = [1.0, -1.0, 1.0, -1.0]
+    output = np.empty_like(data)
+
+    result = ffht.fht(data, out=output)
+    print(f"Input:  {data}")
+    print(f"Output: {output}")
+    assert result is output
+    assert data.tolist() == [1.0, -1.0, 1.0, -1.0]
+    assert output.tolist() == [0.0, 4.0, 0.0, 0.0]
+
+    # A strided view or a list would be transformed as a temporary copy
+    try:
+        ffht.fht(np.zeros(8, dtype=np.float32)[::2])
+        assert False, "expected ValueError"
+    except ValueError:
+        pass
+    try:
+        ffht.fht([1.0, -1.0])
+        assert False, "expected TypeError"
+    except TypeError:
+        pass
+
+    return output
+
+def test_batch():
+    """Every row, or every column, of a matrix in one call"""
+    print("\ntest_batch")
+
+    data = np.array([[1.0, -1.0, 1.0, -1.0],
+                     [1.0, 1.0, 1.0, 1.0]], dtype=np.float32)
+    ffht.fht_batch(data)
+    print(f"Rows:\n{data}")
+    assert data.tolist() == [[0.0, 4.0, 0.0, 0.0], [4.0, 0.0, 0.0, 0.0]]
+
+    # Along axis 0 the matrix transforms like its transpose along axis 1
+    columns = np.random.randn(8, 5)
+    expected = columns.T.copy()
+    ffht.fht_batch(expected, threads=2)
+    ffht.fht_batch(columns, axis=0)
+    assert np.allclose(columns, expected.T)
+
+    return data
+
+def test_wisdom():
+    """Tune small sizes, save, forget and reload the wisdom"""
+    print("\ntest_wisdom")
+
+    path = os.path.join(tempfile.mkdtemp(), "wisdom.txt")
+    ffht.tune(max_log_n=8, max_threads=1)
+    ffht.wisdom_save(path)
+    ffht.wisdom_forget()
+    ffht.wisdom_load(path)
+    with open(path) as f:
+        print(f"Wisdom file starts: {f.readline().strip()}")
+
+    # Tuning changes the kernel, not the result
+    data = np.arange(8, dtype=np.float64)
+    ffht.fht(data)
+    assert data.tolist() == [28.0, -4.0, -8.0, 0.0, -16.0, 0.0, 0.0, 0.0]
+
+    try:
+        ffht.wisdom_load(path + ".missing")
+        assert False, "missing file must raise"
+    except OSError:
+        pass
+    os.remove(path)
+    ffht.wisdom_forget()
+
+def test_stats():
+    """Call counters of the calling thread"""
+    print("\ntest_stats")
+
+    was = ffht.stats_enable()
+    ffht.stats_reset(all_threads=False)
+    data = np.ones(32, dtype=np.float32)
+    ffht.fht(data)
+    ffht.fht(data)
+    ffht.stats_enable(was)
+
+    entries = ffht.stats(all_threads=False)
+    print(f"Counters: {entries}")
+    inplace = [e for e in entries if e["entry"] == "inplace" and e["log_n"] == 5]
+    assert len(inplace) == 1 and inplace[0]["dtype"] == "float32"
+    assert inplace[0]["calls"] == 2 and inplace[0]["bytes"] == 2 * 32 * 4
+    assert sum(inplace[0]["histogram"]) == 2
+    ffht.stats_reset()
+    assert ffht.stats() == []
+
+def test_hd():
+    """Three sign-flip-and-transform rounds on the rows of a matrix"""
+    print("\ntest_hd")
+
+    rng = np.random.default_rng(3)
+    n = 128
+    signs = rng.integers(0, 2**63, size=3 * n // 64, dtype=np.uint64)
+    data = rng.standard_normal((4, n))
+    expected = data.copy()
+    for row in expected:
+        for r in range(3):
+            words = signs[r * n // 64:(r + 1) * n // 64]
+            bits = (words[:, None] >> np.arange(64, dtype=np.uint64)) & np.uint64(1)
+            row *= np.where(bits.reshape(-1) == 1, -1.0, 1.0)
+            ffht.fht(row)
+
+    def hd_calls():
+        return sum(e["calls"] for e in ffht.stats(all_threads=False)
+                   if e["entry"] == "hd" and e["dtype"] == "float64" and e["log_n"] == 7)
+
+    scale = n ** -1.5
+    was = ffht.stats_enable()
+    before = hd_calls()
+    ffht.fht_hd(data, signs, scale=scale)
+    after = hd_calls()
+    ffht.stats_enable(was)
+    print(f"Max difference to flip-then-fht: {np.abs(data - expected * scale).max()}")
+    assert np.allclose(data, expected * scale)
+    # The batch is one 'hd' call, counted under its own entry
+    assert after == before + 1
+
+def test_reductions():
+    """argmax, top-k and threshold against a sort of the spectrum"""
+    print("\ntest_reductions")
+
+    rng = np.random.default_rng(5)
+    n = 256
+    data = rng.integers(-5, 6, size=(3, n)).astype(np.float32)
+    spectrum = data.astype(np.float64)
+    for row in spectrum:
+        ffht.fht(row)
+    # Larger magnitude first, then lower index
+    order = np.lexsort((np.arange(n)[None, :].repeat(3, 0), -np.abs(spectrum)), axis=1)
+
+    top = data.copy()
+    assert (ffht.fht_topk(top, 4) == order[:, :4]).all()
+    assert np.array_equal(top, spectrum)
+    rows = data.copy()
+    assert (ffht.fht_argmax(rows) == order[:, 0]).all()
+    assert ffht.fht_argmax(data[0].copy()) == order[0, 0]
+
+    t = np.abs(spectrum[0, order[0, 9]])
+    hits = ffht.fht_threshold(data[0].astype(np.float64), t)
+    assert (hits == np.flatnonzero(np.abs(spectrum[0]) >= t)).all()
+
+def test_order():
+    """Sequency and Paley output against the natural spectrum, permuted"""
+    print("\ntest_order")
+
+    log_n = 10
+    n = 1 << log_n
+    data = np.random.default_rng(6).integers(-5, 6, size=n).astype(np.float64)
+    natural = ffht.fht(data, out=np.empty_like(data))
+    k = np.arange(n)
+    rev = np.array([int(format(i, "0%db" % log_n)[::-1], 2) for i in k])
+    gray_rev = rev[k ^ (k >> 1)]
+
+    paley = ffht.fht(data, out=np.empty_like(data), order="paley")
+    assert np.array_equal(paley, natural[rev])
+    inplace = data.astype(np.float32)
+    ffht.fht(inplace, order="sequency")
+    assert np.array_equal(inplace, natural[gray_rev])
+    try:
+        ffht.fht(data.copy(), order="hadamard")
+        assert False
+    except ValueError:
+        pass
+
+def test_file():
+    """Out-of-core transform of a vector stored after a header in a file"""
+    print("\ntest_file")
+
+    path = os.path.join(tempfile.mkdtemp(), "vector.bin")
+    data = np.cos(np.arange(1 << 14) * 0.3)
+    with open(path, "wb") as f:
+        f.write(b"header")
+        f.write(data.tobytes())
+    with open(path, "r+b") as f:
+        # 64 KiB tiles: two passes over the file
+        ffht.fht_file(f, data.size, offset=6, dtype=np.float64, mem_bytes=128 << 10)
+        f.seek(6)
+        result = np.frombuffer(f.read(), dtype=np.float64)
+        try:
+            ffht.fht_file(f, 1 << 20, dtype=np.float64)
+            assert False, "reading past the end must raise"
+        except OSError:
+            pass
+
+    ffht.fht(data)
+    print(f"Max difference to fht: {np.abs(result - data).max()}")
+    assert np.allclose(result, data)
+    os.remove(path)
+
 def main():
     print("=" * 60)
     print("FFHT Python Test (corresponding to test_quick.c)")
     print("=" * 60)
+    print(f"Selected kernel: {ffht.kernel_name()}")
 
     result1 = test_inplace()
     result2 = test_inplace_copy()
     result3 = test_double()
     result4 = test_larger_size()
+    test_scaled()
+    test_int()
+    test_half()
+    test_out()
+    test_batch()
+    test_wisdom()
+    test_stats()
+    test_hd()
+    test_reductions()
+    test_order()
+    test_file()
 
     print("\n" + "=" * 60)
     print("Summary:")